@@ -0,0 +1,80 @@
+/**
+ * @file bench_bulk_cancel.cpp
+ * @brief Order cancellation restock benchmark
+ *
+ * Usage: bench_bulk_cancel [orders] [products]
+ * Confirms the same set of multi-line orders twice, then cancels them once
+ * one order at a time and once with a single cancelOrders call, which
+ * returns all released stock under one inventory lock acquisition.
+ */
+
+#include "../include/Order.hpp"
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+using namespace quirkventory;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int LINES_PER_ORDER = 3;
+
+std::vector<std::string> placeOrders(OrderManager& manager, Inventory& inventory, int order_count, int product_count) {
+    std::vector<std::string> order_ids;
+    order_ids.reserve(order_count);
+    for (int i = 0; i < order_count; ++i) {
+        Order* order = manager.createOrder("ORD" + std::to_string(i), "CUST" + std::to_string(i % 1000));
+        for (int line = 0; line < LINES_PER_ORDER; ++line) {
+            order->addItem("SKU" + std::to_string((i * LINES_PER_ORDER + line) % product_count), 1, 10.0);
+        }
+        order->processOrder(inventory);
+        order_ids.push_back(order->getOrderId());
+    }
+    return order_ids;
+}
+
+double run(const char* label, bool bulk, int order_count, int product_count) {
+    Inventory inventory;
+    OrderManager manager(&inventory);
+    auto expiry = std::chrono::system_clock::now() + std::chrono::hours(24 * 30);
+    int per_product = order_count * LINES_PER_ORDER / product_count + 1;
+    for (int p = 0; p < product_count; ++p) {
+        inventory.addProduct(std::make_unique<PerishableProduct>(
+            "SKU" + std::to_string(p), "Item " + std::to_string(p), "Bench", 10.0, per_product, expiry));
+    }
+    std::vector<std::string> order_ids = placeOrders(manager, inventory, order_count, product_count);
+    int reserved_quantity = inventory.getTotalQuantity();
+
+    auto start = Clock::now();
+    size_t cancelled = 0;
+    if (bulk) {
+        cancelled = manager.cancelOrders(order_ids, "Bulk cancel");
+    } else {
+        for (const auto& order_id : order_ids) {
+            cancelled += manager.cancelOrder(order_id, "Cancel") ? 1 : 0;
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << std::left << std::setw(8) << label << std::right
+              << std::setw(8) << cancelled << " orders in " << std::setw(8) << seconds * 1000 << " ms ("
+              << std::setw(6) << cancelled / seconds / 1e6 << " M orders/s), restocked "
+              << inventory.getTotalQuantity() - reserved_quantity << " units" << std::endl;
+    return seconds;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int order_count = argc > 1 ? std::stoi(argv[1]) : 100000;
+    int product_count = argc > 2 ? std::stoi(argv[2]) : 1000;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << order_count << " orders x " << LINES_PER_ORDER << " lines over "
+              << product_count << " products" << std::endl;
+
+    double single = run("single", false, order_count, product_count);
+    double bulk = run("bulk", true, order_count, product_count);
+    std::cout << "Bulk speedup: " << single / bulk << "x" << std::endl;
+    return 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file bench_cluster_scaling.cpp
+ * @brief Order throughput of a partitioned cluster from 1 to 8 node processes
+ *
+ * Usage: bench_cluster_scaling [clients] [seconds] [cross_node_percent]
+ * Each node is a forked child process serving its partition over loopback.
+ * Client threads in the parent place two-line orders through one shared
+ * ClusterRouter; cross_node_percent of the orders pair products owned by
+ * different nodes and go through two-phase commit. Throughput only scales
+ * with nodes if the machine has cores to run them on.
+ */
+
+#include "../include/Cluster.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <sys/wait.h>
+
+using namespace quirkventory;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t kProductsPerNode = 2000;
+
+struct NodeProcess {
+    pid_t pid;
+    int stop_fd;    // Closing it tells the child to exit
+    uint16_t port;
+};
+
+// Fork a node serving on a free port; the parent has no threads yet at this point
+bool spawnNode(NodeProcess& process) {
+    int port_pipe[2];
+    int stop_pipe[2];
+    if (::pipe(port_pipe) < 0 || ::pipe(stop_pipe) < 0) {
+        return false;
+    }
+
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        ::close(port_pipe[0]);
+        ::close(stop_pipe[1]);
+        int status = 1;
+        {
+            Inventory inventory;
+            ClusterNode node(inventory, 0);
+            if (node.start()) {
+                uint16_t port = node.getPort();
+                if (::write(port_pipe[1], &port, sizeof(port)) == sizeof(port)) {
+                    char byte;
+                    while (::read(stop_pipe[0], &byte, 1) > 0) {
+                    }
+                    status = 0;
+                }
+                node.stop();
+            }
+        }
+        ::_exit(status);
+    }
+
+    ::close(port_pipe[1]);
+    ::close(stop_pipe[0]);
+    process.pid = pid;
+    process.stop_fd = stop_pipe[1];
+    bool ok = ::read(port_pipe[0], &process.port, sizeof(process.port)) == sizeof(process.port);
+    ::close(port_pipe[0]);
+    return ok;
+}
+
+// Later children inherited the earlier stop pipes, so close them all before waiting
+void stopNodes(const std::vector<NodeProcess>& processes) {
+    for (const auto& process : processes) {
+        ::close(process.stop_fd);
+    }
+    for (const auto& process : processes) {
+        ::waitpid(process.pid, nullptr, 0);
+    }
+}
+
+struct RunResult {
+    size_t committed = 0;
+    size_t failed = 0;
+    double orders_per_second = 0.0;
+    double p50_us = 0.0;
+    double p99_us = 0.0;
+};
+
+RunResult run(const std::vector<NodeProcess>& processes, size_t clients, double seconds, int cross_percent) {
+    std::vector<ClusterNodeAddress> addresses;
+    for (const auto& process : processes) {
+        addresses.push_back({"127.0.0.1", process.port});
+    }
+    ClusterRouter router(addresses);
+
+    // Products grouped by owner so orders can pick same-node or cross-node pairs
+    size_t node_count = processes.size();
+    std::vector<std::vector<std::string>> owned(node_count);
+    auto expiry = std::chrono::system_clock::now() + std::chrono::hours(24 * 30);
+    for (size_t i = 0; i < kProductsPerNode * node_count; ++i) {
+        std::string id = "N" + std::to_string(node_count) + "-P" + std::to_string(i);
+        router.addProduct(PerishableProduct(id, "Product " + std::to_string(i), "Category" + std::to_string(i % 8),
+                                            1.0 + static_cast<double>(i % 100), 1000000, expiry));
+        owned[router.ownerOf(id)].push_back(id);
+    }
+
+    std::atomic<bool> stop{false};
+    std::vector<std::vector<double>> latencies(clients);
+    std::vector<size_t> failures(clients, 0);
+    std::vector<std::thread> threads;
+    for (size_t c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c]() {
+            std::mt19937 rng(static_cast<unsigned>(c + 1));
+            std::uniform_int_distribution<int> percent(0, 99);
+            while (!stop.load()) {
+                size_t first = rng() % node_count;
+                size_t second = first;
+                if (node_count > 1 && percent(rng) < cross_percent) {
+                    second = (first + 1 + rng() % (node_count - 1)) % node_count;
+                }
+                const auto& a = owned[first];
+                const auto& b = owned[second];
+                std::vector<std::pair<std::string, int>> lines = {
+                    {a[rng() % a.size()], 1}, {b[rng() % b.size()], 1}};
+
+                auto start = Clock::now();
+                ClusterOrderResult result = router.placeOrder(lines);
+                double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+                if (result == ClusterOrderResult::COMMITTED) {
+                    latencies[c].push_back(us);
+                } else {
+                    failures[c]++;
+                }
+            }
+        });
+    }
+
+    auto start = Clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    RunResult result;
+    std::vector<double> all;
+    for (size_t c = 0; c < clients; ++c) {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        result.failed += failures[c];
+    }
+    result.committed = all.size();
+    result.orders_per_second = static_cast<double>(all.size()) / elapsed;
+    if (!all.empty()) {
+        std::sort(all.begin(), all.end());
+        result.p50_us = all[all.size() / 2];
+        result.p99_us = all[std::min(all.size() - 1, all.size() * 99 / 100)];
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t clients = argc > 1 ? std::stoul(argv[1]) : 16;
+    double seconds = argc > 2 ? std::stod(argv[2]) : 2.0;
+    int cross_percent = argc > 3 ? std::stoi(argv[3]) : 20;
+    const std::vector<size_t> node_counts = {1, 2, 4, 8};
+
+    // Fork every node up front, before the parent starts any thread
+    std::vector<NodeProcess> processes(node_counts.back());
+    for (auto& process : processes) {
+        if (!spawnNode(process)) {
+            stopNodes(std::vector<NodeProcess>(processes.begin(), processes.begin() + (&process - processes.data())));
+            std::cerr << "Failed to start a node process" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "Cluster scaling: " << clients << " clients, " << seconds << " s per run, "
+              << cross_percent << "% cross-node orders, "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    std::cout << std::setw(6) << "nodes" << std::setw(14) << "orders/s" << std::setw(10) << "speedup"
+              << std::setw(12) << "p50 us" << std::setw(12) << "p99 us" << std::setw(10) << "failed" << std::endl;
+
+    double baseline = 0.0;
+    for (size_t node_count : node_counts) {
+        // Runs reuse the first node_count processes; product IDs are prefixed per run
+        std::vector<NodeProcess> used(processes.begin(), processes.begin() + node_count);
+        RunResult result = run(used, clients, seconds, cross_percent);
+        if (baseline == 0.0) {
+            baseline = result.orders_per_second;
+        }
+        std::cout << std::setw(6) << node_count << std::setw(14) << std::fixed << std::setprecision(0)
+                  << result.orders_per_second << std::setw(9) << std::setprecision(2)
+                  << (baseline > 0.0 ? result.orders_per_second / baseline : 0.0) << "x"
+                  << std::setw(12) << std::setprecision(1) << result.p50_us
+                  << std::setw(12) << result.p99_us << std::setw(10) << result.failed << std::endl;
+    }
+
+    stopNodes(processes);
+    return 0;
+}
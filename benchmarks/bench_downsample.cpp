@@ -0,0 +1,75 @@
+/**
+ * @file bench_downsample.cpp
+ * @brief Chart downsampling throughput benchmark
+ *
+ * Usage: bench_downsample [points] [target]
+ * Downsamples a random-walk series with LTTB and min/max bucketing, both on
+ * raw arrays and end to end from a compressed TimeSeries, and reports
+ * million points per second.
+ */
+
+#include "../include/Downsampling.hpp"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <cmath>
+#include <string>
+
+using namespace quirkventory;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+void report(const std::string& label, size_t points, size_t selected, double seconds) {
+    std::cout << std::left << std::setw(28) << label << std::right
+              << std::setw(10) << std::setprecision(1) << seconds * 1000.0 << " ms"
+              << std::setw(10) << points / seconds / 1e6 << " Mpts/s"
+              << std::setw(10) << selected << " selected" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t point_count = argc > 1 ? std::stoul(argv[1]) : 10000000;
+    size_t target = argc > 2 ? std::stoul(argv[2]) : 2000;
+
+    std::cout << "Generating " << point_count << " points..." << std::endl;
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::vector<double> x(point_count);
+    std::vector<double> y(point_count);
+    double level = 1000.0;
+    for (size_t i = 0; i < point_count; ++i) {
+        level += step(rng);
+        x[i] = 1704067200.0 + static_cast<double>(i) * 10.0;
+        y[i] = level;
+    }
+
+    std::cout << std::fixed;
+
+    auto start = Clock::now();
+    auto lttb = Downsampling::largestTriangleThreeBuckets(x.data(), y.data(), point_count, target);
+    report("LTTB (arrays)", point_count, lttb.size(), std::chrono::duration<double>(Clock::now() - start).count());
+
+    start = Clock::now();
+    auto min_max = Downsampling::minMaxBuckets(y.data(), point_count, target);
+    report("Min/max (arrays)", point_count, min_max.size(), std::chrono::duration<double>(Clock::now() - start).count());
+
+    // End to end: decode the compressed series for the range, then downsample
+    TimeSeries series;
+    for (size_t i = 0; i < point_count; ++i) {
+        series.append(static_cast<long long>(x[i]), std::round(y[i]));
+    }
+    std::cout << "Compressed series: " << std::setprecision(2)
+              << static_cast<double>(series.getCompressedBytes()) / point_count << " bytes/point" << std::endl;
+
+    start = Clock::now();
+    auto points = series.getPoints(static_cast<long long>(x.front()), static_cast<long long>(x.back()));
+    report("Decode", point_count, points.size(), std::chrono::duration<double>(Clock::now() - start).count());
+
+    start = Clock::now();
+    auto selected = Downsampling::downsample(points, target, DownsampleMethod::LTTB);
+    report("LTTB (from points)", point_count, selected.size(), std::chrono::duration<double>(Clock::now() - start).count());
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file bench_holds.cpp
+ * @brief Stock hold placement and expiry benchmark
+ *
+ * Usage: bench_holds [holds]
+ * Measures the raw timing wheel with millions of timers spread over an
+ * hour of ticks, then places holds through Inventory and expires them.
+ */
+
+#include "../include/Inventory.hpp"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <thread>
+
+using namespace quirkventory;
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char* argv[]) {
+    size_t hold_count = argc > 1 ? std::stoul(argv[1]) : 2000000;
+    std::cout << std::fixed << std::setprecision(1);
+
+    // Timing wheel alone: 100 ms ticks, TTLs up to one hour
+    {
+        std::mt19937_64 rng(1);
+        TimingWheel wheel;
+        auto start = Clock::now();
+        for (uint64_t id = 1; id <= hold_count; ++id) {
+            wheel.schedule(id, 1 + rng() % 36000);
+        }
+        double schedule_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        start = Clock::now();
+        size_t fired = 0;
+        for (uint64_t tick = 1; tick <= 36000; ++tick) {
+            fired += wheel.advance(tick, [](uint64_t) {});
+        }
+        double expire_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::cout << "Wheel: scheduled " << hold_count << " timers at "
+                  << hold_count / schedule_seconds / 1e6 << " M/s, expired " << fired << " over 36000 ticks at "
+                  << fired / expire_seconds / 1e6 << " M/s" << std::endl;
+    }
+
+    // Through Inventory: holds on 1000 products, all expiring within a second
+    Inventory inventory;
+    auto expiry = std::chrono::system_clock::now() + std::chrono::hours(24 * 30);
+    for (int i = 0; i < 1000; ++i) {
+        inventory.addProduct(std::make_unique<PerishableProduct>(
+            "P" + std::to_string(i), "Product " + std::to_string(i), "Bench", 1.0,
+            static_cast<int>(hold_count), expiry));
+    }
+
+    std::vector<std::string> product_ids;
+    for (int i = 0; i < 1000; ++i) {
+        product_ids.push_back("P" + std::to_string(i));
+    }
+
+    // Early holds start expiring while later ones are still being placed
+    auto start = Clock::now();
+    size_t placed = 0;
+    for (size_t i = 0; i < hold_count; ++i) {
+        placed += inventory.placeHold(product_ids[i % 1000], 1, std::chrono::milliseconds(200 + i % 800)) != 0;
+    }
+    double place_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << "Inventory: placed " << placed << " holds at " << placed / place_seconds / 1e6
+              << " M/s, " << inventory.getHoldCount() << " still active" << std::endl;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+    start = Clock::now();
+    size_t expired = inventory.expireHolds();
+    double expire_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << "Inventory: expired " << expired << " holds in " << expire_seconds * 1000.0 << " ms ("
+              << expired / expire_seconds / 1e6 << " M/s), " << inventory.getHoldCount() << " remaining" << std::endl;
+
+    return 0;
+}
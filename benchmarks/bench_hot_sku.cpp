@@ -0,0 +1,80 @@
+/**
+ * @file bench_hot_sku.cpp
+ * @brief Contended single-product reservation benchmark
+ *
+ * Usage: bench_hot_sku [threads] [removals_per_thread]
+ * Every thread removes one unit at a time from the same product, first
+ * through the plain locked path, then with every removal combined, then
+ * with automatic hot-key detection.
+ */
+
+#include "../include/Inventory.hpp"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <atomic>
+
+using namespace quirkventory;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+void run(const char* label, StockCombining mode, int threads, int per_thread) {
+    Inventory inventory;
+    inventory.setStockCombining(mode);
+    auto expiry = std::chrono::system_clock::now() + std::chrono::hours(24 * 30);
+    inventory.addProduct(std::make_unique<PerishableProduct>(
+        "HOT001", "Flash Sale Item", "Bench", 10.0, threads * per_thread, expiry));
+    inventory.addProduct(std::make_unique<PerishableProduct>(
+        "COLD001", "Regular Item", "Bench", 10.0, 1000, expiry));
+
+    std::atomic<bool> go{false};
+    std::atomic<int> succeeded{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            int ok = 0;
+            for (int i = 0; i < per_thread; ++i) {
+                ok += inventory.removeQuantity("HOT001", 1) ? 1 : 0;
+            }
+            succeeded += ok;
+        });
+    }
+
+    auto start = Clock::now();
+    go = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    const StockCombiner& combiner = inventory.getStockCombiner();
+    uint64_t batches = combiner.getBatchCount();
+    std::cout << std::left << std::setw(10) << label << std::right
+              << std::setw(10) << succeeded.load() / seconds / 1e6 << " M removals/s, "
+              << std::setw(8) << batches << " batches";
+    if (batches > 0) {
+        std::cout << " (avg " << static_cast<double>(combiner.getCombinedRequestCount()) / batches << " per batch)";
+    }
+    std::cout << ", left " << inventory.getProduct("HOT001")->getQuantity()
+              << ", hot: HOT001=" << combiner.isHot("HOT001")
+              << " COLD001=" << combiner.isHot("COLD001") << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int threads = argc > 1 ? std::stoi(argv[1]) : 64;
+    int per_thread = argc > 2 ? std::stoi(argv[2]) : 20000;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << threads << " threads x " << per_thread << " removals of one SKU" << std::endl;
+
+    run("locked", StockCombining::OFF, threads, per_thread);
+    run("combined", StockCombining::ALWAYS, threads, per_thread);
+    run("auto", StockCombining::AUTO, threads, per_thread);
+    return 0;
+}
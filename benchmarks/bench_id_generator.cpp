@@ -0,0 +1,90 @@
+/**
+ * @file bench_id_generator.cpp
+ * @brief Unique ID generation throughput and collision benchmark
+ *
+ * Usage: bench_id_generator [total_ids] [max_threads]
+ * Reports IDs/sec for 1, 2, 4, ... max_threads threads, then generates
+ * total_ids IDs across max_threads threads and checks them for collisions.
+ */
+
+#include "../include/IdGenerator.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace quirkventory;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+/**
+ * @brief Generate IDs on several threads, optionally keeping them
+ * @return Elapsed seconds
+ */
+double run(IdGenerator& generator, size_t total, size_t thread_count, std::vector<uint64_t>* output) {
+    std::vector<std::thread> threads;
+    auto start = Clock::now();
+
+    for (size_t t = 0; t < thread_count; ++t) {
+        size_t first = total * t / thread_count;
+        size_t last = total * (t + 1) / thread_count;
+        threads.emplace_back([&generator, output, first, last]() {
+            uint64_t checksum = 0;
+            for (size_t i = first; i < last; ++i) {
+                uint64_t id = generator.next();
+                if (output) {
+                    (*output)[i] = id;
+                } else {
+                    checksum ^= id;
+                }
+            }
+            volatile uint64_t sink = checksum;
+            (void)sink;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t total = argc > 1 ? std::stoul(argv[1]) : 100000000;
+    size_t max_threads = argc > 2 ? std::stoul(argv[2]) : 8;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    size_t throughput_ids = std::min<size_t>(total, 20000000);
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        IdGenerator generator;
+        double seconds = run(generator, throughput_ids, threads, nullptr);
+        std::cout << std::setw(3) << threads << " threads: "
+                  << std::setw(8) << throughput_ids / seconds / 1e6 << " M IDs/s" << std::endl;
+    }
+
+    std::cout << "Collision check over " << total << " IDs on " << max_threads << " threads..." << std::endl;
+    std::vector<uint64_t> ids(total);
+    IdGenerator generator;
+    double seconds = run(generator, total, max_threads, &ids);
+
+    std::sort(ids.begin(), ids.end());
+    size_t collisions = 0;
+    for (size_t i = 1; i < ids.size(); ++i) {
+        collisions += ids[i] == ids[i - 1];
+    }
+
+    auto lead = IdGenerator::getTimestamp(ids.back()) - std::chrono::system_clock::now();
+    std::cout << "Generated in " << seconds << " s, collisions: " << collisions
+              << ", newest ID ahead of clock by "
+              << std::max<long long>(0, std::chrono::duration_cast<std::chrono::milliseconds>(lead).count())
+              << " ms" << std::endl;
+
+    return collisions == 0 ? 0 : 1;
+}
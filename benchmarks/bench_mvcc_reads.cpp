@@ -0,0 +1,119 @@
+/**
+ * @file bench_mvcc_reads.cpp
+ * @brief Writer latency while long snapshots run, with and without versioning
+ *
+ * Usage: bench_mvcc_reads [products] [seconds]
+ * A writer thread keeps moving stock while a reader takes full inventory
+ * snapshots back to back. Without versioning each snapshot holds the
+ * inventory lock for the whole copy; with versioning it reads a pinned view.
+ */
+
+#include "../include/Inventory.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace quirkventory;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct RunResult {
+    size_t writes = 0;
+    size_t snapshots = 0;
+    double p50_us = 0.0;
+    double p99_us = 0.0;
+    double max_us = 0.0;
+    double snapshot_ms = 0.0;
+    uint64_t retained_versions = 0;
+};
+
+RunResult run(size_t product_count, double seconds, bool versioned) {
+    Inventory inventory;
+    auto expiry = std::chrono::system_clock::now() + std::chrono::hours(24 * 30);
+    for (size_t i = 0; i < product_count; ++i) {
+        inventory.addProduct(std::make_unique<PerishableProduct>(
+            "P" + std::to_string(i), "Product " + std::to_string(i), "Category" + std::to_string(i % 8),
+            1.0 + static_cast<double>(i % 100), 1000, expiry));
+    }
+    inventory.setStockCombining(StockCombining::OFF);
+    if (versioned) {
+        inventory.enableVersioning(std::chrono::milliseconds(0));
+    }
+
+    std::atomic<bool> stop{false};
+    RunResult result;
+
+    std::thread reader([&]() {
+        double total_ms = 0.0;
+        while (!stop.load()) {
+            auto start = Clock::now();
+            auto snapshot = inventory.snapshot();
+            total_ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            result.snapshots++;
+            if (versioned) {
+                inventory.collectVersionGarbage();
+            }
+        }
+        result.snapshot_ms = result.snapshots > 0 ? total_ms / result.snapshots : 0.0;
+    });
+
+    std::vector<double> latencies;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, product_count - 1);
+    auto end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    while (Clock::now() < end) {
+        std::string id = "P" + std::to_string(pick(rng));
+        auto start = Clock::now();
+        if (latencies.size() % 2 == 0) {
+            inventory.removeQuantity(id, 1);
+        } else {
+            inventory.addQuantity(id, 1);
+        }
+        latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+    stop = true;
+    reader.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    result.writes = latencies.size();
+    if (!latencies.empty()) {
+        result.p50_us = latencies[latencies.size() / 2];
+        result.p99_us = latencies[latencies.size() * 99 / 100];
+        result.max_us = latencies.back();
+    }
+    if (const VersionStore* versions = inventory.getVersionStore()) {
+        result.retained_versions = versions->getVersionCount();
+    }
+    return result;
+}
+
+void print(const char* label, const RunResult& result, double seconds) {
+    std::cout << label << std::endl
+              << "  writes/s:          " << result.writes / seconds << std::endl
+              << "  write p50/p99/max: " << result.p50_us << " / " << result.p99_us << " / "
+              << result.max_us << " us" << std::endl
+              << "  snapshots:         " << result.snapshots << " (avg " << result.snapshot_ms << " ms)" << std::endl;
+    if (result.retained_versions > 0) {
+        std::cout << "  retained versions: " << result.retained_versions << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t product_count = argc > 1 ? std::stoul(argv[1]) : 200000;
+    double seconds = argc > 2 ? std::stod(argv[2]) : 3.0;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Products: " << product_count << ", " << seconds << " s per run" << std::endl;
+
+    print("Locked snapshots:", run(product_count, seconds, false), seconds);
+    print("Versioned snapshots:", run(product_count, seconds, true), seconds);
+    return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file bench_order_concurrency.cpp
+ * @brief Order processing concurrency benchmark
+ *
+ * Usage: bench_order_concurrency [orders] [products]
+ * Processes the same pending orders with fixed concurrency levels and with
+ * the adaptive limiter, reporting throughput and, for the adaptive run, the
+ * limit it settled on.
+ */
+
+#include "../include/Order.hpp"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+
+using namespace quirkventory;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+void run(const std::string& label, int max_concurrent, int order_count, int product_count) {
+    Inventory inventory;
+    OrderManager manager(&inventory);
+    auto expiry = std::chrono::system_clock::now() + std::chrono::hours(24 * 30);
+    for (int p = 0; p < product_count; ++p) {
+        inventory.addProduct(std::make_unique<PerishableProduct>(
+            "SKU" + std::to_string(p), "Item " + std::to_string(p), "Bench", 10.0, order_count, expiry));
+    }
+    for (int i = 0; i < order_count; ++i) {
+        Order* order = manager.createOrder("ORD" + std::to_string(i), "CUST" + std::to_string(i % 1000));
+        order->addItem("SKU" + std::to_string(i % product_count), 1, 10.0);
+        order->addItem("SKU" + std::to_string((i * 7 + 3) % product_count), 1, 10.0);
+    }
+
+    auto start = Clock::now();
+    int processed = manager.processAllPendingOrders(inventory, max_concurrent);
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << std::left << std::setw(10) << label << std::right
+              << std::setw(8) << processed << " orders in " << std::setw(8) << seconds * 1000 << " ms ("
+              << std::setw(7) << processed / seconds / 1e3 << " K orders/s)";
+    if (max_concurrent == 0) {
+        const ConcurrencyLimiter& limiter = manager.getProcessingLimiter();
+        std::cout << ", limit " << limiter.getLimit()
+                  << ", latency " << limiter.getLatencyMicros() << " us"
+                  << " (baseline " << limiter.getBaselineLatencyMicros() << " us)";
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int order_count = argc > 1 ? std::stoi(argv[1]) : 20000;
+    int product_count = argc > 2 ? std::stoi(argv[2]) : 100;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << order_count << " orders over " << product_count << " products, "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+
+    for (int fixed : {1, 4, 16, 64}) {
+        run("fixed " + std::to_string(fixed), fixed, order_count, product_count);
+    }
+    run("adaptive", 0, order_count, product_count);
+    return 0;
+}
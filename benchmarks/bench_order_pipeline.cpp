@@ -0,0 +1,98 @@
+/**
+ * @file bench_order_pipeline.cpp
+ * @brief Staged order pipeline benchmark
+ *
+ * Usage: bench_order_pipeline [orders] [products]
+ * Processes the same three-line orders with one processOrder call per
+ * order, then through the staged pipeline with batches of 1 and 64, and
+ * reports throughput, latency and inventory lock acquisitions per order.
+ */
+
+#include "../include/OrderPipeline.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+using namespace quirkventory;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int LINES_PER_ORDER = 3;
+
+struct Setup {
+    Inventory inventory;
+    OrderManager manager{&inventory};
+    std::vector<Order*> orders;
+
+    Setup(int order_count, int product_count) {
+        auto expiry = std::chrono::system_clock::now() + std::chrono::hours(24 * 30);
+        for (int p = 0; p < product_count; ++p) {
+            inventory.addProduct(std::make_unique<PerishableProduct>(
+                "SKU" + std::to_string(p), "Item " + std::to_string(p), "Bench", 10.0, order_count, expiry));
+        }
+        orders.reserve(order_count);
+        for (int i = 0; i < order_count; ++i) {
+            Order* order = manager.createOrder("ORD" + std::to_string(i), "CUST" + std::to_string(i % 1000));
+            for (int line = 0; line < LINES_PER_ORDER; ++line) {
+                order->addItem("SKU" + std::to_string((i * LINES_PER_ORDER + line) % product_count), 1, 10.0);
+            }
+            orders.push_back(order);
+        }
+    }
+};
+
+void report(const char* label, size_t orders, double seconds, double lock_acquisitions, const std::string& extra) {
+    std::cout << std::left << std::setw(12) << label << std::right
+              << std::setw(8) << seconds * 1000 << " ms (" << std::setw(7) << orders / seconds / 1e3
+              << " K orders/s), " << std::setw(6) << lock_acquisitions / orders
+              << " reserve locks/order" << extra << std::endl;
+}
+
+void runDirect(int order_count, int product_count) {
+    Setup setup(order_count, product_count);
+    auto start = Clock::now();
+    for (Order* order : setup.orders) {
+        order->processOrder(setup.inventory);
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    report("direct", setup.orders.size(), seconds, static_cast<double>(setup.orders.size()) * LINES_PER_ORDER, "");
+}
+
+void runPipeline(const char* label, size_t batch_size, int order_count, int product_count) {
+    Setup setup(order_count, product_count);
+    OrderPipelineConfig config;
+    config.batch_size = batch_size;
+    OrderPipeline pipeline(setup.inventory, config);
+
+    auto start = Clock::now();
+    for (Order* order : setup.orders) {
+        while (!pipeline.submit(order)) {
+            std::this_thread::yield();
+        }
+    }
+    pipeline.waitUntilIdle(std::chrono::minutes(5));
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    OrderPipelineStats stats = pipeline.getStats();
+    std::ostringstream extra;
+    extra << std::fixed << std::setprecision(2) << ", " << stats.confirmed << " confirmed, latency avg "
+          << stats.average_latency_us / 1000 << " ms / max " << stats.max_latency_us / 1000.0 << " ms";
+    report(label, setup.orders.size(), seconds, static_cast<double>(stats.reserve_batches), extra.str());
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int order_count = argc > 1 ? std::stoi(argv[1]) : 50000;
+    int product_count = argc > 2 ? std::stoi(argv[2]) : 1000;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << order_count << " orders x " << LINES_PER_ORDER << " lines over "
+              << product_count << " products" << std::endl;
+
+    runDirect(order_count, product_count);
+    runPipeline("pipeline/1", 1, order_count, product_count);
+    runPipeline("pipeline/64", 64, order_count, product_count);
+    return 0;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file bench_report_export.cpp
+ * @brief Streaming report export throughput benchmark
+ *
+ * Usage: bench_report_export [products] [output_dir]
+ * Exports a full inventory listing in each format and reports MB/s.
+ */
+
+#include "../include/Inventory.hpp"
+#include "../include/NotificationSystem.hpp"
+#include "../include/ReportWriter.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cstdio>
+#include <string>
+
+using namespace quirkventory;
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char* argv[]) {
+    size_t product_count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    std::string output_dir = argc > 2 ? argv[2] : "/tmp";
+
+    const char* categories[] = {"Dairy", "Bakery", "Produce", "Electronics", "Household", "Frozen"};
+    auto now = std::chrono::system_clock::now();
+
+    std::cout << "Building " << product_count << " products..." << std::endl;
+    Inventory inventory;
+    for (size_t i = 0; i < product_count; ++i) {
+        auto expiry = now + std::chrono::hours(1 + 24 * static_cast<int>(i % 60));
+        inventory.addProduct(std::make_unique<PerishableProduct>(
+            "P" + std::to_string(i), "Product " + std::to_string(i), categories[i % 6],
+            1.0 + static_cast<double>(i % 100), static_cast<int>(i % 200), expiry));
+    }
+
+    InventoryReport report(&inventory, "bench", true, true, true);
+    const std::pair<const char*, ReportFormat> formats[] = {
+        {"text", ReportFormat::TEXT},
+        {"csv", ReportFormat::CSV},
+        {"jsonl", ReportFormat::JSON_LINES}
+    };
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& format : formats) {
+        std::string filename = output_dir + "/quirkventory_export." + format.first;
+
+        auto start = Clock::now();
+        bool ok = report.exportToFile(filename, format.second);
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::FILE* file = std::fopen(filename.c_str(), "rb");
+        long bytes = 0;
+        if (file) {
+            std::fseek(file, 0, SEEK_END);
+            bytes = std::ftell(file);
+            std::fclose(file);
+        }
+        std::remove(filename.c_str());
+
+        double megabytes = bytes / (1024.0 * 1024.0);
+        std::cout << std::setw(6) << format.first << ": " << (ok ? "" : "FAILED ")
+                  << megabytes << " MB in " << seconds * 1000 << " ms ("
+                  << megabytes / seconds << " MB/s)" << std::endl;
+    }
+
+    return 0;
+}
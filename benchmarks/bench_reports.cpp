@@ -0,0 +1,96 @@
+/**
+ * @file bench_reports.cpp
+ * @brief Report generation latency benchmark
+ *
+ * Usage: bench_reports [products] [orders] [runs]
+ * Defaults to 5M products and 20M orders, which needs several GB of memory;
+ * pass smaller sizes for a quick run.
+ */
+
+#include "../include/Inventory.hpp"
+#include "../include/Order.hpp"
+#include "../include/NotificationSystem.hpp"
+#include "../include/ThreadPool.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace quirkventory;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+template <typename F>
+double medianMillis(int runs, F&& body) {
+    std::vector<double> samples;
+    for (int i = 0; i < runs; ++i) {
+        auto start = Clock::now();
+        body();
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t product_count = argc > 1 ? std::stoul(argv[1]) : 5000000;
+    size_t order_count = argc > 2 ? std::stoul(argv[2]) : 20000000;
+    int runs = argc > 3 ? std::stoi(argv[3]) : 5;
+
+    const char* categories[] = {"Dairy", "Bakery", "Produce", "Electronics", "Household", "Frozen"};
+    auto now = std::chrono::system_clock::now();
+
+    std::cout << "Building " << product_count << " products and " << order_count << " orders..." << std::endl;
+
+    Inventory inventory;
+    for (size_t i = 0; i < product_count; ++i) {
+        auto expiry = now + std::chrono::hours(1 + 24 * static_cast<int>(i % 60));
+        inventory.addProduct(std::make_unique<PerishableProduct>(
+            "P" + std::to_string(i), "Product " + std::to_string(i), categories[i % 6],
+            1.0 + static_cast<double>(i % 100), static_cast<int>(i % 200), expiry));
+    }
+
+    // Orders spread over the last 90 days, most of them confirmed
+    OrderManager order_manager;
+    for (size_t i = 0; i < order_count; ++i) {
+        auto order_date = now - std::chrono::seconds(90LL * 24 * 3600 * (order_count - i) / order_count);
+        Order* order = order_manager.createOrder("O" + std::to_string(i), "C" + std::to_string(i % 100000), order_date);
+        order->addItem("P" + std::to_string(i % std::max<size_t>(product_count, 1)), 1 + static_cast<int>(i % 3), 10.0);
+        if (i % 10 != 0) {
+            order->updateStatus(OrderStatus::CONFIRMED);
+        }
+    }
+
+    std::cout << "Report threads: " << ThreadPool::getShared().getThreadCount() << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    double snapshot_ms = medianMillis(runs, [&]() {
+        inventory.snapshot(7, &ThreadPool::getShared());
+    });
+    std::cout << "Inventory snapshot:        " << snapshot_ms << " ms" << std::endl;
+
+    size_t inventory_report_size = 0;
+    double inventory_ms = medianMillis(runs, [&]() {
+        InventoryReport report(&inventory, "bench", true, false);
+        inventory_report_size = report.generate().size();
+    });
+    std::cout << "Inventory report:          " << inventory_ms << " ms (" << inventory_report_size << " bytes)" << std::endl;
+
+    double sales_30d_ms = medianMillis(runs, [&]() {
+        SalesReport report(&order_manager, now - std::chrono::hours(24 * 30), now, "bench");
+        report.generate();
+    });
+    std::cout << "Sales report (30 days):    " << sales_30d_ms << " ms" << std::endl;
+
+    double sales_all_ms = medianMillis(runs, [&]() {
+        SalesReport report(&order_manager, now - std::chrono::hours(24 * 90), now, "bench");
+        report.generate();
+    });
+    std::cout << "Sales report (90 days):    " << sales_all_ms << " ms" << std::endl;
+
+    return 0;
+}
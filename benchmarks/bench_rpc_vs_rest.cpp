@@ -0,0 +1,164 @@
+/**
+ * @file bench_rpc_vs_rest.cpp
+ * @brief Per-call cost of the binary RPC protocol against the JSON REST API
+ *
+ * Usage: bench_rpc_vs_rest [lookups] [orders] [batch_size]
+ * Runs product lookups and one-line orders (create and process) through:
+ * - REST: HTTPServer::handleRawRequest, i.e. request parsing, routing, JSON
+ *   building and response serialization, with no socket in between (the
+ *   server loop is simulated), so REST is measured without any I/O cost;
+ * - RPC one call per round trip, over a Unix domain socket and over TCP
+ *   loopback;
+ * - RPC pipelined in batches of batch_size calls per round trip.
+ */
+
+#include "../include/HTTPServer.hpp"
+#include "../include/Rpc.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace quirkventory;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t kProducts = 1000;
+
+std::string productId(size_t i) {
+    return "P" + std::to_string(i % kProducts);
+}
+
+// Run count operations, return microseconds per operation and report failures
+double measure(size_t count, const std::function<bool(size_t)>& operation, size_t& failures) {
+    failures = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        if (!operation(i)) {
+            failures++;
+        }
+    }
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / static_cast<double>(count);
+}
+
+// Run count operations in batches built by add, return microseconds per operation
+double measureBatched(RpcClient& client, size_t count, size_t batch_size,
+                      const std::function<void(RpcBatch&, size_t)>& add, size_t& failures) {
+    failures = 0;
+    RpcBatch batch;
+    auto start = Clock::now();
+    for (size_t done = 0; done < count; done += batch_size) {
+        batch.clear();
+        for (size_t i = done; i < std::min(count, done + batch_size); ++i) {
+            add(batch, i);
+        }
+        client.execute(batch);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (batch.result(i).status != RpcStatus::OK) {
+                failures++;
+            }
+        }
+    }
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / static_cast<double>(count);
+}
+
+void report(const std::string& label, double us_per_op, size_t failures, double baseline_us) {
+    std::cout << "  " << std::left << std::setw(28) << label << std::right
+              << std::setw(10) << std::fixed << std::setprecision(2) << us_per_op << " us"
+              << std::setw(12) << std::setprecision(0) << 1e6 / us_per_op << " ops/s"
+              << std::setw(9) << std::setprecision(1) << baseline_us / us_per_op << "x"
+              << (failures ? "  (" + std::to_string(failures) + " failed)" : "") << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t lookups = argc > 1 ? std::stoul(argv[1]) : 200000;
+    size_t orders = argc > 2 ? std::stoul(argv[2]) : 20000;
+    size_t batch_size = argc > 3 ? std::stoul(argv[3]) : 32;
+
+    Inventory inventory;
+    auto expiry = std::chrono::system_clock::now() + std::chrono::hours(24 * 30);
+    for (size_t i = 0; i < kProducts; ++i) {
+        inventory.addProduct(std::make_unique<PerishableProduct>(
+            productId(i), "Product " + std::to_string(i), "Category" + std::to_string(i % 8),
+            1.0 + static_cast<double>(i % 100), 1000000000, expiry));
+    }
+    OrderManager order_manager(&inventory);
+
+    HTTPServer http("localhost", 8080);
+    http.setSystemComponents(&inventory, &order_manager, nullptr, nullptr);
+    http.start();
+
+    RpcServer tcp_server(inventory, order_manager);
+    RpcServer unix_server(inventory, order_manager);
+    std::string socket_path = "/tmp/bench_rpc_" + std::to_string(::getpid()) + ".sock";
+    RpcClient tcp_client;
+    RpcClient unix_client;
+    if (!tcp_server.start(0) || !unix_server.startUnix(socket_path) ||
+        !tcp_client.connect("127.0.0.1", tcp_server.getPort()) || !unix_client.connectUnix(socket_path)) {
+        std::cerr << "Failed to start the RPC servers" << std::endl;
+        return 1;
+    }
+
+    size_t failures;
+    std::cout << "Product lookup (" << lookups << " calls)" << std::endl;
+    double rest_us = measure(lookups, [&](size_t i) {
+        std::string response = http.handleRawRequest("GET /api/products/" + productId(i) + " HTTP/1.1\r\n"
+                                                     "Host: localhost\r\n\r\n");
+        return response.compare(0, 12, "HTTP/1.1 200") == 0;
+    }, failures);
+    report("REST (in-process)", rest_us, failures, rest_us);
+
+    RpcProduct product;
+    report("RPC unix, 1 per trip", measure(lookups, [&](size_t i) {
+        return unix_client.getProduct(productId(i), product) == RpcStatus::OK;
+    }, failures), failures, rest_us);
+    report("RPC tcp, 1 per trip", measure(lookups, [&](size_t i) {
+        return tcp_client.getProduct(productId(i), product) == RpcStatus::OK;
+    }, failures), failures, rest_us);
+    report("RPC unix, " + std::to_string(batch_size) + " per trip",
+           measureBatched(unix_client, lookups, batch_size, [](RpcBatch& batch, size_t i) {
+               batch.getProduct(productId(i));
+           }, failures), failures, rest_us);
+    report("RPC tcp, " + std::to_string(batch_size) + " per trip",
+           measureBatched(tcp_client, lookups, batch_size, [](RpcBatch& batch, size_t i) {
+               batch.getProduct(productId(i));
+           }, failures), failures, rest_us);
+
+    std::cout << "Order create + process (" << orders << " one-line orders)" << std::endl;
+    rest_us = measure(orders, [&](size_t i) {
+        std::string body = "{\"customer_id\": \"C" + std::to_string(i % 100) + "\", \"items\": [{\"product_id\": \"" +
+                           productId(i) + "\", \"quantity\": 1}]}";
+        std::string response = http.handleRawRequest("POST /api/orders HTTP/1.1\r\n"
+                                                     "Host: localhost\r\n"
+                                                     "Content-Type: application/json\r\n"
+                                                     "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" +
+                                                     body);
+        return response.compare(0, 12, "HTTP/1.1 201") == 0;
+    }, failures);
+    report("REST (in-process)", rest_us, failures, rest_us);
+
+    RpcOrder order;
+    report("RPC unix, 1 per trip", measure(orders, [&](size_t i) {
+        return unix_client.createOrder("C" + std::to_string(i % 100), {{productId(i), 1}}, order) == RpcStatus::OK;
+    }, failures), failures, rest_us);
+    report("RPC unix, " + std::to_string(batch_size) + " per trip",
+           measureBatched(unix_client, orders, batch_size, [](RpcBatch& batch, size_t i) {
+               batch.createOrder("C" + std::to_string(i % 100), {{productId(i), 1}});
+           }, failures), failures, rest_us);
+
+    std::cout << "RPC server writes: " << unix_server.getWriteCount() + tcp_server.getWriteCount() << " for "
+              << unix_server.getRequestCount() + tcp_server.getRequestCount() << " requests" << std::endl;
+
+    unix_client.close();
+    tcp_client.close();
+    unix_server.stop();
+    tcp_server.stop();
+    http.stop();
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file bench_seqlock_reads.cpp
+ * @brief Throughput of Inventory's hot read paths under concurrent stock writes
+ *
+ * Usage: bench_seqlock_reads [products] [seconds] [reader_threads] [writer_threads]
+ * Reader threads call one read path on random products while writer threads
+ * move stock (removeQuantity then addQuantity) as fast as they can. The
+ * read paths are getAvailableQuantity, hasProduct and validateOrder on a
+ * three-line order, which read per-product stock cells under sequence
+ * locks, and getProduct, which still takes the inventory lock and serves
+ * as the locked reference. Each path is run without and with writers; the
+ * writers' rate shows what the readers cost them.
+ */
+
+#include "../include/Inventory.hpp"
+#include "../include/Order.hpp"
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace quirkventory;
+
+namespace {
+
+struct RunResult {
+    double reads_per_second = 0.0;
+    double writes_per_second = 0.0;
+    long long checksum = 0;
+};
+
+using ReadPath = std::function<long long(std::mt19937&)>;
+
+RunResult run(Inventory& inventory, const std::vector<std::string>& ids, double seconds,
+              size_t reader_count, size_t writer_count, const ReadPath& read) {
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> reads{0};
+    std::atomic<size_t> writes{0};
+    std::atomic<long long> checksum{0};     // Keeps the reads from being optimized away
+
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < writer_count; ++w) {
+        threads.emplace_back([&, w]() {
+            std::mt19937 rng(static_cast<uint32_t>(1000 + w));
+            std::uniform_int_distribution<size_t> pick(0, ids.size() - 1);
+            size_t count = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const std::string& id = ids[pick(rng)];
+                inventory.removeQuantity(id, 1);
+                inventory.addQuantity(id, 1);
+                count += 2;
+            }
+            writes += count;
+        });
+    }
+    for (size_t r = 0; r < reader_count; ++r) {
+        threads.emplace_back([&, r]() {
+            std::mt19937 rng(static_cast<uint32_t>(r + 1));
+            size_t count = 0;
+            long long sink = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (int i = 0; i < 256; ++i) {
+                    sink += read(rng);
+                }
+                count += 256;
+            }
+            reads += count;
+            checksum += sink;
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    RunResult result;
+    result.reads_per_second = static_cast<double>(reads.load()) / seconds;
+    result.writes_per_second = static_cast<double>(writes.load()) / seconds;
+    result.checksum = checksum.load();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t product_count = argc > 1 ? std::stoul(argv[1]) : 10000;
+    double seconds = argc > 2 ? std::stod(argv[2]) : 2.0;
+    size_t reader_count = argc > 3 ? std::stoul(argv[3]) : 4;
+    size_t writer_count = argc > 4 ? std::stoul(argv[4]) : 1;
+
+    Inventory inventory;
+    std::vector<std::string> ids;
+    auto expiry = std::chrono::system_clock::now() + std::chrono::hours(24 * 30);
+    for (size_t i = 0; i < product_count; ++i) {
+        ids.push_back("P" + std::to_string(i));
+        inventory.addProduct(std::make_unique<PerishableProduct>(
+            ids.back(), "Product " + std::to_string(i), "Category" + std::to_string(i % 8),
+            1.0 + static_cast<double>(i % 100), 1000000, expiry));
+    }
+    inventory.setStockCombining(StockCombining::OFF);
+
+    // Orders to validate, built up front so the loop measures only the reads
+    std::vector<std::unique_ptr<Order>> orders;
+    for (size_t i = 0; i < 1024; ++i) {
+        auto order = std::make_unique<Order>("ORD-" + std::to_string(i), "C" + std::to_string(i % 100));
+        for (size_t line = 0; line < 3; ++line) {
+            size_t p = (i * 7 + line * 131) % product_count;
+            order->addItem(ids[p], 1, 1.0 + static_cast<double>(p % 100));
+        }
+        orders.push_back(std::move(order));
+    }
+
+    std::uniform_int_distribution<size_t> pick_product(0, product_count - 1);
+    std::uniform_int_distribution<size_t> pick_order(0, orders.size() - 1);
+    std::vector<std::pair<std::string, ReadPath>> paths = {
+        {"getAvailableQuantity", [&](std::mt19937& rng) {
+            return static_cast<long long>(inventory.getAvailableQuantity(ids[pick_product(rng)]));
+        }},
+        {"hasProduct", [&](std::mt19937& rng) {
+            return static_cast<long long>(inventory.hasProduct(ids[pick_product(rng)]));
+        }},
+        {"validateOrder (3 lines)", [&](std::mt19937& rng) {
+            return static_cast<long long>(orders[pick_order(rng)]->validateOrder(inventory).size());
+        }},
+        {"getProduct (locked)", [&](std::mt19937& rng) {
+            return static_cast<long long>(inventory.getProduct(ids[pick_product(rng)]) != nullptr);
+        }},
+    };
+
+    std::cout << product_count << " products, " << reader_count << " reader thread(s), " << writer_count
+              << " writer thread(s), " << seconds << " s per run, " << std::thread::hardware_concurrency()
+              << " CPU(s)" << std::endl;
+    std::cout << "  " << std::left << std::setw(26) << "Read path" << std::right << std::setw(16)
+              << "reads/s alone" << std::setw(20) << "reads/s w/ writes" << std::setw(12) << "writes/s"
+              << std::endl;
+
+    RunResult writers_alone = run(inventory, ids, seconds, 0, writer_count, nullptr);
+    std::cout << "  " << std::left << std::setw(26) << "(writers alone)" << std::right << std::fixed
+              << std::setprecision(0) << std::setw(48) << writers_alone.writes_per_second << std::endl;
+
+    for (const auto& path : paths) {
+        RunResult alone = run(inventory, ids, seconds, reader_count, 0, path.second);
+        RunResult contended = run(inventory, ids, seconds, reader_count, writer_count, path.second);
+        std::cout << "  " << std::left << std::setw(26) << path.first << std::right << std::fixed
+                  << std::setprecision(0) << std::setw(16) << alone.reads_per_second
+                  << std::setw(20) << contended.reads_per_second
+                  << std::setw(12) << contended.writes_per_second << std::endl;
+    }
+    return 0;
+}
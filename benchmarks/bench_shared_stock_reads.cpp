@@ -0,0 +1,176 @@
+/**
+ * @file bench_shared_stock_reads.cpp
+ * @brief Stock lookups through the shared-memory view against Inventory's locked getters
+ *
+ * Usage: bench_shared_stock_reads [products] [seconds] [reader_threads]
+ * Reader threads look up random products' available quantity, either with
+ * Inventory::getAvailableQuantity (the inventory lock) or with a
+ * SharedStockReader on the inventory's published segment (per-record
+ * sequence locks, as a sidecar process would). Each is run with no writer
+ * and with a writer thread moving stock as fast as it can, and the writer's
+ * own rate is reported to show what the readers cost it. ns/read is the
+ * wall time per lookup in one reader thread, so with more reader threads
+ * than CPUs it includes time spent waiting for a CPU.
+ */
+
+#include "../include/Inventory.hpp"
+#include "../include/SharedStockView.hpp"
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace quirkventory;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct RunResult {
+    double reads_per_second = 0.0;
+    double ns_per_read = 0.0;
+    double writes_per_second = 0.0;
+    size_t busy = 0;
+    long long checksum = 0;
+};
+
+RunResult run(Inventory& inventory, const std::vector<std::string>& ids, double seconds, size_t reader_count,
+              bool shared, bool with_writer) {
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> writes{0};
+    std::atomic<size_t> reads{0};
+    std::atomic<size_t> busy{0};
+    std::atomic<double> read_seconds{0.0};
+    std::atomic<long long> checksum{0};     // Keeps the reads from being optimized away
+
+    std::thread writer;
+    if (with_writer) {
+        writer = std::thread([&]() {
+            std::mt19937 rng(7);
+            std::uniform_int_distribution<size_t> pick(0, ids.size() - 1);
+            size_t count = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const std::string& id = ids[pick(rng)];
+                inventory.removeQuantity(id, 1);
+                inventory.addQuantity(id, 1);
+                count += 2;
+            }
+            writes.store(count);
+        });
+    }
+
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < reader_count; ++r) {
+        readers.emplace_back([&, r]() {
+            SharedStockReader view;
+            if (shared && !view.open("/quirkventory_bench_" + std::to_string(::getpid()))) {
+                return;
+            }
+            std::mt19937 rng(static_cast<uint32_t>(r + 1));
+            std::uniform_int_distribution<size_t> pick(0, ids.size() - 1);
+            size_t count = 0;
+            size_t count_busy = 0;
+            long long sink = 0;
+            auto start = Clock::now();
+            while (!stop.load(std::memory_order_relaxed)) {
+                // Check the clock every 1024 reads so it does not dominate the loop
+                for (int i = 0; i < 1024; ++i) {
+                    const std::string& id = ids[pick(rng)];
+                    if (shared) {
+                        SharedStockRecord record;
+                        if (view.read(id, record) == SharedReadResult::FOUND) {
+                            sink += record.available_quantity;
+                        } else {
+                            count_busy++;
+                        }
+                    } else {
+                        sink += inventory.getAvailableQuantity(id);
+                    }
+                }
+                count += 1024;
+            }
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            reads += count;
+            busy += count_busy;
+            double expected = read_seconds.load();
+            while (!read_seconds.compare_exchange_weak(expected, expected + elapsed)) {
+            }
+            checksum += sink;
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    if (writer.joinable()) {
+        writer.join();
+    }
+
+    RunResult result;
+    result.reads_per_second = static_cast<double>(reads.load()) / seconds;
+    result.ns_per_read = reads.load() ? read_seconds.load() * 1e9 / static_cast<double>(reads.load()) : 0.0;
+    result.writes_per_second = static_cast<double>(writes.load()) / seconds;
+    result.busy = busy.load();
+    result.checksum = checksum.load();
+    return result;
+}
+
+void report(const std::string& label, const RunResult& result, bool with_writer) {
+    std::cout << "  " << std::left << std::setw(34) << label << std::right
+              << std::setw(9) << std::fixed << std::setprecision(1) << result.ns_per_read << " ns/read"
+              << std::setw(14) << std::setprecision(0) << result.reads_per_second << " reads/s";
+    if (with_writer) {
+        std::cout << std::setw(12) << result.writes_per_second << " writes/s";
+    }
+    if (result.busy) {
+        std::cout << "  (" << result.busy << " busy/not found)";
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t product_count = argc > 1 ? std::stoul(argv[1]) : 10000;
+    double seconds = argc > 2 ? std::stod(argv[2]) : 2.0;
+    size_t reader_count = argc > 3 ? std::stoul(argv[3]) : 2;
+
+    Inventory inventory;
+    std::vector<std::string> ids;
+    auto expiry = std::chrono::system_clock::now() + std::chrono::hours(24 * 30);
+    for (size_t i = 0; i < product_count; ++i) {
+        ids.push_back("P" + std::to_string(i));
+        inventory.addProduct(std::make_unique<PerishableProduct>(
+            ids.back(), "Product " + std::to_string(i), "Category" + std::to_string(i % 8),
+            1.0 + static_cast<double>(i % 100), 1000, expiry));
+    }
+    inventory.setStockCombining(StockCombining::OFF);
+    if (!inventory.publishSharedView("/quirkventory_bench_" + std::to_string(::getpid()), product_count * 2)) {
+        std::cerr << "Failed to create the shared stock view" << std::endl;
+        return 1;
+    }
+
+    std::cout << product_count << " products, " << reader_count << " reader thread(s), "
+              << seconds << " s per run, " << std::thread::hardware_concurrency() << " CPU(s)" << std::endl;
+
+    RunResult writer_alone = run(inventory, ids, seconds, 0, false, true);
+    std::cout << "  " << std::left << std::setw(34) << "Writer alone" << std::right
+              << std::setw(50) << std::fixed << std::setprecision(0) << writer_alone.writes_per_second
+              << " writes/s" << std::endl;
+
+    for (bool with_writer : {false, true}) {
+        std::cout << (with_writer ? "With a writer" : "No writer") << std::endl;
+        report("getAvailableQuantity (lock)", run(inventory, ids, seconds, reader_count, false, with_writer),
+               with_writer);
+        report("SharedStockReader (seqlock)", run(inventory, ids, seconds, reader_count, true, with_writer),
+               with_writer);
+    }
+
+    inventory.stopSharedView();
+    return 0;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+namespace quirkventory {
+
+// Forward declarations
+class Order;
+class Inventory;
+
+/**
+ * @brief Per-product FIFO queues of backordered order lines
+ *
+ * Each product keeps its waiting lines in arrival order together with the
+ * total quantity they still need. A restock is matched in one pass: the
+ * queue takes min(available, demand) from the inventory with a single
+ * lock acquisition, then hands it out front to back, partially filling the
+ * last line it reaches.
+ *
+ * Cancelled and removed orders are dropped lazily: cancel() retires the
+ * order's ticket and its lines are discarded when a matching pass reaches
+ * them. Stock taken for discarded lines is returned to the inventory.
+ */
+class BackorderQueue {
+private:
+    struct Line {
+        Order* order;
+        uint64_t ticket;        // Matches waiting_ while the order is still queued
+        int remaining;
+    };
+
+    struct ProductQueue {
+        std::deque<Line> lines;
+        long long demand = 0;   // Sum of remaining over lines, including retired ones
+    };
+
+    struct WaitingOrder {
+        uint64_t ticket;
+        size_t open_lines;
+    };
+
+    std::unordered_map<std::string, ProductQueue> queues_;
+    std::unordered_map<const Order*, WaitingOrder> waiting_;
+    uint64_t next_ticket_;
+    long long units_allocated_;
+    mutable std::mutex mutex_;
+
+public:
+    /**
+     * @brief Constructor
+     */
+    BackorderQueue();
+
+    // Disable copy constructor and assignment operator
+    BackorderQueue(const BackorderQueue&) = delete;
+    BackorderQueue& operator=(const BackorderQueue&) = delete;
+
+    /**
+     * @brief Queue every backordered item of an order
+     * @param order BACKORDERED order; must stay alive until cancel() or it is filled
+     */
+    void enqueue(Order& order);
+
+    /**
+     * @brief Stop filling an order
+     * @param order Order that was cancelled or is about to be destroyed
+     */
+    void cancel(const Order& order);
+
+    /**
+     * @brief Allocate available stock of a product to its waiting lines
+     * @param product_id Product to match
+     * @param inventory Inventory to take the stock from
+     * @return Units allocated to orders
+     */
+    int match(const std::string& product_id, Inventory& inventory);
+
+    /**
+     * @brief Get quantity still waiting for a product
+     * @param product_id Product ID
+     * @return Outstanding units (may include lines of cancelled orders not yet discarded)
+     */
+    long long getWaitingQuantity(const std::string& product_id) const;
+
+    /**
+     * @brief Get number of orders with at least one waiting line
+     * @return Waiting order count
+     */
+    size_t getWaitingOrderCount() const;
+
+    /**
+     * @brief Get total units handed to backorders so far
+     * @return Allocated units
+     */
+    long long getUnitsAllocated() const;
+
+private:
+    /**
+     * @brief Close one of an order's lines (lock held)
+     */
+    void closeLineLocked(const Line& line);
+};
+
+} // namespace quirkventory
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+
+namespace quirkventory {
+
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer queue
+ *
+ * Fixed ring of cells, each carrying a sequence number that tells producers
+ * and consumers whether the cell is free for the current lap (Vyukov's
+ * bounded MPMC design). Push and pop are one CAS on the shared position
+ * plus a release store on the cell; a full queue fails the push instead of
+ * growing, which gives callers backpressure.
+ *
+ * @tparam T Element type (must be default constructible and movable)
+ */
+template <typename T>
+class BoundedQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> enqueue_pos_;
+    alignas(64) std::atomic<size_t> dequeue_pos_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of elements (rounded up to a power of two)
+     * @throws std::invalid_argument if capacity is 0
+     */
+    explicit BoundedQueue(size_t capacity) : enqueue_pos_(0), dequeue_pos_(0) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        cells_ = std::make_unique<Cell[]>(size);
+        mask_ = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Disable copy constructor and assignment operator
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Add an element
+     * @param value Element to add (moved from only on success)
+     * @return false if the queue is full
+     */
+    bool tryPush(T& value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // The cell still holds last lap's element
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Remove the oldest element
+     * @param value Receives the element
+     * @return false if the queue is empty
+     */
+    bool tryPop(T& value) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // Nothing published in this cell yet
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Remove up to max_count elements, appending them to out
+     * @param out Receives the elements in queue order
+     * @param max_count Maximum number of elements to take
+     * @return Number of elements taken
+     */
+    size_t popBatch(std::vector<T>& out, size_t max_count) {
+        size_t taken = 0;
+        T value;
+        while (taken < max_count && tryPop(value)) {
+            out.push_back(std::move(value));
+            ++taken;
+        }
+        return taken;
+    }
+
+    /**
+     * @brief Get approximate number of queued elements
+     * @return Element count (exact only when no push/pop is in progress)
+     */
+    size_t sizeApprox() const {
+        size_t enqueued = enqueue_pos_.load(std::memory_order_relaxed);
+        size_t dequeued = dequeue_pos_.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    /**
+     * @brief Get queue capacity
+     * @return Capacity (a power of two)
+     */
+    size_t capacity() const { return mask_ + 1; }
+};
+
+} // namespace quirkventory
@@ -5,6 +5,7 @@
 #include "Order.hpp"
 #include "User.hpp"
 #include "NotificationSystem.hpp"
+#include "Scheduler.hpp"
 #include <string>
 #include <vector>
 #include <memory>
@@ -44,6 +45,7 @@ private:
     std::unique_ptr<OrderManager> order_manager_;
     std::unique_ptr<UserManager> user_manager_;
     std::unique_ptr<NotificationManager> notification_manager_;
+    std::unique_ptr<Scheduler> scheduler_;  // Declared last so its jobs stop first
     
     // CLI state
     bool running_;
@@ -161,6 +163,7 @@ private:
     void handleSalesReport();
     void handleNotificationHistory();
     void handleSystemStatus();
+    void handleMaintenanceStatus();
 
     // Command handlers - System
     void handleHelp();
@@ -250,7 +253,7 @@ namespace CLIUtils {
     /**
      * @brief Generate unique ID
      * @param prefix ID prefix
-     * @return Unique ID string
+     * @return Unique, time-ordered ID string from the shared IdGenerator
      */
     std::string generateId(const std::string& prefix = "");
 
@@ -0,0 +1,412 @@
+#pragma once
+
+#include "Inventory.hpp"
+#include "Codec.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief Assigns products to cluster nodes by rendezvous hashing
+ *
+ * A product belongs to the node with the highest hash of (product ID, node
+ * index). Every router computes the same owner without coordination, and
+ * growing a cluster from N to N+1 nodes moves only the products the new
+ * node wins (about 1 in N+1).
+ */
+class ClusterPartitioner {
+private:
+    size_t node_count_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param node_count Number of nodes
+     * @throws std::invalid_argument if node_count is 0
+     */
+    explicit ClusterPartitioner(size_t node_count);
+
+    /**
+     * @brief Get the node that owns a product
+     * @param product_id ID of the product
+     * @return Node index in [0, node count)
+     */
+    size_t ownerOf(const std::string& product_id) const;
+
+    size_t getNodeCount() const { return node_count_; }
+};
+
+/**
+ * @brief Outcome of a routed product operation
+ */
+enum class ClusterResult {
+    OK,
+    NOT_FOUND,      // The owning node has no such product
+    REJECTED,       // The owning node refused (duplicate ID, invalid value, not enough stock)
+    UNAVAILABLE     // The owning node could not be reached in time
+};
+
+/**
+ * @brief Outcome of ClusterRouter::placeOrder
+ */
+enum class ClusterOrderResult {
+    COMMITTED,
+    INSUFFICIENT_STOCK,     // Some line could not be reserved; nothing was taken
+    UNAVAILABLE,            // A node was unreachable; nothing was taken
+    PARTIALLY_COMMITTED,    // A node could not confirm its prepared holds (product removed or recounted)
+    INVALID                 // No lines, or a non-positive quantity
+};
+
+/**
+ * @brief Counters of one cluster node
+ */
+struct ClusterNodeStats {
+    uint64_t product_count;
+    uint64_t requests;
+    uint64_t prepared;      // Cross-node transactions currently prepared on the node
+    uint64_t committed;     // Cross-node transactions committed on the node
+    uint64_t aborted;       // Cross-node transactions aborted on the node
+};
+
+/**
+ * @brief Serves one partition of a clustered inventory over TCP
+ *
+ * Answers product operations routed to it by ClusterRouter and takes part
+ * in cross-node orders with two-phase commit over stock holds: prepare
+ * places holds on every line (all or none), commit confirms them, abort
+ * releases them. Once a node has voted to commit it keeps the holds until
+ * the coordinator's decision arrives, however long that takes; the router
+ * retries undelivered decisions until the node acknowledges them. An abort
+ * that arrives before its prepare, or while the prepare is still placing
+ * holds, is remembered, so the prepare is refused and releases its holds
+ * instead of keeping stock that no decision will ever release.
+ */
+class ClusterNode {
+private:
+    struct Session {
+        int fd = -1;
+        std::thread thread;
+        std::atomic<bool> finished{false};
+    };
+
+    struct PreparedTransaction {
+        std::vector<uint64_t> hold_ids;
+    };
+
+    Inventory& inventory_;
+    std::string bind_address_;
+    uint16_t port_;
+
+    // Prepared cross-node transactions by transaction ID
+    std::unordered_map<uint64_t, PreparedTransaction> prepared_;
+    // Transactions aborted before their prepare arrived, oldest first (bounded)
+    std::unordered_set<uint64_t> early_aborts_;
+    std::deque<uint64_t> early_abort_order_;
+    mutable std::mutex prepared_mutex_;
+
+    int listen_fd_;
+    std::atomic<bool> running_;
+    std::thread accept_thread_;
+    std::vector<std::unique_ptr<Session>> sessions_;
+    mutable std::mutex sessions_mutex_;
+
+    std::atomic<uint64_t> requests_;
+    std::atomic<uint64_t> committed_;
+    std::atomic<uint64_t> aborted_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param inventory This node's partition of the inventory
+     * @param port TCP port to listen on (0 picks a free one)
+     * @param bind_address IPv4 address to listen on
+     */
+    ClusterNode(Inventory& inventory, uint16_t port, const std::string& bind_address = "127.0.0.1");
+
+    /**
+     * @brief Destructor - stops serving
+     */
+    ~ClusterNode();
+
+    // Disable copy constructor and assignment operator
+    ClusterNode(const ClusterNode&) = delete;
+    ClusterNode& operator=(const ClusterNode&) = delete;
+
+    /**
+     * @brief Start serving
+     * @return false if already running or the address cannot be bound
+     */
+    bool start();
+
+    /**
+     * @brief Close all connections and stop listening
+     */
+    void stop();
+
+    bool isRunning() const { return running_.load(); }
+
+    /**
+     * @brief Get the port routers connect to
+     * @return Bound port once started (resolves port 0), else the configured one
+     */
+    uint16_t getPort() const { return port_; }
+
+    /**
+     * @brief Get the node's counters
+     */
+    ClusterNodeStats getStats() const;
+
+private:
+    void acceptLoop();
+
+    /**
+     * @brief Answer requests on one connection until it closes
+     */
+    void serve(Session& session);
+
+    /**
+     * @brief Execute one request and encode the reply
+     * @return false if the request is malformed
+     */
+    bool handle(uint8_t type, const std::vector<uint8_t>& body, ByteWriter& reply);
+
+    /**
+     * @brief Place holds for every line, or none
+     * @return true if all lines were held; false also if the transaction
+     *         was already aborted
+     */
+    bool prepare(uint64_t transaction_id, const std::vector<std::pair<std::string, int>>& lines);
+
+    /**
+     * @brief Confirm a prepared transaction's holds
+     * @return false if the transaction is unknown or a hold could not be confirmed
+     */
+    bool commit(uint64_t transaction_id);
+
+    /**
+     * @brief Release a prepared transaction's holds
+     *
+     * An unknown transaction is remembered as aborted, in case its prepare
+     * is still on the way.
+     */
+    void abort(uint64_t transaction_id);
+
+    void reapSessions();
+};
+
+/**
+ * @brief Address of a cluster node
+ */
+struct ClusterNodeAddress {
+    std::string host;   // IPv4 address
+    uint16_t port;
+};
+
+/**
+ * @brief Routes inventory operations to the nodes of a partitioned cluster
+ *
+ * Product operations go to the product's owner (see ClusterPartitioner).
+ * Orders whose lines all live on one node are reserved there in a single
+ * round trip. Orders spanning nodes use two-phase commit: every involved
+ * node prepares (holds its lines) in parallel, then all are told to commit
+ * if every one prepared, or to abort otherwise. A decision that cannot be
+ * delivered is retried from a background thread until the node answers,
+ * since a node that voted to commit keeps its holds until it hears the
+ * outcome. Undelivered decisions are kept only in the router's memory and
+ * are not persisted: if the router is destroyed or its process crashes
+ * before delivering them, they are lost and the affected nodes keep those
+ * prepared holds until they are restarted. ClusterNodeStats::prepared
+ * shows how many a node is still holding.
+ *
+ * Thread-safe: connections to each node are pooled, and concurrent calls
+ * use separate connections.
+ */
+class ClusterRouter {
+private:
+    struct NodeConnections {
+        ClusterNodeAddress address;
+        std::vector<int> idle;
+        std::mutex mutex;
+    };
+
+    /**
+     * @brief One request to one node and its reply
+     */
+    struct Call {
+        size_t node;
+        uint8_t type;
+        ByteWriter request;
+        ClusterResult result = ClusterResult::UNAVAILABLE;
+        std::vector<uint8_t> reply;     // Reply body after the status
+        int fd = -1;
+    };
+
+    std::vector<std::unique_ptr<NodeConnections>> nodes_;
+    ClusterPartitioner partitioner_;
+    std::chrono::milliseconds timeout_;
+
+    std::mt19937_64 transaction_ids_;
+    std::mutex transaction_mutex_;
+
+    /**
+     * @brief A commit or abort a node has not acknowledged yet
+     */
+    struct Decision {
+        size_t node;
+        uint8_t type;
+        uint64_t transaction_id;
+    };
+
+    std::vector<Decision> undelivered_;     // Memory only; lost if the router goes away
+    bool stopping_;
+    std::thread retry_thread_;          // Started on the first undelivered decision
+    std::mutex decisions_mutex_;
+    std::condition_variable decisions_cv_;
+
+    std::atomic<uint64_t> single_node_orders_;
+    std::atomic<uint64_t> cross_node_orders_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param nodes Node addresses; their order defines the partitioning, so
+     *        every router of a cluster must list the nodes in the same order
+     * @param timeout How long to wait for a node's reply
+     * @throws std::invalid_argument if nodes is empty or a host is not an IPv4 address
+     */
+    explicit ClusterRouter(const std::vector<ClusterNodeAddress>& nodes,
+                           std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
+    /**
+     * @brief Destructor - stops retrying decisions and closes pooled connections
+     */
+    ~ClusterRouter();
+
+    // Disable copy constructor and assignment operator
+    ClusterRouter(const ClusterRouter&) = delete;
+    ClusterRouter& operator=(const ClusterRouter&) = delete;
+
+    /**
+     * @brief Get the node that owns a product
+     */
+    size_t ownerOf(const std::string& product_id) const { return partitioner_.ownerOf(product_id); }
+
+    size_t getNodeCount() const { return nodes_.size(); }
+
+    /**
+     * @brief Add a product on its owning node
+     * @param product Product to copy
+     * @return OK, REJECTED if the ID exists or a field is invalid, or UNAVAILABLE
+     */
+    ClusterResult addProduct(const Product& product);
+
+    /**
+     * @brief Read a product from its owning node
+     * @param product_id ID of the product
+     * @param product Receives the product's state
+     * @return OK, NOT_FOUND or UNAVAILABLE
+     */
+    ClusterResult getProduct(const std::string& product_id, ProductVersion& product);
+
+    /**
+     * @brief Add stock on the owning node
+     * @return OK, NOT_FOUND, REJECTED (non-positive amount) or UNAVAILABLE
+     */
+    ClusterResult addQuantity(const std::string& product_id, int amount);
+
+    /**
+     * @brief Remove stock on the owning node
+     * @return OK, NOT_FOUND, REJECTED (not enough available stock) or UNAVAILABLE
+     */
+    ClusterResult removeQuantity(const std::string& product_id, int amount);
+
+    /**
+     * @brief Remove a product from its owning node
+     * @return OK, NOT_FOUND or UNAVAILABLE
+     */
+    ClusterResult removeProduct(const std::string& product_id);
+
+    /**
+     * @brief Reserve an order's lines across the cluster, all or nothing
+     * @param lines (product ID, quantity) lines; repeated products are merged
+     * @return Outcome of the order
+     */
+    ClusterOrderResult placeOrder(const std::vector<std::pair<std::string, int>>& lines);
+
+    /**
+     * @brief Read one node's counters
+     * @param node Node index
+     * @param stats Receives the counters
+     * @return OK or UNAVAILABLE
+     */
+    ClusterResult getNodeStats(size_t node, ClusterNodeStats& stats);
+
+    /**
+     * @brief Get number of orders reserved on a single node
+     */
+    uint64_t getSingleNodeOrderCount() const { return single_node_orders_.load(); }
+
+    /**
+     * @brief Get number of orders that ran two-phase commit
+     */
+    uint64_t getCrossNodeOrderCount() const { return cross_node_orders_.load(); }
+
+    /**
+     * @brief Get number of commit or abort decisions waiting to be redelivered
+     */
+    size_t getUndeliveredDecisionCount();
+
+private:
+    /**
+     * @brief Send every call's request, then collect every reply
+     *
+     * Requests to different nodes are in flight together, so a set of calls
+     * costs about one round trip.
+     */
+    void execute(std::vector<Call>& calls);
+
+    /**
+     * @brief Send one request to a product's owner and wait for the reply
+     */
+    ClusterResult callOwner(const std::string& product_id, uint8_t type, ByteWriter request,
+                            std::vector<uint8_t>* reply = nullptr);
+
+    /**
+     * @brief Take a pooled connection to a node, or open one
+     * @return Connected socket, or -1 if the node cannot be reached
+     */
+    int acquire(size_t node);
+
+    /**
+     * @brief Return a healthy connection to the pool
+     */
+    void release(size_t node, int fd);
+
+    uint64_t nextTransactionId();
+
+    /**
+     * @brief Queue decisions whose node could not be reached for redelivery
+     * @param calls Commit or abort calls of one transaction, after execute()
+     * @param transaction_id The transaction they decide
+     */
+    void retryLater(const std::vector<Call>& calls, uint64_t transaction_id);
+
+    /**
+     * @brief Redeliver queued decisions until they are acknowledged or the router stops
+     */
+    void retryLoop();
+};
+
+} // namespace quirkventory
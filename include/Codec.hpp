@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief Append-only binary encoder with LEB128 varints
+ *
+ * Unsigned varints use 7 bits per byte (small values take one byte); signed
+ * values are zigzag-encoded first so small negative numbers stay small.
+ * Fixed-width fields are little-endian.
+ */
+class ByteWriter {
+private:
+    std::vector<uint8_t> buffer_;
+
+public:
+    ByteWriter() = default;
+
+    void putUInt8(uint8_t value) { buffer_.push_back(value); }
+    void putVarUInt(uint64_t value);
+    void putVarInt(int64_t value);
+    void putFixed64(uint64_t value);
+    void putDouble(double value);
+
+    /**
+     * @brief Write a length-prefixed string
+     * @param value String to write
+     */
+    void putString(const std::string& value);
+
+    /**
+     * @brief Write raw bytes without a length prefix
+     */
+    void putBytes(const uint8_t* data, size_t size);
+
+    const std::vector<uint8_t>& getBuffer() const { return buffer_; }
+    size_t size() const { return buffer_.size(); }
+
+    /**
+     * @brief Take ownership of the encoded bytes
+     * @return Encoded bytes; the writer is left empty
+     */
+    std::vector<uint8_t> release();
+};
+
+/**
+ * @brief Bounds-checked decoder for data written by ByteWriter
+ *
+ * Every read returns false (and leaves the output unspecified) instead of
+ * reading past the end of the buffer, so truncated or corrupt input is
+ * reported rather than crashing.
+ */
+class ByteReader {
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t position_;
+
+public:
+    ByteReader(const uint8_t* data, size_t size) : data_(data), size_(size), position_(0) {}
+    explicit ByteReader(const std::vector<uint8_t>& buffer)
+        : data_(buffer.data()), size_(buffer.size()), position_(0) {}
+
+    bool getUInt8(uint8_t& value);
+    bool getVarUInt(uint64_t& value);
+    bool getVarInt(int64_t& value);
+    bool getFixed64(uint64_t& value);
+    bool getDouble(double& value);
+    bool getString(std::string& value);
+    bool getBytes(uint8_t* data, size_t size);
+
+    bool atEnd() const { return position_ >= size_; }
+    size_t getPosition() const { return position_; }
+    size_t getRemaining() const { return size_ - position_; }
+};
+
+} // namespace quirkventory
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief Tuning of a ConcurrencyLimiter
+ */
+struct ConcurrencyLimiterConfig {
+    int initial_limit = 4;
+    int min_limit = 1;
+    int max_limit = 256;
+    std::chrono::microseconds latency_target{std::chrono::milliseconds(50)};  // 0 = no target
+    double tolerance = 1.5;     // Latency growth over the baseline accepted before backing off
+    double smoothing = 0.2;     // Weight of each new limit estimate
+};
+
+/**
+ * @brief Gradient-based adaptive concurrency limit
+ *
+ * Work is admitted while fewer than limit() items are in flight. Each
+ * completion reports its latency: a fast moving average tracks current
+ * latency, and the baseline follows it down at once but up only slowly, so
+ * it approximates the latency seen without queueing while still adapting
+ * to work that has genuinely become slower. The ratio baseline * tolerance
+ * / current is the gradient; while latency stays near the baseline the
+ * gradient is 1 and the limit grows by a queue allowance of sqrt(limit),
+ * and once extra concurrency only adds queueing or contention the gradient
+ * drops below 1 and the limit shrinks with it.
+ * Latency above the target scales the limit down by target / current as
+ * well. Growth only happens while the limit is actually being used, so an
+ * idle or app-limited caller does not inflate it.
+ */
+class ConcurrencyLimiter {
+private:
+    ConcurrencyLimiterConfig config_;
+    double limit_;
+    int in_flight_;
+    double short_latency_us_;       // Fast moving average, 0 until the first sample
+    double long_latency_us_;        // Baseline: lowest recent average, drifting up slowly
+    uint64_t samples_;
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+
+public:
+    static constexpr double SHORT_WEIGHT = 0.3;
+    static constexpr double LONG_WEIGHT = 0.002;
+
+    /**
+     * @brief Constructor
+     * @param config Limits, latency target and smoothing
+     * @throws std::invalid_argument if the limits are not 1 <= min <= initial <= max
+     */
+    explicit ConcurrencyLimiter(const ConcurrencyLimiterConfig& config = ConcurrencyLimiterConfig());
+
+    // Disable copy constructor and assignment operator
+    ConcurrencyLimiter(const ConcurrencyLimiter&) = delete;
+    ConcurrencyLimiter& operator=(const ConcurrencyLimiter&) = delete;
+
+    /**
+     * @brief Admit one item if the limit allows it
+     * @return true if admitted (report it with onComplete)
+     */
+    bool tryAcquire();
+
+    /**
+     * @brief Wait until one item can be admitted
+     */
+    void acquire();
+
+    /**
+     * @brief Report a completed item and adapt the limit
+     * @param latency Time from admission to completion
+     * @param dropped true if the item failed for reasons unrelated to load;
+     *                its latency is not used as a sample
+     */
+    void onComplete(std::chrono::microseconds latency, bool dropped = false);
+
+    /**
+     * @brief Get current concurrency limit
+     * @return Limit (at least config min_limit)
+     */
+    int getLimit() const;
+
+    /**
+     * @brief Get number of admitted items not yet completed
+     * @return In-flight count
+     */
+    int getInFlight() const;
+
+    /**
+     * @brief Get the recent latency average
+     * @return Latency in microseconds (0 before the first sample)
+     */
+    double getLatencyMicros() const;
+
+    /**
+     * @brief Get the baseline latency average
+     * @return Latency in microseconds (0 before the first sample)
+     */
+    double getBaselineLatencyMicros() const;
+
+    /**
+     * @brief Get number of latency samples taken
+     * @return Sample count
+     */
+    uint64_t getSampleCount() const;
+
+    /**
+     * @brief Get the limiter configuration
+     * @return Configuration
+     */
+    const ConcurrencyLimiterConfig& getConfig() const { return config_; }
+
+private:
+    /**
+     * @brief Compute the next limit from the latest sample (mutex held)
+     * @param in_flight In-flight count when the sample completed
+     */
+    void updateLimit(int in_flight);
+};
+
+} // namespace quirkventory
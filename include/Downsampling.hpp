@@ -0,0 +1,66 @@
+#pragma once
+
+#include "TimeSeries.hpp"
+#include <vector>
+#include <cstddef>
+
+namespace quirkventory {
+
+/**
+ * @brief Point selection strategy for chart downsampling
+ */
+enum class DownsampleMethod {
+    LTTB,       // Largest-Triangle-Three-Buckets: keeps the visual shape
+    MIN_MAX     // Minimum and maximum of each bucket: keeps every extreme
+};
+
+/**
+ * @brief Chart downsampling over structure-of-arrays series
+ *
+ * Both methods split the series into equal-count buckets and pick
+ * representative points, so a chart receives a bounded number of points
+ * however long the range is. Inputs are separate timestamp and value arrays
+ * so the per-bucket loops stream through contiguous memory. Selected
+ * indices are returned in increasing order and always include the first
+ * and last point.
+ */
+namespace Downsampling {
+    /**
+     * @brief Select points with Largest-Triangle-Three-Buckets
+     * @param x Timestamps (ascending)
+     * @param y Values
+     * @param count Number of points
+     * @param threshold Target number of points
+     * @return Indices of selected points (all points if count <= threshold)
+     */
+    std::vector<size_t> largestTriangleThreeBuckets(const double* x, const double* y,
+                                                    size_t count, size_t threshold);
+
+    /**
+     * @brief Select the minimum and maximum of each bucket
+     * @param y Values
+     * @param count Number of points
+     * @param threshold Target number of points (two per bucket)
+     * @return Indices of selected points (all points if count <= threshold)
+     */
+    std::vector<size_t> minMaxBuckets(const double* y, size_t count, size_t threshold);
+
+    /**
+     * @brief Select points with the given method
+     * @return Indices of selected points in increasing order
+     */
+    std::vector<size_t> selectIndices(const double* x, const double* y, size_t count,
+                                      size_t threshold, DownsampleMethod method);
+
+    /**
+     * @brief Downsample a time series
+     * @param points Samples in time order
+     * @param threshold Target number of points
+     * @param method Selection method
+     * @return Selected samples in time order
+     */
+    std::vector<TimeSeriesPoint> downsample(const std::vector<TimeSeriesPoint>& points,
+                                            size_t threshold, DownsampleMethod method);
+}
+
+} // namespace quirkventory
@@ -5,6 +5,8 @@
 #include "Order.hpp"
 #include "User.hpp"
 #include "NotificationSystem.hpp"
+#include "IdempotencyCache.hpp"
+#include "Replication.hpp"
 #include <string>
 #include <memory>
 #include <functional>
@@ -26,6 +28,9 @@ struct HTTPRequest {
     
     // Helper method to get query parameter
     std::string getQueryParam(const std::string& key) const;
+    
+    // Helper method to get a header by case-insensitive name ("" if absent)
+    std::string getHeader(const std::string& name) const;
 };
 
 /**
@@ -79,6 +84,13 @@ private:
     UserManager* user_manager_;
     NotificationManager* notification_manager_;
 
+    // Responses of POST /api/orders by Idempotency-Key, for client retries
+    IdempotencyCache order_idempotency_;
+
+    // Replication role; a follower serves read-only
+    const ReplicationPrimary* replication_primary_;
+    const ReplicationFollower* replication_follower_;
+
 public:
     /**
      * @brief Constructor
@@ -104,6 +116,17 @@ public:
                            UserManager* user_manager,
                            NotificationManager* notification_manager);
 
+    /**
+     * @brief Set the replication role of this node
+     * @param primary Replication primary, if this node is one
+     * @param follower Replication follower, if this node is one
+     *
+     * With a follower set the server is read-only: only GET endpoints are
+     * served and other methods get 405. Replication progress and lag are
+     * reported by GET /api/replication/status and the system status.
+     */
+    void setReplication(const ReplicationPrimary* primary, const ReplicationFollower* follower);
+
     /**
      * @brief Start the HTTP server
      * @return true if server started successfully
@@ -127,6 +150,15 @@ public:
      */
     std::string getServerUrl() const;
 
+    /**
+     * @brief Answer one raw HTTP request the way a connection would
+     *
+     * Routes are set up by start(); before that every request gets 404.
+     * @param request_data Request line, headers and body
+     * @return Serialized HTTP response
+     */
+    std::string handleRawRequest(const std::string& request_data);
+
 private:
     /**
      * @brief Setup REST API routes
@@ -188,20 +220,40 @@ private:
     HTTPResponse handleGetOrders(const HTTPRequest& request);
     HTTPResponse handleGetOrder(const HTTPRequest& request);
     HTTPResponse handlePostOrder(const HTTPRequest& request);
+    HTTPResponse createOrderFromRequest(const HTTPRequest& request);
     HTTPResponse handlePutOrder(const HTTPRequest& request);
+    HTTPResponse handleDeleteOrder(const HTTPRequest& request);
+    HTTPResponse handleCancelOrders(const HTTPRequest& request);
     
     HTTPResponse handleGetSalesReport(const HTTPRequest& request);
     HTTPResponse handleGetInventoryReport(const HTTPRequest& request);
+    HTTPResponse handleGetTopProducts(const HTTPRequest& request);
+    HTTPResponse handleGetCustomerAnalytics(const HTTPRequest& request);
+    HTTPResponse handleGetInventoryChart(const HTTPRequest& request);
+    HTTPResponse handleGetSalesChart(const HTTPRequest& request);
     
     HTTPResponse handleGetUsers(const HTTPRequest& request);
     HTTPResponse handlePostUser(const HTTPRequest& request);
     
     HTTPResponse handleGetSystemStatus(const HTTPRequest& request);
+    HTTPResponse handleGetReplicationStatus(const HTTPRequest& request);
+
+    /**
+     * @brief Open an inventory view for an as_of query parameter
+     * @param as_of Epoch seconds or YYYY-MM-DD (UTC)
+     * @param view Receives the open view
+     * @param error Receives the response to send when no view can be opened
+     * @return true if the view was opened
+     */
+    bool openAsOfView(const std::string& as_of, VersionStore::ReadView& view, HTTPResponse& error);
 
     // Utility methods
     std::string extractPathParameter(const std::string& path, const std::string& pattern);
     std::string productToJSON(const Product* product);
+    std::string productRecordToJSON(const ProductRecord& product);
+    std::string productStateToJSON(const ProductVersion& product);
     std::string orderToJSON(const Order* order);
+    std::string orderRecordToJSON(const OrderRecord& order);
     std::string userToJSON(const User* user);
     std::string parseJSONString(const std::string& json, const std::string& key);
     double parseJSONDouble(const std::string& json, const std::string& key);
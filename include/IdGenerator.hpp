@@ -0,0 +1,112 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief Lock-free, Snowflake-style unique ID generator
+ *
+ * IDs are 63-bit integers laid out as
+ *
+ *     [41 bits: milliseconds since 2024-01-01 UTC][10 bits: node][12 bits: sequence]
+ *
+ * so they sort by creation time and are unique across up to 1024 nodes
+ * without coordination. Within a node, the (time, sequence) part comes from
+ * a single atomic counter that never moves backwards. Each thread leases a
+ * small block of sequence numbers with one compare-and-swap and hands them
+ * out from thread-local storage, so threads rarely touch the shared counter.
+ *
+ * If more than 4096 IDs are requested in one millisecond, the counter moves
+ * into the next millisecond instead of blocking. IDs stay unique and
+ * monotonic, and the embedded time catches up with the clock once the burst
+ * ends. A clock that steps backwards is handled the same way.
+ *
+ * IDs from one thread are strictly increasing. IDs from different threads
+ * are unique and ordered to within a lease.
+ */
+class IdGenerator {
+public:
+    static constexpr int NODE_BITS = 10;
+    static constexpr int SEQUENCE_BITS = 12;
+    static constexpr uint32_t MAX_NODE_ID = (1u << NODE_BITS) - 1;
+    static constexpr long long EPOCH_MS = 1704067200000LL;  // 2024-01-01T00:00:00Z
+
+private:
+    std::atomic<uint64_t> state_;   // (milliseconds since EPOCH_MS << SEQUENCE_BITS) | sequence
+    uint32_t node_id_;
+    uint32_t lease_size_;
+    uint64_t instance_id_;          // Distinguishes generators in thread-local caches
+
+public:
+    /**
+     * @brief Constructor
+     * @param node_id Node number embedded in every ID (0 to MAX_NODE_ID)
+     * @param lease_size Sequence numbers a thread takes per counter update (1 to 4096)
+     * @throws std::invalid_argument if node_id or lease_size is out of range
+     */
+    explicit IdGenerator(uint32_t node_id = 0, uint32_t lease_size = 64);
+
+    // Disable copy constructor and assignment operator due to atomic state
+    IdGenerator(const IdGenerator&) = delete;
+    IdGenerator& operator=(const IdGenerator&) = delete;
+
+    /**
+     * @brief Generate the next ID
+     * @return Unique 63-bit ID
+     */
+    uint64_t next();
+
+    /**
+     * @brief Generate the next ID as a string
+     * @param prefix Prefix such as "ORD"
+     * @return prefix followed by the ID in 13-character Crockford base32
+     */
+    std::string nextString(const std::string& prefix = "");
+
+    uint32_t getNodeId() const { return node_id_; }
+
+    /**
+     * @brief Format an ID as fixed-width Crockford base32
+     * @param id ID to format
+     * @param prefix Prefix to prepend
+     * @return String that sorts in the same order as the IDs
+     */
+    static std::string format(uint64_t id, const std::string& prefix = "");
+
+    /**
+     * @brief Get the creation time embedded in an ID
+     * @param id ID to decode
+     * @return Creation time (millisecond precision)
+     */
+    static std::chrono::system_clock::time_point getTimestamp(uint64_t id);
+
+    /**
+     * @brief Get the node number embedded in an ID
+     * @param id ID to decode
+     * @return Node number
+     */
+    static uint32_t getNodeId(uint64_t id);
+
+    /**
+     * @brief Get the process-wide generator used for order and product IDs
+     * @return Shared generator for node 0
+     */
+    static IdGenerator& getShared();
+
+private:
+    /**
+     * @brief Reserve a block of counter values
+     * @param now_ms Current milliseconds since EPOCH_MS
+     * @param count Number of values to reserve
+     * @return First reserved value
+     */
+    uint64_t lease(uint64_t now_ms, uint32_t count);
+
+    static uint64_t currentMillis();
+};
+
+} // namespace quirkventory
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief Response stored for an idempotency key
+ */
+struct IdempotentResponse {
+    int status_code = 0;
+    std::string status_message;
+    std::string body;
+};
+
+/**
+ * @brief Outcome of claiming an idempotency key
+ */
+enum class IdempotencyOutcome {
+    NEW,            // First request with this key: process it, then complete() or abandon()
+    IN_PROGRESS,    // Another request with this key is still being processed
+    REPLAY,         // Already processed: return the stored response
+    MISMATCH        // Key was used before with a different request
+};
+
+/**
+ * @brief Bounded, TTL-evicted cache of responses by idempotency key
+ *
+ * Keys hash onto independently locked shards so concurrent requests only
+ * contend when they land on the same shard. Each shard keeps its entries in
+ * insertion order; since every entry lives for the same TTL, that is also
+ * expiry order, so eviction only ever looks at the oldest entries. A shard
+ * that reaches its share of the capacity drops its oldest entry.
+ *
+ * Every key is tied to a fingerprint of the request it was first used with,
+ * so a client reusing a key for a different request gets MISMATCH instead
+ * of somebody else's response.
+ */
+class IdempotencyCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct Entry {
+        std::string fingerprint;
+        Clock::time_point created;
+        bool completed = false;
+        IdempotentResponse response;
+    };
+
+    struct Shard {
+        std::unordered_map<std::string, Entry> entries;
+        std::deque<std::pair<Clock::time_point, std::string>> by_age;
+        std::mutex mutex;
+    };
+
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_mask_;
+    size_t shard_capacity_;
+    std::chrono::milliseconds ttl_;
+    std::atomic<uint64_t> replays_;
+    std::atomic<uint64_t> evictions_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of keys kept
+     * @param ttl How long a key is remembered
+     * @param shard_count Number of shards (rounded up to a power of two)
+     * @throws std::invalid_argument if capacity, ttl or shard_count is not positive
+     */
+    explicit IdempotencyCache(size_t capacity = 100000,
+                              std::chrono::milliseconds ttl = std::chrono::hours(24),
+                              size_t shard_count = 16);
+
+    // Disable copy constructor and assignment operator
+    IdempotencyCache(const IdempotencyCache&) = delete;
+    IdempotencyCache& operator=(const IdempotencyCache&) = delete;
+
+    /**
+     * @brief Claim a key for a request
+     * @param key Idempotency key sent by the client
+     * @param fingerprint Digest of the request the key is used with
+     * @param response Receives the stored response when the outcome is REPLAY
+     * @return What the caller should do with the request
+     */
+    IdempotencyOutcome begin(const std::string& key, const std::string& fingerprint,
+                             IdempotentResponse& response);
+
+    /**
+     * @brief Store the response of a request claimed with begin()
+     * @param key Idempotency key
+     * @param response Response to replay for retries
+     */
+    void complete(const std::string& key, const IdempotentResponse& response);
+
+    /**
+     * @brief Release a claimed key without storing a response
+     * @param key Idempotency key
+     *
+     * Used when the request failed in a way a retry may fix.
+     */
+    void abandon(const std::string& key);
+
+    /**
+     * @brief Drop every expired key
+     * @return Number of keys dropped
+     */
+    size_t evictExpired();
+
+    /**
+     * @brief Get number of keys held
+     * @return Key count
+     */
+    size_t size() const;
+
+    /**
+     * @brief Get number of requests answered from the cache
+     * @return Replay count
+     */
+    uint64_t getReplayCount() const { return replays_.load(); }
+
+    /**
+     * @brief Get number of keys dropped by TTL or capacity
+     * @return Eviction count
+     */
+    uint64_t getEvictionCount() const { return evictions_.load(); }
+
+private:
+    Shard& shardFor(const std::string& key) const;
+
+    /**
+     * @brief Drop expired entries, then the oldest ones beyond capacity (shard locked)
+     * @param shard Shard to trim
+     * @param now Current time
+     * @param room Entries to make room for
+     * @return Number of entries dropped
+     */
+    size_t trimLocked(Shard& shard, Clock::time_point now, size_t room);
+};
+
+} // namespace quirkventory
@@ -1,17 +1,127 @@
 #pragma once
 
 #include "Product.hpp"
+#include "TimeSeries.hpp"
+#include "TimingWheel.hpp"
+#include "StockCombiner.hpp"
+#include "VersionStore.hpp"
+#include "SharedStockView.hpp"
+#include "StockTable.hpp"
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <atomic>
 #include <string>
 #include <functional>
+#include <chrono>
+#include <optional>
 
 namespace quirkventory {
 
 // Forward declarations
 class Notification;
+class ThreadPool;
+
+/**
+ * @brief Point-in-time copy of one product's reporting fields
+ */
+struct ProductRecord {
+    std::string id;
+    std::string name;
+    std::string category;
+    double price;
+    int quantity;
+    int low_stock_threshold;
+    bool expired;
+    bool expiring_soon;
+    std::string expiry_info;    // Only filled for expired or expiring-soon products
+    uint64_t product_version;   // As reported by Product::getVersion()
+
+    double getTotalValue() const { return price * quantity; }
+    bool isLowStock() const { return quantity < low_stock_threshold; }
+};
+
+/**
+ * @brief Field changes for Inventory::updateProduct; unset fields are left alone
+ */
+struct ProductUpdate {
+    std::optional<std::string> name;
+    std::optional<std::string> category;
+    std::optional<double> price;
+    std::optional<int> quantity;
+
+    bool empty() const { return !name && !category && !price && !quantity; }
+};
+
+/**
+ * @brief Outcome of Inventory::updateProduct
+ */
+enum class ProductUpdateResult {
+    UPDATED,
+    NOT_FOUND,
+    VERSION_MISMATCH,   // The product changed since the caller read the expected version
+    INVALID             // A field value was rejected; nothing was changed
+};
+
+/**
+ * @brief Stock set aside for a checkout until it is confirmed, released, or expires
+ */
+struct StockHold {
+    uint64_t hold_id;
+    std::string product_id;
+    int quantity;
+    std::chrono::system_clock::time_point expires_at;
+};
+
+/**
+ * @brief Callback invoked after stock of a product increases
+ *
+ * Called with the product ID after addQuantity or a raising updateQuantity,
+ * without the inventory lock held, so it may call back into the inventory.
+ */
+using RestockListener = std::function<void(const std::string&)>;
+
+/**
+ * @brief Consistent copy of the whole inventory taken under one lock
+ */
+struct InventorySnapshot {
+    std::vector<ProductRecord> products;
+    std::chrono::system_clock::time_point taken_at;
+};
+
+/**
+ * @brief One committed inventory change, as passed to a ChangeListener
+ */
+struct InventoryChange {
+    enum class Kind {
+        PRODUCT,    // A product's new state (removed set for removals)
+        THRESHOLD   // A category's low-stock threshold was set
+    };
+
+    Kind kind = Kind::PRODUCT;
+    std::shared_ptr<const ProductVersion> product;  // PRODUCT only
+    std::string category;                           // THRESHOLD only
+    int threshold = 0;                              // THRESHOLD only
+};
+
+/**
+ * @brief Callback invoked for every committed change, in commit order
+ *
+ * Called with the inventory lock held, so it must be quick and must not
+ * call back into the inventory.
+ */
+using ChangeListener = std::function<void(const InventoryChange&)>;
+
+/**
+ * @brief Full replicable state of an inventory (see Inventory::captureState)
+ */
+struct InventoryState {
+    std::vector<std::shared_ptr<const ProductVersion>> products;
+    std::unordered_map<std::string, int> category_thresholds;
+    int default_threshold = 0;
+};
 
 /**
  * @brief Thread-safe inventory management system
@@ -34,8 +144,45 @@ private:
     
     // Notification system
     std::vector<std::function<void(const std::string&)>> alert_callbacks_;
+    std::unordered_map<uint64_t, RestockListener> restock_listeners_;
+    uint64_t next_restock_listener_id_;
+
+    // Timed stock holds; held quantity stays on hand but is not available
+    std::unordered_map<uint64_t, StockHold> holds_;
+    std::unordered_map<std::string, int> held_quantities_;
+    TimingWheel hold_expiry_;
+    std::chrono::steady_clock::time_point hold_clock_origin_;
+
+    // Stock level history ("product:<id>" and "category:<name>" series)
+    TimeSeriesStore stock_history_;
+    std::unordered_map<std::string, int> category_quantities_;
+
+    // Products below their low-stock threshold, kept in step with every stock change
+    std::unordered_set<std::string> low_stock_ids_;
+
+    // Batches concurrent removals of hot products under one lock acquisition
+    StockCombiner stock_combiner_;
+    std::atomic<StockCombining> combining_mode_;
+
+    // Product history for point-in-time reads; created by enableVersioning()
+    std::unique_ptr<VersionStore> versions_;
+    std::atomic<bool> versioning_enabled_;
+
+    // Receives every committed change (replication); empty when unset
+    ChangeListener change_listener_;
+
+    // Lock-free copies of every product's stock fields for hot read paths
+    StockTable stock_table_;
+
+    // Stock records for other processes on this host; created by publishSharedView()
+    std::unique_ptr<SharedStockWriter> shared_view_;
 
 public:
+    /**
+     * @brief Longest hold placeHold() places; longer TTLs are shortened to it
+     */
+    static constexpr std::chrono::milliseconds MAX_HOLD_TTL = std::chrono::hours(24 * 365 * 10);
+
     /**
      * @brief Constructor
      * @param default_threshold Default low stock threshold for all products
@@ -77,6 +224,24 @@ public:
      */
     bool updateQuantity(const std::string& product_id, int new_quantity);
 
+    /**
+     * @brief Change product fields if the product is still at an expected version
+     * @param product_id ID of the product
+     * @param update Fields to change
+     * @param expected_version Version the caller based the update on (0 to update unconditionally)
+     * @param current_version Receives the product's version after the call
+     * @param updated_state If given, receives the state the update wrote (only on UPDATED)
+     * @return UPDATED, or why nothing was changed
+     *
+     * Compare-and-set: the version check and every field change happen under
+     * one lock acquisition, so of two editors who read the same version only
+     * the first succeeds and the other gets VERSION_MISMATCH with the new
+     * version instead of silently overwriting the first one's change.
+     */
+    ProductUpdateResult updateProduct(const std::string& product_id, const ProductUpdate& update,
+                                      uint64_t expected_version, uint64_t& current_version,
+                                      ProductVersion* updated_state = nullptr);
+
     /**
      * @brief Add quantity to existing product
      * @param product_id ID of the product
@@ -85,6 +250,18 @@ public:
      */
     bool addQuantity(const std::string& product_id, int amount);
 
+    /**
+     * @brief Return stock for many products under one lock acquisition
+     * @param releases (product ID, quantity) pairs; repeated products are summed
+     * @return Total units returned (releases for unknown products are skipped)
+     *
+     * Used when cancelled orders give back their reserved stock. Products
+     * that rise back to their threshold leave the low-stock set and raise a
+     * "LOW STOCK CLEARED" alert; restock listeners run once per product
+     * after the lock is released.
+     */
+    int releaseQuantities(const std::vector<std::pair<std::string, int>>& releases);
+
     /**
      * @brief Remove quantity from existing product
      * @param product_id ID of the product
@@ -93,6 +270,47 @@ public:
      */
     bool removeQuantity(const std::string& product_id, int amount);
 
+    /**
+     * @brief Choose when removeQuantity goes through the stock combiner
+     * @param mode AUTO (default) combines only products detected as hot
+     *
+     * A product becomes hot when it alone takes many removals within a
+     * short window; concurrent removals of a hot product are then applied
+     * in batches by one thread under a single lock acquisition.
+     */
+    void setStockCombining(StockCombining mode);
+
+    /**
+     * @brief Get the combiner used for contended removals
+     * @return Reference to the stock combiner (for hot-key and batch statistics)
+     */
+    const StockCombiner& getStockCombiner() const { return stock_combiner_; }
+
+    /**
+     * @brief Remove as much available stock as possible, up to a limit
+     * @param product_id ID of the product
+     * @param max_quantity Most units to remove
+     * @return Units removed (0 if the product is missing or nothing is available)
+     *
+     * Held stock is not taken. Used to allocate a restock to waiting
+     * backorders with a single lock acquisition.
+     */
+    int takeAvailableQuantity(const std::string& product_id, int max_quantity);
+
+    /**
+     * @brief Reserve stock for many orders under one lock acquisition
+     * @param orders Each order's (product ID, quantity) lines
+     * @param reserved Receives, per order, whether all of its lines were reserved
+     * @return Number of orders reserved
+     *
+     * Orders are all-or-nothing and are taken in the given order, so an
+     * earlier order in the batch wins over a later one for scarce stock.
+     * Held stock is not available. Each product's stock is updated once for
+     * the whole batch.
+     */
+    size_t reserveBatch(const std::vector<std::vector<std::pair<std::string, int>>>& orders,
+                        std::vector<bool>& reserved);
+
     /**
      * @brief Get a product by ID
      * @param product_id ID of the product
@@ -100,6 +318,16 @@ public:
      */
     const Product* getProduct(const std::string& product_id) const;
 
+    /**
+     * @brief Copy a product's current state under the lock
+     * @param product_id ID of the product
+     * @param state Receives the state, including its low-stock threshold
+     * @return false if the product does not exist
+     *
+     * Safe against concurrent removal, unlike reading through getProduct().
+     */
+    bool getProductState(const std::string& product_id, ProductVersion& state) const;
+
     /**
      * @brief Get all products in inventory
      * @return Vector of const pointers to all products
@@ -123,6 +351,9 @@ public:
     /**
      * @brief Check for low stock products
      * @return Vector of products that are low in stock
+     *
+     * Reads the maintained low-stock set, so cost is proportional to the
+     * number of low products rather than the catalogue size.
      */
     std::vector<const Product*> getLowStockProducts() const;
 
@@ -183,6 +414,19 @@ public:
      */
     void registerAlertCallback(std::function<void(const std::string&)> callback);
 
+    /**
+     * @brief Register a listener notified when a product is restocked
+     * @param listener Callback receiving the product ID
+     * @return Listener ID for removeRestockListener
+     */
+    uint64_t addRestockListener(RestockListener listener);
+
+    /**
+     * @brief Unregister a restock listener
+     * @param listener_id ID returned by addRestockListener
+     */
+    void removeRestockListener(uint64_t listener_id);
+
     /**
      * @brief Generate and send low stock alerts
      */
@@ -212,32 +456,384 @@ public:
     std::string generateExpiryReport() const;
 
     /**
-     * @brief Check if product exists in inventory
+     * @brief Check if product exists in inventory (does not lock; see readStock)
      * @param product_id Product ID to check
      * @return true if product exists
      */
     bool hasProduct(const std::string& product_id) const;
 
     /**
-     * @brief Get available quantity for a product
+     * @brief Get available quantity for a product (does not lock; see readStock)
      * @param product_id Product ID
-     * @return Available quantity, -1 if product not found
+     * @return On-hand quantity minus held quantity, -1 if product not found
      */
     int getAvailableQuantity(const std::string& product_id) const;
 
+    /**
+     * @brief Copy a product's stock, price, version and expiry without locking
+     * @param product_id Product ID
+     * @param stock Receives a consistent copy of the fields
+     * @return false if product not found
+     *
+     * Reads a per-product copy of the fields that every committed change
+     * rewrites under a sequence lock, so readers never wait for the
+     * inventory lock and only retry while that product is being written.
+     * Changes made through the Product pointers returned by getProduct()
+     * are not seen.
+     */
+    bool readStock(const std::string& product_id, ProductStock& stock) const;
+
+    /**
+     * @brief Hold stock for a checkout
+     * @param product_id Product ID
+     * @param quantity Quantity to hold (must be positive)
+     * @param ttl Time until the hold expires and the stock becomes available
+     *        again (must be positive; capped at MAX_HOLD_TTL)
+     * @return Hold ID, or 0 if the quantity or TTL is not positive, the product
+     *         is missing or not enough stock is available
+     *
+     * Held stock stays on hand but is excluded from getAvailableQuantity and
+     * cannot be taken by removeQuantity or other holds.
+     */
+    uint64_t placeHold(const std::string& product_id, int quantity, std::chrono::milliseconds ttl);
+
+    /**
+     * @brief Convert a hold into a stock removal
+     * @param hold_id Hold to confirm
+     * @return true if the hold was active and its stock was removed
+     */
+    bool confirmHold(uint64_t hold_id);
+
+    /**
+     * @brief Cancel a hold, making its stock available again
+     * @param hold_id Hold to release
+     * @return true if the hold was active
+     */
+    bool releaseHold(uint64_t hold_id);
+
+    /**
+     * @brief Release holds whose TTL has passed
+     * @return Number of holds expired
+     *
+     * Also runs at the start of every hold operation, so expired holds are
+     * released within one 100 ms wheel tick of the next hold activity.
+     */
+    size_t expireHolds();
+
+    /**
+     * @brief Get an active hold
+     * @param hold_id Hold ID
+     * @param hold Receives the hold if found
+     * @return true if the hold is active
+     */
+    bool getHold(uint64_t hold_id, StockHold& hold) const;
+
+    /**
+     * @brief Get quantity currently held for a product
+     * @param product_id Product ID
+     * @return Held quantity (0 if none)
+     */
+    int getHeldQuantity(const std::string& product_id) const;
+
+    /**
+     * @brief Get number of active holds
+     * @return Hold count
+     */
+    size_t getHoldCount() const;
+
     /**
      * @brief Validate inventory consistency
      * @return Vector of error messages, empty if no issues
      */
     std::vector<std::string> validateInventory() const;
 
+    /**
+     * @brief Copy all products' reporting fields under a single lock
+     * @param expiring_days Window used for the expiring-soon flag
+     * @param pool Optional thread pool used to copy hash buckets in parallel
+     * @return Snapshot that stays consistent while the inventory keeps changing
+     *
+     * With versioning enabled the copy comes from a pinned view instead and
+     * the inventory lock is not taken.
+     */
+    InventorySnapshot snapshot(int expiring_days = 7, ThreadPool* pool = nullptr) const;
+
+    /**
+     * @brief Visit every product's reporting fields in bounded memory
+     * @param visitor Function called for each product
+     * @param expiring_days Window used for the expiring-soon flag
+     * @param batch_size Products copied per lock acquisition
+     *
+     * Products are copied a batch at a time and the lock is released while the
+     * visitor runs, so the visitor may do slow work such as file output. Each
+     * batch is consistent, but products changed between batches may be seen
+     * in either state, and a concurrent rehash may skip or repeat products.
+     * With versioning enabled every product is read from one pinned view
+     * instead, so the whole visit sees a single consistent state.
+     */
+    void forEachProduct(const std::function<void(const ProductRecord&)>& visitor,
+                        int expiring_days = 7, size_t batch_size = 4096) const;
+
+    /**
+     * @brief Start keeping product history for point-in-time reads (MVCC)
+     * @param retention How far back as-of reads can reach
+     * @return false if versioning was already enabled
+     *
+     * Every later change appends a new product version instead of only
+     * changing the product in place. snapshot() and forEachProduct() then
+     * read a pinned view of those versions without taking the inventory
+     * lock, so long reports no longer hold up writers and forEachProduct()
+     * sees one consistent state. Costs one small allocation per change;
+     * run collectVersionGarbage() periodically to bound the history.
+     */
+    bool enableVersioning(std::chrono::milliseconds retention = std::chrono::minutes(5));
+
+    /**
+     * @brief Check whether product history is kept
+     * @return true after enableVersioning()
+     */
+    bool isVersioningEnabled() const { return versioning_enabled_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Pin the latest committed state
+     * @return Open view, or an invalid one if versioning is not enabled
+     */
+    VersionStore::ReadView openReadView() const;
+
+    /**
+     * @brief Pin the state at a past point in time
+     * @param as_of Time to read at (within the retention window)
+     * @return Open view, or an invalid one if versioning is not enabled or
+     *         as_of is older than the retained history
+     */
+    VersionStore::ReadView openReadViewAsOf(std::chrono::system_clock::time_point as_of) const;
+
+    /**
+     * @brief Read one product's reporting fields from a view
+     * @param view Open view
+     * @param product_id ID of the product
+     * @param record Receives the fields as of the view
+     * @param expiring_days Window used for the expiring-soon flag
+     * @return false if the product did not exist for the view
+     */
+    bool getProductRecord(const VersionStore::ReadView& view, const std::string& product_id,
+                          ProductRecord& record, int expiring_days = 7) const;
+
+    /**
+     * @brief Visit every product's reporting fields as of a view
+     * @param view Open view
+     * @param visitor Function called for each product
+     * @param expiring_days Window used for the expiring-soon flag
+     */
+    void forEachProduct(const VersionStore::ReadView& view,
+                        const std::function<void(const ProductRecord&)>& visitor,
+                        int expiring_days = 7) const;
+
+    /**
+     * @brief Copy all products' reporting fields as they were at a point in time
+     * @param as_of Time to read at (within the retention window)
+     * @param result Receives the snapshot (taken_at is as_of)
+     * @param expiring_days Window used for the expiring-soon flag
+     * @return false if versioning is not enabled or as_of is too old
+     */
+    bool snapshotAsOf(std::chrono::system_clock::time_point as_of, InventorySnapshot& result,
+                      int expiring_days = 7) const;
+
+    /**
+     * @brief Drop product versions no reader needs any more
+     * @return Number of versions dropped (0 if versioning is not enabled)
+     */
+    size_t collectVersionGarbage();
+
+    /**
+     * @brief Get the product history
+     * @return Version store, or nullptr if versioning is not enabled
+     */
+    const VersionStore* getVersionStore() const { return isVersioningEnabled() ? versions_.get() : nullptr; }
+
+    /**
+     * @brief Set the listener that receives every committed change
+     * @param listener Listener, or an empty function to remove it
+     *
+     * Used by replication to build its mutation log. Changes made through
+     * the Product pointers returned by getProduct() are not seen.
+     */
+    void setChangeListener(ChangeListener listener);
+
+    /**
+     * @brief Copy the full replicable state under one lock
+     * @param on_captured Called with the lock still held after the copy, so
+     *        the caller can note its position in the change stream
+     * @return Every product's state, the category thresholds and the default threshold
+     */
+    InventoryState captureState(const std::function<void()>& on_captured = nullptr) const;
+
+    /**
+     * @brief Replace the whole inventory with a captured state
+     * @param state State from captureState(), usually another node's
+     *
+     * Products not in the state are removed; the others are applied with
+     * applyProductState(). Pointers obtained earlier from getProduct() stay
+     * valid for products the state keeps, but not for removed ones.
+     */
+    void restoreState(const InventoryState& state);
+
+    /**
+     * @brief Make one product match a committed state (insert, update or remove)
+     * @param state Product state, e.g. received from a replication primary
+     * @return false if the state was rejected (invalid fields)
+     *
+     * Unlike the regular mutators this accepts past expiry dates and keeps
+     * the state's product version, so a replica reports the same ETags.
+     * An existing product is updated in place rather than replaced.
+     */
+    bool applyProductState(const ProductVersion& state);
+
+    /**
+     * @brief Get recorded stock levels over time
+     * @return Store with one series per product ("product:<id>") and per
+     *         category ("category:<name>"), sampled on every stock change
+     */
+    const TimeSeriesStore& getStockHistory() const { return stock_history_; }
+
+    /**
+     * @brief Start publishing stock levels into a shared-memory segment
+     * @param name Segment name, e.g. "/quirkventory-stock"
+     * @param capacity Record slots (see SharedStockWriter)
+     * @return false if already publishing or the segment cannot be created
+     * @throws std::invalid_argument if the name or capacity is invalid
+     *
+     * Every product is published right away and again on each committed
+     * change, including holds placed and released, so processes on the same
+     * host can read stock with SharedStockReader instead of calling in.
+     * Changes made through the Product pointers returned by getProduct()
+     * are not seen.
+     */
+    bool publishSharedView(const std::string& name, size_t capacity = 65536);
+
+    /**
+     * @brief Stop publishing and remove the segment
+     */
+    void stopSharedView();
+
+    bool isPublishingSharedView() const;
+
 private:
+    /**
+     * @brief Append the product's current state to the history (lock held)
+     * @param product Changed product
+     * @param removed true when the product is being removed
+     */
+    void publishVersionLocked(const Product& product, bool removed = false);
+
+    /**
+     * @brief Write the product's stock to the stock table and the shared view, if any (lock held)
+     * @param product Changed product
+     * @param removed true when the product is being removed
+     */
+    void publishStockLocked(const Product& product, bool removed = false);
+
+    /**
+     * @brief Pass a change to the change listener, if any (lock held)
+     */
+    void notifyChangeLocked(const InventoryChange& change);
+
+    /**
+     * @brief removeProduct() with the lock already held
+     */
+    bool removeProductLocked(const std::string& product_id);
+
+    /**
+     * @brief applyProductState() with the lock already held
+     */
+    bool applyProductStateLocked(const ProductVersion& state);
+
+    /**
+     * @brief Move a product's stock to another category's totals and change its category (lock held)
+     */
+    void moveCategoryLocked(Product& product, const std::string& category);
+
+    /**
+     * @brief Capture a product's state as a version (lock held)
+     */
+    std::shared_ptr<ProductVersion> makeVersionLocked(const Product& product) const;
+
+    /**
+     * @brief Turn a version into reporting fields
+     * @param version Product version
+     * @param at Time the expiry flags are evaluated at
+     * @param expiring_days Window used for the expiring-soon flag
+     */
+    static ProductRecord makeVersionRecord(const ProductVersion& version,
+                                           std::chrono::system_clock::time_point at, int expiring_days);
+
     /**
      * @brief Send alert to all registered callbacks
      * @param message Alert message
      */
     void sendAlert(const std::string& message);
 
+    /**
+     * @brief Invoke restock listeners (lock not held)
+     * @param product_id Restocked product
+     */
+    void notifyRestock(const std::string& product_id);
+
+    /**
+     * @brief Apply a batch of combined removals under one lock acquisition
+     * @param batch Requests in arrival order; each is marked succeeded or failed
+     */
+    void applyRemovalBatch(const std::vector<StockCombiner::Request*>& batch);
+
+    /**
+     * @brief Remove stock and raise a low-stock alert if needed (lock held)
+     * @param product Product to remove stock from
+     * @param amount Quantity to remove (not more than on hand)
+     */
+    void removeStockLocked(Product& product, int amount);
+
+    /**
+     * @brief Drop a hold and its held quantity (lock held)
+     * @param it Hold to drop
+     * @param publish Publish the product's new available quantity to lock-free
+     *        readers; false when the caller changes its stock next anyway
+     */
+    void dropHoldLocked(std::unordered_map<uint64_t, StockHold>::iterator it, bool publish = true);
+
+    /**
+     * @brief Expire holds up to the current wheel tick (lock held)
+     * @return Number of holds expired
+     */
+    size_t expireHoldsLocked();
+
+    /**
+     * @brief Get quantity held for a product (lock held)
+     */
+    int heldQuantityLocked(const std::string& product_id) const;
+
+    /**
+     * @brief Record a product's new stock level and its category total
+     * @param product Product whose quantity changed (called with the lock held)
+     * @param quantity_change Change applied to the category total
+     */
+    void recordStockLevel(const Product& product, int quantity_change);
+
+    /**
+     * @brief Move a product into or out of the low-stock set (lock held)
+     * @param product Product whose quantity or threshold changed
+     *
+     * A product leaving the set raises a "LOW STOCK CLEARED" alert.
+     */
+    void updateLowStockLocked(const Product& product);
+
+    /**
+     * @brief Copy a product's reporting fields
+     * @param product Product to copy
+     * @param expiring_days Window used for the expiring-soon flag
+     * @return Record for the product
+     */
+    ProductRecord makeProductRecord(const Product& product, int expiring_days) const;
+
     /**
      * @brief Convert string to lowercase for case-insensitive search
      * @param str Input string
@@ -3,17 +3,22 @@
 #include "Product.hpp"
 #include "Order.hpp"
 #include "User.hpp"
+#include "ReportWriter.hpp"
+#include "Sketches.hpp"
 #include <string>
 #include <chrono>
 #include <memory>
 #include <vector>
 #include <functional>
+#include <map>
+#include <unordered_map>
 
 namespace quirkventory {
 
 // Forward declarations
 class Inventory;
 class OrderManager;
+struct ProductRecord;
 
 /**
  * @brief Notification priority levels
@@ -245,6 +250,17 @@ public:
      */
     virtual bool exportToFile(const std::string& filename) const;
 
+    /**
+     * @brief Stream the report to a file in a given format
+     * @param filename Output filename
+     * @param format Text, CSV or JSON lines
+     * @return true if export successful
+     *
+     * Rows are written through a buffered sink as they are produced, so
+     * memory use does not grow with report size.
+     */
+    bool exportToFile(const std::string& filename, ReportFormat format) const;
+
     /**
      * @brief Get report header
      * @return Formatted header string
@@ -268,13 +284,54 @@ protected:
      * @brief Clear all sections
      */
     void clearSections();
+
+    /**
+     * @brief Emit the report body to a streaming writer
+     * @param writer Destination writer
+     */
+    virtual void writeContent(ReportWriter& writer) const = 0;
 };
 
 /**
  * @brief Sales report implementation
+ *
+ * Each report captures one snapshot: the period's orders (live and
+ * archived, read together) and the sales aggregates (read under one lock).
+ * The orders are aggregated in parallel shards on the shared thread pool,
+ * and every section is then formatted concurrently from the snapshot.
  */
 class SalesReport : public Report {
 private:
+    // Customers tracked by each shard's revenue sketch
+    static constexpr size_t TOP_CUSTOMER_CAPACITY = 256;
+
+    /**
+     * @brief Per-period order totals, computed per shard and merged
+     *
+     * Customer revenue goes into a Space-Saving sketch, so memory stays
+     * bounded however many customers ordered in the period.
+     */
+    struct PeriodOrderTotals {
+        size_t order_count = 0;
+        std::unordered_map<OrderStatus, int> status_counts;
+        double revenue = 0.0;
+        SpaceSavingSketch customer_revenue{TOP_CUSTOMER_CAPACITY};
+
+        void merge(const PeriodOrderTotals& other);
+    };
+
+    /**
+     * @brief Everything the report shows, captured once per report
+     *
+     * The aggregates are read right after the orders. They can differ from
+     * the order statuses only by transitions whose listeners are still
+     * running.
+     */
+    struct SalesSnapshot {
+        PeriodOrderTotals orders;
+        SalesRangeSummary sales;
+    };
+
     const OrderManager* order_manager_;
     std::chrono::system_clock::time_point start_date_;
     std::chrono::system_clock::time_point end_date_;
@@ -299,33 +356,81 @@ public:
     std::string generate() override;
 
 private:
+    /**
+     * @brief Capture the period's orders and sales aggregates
+     * @return Snapshot every section is built from
+     */
+    SalesSnapshot captureSnapshot() const;
+
+    /**
+     * @brief Aggregate the period's orders
+     * @param rows Captured orders
+     * @return Merged totals over every shard
+     */
+    static PeriodOrderTotals collectOrderTotals(const std::vector<OrderSummaryRow>& rows);
+
+    /**
+     * @brief Get the time series bucket size that keeps the report readable
+     * @return Hours for up to two days, weeks beyond about two months, else days
+     */
+    BucketGranularity getSeriesGranularity() const;
+
     /**
      * @brief Generate order summary section
+     * @param totals Period order totals
      * @return Order summary content
      */
-    std::string generateOrderSummary() const;
+    std::string generateOrderSummary(const PeriodOrderTotals& totals) const;
 
     /**
      * @brief Generate revenue analysis section
+     * @param summary Captured sales aggregates
      * @return Revenue analysis content
      */
-    std::string generateRevenueAnalysis() const;
+    std::string generateRevenueAnalysis(const SalesRangeSummary& summary) const;
 
     /**
      * @brief Generate customer analysis section
+     * @param snapshot Captured report data
      * @return Customer analysis content
      */
-    std::string generateCustomerAnalysis() const;
+    std::string generateCustomerAnalysis(const SalesSnapshot& snapshot) const;
+
+protected:
+    /**
+     * @brief Override: Stream summary, status, category, product and customer sections
+     */
+    void writeContent(ReportWriter& writer) const override;
 };
 
 /**
  * @brief Inventory report implementation
+ *
+ * Works from a single inventory snapshot: shards of the snapshot are
+ * aggregated in parallel on the shared thread pool, and the sections are
+ * formatted concurrently from the merged totals.
  */
 class InventoryReport : public Report {
 private:
+    /**
+     * @brief Snapshot totals, computed per shard and merged
+     */
+    struct InventoryTotals {
+        size_t product_count = 0;
+        long long total_quantity = 0;
+        double total_value = 0.0;
+        std::map<std::string, double> category_values;
+        std::vector<const ProductRecord*> low_stock;
+        std::vector<const ProductRecord*> expired;
+        std::vector<const ProductRecord*> expiring_soon;
+
+        void merge(const InventoryTotals& other);
+    };
+
     const Inventory* inventory_;
     bool include_low_stock_;
     bool include_expired_;
+    bool include_product_listing_;
 
 public:
     /**
@@ -334,11 +439,13 @@ public:
      * @param generated_by User who generated the report
      * @param include_low_stock Include low stock analysis
      * @param include_expired Include expired products analysis
+     * @param include_product_listing Include every product in file exports
      */
     InventoryReport(const Inventory* inventory,
                    const std::string& generated_by,
                    bool include_low_stock = true,
-                   bool include_expired = true);
+                   bool include_expired = true,
+                   bool include_product_listing = false);
 
     /**
      * @brief Override: Generate inventory report
@@ -347,29 +454,50 @@ public:
     std::string generate() override;
 
 private:
+    /**
+     * @brief Aggregate a snapshot of the inventory
+     * @param products Snapshot records
+     * @return Merged totals over every shard
+     */
+    static InventoryTotals collectInventoryTotals(const std::vector<ProductRecord>& products);
+
     /**
      * @brief Generate inventory overview section
+     * @param totals Snapshot totals
      * @return Inventory overview content
      */
-    std::string generateInventoryOverview() const;
+    std::string generateInventoryOverview(const InventoryTotals& totals) const;
 
     /**
      * @brief Generate category breakdown section
+     * @param totals Snapshot totals
      * @return Category breakdown content
      */
-    std::string generateCategoryBreakdown() const;
+    std::string generateCategoryBreakdown(const InventoryTotals& totals) const;
 
     /**
      * @brief Generate low stock section
+     * @param totals Snapshot totals
      * @return Low stock analysis content
      */
-    std::string generateLowStockSection() const;
+    std::string generateLowStockSection(const InventoryTotals& totals) const;
 
     /**
      * @brief Generate expired products section
+     * @param totals Snapshot totals
      * @return Expired products analysis content
      */
-    std::string generateExpiredSection() const;
+    std::string generateExpiredSection(const InventoryTotals& totals) const;
+
+protected:
+    /**
+     * @brief Override: Stream overview, category, low stock, expiry and product sections
+     *
+     * Every section reads the same state. With versioning enabled that is
+     * one pinned view, streamed a pass per section in bounded memory;
+     * otherwise it is one snapshot of the inventory.
+     */
+    void writeContent(ReportWriter& writer) const override;
 };
 
 /**
@@ -2,13 +2,18 @@
 
 #include "Product.hpp"
 #include "Inventory.hpp"
+#include "SalesAnalytics.hpp"
+#include "OrderTimeIndex.hpp"
+#include "ConcurrencyLimiter.hpp"
 #include <vector>
+#include <deque>
 #include <string>
 #include <chrono>
 #include <future>
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <functional>
 
 namespace quirkventory {
 
@@ -19,6 +24,8 @@ struct OrderItem {
     std::string product_id;
     int quantity;
     double unit_price;
+    std::string category;   // Product category captured when the order is processed
+    int backordered = 0;    // Units still waiting for stock on a backordered order
     
     OrderItem(const std::string& id, int qty, double price)
         : product_id(id), quantity(qty), unit_price(price) {}
@@ -36,7 +43,8 @@ enum class OrderStatus {
     SHIPPED,        // Order has been shipped
     DELIVERED,      // Order delivered to customer
     CANCELLED,      // Order cancelled
-    FAILED          // Order processing failed
+    FAILED,         // Order processing failed
+    BACKORDERED     // Accepted; some units wait for a restock (appended so archived values stay stable)
 };
 
 /**
@@ -44,6 +52,57 @@ enum class OrderStatus {
  */
 std::string orderStatusToString(OrderStatus status);
 
+/**
+ * @brief Plain copy of an order's data, detached from the live Order object
+ *
+ * Used for archived orders and for history queries that combine live and
+ * archived orders.
+ */
+struct OrderRecord {
+    std::string order_id;
+    std::string customer_id;
+    OrderStatus status;
+    std::chrono::system_clock::time_point order_date;
+    std::chrono::system_clock::time_point processed_date;   // Epoch if never processed
+    std::vector<OrderItem> items;
+    double total_amount;
+    std::string notes;
+};
+
+/**
+ * @brief The fields a sales report needs from one order
+ */
+struct OrderSummaryRow {
+    std::string customer_id;
+    OrderStatus status;
+    double total_amount;
+};
+
+class Order;
+class OrderArchive;
+class BackorderQueue;
+
+/**
+ * @brief (product ID, quantity) pairs of stock to return to the inventory
+ */
+using StockReleases = std::vector<std::pair<std::string, int>>;
+
+/**
+ * @brief Callback invoked after an order changes status
+ *
+ * Called with the order, its previous status, its new status and the
+ * caller's release collector (nullptr unless the change is a cancellation
+ * whose caller batches stock releases). The order's internal lock is not
+ * held, so the callback may use the order's getters.
+ *
+ * Changes to one order are delivered one at a time, in the order they
+ * happened. A change made while another thread is delivering that order's
+ * notifications is queued and delivered by that thread; a cancellation
+ * queued this way releases its stock directly instead of through the
+ * caller's collector.
+ */
+using OrderStatusListener = std::function<void(const Order&, OrderStatus, OrderStatus, StockReleases*)>;
+
 /**
  * @brief Order processing system with multithreading support
  * 
@@ -68,13 +127,25 @@ private:
     // Processing result
     std::string error_message_;
 
+    // Status change notification
+    struct StatusChange {
+        OrderStatus old_status;
+        OrderStatus new_status;
+        StockReleases* releases;
+    };
+    OrderStatusListener status_listener_;
+    std::deque<StatusChange> pending_changes_;  // Guarded by order_mutex_
+    bool delivering_changes_;                   // Guarded by order_mutex_
+
 public:
     /**
      * @brief Constructor
      * @param order_id Unique order identifier
      * @param customer_id Customer identifier
+     * @param order_date Order date (defaults to now)
      */
-    Order(const std::string& order_id, const std::string& customer_id);
+    Order(const std::string& order_id, const std::string& customer_id,
+          const std::chrono::system_clock::time_point& order_date = std::chrono::system_clock::now());
 
     /**
      * @brief Destructor
@@ -104,6 +175,13 @@ public:
     void setNotes(const std::string& notes);
     void setCustomerId(const std::string& customer_id);
 
+    /**
+     * @brief Register the listener notified after every status change
+     * @param listener Callback receiving the order, old status, new status
+     *        and release collector
+     */
+    void setStatusListener(OrderStatusListener listener);
+
     /**
      * @brief Add an item to the order
      * @param product_id Product identifier
@@ -144,16 +222,23 @@ public:
     /**
      * @brief Validate order against inventory
      * @param inventory Reference to inventory system
+     * @param check_availability Whether insufficient stock counts as an error
      * @return Vector of validation error messages (empty if valid)
      */
-    std::vector<std::string> validateOrder(const Inventory& inventory) const;
+    std::vector<std::string> validateOrder(const Inventory& inventory, bool check_availability = true) const;
 
     /**
      * @brief Process order synchronously
      * @param inventory Reference to inventory system
-     * @return true if processing successful
+     * @param allow_backorder Take whatever stock is available and leave the rest backordered
+     * @return true if the order was confirmed (or backordered)
+     *
+     * Without allow_backorder an order short of stock fails. With it, the
+     * available units are reserved, each item's shortfall is recorded in
+     * OrderItem::backordered and the order becomes BACKORDERED until
+     * fillBackorder() has covered every item.
      */
-    bool processOrder(Inventory& inventory);
+    bool processOrder(Inventory& inventory, bool allow_backorder = false);
 
     /**
      * @brief Process order asynchronously
@@ -162,12 +247,43 @@ public:
      */
     std::future<bool> processOrderAsync(Inventory& inventory);
 
+    /**
+     * @brief Start processing in stages: move to PROCESSING and validate
+     * @param inventory Inventory to validate against
+     * @param check_availability Fail the order if stock is short right now
+     * @return true if the order is ready to have its stock reserved
+     *
+     * On failure the order is FAILED (or left as it was if it could not be
+     * moved to PROCESSING) and getErrorMessage() says why. Used by
+     * processOrder() and by the stages of OrderPipeline.
+     */
+    bool beginProcessing(const Inventory& inventory, bool check_availability = true);
+
+    /**
+     * @brief Finish staged processing once stock has been reserved elsewhere
+     * @param reserved Whether all of the order's stock was reserved
+     * @return true if the order is now CONFIRMED
+     */
+    bool completeProcessing(bool reserved);
+
     /**
      * @brief Cancel the order
      * @param reason Cancellation reason
+     * @param releases If set, the status listener appends the stock the
+     *        order gives back here instead of releasing it at once
      * @return true if cancelled successfully
      */
-    bool cancelOrder(const std::string& reason = "");
+    bool cancelOrder(const std::string& reason = "", StockReleases* releases = nullptr);
+
+    /**
+     * @brief Allocate restocked units to a backordered item
+     * @param product_id Product the units belong to
+     * @param quantity Units available for this order
+     * @return Units used (0 if the order is no longer backordered)
+     *
+     * The order becomes CONFIRMED once no item is waiting.
+     */
+    int fillBackorder(const std::string& product_id, int quantity);
 
     /**
      * @brief Update order status
@@ -200,6 +316,12 @@ public:
      */
     bool canModify() const;
 
+    /**
+     * @brief Copy the order's data under its lock
+     * @return Detached record of the order
+     */
+    OrderRecord toRecord() const;
+
     /**
      * @brief Get processing duration
      * @return Duration in milliseconds, -1 if not processed
@@ -210,9 +332,17 @@ private:
     /**
      * @brief Internal processing logic
      * @param inventory Reference to inventory system
+     * @param allow_backorder Backorder items that are short of stock
      * @return true if processing successful
      */
-    bool processOrderInternal(Inventory& inventory);
+    bool processOrderInternal(Inventory& inventory, bool allow_backorder);
+
+    /**
+     * @brief Reserve available stock and backorder the rest
+     * @param inventory Reference to inventory system
+     * @return true (the order is CONFIRMED or BACKORDERED)
+     */
+    bool reserveWithBackorders(Inventory& inventory);
 
     /**
      * @brief Set error message and update status to FAILED
@@ -220,10 +350,40 @@ private:
      */
     void setError(const std::string& message);
 
+    /**
+     * @brief Record the current product category on every item
+     * @param inventory Inventory to look categories up in
+     */
+    void captureItemCategories(const Inventory& inventory);
+
+    /**
+     * @brief Queue a status change for the listener
+     * @param old_status Status before the change
+     * @param new_status Status after the change
+     * @param releases Release collector passed on to the listener
+     *
+     * Must be called with order_mutex_ held, in the same critical section
+     * that changed status_, so queue order is transition order.
+     */
+    void queueStatusChange(OrderStatus old_status, OrderStatus new_status,
+                           StockReleases* releases = nullptr);
+
+    /**
+     * @brief Deliver queued status changes unless another call is already doing so
+     * @param lock Held lock on order_mutex_; released while the listener runs
+     */
+    void deliverStatusChanges(std::unique_lock<std::mutex>& lock);
+
     /**
      * @brief Update total amount based on current items
      */
     void updateTotalAmount();
+
+    /**
+     * @brief Sum item totals without locking
+     * @return Total amount for all items
+     */
+    double sumItemTotals() const;
 };
 
 /**
@@ -235,6 +395,7 @@ private:
 class OrderManager {
 private:
     std::unordered_map<std::string, std::unique_ptr<Order>> orders_;
+    OrderTimeIndex orders_by_date_;
     mutable std::mutex orders_mutex_;
     
     // Statistics
@@ -242,16 +403,35 @@ private:
     std::atomic<int> successful_orders_;
     std::atomic<int> failed_orders_;
 
+    // Incrementally maintained sales aggregates
+    SalesAggregator sales_aggregator_;
+
+    // Compressed store of cleared (delivered/cancelled) orders
+    std::unique_ptr<OrderArchive> archive_;
+
+    // Backorders waiting for restocks of inventory_ (only with an inventory)
+    Inventory* inventory_;
+    std::unique_ptr<BackorderQueue> backorders_;
+    uint64_t restock_listener_id_;
+
+    // Adaptive concurrency of processAllPendingOrders
+    ConcurrencyLimiter processing_limiter_;
+    std::atomic<size_t> processing_queue_depth_;
+
 public:
     /**
      * @brief Constructor
+     * @param inventory Inventory whose restocks fill backordered orders
+     *                  (nullptr = backordered orders are never filled)
+     *
+     * The inventory must outlive the manager.
      */
-    OrderManager();
+    explicit OrderManager(Inventory* inventory = nullptr);
 
     /**
      * @brief Destructor
      */
-    ~OrderManager() = default;
+    ~OrderManager();
 
     // Disable copy constructor and assignment operator
     OrderManager(const OrderManager&) = delete;
@@ -261,9 +441,20 @@ public:
      * @brief Create a new order
      * @param order_id Unique order identifier
      * @param customer_id Customer identifier
+     * @param order_date Order date (defaults to now)
      * @return Pointer to created order, nullptr if order_id already exists
      */
-    Order* createOrder(const std::string& order_id, const std::string& customer_id);
+    Order* createOrder(const std::string& order_id, const std::string& customer_id,
+                       const std::chrono::system_clock::time_point& order_date = std::chrono::system_clock::now());
+
+    /**
+     * @brief Create a new order with a generated ID
+     * @param customer_id Customer identifier
+     * @param order_date Order date (defaults to now)
+     * @return Pointer to created order (ID from the shared IdGenerator, prefixed "ORD")
+     */
+    Order* createOrderForCustomer(const std::string& customer_id,
+                                  const std::chrono::system_clock::time_point& order_date = std::chrono::system_clock::now());
 
     /**
      * @brief Get an order by ID
@@ -292,13 +483,80 @@ public:
      */
     std::vector<Order*> getOrdersByCustomer(const std::string& customer_id) const;
 
+    /**
+     * @brief Get orders dated within a range
+     * @param start Range start (inclusive)
+     * @param end Range end (inclusive)
+     * @return Orders in order-date order
+     *
+     * Uses the date index, so cost is proportional to the matching window
+     * rather than the total number of orders.
+     */
+    std::vector<Order*> getOrdersInDateRange(const std::chrono::system_clock::time_point& start,
+                                             const std::chrono::system_clock::time_point& end) const;
+
+    /**
+     * @brief Capture status, amount and customer of every order dated within a range
+     * @param start Range start (inclusive)
+     * @param end Range end (inclusive)
+     * @return Rows for live orders followed by archived ones
+     *
+     * Live and archived orders are read under one hold of the order lock,
+     * which clearCompletedOrders() also takes, so an order being archived is
+     * seen exactly once. The rows stay valid after orders are cleared.
+     */
+    std::vector<OrderSummaryRow> getOrderSummariesInDateRange(const std::chrono::system_clock::time_point& start,
+                                                              const std::chrono::system_clock::time_point& end) const;
+
     /**
      * @brief Process all pending orders
      * @param inventory Reference to inventory system
-     * @param max_concurrent Maximum number of concurrent processing threads
+     * @param max_concurrent Fixed number of concurrent processing threads
+     *                       (0 = adapt to observed latency)
      * @return Number of successfully processed orders
+     *
+     * In adaptive mode orders run on the shared thread pool and are admitted
+     * by the manager's processing limiter, which keeps learning across calls.
+     * Must not be called from a task of the shared pool.
+     */
+    int processAllPendingOrders(Inventory& inventory, int max_concurrent = 0);
+
+    /**
+     * @brief Get the limiter used by adaptive order processing
+     * @return Reference to the limiter (current limit, in-flight, latency)
+     */
+    const ConcurrencyLimiter& getProcessingLimiter() const { return processing_limiter_; }
+
+    /**
+     * @brief Get number of pending orders waiting for admission
+     * @return Orders of running processAllPendingOrders calls not yet started
+     */
+    size_t getProcessingQueueDepth() const { return processing_queue_depth_.load(); }
+
+    /**
+     * @brief Cancel an order and return its reserved stock
+     * @param order_id Order identifier
+     * @param reason Cancellation reason stored in the order notes
+     * @return true if the order exists and could be cancelled
+     *
+     * Confirmed orders return their items, backordered orders the units
+     * already allocated to them. Stock is only returned when the manager
+     * was constructed with an inventory.
+     */
+    bool cancelOrder(const std::string& order_id, const std::string& reason = "");
+
+    /**
+     * @brief Cancel many orders and return their stock in one batch
+     * @param order_ids Order identifiers
+     * @param reason Cancellation reason stored in each order's notes
+     * @return Number of orders cancelled
+     *
+     * Released quantities are summed per product and applied with a single
+     * inventory lock acquisition, so cancelling a large set of orders does
+     * not take the inventory lock once per line. Unknown, shipped and
+     * delivered orders and orders already cancelled are skipped.
      */
-    int processAllPendingOrders(Inventory& inventory, int max_concurrent = 4);
+    size_t cancelOrders(const std::vector<std::string>& order_ids, const std::string& reason = "");
 
     /**
      * @brief Remove an order
@@ -319,13 +577,67 @@ public:
      */
     size_t getTotalOrderCount() const;
 
+    /**
+     * @brief Get a customer's full order history
+     * @param customer_id Customer identifier
+     * @return Live and archived orders of the customer in order-date order
+     */
+    std::vector<OrderRecord> getCustomerHistory(const std::string& customer_id) const;
+
     /**
      * @brief Clear all completed orders
      * @return Number of orders cleared
+     *
+     * Delivered and cancelled orders are moved into the order archive, where
+     * they stay available to reports and history queries.
      */
     int clearCompletedOrders();
 
+    /**
+     * @brief Get the archive of cleared orders
+     * @return Reference to the order archive
+     */
+    const OrderArchive& getArchive() const;
+
+    /**
+     * @brief Get the queue of backordered lines
+     * @return Backorder queue, nullptr if the manager has no inventory
+     */
+    const BackorderQueue* getBackorders() const { return backorders_.get(); }
+
+    /**
+     * @brief Get the sales aggregates maintained for orders of this manager
+     * @return Reference to the sales aggregator
+     */
+    const SalesAggregator& getSalesAggregator() const { return sales_aggregator_; }
+
 private:
+    /**
+     * @brief Keep sales aggregates in sync with an order's status change
+     * @param order Order whose status changed
+     * @param old_status Status before the change
+     * @param new_status Status after the change
+     * @param releases Collector for stock a cancellation returns (nullptr = release at once)
+     */
+    void onOrderStatusChanged(const Order& order, OrderStatus old_status, OrderStatus new_status,
+                              StockReleases* releases);
+
+    /**
+     * @brief Return the stock a cancelled order had reserved
+     * @param order Cancelled order
+     * @param releases If set, the releases are appended here (cancelOrders()
+     *        applies them in one batch) instead of being applied immediately
+     */
+    void releaseReservedStock(const Order& order, StockReleases* releases);
+
+    /**
+     * @brief Process orders on the shared pool under the processing limiter
+     * @param orders Orders to process
+     * @param inventory Reference to inventory system
+     * @return Number of successfully processed orders
+     */
+    int processAdaptively(const std::vector<Order*>& orders, Inventory& inventory);
+
     /**
      * @brief Update statistics after order processing
      * @param success Whether the order was processed successfully
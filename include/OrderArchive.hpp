@@ -0,0 +1,185 @@
+#pragma once
+
+#include "Order.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <chrono>
+#include <mutex>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief Append-only string dictionary mapping strings to dense ids
+ *
+ * Each distinct string is stored once; ids are assigned in insertion order.
+ * Not thread-safe.
+ */
+class StringDictionary {
+private:
+    std::deque<std::string> values_;    // Deque keeps string_view keys stable
+    std::unordered_map<std::string_view, uint32_t> ids_;
+    size_t string_bytes_;
+
+public:
+    StringDictionary() : string_bytes_(0) {}
+
+    // Keys point into values_, so copying would leave them dangling
+    StringDictionary(const StringDictionary&) = delete;
+    StringDictionary& operator=(const StringDictionary&) = delete;
+
+    /**
+     * @brief Get the id of a string, adding it if new
+     * @param value String to intern
+     * @return Dictionary id
+     */
+    uint32_t intern(const std::string& value);
+
+    /**
+     * @brief Look up the id of a string without adding it
+     * @param value String to find
+     * @param id Receives the id if found
+     * @return true if the string is in the dictionary
+     */
+    bool find(const std::string& value, uint32_t& id) const;
+
+    const std::string& get(uint32_t id) const { return values_[id]; }
+    size_t size() const { return values_.size(); }
+
+    /**
+     * @brief Estimate memory used by the dictionary
+     * @return Approximate size in bytes
+     */
+    size_t getMemoryUsage() const;
+};
+
+/**
+ * @brief Immutable, compressed columnar archive of completed orders
+ *
+ * Orders are stored in per-day segments (UTC). Each segment is written once
+ * and never modified; within a segment rows are sorted by order date and
+ * every field is kept in its own varint-encoded column:
+ *
+ * - order ids are front-coded against the previous id,
+ * - order dates are microsecond deltas from the previous row,
+ * - customer, product and category ids go through archive-wide dictionaries,
+ * - prices are stored as whole cents when exact, raw doubles otherwise.
+ *
+ * A typical order takes a few dozen bytes instead of a full Order object
+ * with its mutex, atomic and heap-allocated strings. Date-range queries
+ * decode only segments overlapping the range, and customer queries skip
+ * segments whose customer set does not contain the customer.
+ *
+ * Thread-safe. Visitors run under the archive lock and must not call back
+ * into the archive.
+ */
+class OrderArchive {
+private:
+    struct Segment {
+        long long day;                      // UTC day index
+        long long first_timestamp;          // Microseconds since epoch
+        long long last_timestamp;
+        size_t row_count = 0;
+        std::vector<uint32_t> customer_set; // Sorted distinct customer ids
+
+        // Columns
+        std::vector<uint8_t> order_ids;
+        std::vector<uint8_t> timestamps;
+        std::vector<uint8_t> customers;
+        std::vector<uint8_t> statuses;
+        std::vector<uint8_t> items;
+        std::vector<uint8_t> notes;
+
+        size_t getByteSize() const;
+    };
+
+    std::map<long long, std::vector<Segment>> segments_by_day_;
+    StringDictionary customers_;
+    StringDictionary products_;
+    StringDictionary categories_;
+    size_t order_count_;
+    mutable std::mutex archive_mutex_;
+
+public:
+    OrderArchive();
+
+    // Disable copy constructor and assignment operator due to mutex
+    OrderArchive(const OrderArchive&) = delete;
+    OrderArchive& operator=(const OrderArchive&) = delete;
+
+    /**
+     * @brief Archive a batch of orders
+     * @param records Orders to archive (any order; grouped into per-day segments)
+     * @return Number of orders archived
+     */
+    size_t archive(std::vector<OrderRecord> records);
+
+    /**
+     * @brief Visit archived orders dated within a range in date order
+     * @param start Range start (inclusive)
+     * @param end Range end (inclusive)
+     * @param visitor Function called for each order
+     */
+    void forEachInRange(const std::chrono::system_clock::time_point& start,
+                        const std::chrono::system_clock::time_point& end,
+                        const std::function<void(const OrderRecord&)>& visitor) const;
+
+    /**
+     * @brief Get archived orders dated within a range
+     * @param start Range start (inclusive)
+     * @param end Range end (inclusive)
+     * @return Orders in date order
+     */
+    std::vector<OrderRecord> getOrdersInDateRange(const std::chrono::system_clock::time_point& start,
+                                                  const std::chrono::system_clock::time_point& end) const;
+
+    /**
+     * @brief Get a customer's archived orders
+     * @param customer_id Customer identifier
+     * @return Orders in date order
+     */
+    std::vector<OrderRecord> getOrdersByCustomer(const std::string& customer_id) const;
+
+    /**
+     * @brief Find an archived order by id
+     * @param order_id Order identifier
+     * @param record Receives the order if found
+     * @return true if the order is in the archive
+     *
+     * Scans the order id column of every segment; intended for occasional
+     * lookups rather than hot paths.
+     */
+    bool findOrder(const std::string& order_id, OrderRecord& record) const;
+
+    size_t size() const;
+    size_t getSegmentCount() const;
+
+    /**
+     * @brief Estimate memory used by the archive
+     * @return Approximate size in bytes of columns and dictionaries
+     */
+    size_t getMemoryUsage() const;
+
+private:
+    /**
+     * @brief Encode one day's rows (sorted by date) into a segment
+     */
+    Segment buildSegment(long long day, const std::vector<const OrderRecord*>& rows);
+
+    /**
+     * @brief Decode a segment's rows in order
+     * @param segment Segment to decode
+     * @param visitor Called with each row's timestamp (µs) and record; return false to stop
+     * @param customer_filter Only materialize rows of this customer id (UINT32_MAX for all)
+     */
+    void decodeSegment(const Segment& segment,
+                       const std::function<bool(long long, const OrderRecord&)>& visitor,
+                       uint32_t customer_filter = UINT32_MAX) const;
+};
+
+} // namespace quirkventory
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "BoundedQueue.hpp"
+#include "Order.hpp"
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief Tuning of an OrderPipeline
+ */
+struct OrderPipelineConfig {
+    size_t batch_size = 64;                                          // Most orders per stage step
+    std::chrono::microseconds flush_interval{std::chrono::milliseconds(2)};  // Longest wait for a fuller batch
+    size_t queue_capacity = 4096;                                    // Capacity of each queue between stages
+};
+
+/**
+ * @brief Counters of an OrderPipeline
+ */
+struct OrderPipelineStats {
+    uint64_t submitted = 0;
+    uint64_t rejected = 0;          // Submissions refused because intake was full
+    uint64_t confirmed = 0;
+    uint64_t failed = 0;
+    uint64_t reserve_batches = 0;   // Inventory lock acquisitions by the reserve stage
+    double average_latency_us = 0.0;     // Submission to notification
+    uint64_t max_latency_us = 0;
+
+    /**
+     * @brief Get average orders per reservation batch
+     * @return Orders per batch (0 before the first batch)
+     */
+    double getAverageReserveBatch() const {
+        return reserve_batches > 0 ? static_cast<double>(confirmed + failed) / reserve_batches : 0.0;
+    }
+};
+
+/**
+ * @brief Staged order processing connected by bounded lock-free queues
+ *
+ * Orders move through intake -> validate -> reserve -> confirm -> notify.
+ * Callers submit to intake; each later stage runs on its own thread and
+ * takes its input queue in micro-batches of up to batch_size orders. The
+ * reserve stage reserves a whole batch with one Inventory::reserveBatch()
+ * call, so the inventory lock is taken once per batch instead of once per
+ * order line. A stage that has some orders but not a full batch runs them
+ * once the oldest has waited flush_interval, which bounds the latency
+ * batching adds. Full queues push back: a stage waits for room downstream
+ * and submit() fails when intake is full.
+ *
+ * Orders that fail validation or reservation become FAILED and still pass
+ * through to the notify stage. Orders must outlive their trip through the
+ * pipeline (e.g. be owned by an OrderManager that is not cleared meanwhile).
+ */
+class OrderPipeline {
+public:
+    using BatchListener = std::function<void(const std::vector<Order*>&)>;
+
+private:
+    struct Ticket {
+        Order* order = nullptr;
+        std::chrono::steady_clock::time_point submitted;
+        bool ok = true;         // false once the order has failed a stage
+        bool reserved = false;  // Set by the reserve stage
+    };
+
+    /**
+     * @brief One stage: an input queue and the thread draining it
+     */
+    struct Stage {
+        Stage(size_t capacity, const Stage* previous) : input(capacity), upstream(previous) {}
+        BoundedQueue<Ticket> input;
+        const Stage* upstream;              // nullptr for the stage fed by submit()
+        std::atomic<bool> finished{false};  // Set once the stage has forwarded its last batch
+        std::thread worker;
+    };
+
+    Inventory& inventory_;
+    OrderPipelineConfig config_;
+    BatchListener listener_;
+
+    Stage validate_;
+    Stage reserve_;
+    Stage confirm_;
+    Stage notify_;
+
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> submitted_;
+    std::atomic<uint64_t> rejected_;
+    std::atomic<uint64_t> completed_;
+    std::atomic<uint64_t> confirmed_;
+    std::atomic<uint64_t> failed_;
+    std::atomic<uint64_t> reserve_batches_;
+    std::atomic<uint64_t> total_latency_us_;
+    std::atomic<uint64_t> max_latency_us_;
+
+public:
+    /**
+     * @brief Constructor - starts the stage threads
+     * @param inventory Inventory orders are validated and reserved against
+     * @param config Batch size, flush interval and queue capacity
+     * @param listener Called by the notify stage with each batch of finished
+     *                 orders (confirmed and failed); may be empty
+     * @throws std::invalid_argument if batch_size or queue_capacity is 0
+     */
+    OrderPipeline(Inventory& inventory, const OrderPipelineConfig& config = OrderPipelineConfig(),
+                  BatchListener listener = nullptr);
+
+    /**
+     * @brief Destructor - drains submitted orders, then stops the stages
+     */
+    ~OrderPipeline();
+
+    // Disable copy constructor and assignment operator
+    OrderPipeline(const OrderPipeline&) = delete;
+    OrderPipeline& operator=(const OrderPipeline&) = delete;
+
+    /**
+     * @brief Submit a pending order
+     * @param order Order to process
+     * @return false if intake is full or the pipeline is stopping
+     */
+    bool submit(Order* order);
+
+    /**
+     * @brief Wait until every submitted order has been notified
+     * @param timeout Longest time to wait
+     * @return true if the pipeline is idle
+     */
+    bool waitUntilIdle(std::chrono::milliseconds timeout = std::chrono::seconds(30)) const;
+
+    /**
+     * @brief Get number of orders inside the pipeline
+     * @return Submitted but not yet notified orders
+     */
+    uint64_t getInFlight() const;
+
+    /**
+     * @brief Get pipeline counters
+     * @return Snapshot of the counters
+     */
+    OrderPipelineStats getStats() const;
+
+private:
+    /**
+     * @brief Drain a stage's input in micro-batches until the pipeline stops
+     * @param stage Stage to run
+     * @param step Processes one batch
+     */
+    void runStage(Stage& stage, const std::function<void(std::vector<Ticket>&)>& step);
+
+    /**
+     * @brief Hand a batch to the next stage, waiting while its queue is full
+     */
+    void forward(Stage& next, std::vector<Ticket>& batch);
+
+    void validateBatch(std::vector<Ticket>& batch);
+    void reserveBatch(std::vector<Ticket>& batch);
+    void confirmBatch(std::vector<Ticket>& batch);
+    void notifyBatch(std::vector<Ticket>& batch);
+};
+
+} // namespace quirkventory
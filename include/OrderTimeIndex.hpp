@@ -0,0 +1,118 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+namespace quirkventory {
+
+// Forward declarations
+class Order;
+
+/**
+ * @brief Order index sorted by order date
+ *
+ * Orders are stored in append-only, time-partitioned segments. Because order
+ * dates are assigned at creation, new orders almost always land at the end of
+ * the last segment; a date-range query binary searches for the first matching
+ * segment and entry, then scans only the matching window.
+ *
+ * Removed orders leave tombstones that are compacted once a segment is
+ * mostly empty. Not thread-safe; the owner provides synchronization.
+ */
+class OrderTimeIndex {
+private:
+    struct Entry {
+        long long timestamp;    // Order date in microseconds since epoch
+        Order* order;           // nullptr once removed
+    };
+
+    struct Segment {
+        std::vector<Entry> entries;
+        size_t live_count = 0;
+    };
+
+    std::vector<Segment> segments_;
+    size_t segment_capacity_;
+    size_t size_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param segment_capacity Number of entries per segment before a new one is started
+     */
+    explicit OrderTimeIndex(size_t segment_capacity = 4096);
+
+    /**
+     * @brief Add an order to the index
+     * @param order_date Order date used as the sort key
+     * @param order Order to index
+     */
+    void insert(const std::chrono::system_clock::time_point& order_date, Order* order);
+
+    /**
+     * @brief Remove an order from the index
+     * @param order_date Order date the order was inserted with
+     * @param order Order to remove
+     * @return true if the order was found and removed
+     */
+    bool remove(const std::chrono::system_clock::time_point& order_date, const Order* order);
+
+    /**
+     * @brief Visit orders dated within a range in date order
+     * @param start Range start (inclusive)
+     * @param end Range end (inclusive)
+     * @param visitor Function called for each order
+     */
+    void forEachInRange(const std::chrono::system_clock::time_point& start,
+                        const std::chrono::system_clock::time_point& end,
+                        const std::function<void(Order*)>& visitor) const;
+
+    /**
+     * @brief Get orders dated within a range
+     * @param start Range start (inclusive)
+     * @param end Range end (inclusive)
+     * @return Orders in date order
+     */
+    std::vector<Order*> getRange(const std::chrono::system_clock::time_point& start,
+                                 const std::chrono::system_clock::time_point& end) const;
+
+    /**
+     * @brief Get number of indexed orders
+     * @return Number of live entries
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * @brief Get number of segments
+     * @return Segment count
+     */
+    size_t getSegmentCount() const { return segments_.size(); }
+
+    /**
+     * @brief Remove all entries
+     */
+    void clear();
+
+private:
+    /**
+     * @brief Convert a time point to the index key
+     */
+    static long long toTimestamp(const std::chrono::system_clock::time_point& time_point);
+
+    /**
+     * @brief Find the first segment whose last entry is not before a timestamp
+     * @param timestamp Key to search for
+     * @return Segment position (segments_.size() if none)
+     */
+    size_t findSegment(long long timestamp) const;
+
+    /**
+     * @brief Drop tombstones from a segment and remove it if empty
+     * @param segment_index Segment position
+     */
+    void compactSegment(size_t segment_index);
+};
+
+} // namespace quirkventory
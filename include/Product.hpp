@@ -4,6 +4,7 @@
 #include <chrono>
 #include <memory>
 #include <ostream>
+#include <cstdint>
 
 namespace quirkventory {
 
@@ -21,6 +22,7 @@ protected:
     double price_;
     int quantity_;
     std::chrono::system_clock::time_point created_date_;
+    uint64_t version_;  // Starts at 1, bumped by every setter
 
 public:
     /**
@@ -50,6 +52,15 @@ public:
     int getQuantity() const { return quantity_; }
     const std::chrono::system_clock::time_point& getCreatedDate() const { return created_date_; }
 
+    /**
+     * @brief Get the product's version
+     * @return Counter that changes whenever any field (including stock) changes
+     *
+     * Served as the product's ETag so clients can update it with
+     * compare-and-set semantics (see Inventory::updateProduct).
+     */
+    uint64_t getVersion() const { return version_; }
+
     // Setters with validation
     void setName(const std::string& name);
     void setCategory(const std::string& category);
@@ -140,6 +151,42 @@ public:
                      const std::string& storage_requirements = "",
                      double storage_temperature = 20.0);
 
+    /**
+     * @brief Rebuild a product from a stored state (e.g. a replicated one)
+     * @param id Unique product identifier
+     * @param name Product name
+     * @param category Product category
+     * @param price Product price
+     * @param quantity Quantity on hand
+     * @param expiry_date Expiration date; unlike the constructor, past dates are accepted
+     * @param version Version number to carry over
+     * @return Restored product
+     * @throws std::invalid_argument if the other fields are invalid
+     */
+    static std::unique_ptr<PerishableProduct> restore(const std::string& id,
+                                                      const std::string& name,
+                                                      const std::string& category,
+                                                      double price,
+                                                      int quantity,
+                                                      const std::chrono::system_clock::time_point& expiry_date,
+                                                      uint64_t version);
+
+    /**
+     * @brief Expiry date given to restored products that do not perish
+     * @return A date 100 years from now
+     */
+    static std::chrono::system_clock::time_point farFutureExpiry();
+
+    /**
+     * @brief Take over a restored product's state in place
+     * @param state Product built by restore() for the same ID
+     *
+     * Copies name, category, price, quantity, expiry date and version, so
+     * pointers to this product stay valid while its state is replaced.
+     * Storage requirements are kept.
+     */
+    void restoreState(const PerishableProduct& state);
+
     // Getters for perishable-specific attributes
     const std::chrono::system_clock::time_point& getExpiryDate() const { return expiry_date_; }
     const std::string& getStorageRequirements() const { return storage_requirements_; }
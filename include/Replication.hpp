@@ -0,0 +1,291 @@
+#pragma once
+
+#include "Inventory.hpp"
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief A primary's view of one connected follower
+ */
+struct ReplicaStatus {
+    std::string address;        // Follower's IP:port
+    uint64_t acked_lsn;         // Last change the follower reported applied
+    uint64_t lag_changes;       // Changes logged on the primary but not yet acknowledged
+    uint64_t snapshots_sent;    // Full snapshots sent on this connection
+};
+
+/**
+ * @brief A follower's replication progress and lag
+ */
+struct ReplicationStatus {
+    bool connected;
+    uint64_t applied_lsn;       // Last change applied locally
+    uint64_t primary_lsn;       // Last change the primary had logged, as of its last message
+    uint64_t lag_changes;       // primary_lsn - applied_lsn
+    double apply_delay_ms;      // Commit on the primary to apply here, for the last applied change
+    double since_contact_ms;    // Time since the last message from the primary
+    uint64_t changes_applied;
+    uint64_t snapshots_loaded;
+    uint64_t reconnects;
+};
+
+/**
+ * @brief Streams an inventory's mutation log to follower processes over TCP
+ *
+ * Every committed change (a product's new state or a category threshold) is
+ * numbered with a log sequence number (LSN) and kept in a bounded in-memory
+ * log. A connecting follower names the last LSN it applied; if the log
+ * still reaches back that far it is sent the missing changes, otherwise (a
+ * new follower, one that fell too far behind, or one from before a primary
+ * restart) it first receives a full snapshot. Changes carry whole product
+ * states, so applying one twice is harmless.
+ *
+ * Followers acknowledge what they applied, which gives the primary its
+ * per-follower lag. When the log is idle the primary sends heartbeats so
+ * followers can tell a quiet primary from a lost one.
+ */
+class ReplicationPrimary {
+private:
+    struct LogEntry {
+        uint64_t lsn;
+        int64_t committed_at_us;        // system_clock, microseconds since the epoch
+        std::vector<uint8_t> change;    // Encoded InventoryChange
+    };
+
+    struct Session {
+        int fd = -1;
+        std::string address;
+        std::thread thread;
+        std::atomic<bool> finished{false};
+        std::atomic<uint64_t> acked_lsn{0};
+        std::atomic<uint64_t> snapshots_sent{0};
+    };
+
+    Inventory& inventory_;
+    std::string bind_address_;
+    uint16_t port_;
+    size_t log_capacity_;
+    uint64_t log_id_;               // Distinguishes this log from one of an earlier run
+
+    // Mutation log; appended under the inventory lock, so LSN order is commit order
+    std::deque<LogEntry> log_;
+    uint64_t last_lsn_;
+    mutable std::mutex log_mutex_;
+    std::condition_variable log_cv_;
+
+    int listen_fd_;
+    std::atomic<bool> running_;
+    std::thread accept_thread_;
+    std::vector<std::unique_ptr<Session>> sessions_;
+    mutable std::mutex sessions_mutex_;
+
+public:
+    /**
+     * @brief Constructor - starts logging the inventory's changes
+     * @param inventory Inventory to replicate
+     * @param port TCP port to listen on (0 picks a free one)
+     * @param bind_address IPv4 address to listen on
+     * @param log_capacity Changes kept for followers to catch up from
+     * @throws std::invalid_argument if log_capacity is 0
+     */
+    ReplicationPrimary(Inventory& inventory, uint16_t port,
+                       const std::string& bind_address = "127.0.0.1", size_t log_capacity = 100000);
+
+    /**
+     * @brief Destructor - stops serving and detaches from the inventory
+     */
+    ~ReplicationPrimary();
+
+    // Disable copy constructor and assignment operator
+    ReplicationPrimary(const ReplicationPrimary&) = delete;
+    ReplicationPrimary& operator=(const ReplicationPrimary&) = delete;
+
+    /**
+     * @brief Start accepting followers
+     * @return false if already running or the address cannot be bound
+     */
+    bool start();
+
+    /**
+     * @brief Disconnect all followers and stop listening
+     */
+    void stop();
+
+    /**
+     * @brief Check if the primary is accepting followers
+     */
+    bool isRunning() const { return running_.load(); }
+
+    /**
+     * @brief Get the port followers connect to
+     * @return Bound port once started (resolves port 0), else the configured one
+     */
+    uint16_t getPort() const { return port_; }
+
+    /**
+     * @brief Get the LSN of the newest logged change (0 before the first)
+     */
+    uint64_t getLastLsn() const;
+
+    /**
+     * @brief Get the LSN of the oldest change still in the log
+     * @return Oldest retained LSN, or getLastLsn() + 1 if the log is empty
+     */
+    uint64_t getOldestLsn() const;
+
+    /**
+     * @brief Get the status of every connected follower
+     */
+    std::vector<ReplicaStatus> getReplicas() const;
+
+private:
+    /**
+     * @brief Log one change (inventory lock held)
+     */
+    void onChange(const InventoryChange& change);
+
+    void acceptLoop();
+
+    /**
+     * @brief Serve one follower until it disconnects or the primary stops
+     */
+    void serveFollower(Session& session);
+
+    /**
+     * @brief Send a full snapshot
+     * @param session Follower to send to
+     * @param lsn Receives the LSN the snapshot is consistent with
+     * @return false if the connection failed
+     */
+    bool sendSnapshot(Session& session, uint64_t& lsn);
+
+    /**
+     * @brief Copy logged changes after an LSN
+     * @param after_lsn Last LSN the follower has
+     * @param max_entries Maximum number of changes to copy
+     * @param entries Receives the changes
+     * @return false if changes after after_lsn have already left the log
+     */
+    bool readLog(uint64_t after_lsn, size_t max_entries, std::vector<LogEntry>& entries) const;
+
+    /**
+     * @brief Join and drop sessions whose follower has gone
+     */
+    void reapSessions();
+};
+
+/**
+ * @brief Keeps a local inventory in step with a ReplicationPrimary
+ *
+ * Connects to the primary in a background thread, loads a snapshot when
+ * the primary asks it to, and applies streamed changes in LSN order. If
+ * the connection drops (or the primary goes silent) it reconnects and
+ * resumes from the last applied LSN. The local inventory should be used
+ * read-only (e.g. by an HTTPServer serving GETs and reports); local writes
+ * are overwritten by the next change to the same product or snapshot.
+ */
+class ReplicationFollower {
+private:
+    Inventory& inventory_;
+    std::string primary_host_;
+    uint16_t primary_port_;
+
+    std::atomic<bool> running_;
+    std::thread thread_;
+    std::atomic<int> fd_;
+
+    // Replication progress, shared with getStatus() and waitForLsn()
+    mutable std::mutex status_mutex_;
+    mutable std::condition_variable applied_cv_;
+    uint64_t log_id_;
+    uint64_t applied_lsn_;
+    uint64_t primary_lsn_;
+    bool connected_;
+    std::chrono::steady_clock::time_point last_contact_;
+    double apply_delay_ms_;
+    uint64_t changes_applied_;
+    uint64_t snapshots_loaded_;
+    uint64_t reconnects_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param inventory Local inventory to apply changes to
+     * @param primary_host IPv4 address of the primary
+     * @param primary_port Replication port of the primary
+     */
+    ReplicationFollower(Inventory& inventory, const std::string& primary_host, uint16_t primary_port);
+
+    /**
+     * @brief Destructor - disconnects
+     */
+    ~ReplicationFollower();
+
+    // Disable copy constructor and assignment operator
+    ReplicationFollower(const ReplicationFollower&) = delete;
+    ReplicationFollower& operator=(const ReplicationFollower&) = delete;
+
+    /**
+     * @brief Start following; connection happens in the background
+     * @return false if already running or primary_host is not an IPv4 address
+     */
+    bool start();
+
+    /**
+     * @brief Disconnect and stop following
+     */
+    void stop();
+
+    /**
+     * @brief Check if the follower is running (connected or retrying)
+     */
+    bool isRunning() const { return running_.load(); }
+
+    /**
+     * @brief Get replication progress and lag
+     */
+    ReplicationStatus getStatus() const;
+
+    /**
+     * @brief Wait until a change has been applied locally
+     * @param lsn LSN to wait for, e.g. the primary's getLastLsn() after a write
+     * @param timeout Maximum time to wait
+     * @return true if applied_lsn reached lsn in time
+     */
+    bool waitForLsn(uint64_t lsn, std::chrono::milliseconds timeout) const;
+
+private:
+    /**
+     * @brief Connect, follow, and reconnect until stopped
+     */
+    void run();
+
+    /**
+     * @brief Follow over one connection until it fails
+     */
+    void follow(int fd);
+
+    /**
+     * @brief Replace the local inventory with a SNAPSHOT message
+     * @return false if the message is malformed
+     */
+    bool loadSnapshot(const std::vector<uint8_t>& body);
+
+    /**
+     * @brief Apply the changes of a CHANGES message
+     * @return false if the message is malformed or skips changes
+     */
+    bool applyChanges(const std::vector<uint8_t>& body);
+};
+
+} // namespace quirkventory
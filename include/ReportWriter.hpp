@@ -0,0 +1,260 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdio>
+
+namespace quirkventory {
+
+/**
+ * @brief Output formats supported by ReportWriter
+ */
+enum class ReportFormat {
+    TEXT,
+    CSV,
+    JSON_LINES
+};
+
+/**
+ * @brief Buffered file output
+ *
+ * Collects writes in a fixed-size buffer and hands full buffers to the OS,
+ * so memory use is bounded by the buffer size however much is written.
+ * Write errors are sticky and reported by flush() and close().
+ */
+class FileSink {
+private:
+    std::FILE* file_;
+    std::vector<char> buffer_;
+    size_t used_;
+    size_t bytes_written_;
+    bool failed_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param buffer_size Buffer capacity in bytes
+     */
+    explicit FileSink(size_t buffer_size = 1 << 20);
+
+    /**
+     * @brief Destructor - flushes and closes the file
+     */
+    ~FileSink();
+
+    // Disable copy constructor and assignment operator
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    /**
+     * @brief Open a file for writing, truncating it
+     * @param filename Output filename
+     * @return true if the file was opened
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Append bytes
+     * @param data Bytes to write
+     * @param size Number of bytes
+     */
+    void write(const char* data, size_t size);
+
+    void write(const std::string& text) { write(text.data(), text.size()); }
+
+    void put(char c) {
+        if (used_ == buffer_.size()) {
+            flush();
+        }
+        buffer_[used_++] = c;
+        bytes_written_++;
+    }
+
+    /**
+     * @brief Write buffered bytes to the file
+     * @return true if no write error has occurred
+     */
+    bool flush();
+
+    /**
+     * @brief Flush and close the file
+     * @return true if every write succeeded
+     */
+    bool close();
+
+    bool isOpen() const { return file_ != nullptr; }
+    size_t getBytesWritten() const { return bytes_written_; }
+};
+
+/**
+ * @brief Streaming writer for report sections and rows
+ *
+ * Reports emit sections of rows field by field; each row goes straight to
+ * the sink, so nothing beyond the current row is held in memory. Concrete
+ * writers render the same calls as plain text, CSV or JSON lines.
+ */
+class ReportWriter {
+protected:
+    FileSink& sink_;
+    std::string section_;
+    std::vector<std::string> columns_;
+    size_t field_index_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param sink Destination for rendered output
+     */
+    explicit ReportWriter(FileSink& sink);
+
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~ReportWriter() = default;
+
+    /**
+     * @brief Create a writer for a format
+     * @param format Output format
+     * @param sink Destination for rendered output
+     * @return Writer instance
+     */
+    static std::unique_ptr<ReportWriter> create(ReportFormat format, FileSink& sink);
+
+    /**
+     * @brief Write report metadata
+     * @param title Report title
+     * @param generated_by User who generated the report
+     * @param generated_date Generation time
+     */
+    virtual void beginReport(const std::string& title, const std::string& generated_by,
+                             const std::chrono::system_clock::time_point& generated_date) = 0;
+
+    /**
+     * @brief Start a section of rows
+     * @param name Section identifier (lower case, underscores)
+     * @param columns Column names of the section's rows
+     */
+    void beginSection(const std::string& name, const std::vector<std::string>& columns);
+
+    /**
+     * @brief Write a free-text line in the current section
+     * @param text Note text
+     */
+    virtual void writeNote(const std::string& text) = 0;
+
+    /**
+     * @brief Start a row; follow with one addField() per column and endRow()
+     */
+    void beginRow();
+
+    void addField(const std::string& value);
+    void addField(const char* value);
+    void addField(long long value);
+    void addField(int value) { addField(static_cast<long long>(value)); }
+    void addField(size_t value) { addField(static_cast<long long>(value)); }
+    void addField(double value);
+
+    /**
+     * @brief Finish the current row
+     */
+    void endRow();
+
+    /**
+     * @brief Finish the report
+     */
+    virtual void endReport() = 0;
+
+protected:
+    /**
+     * @brief Render the start of a section (section_ and columns_ are set)
+     */
+    virtual void writeSectionHeader() = 0;
+
+    /**
+     * @brief Render the start of a row
+     */
+    virtual void writeRowStart() = 0;
+
+    /**
+     * @brief Render one field (field_index_ is its column)
+     * @param data Field text
+     * @param size Length of the text
+     * @param numeric true if the text is a number
+     */
+    virtual void writeField(const char* data, size_t size, bool numeric) = 0;
+
+    /**
+     * @brief Render the end of a row
+     */
+    virtual void writeRowEnd() = 0;
+};
+
+/**
+ * @brief Human-readable report layout matching Report::generate()
+ */
+class TextReportWriter : public ReportWriter {
+public:
+    explicit TextReportWriter(FileSink& sink) : ReportWriter(sink) {}
+
+    void beginReport(const std::string& title, const std::string& generated_by,
+                     const std::chrono::system_clock::time_point& generated_date) override;
+    void writeNote(const std::string& text) override;
+    void endReport() override;
+
+protected:
+    void writeSectionHeader() override;
+    void writeRowStart() override;
+    void writeField(const char* data, size_t size, bool numeric) override;
+    void writeRowEnd() override;
+};
+
+/**
+ * @brief RFC 4180 CSV; every row is prefixed with its section name
+ *
+ * Each section starts with a header row, and notes are written as
+ * '#'-prefixed comment lines.
+ */
+class CsvReportWriter : public ReportWriter {
+public:
+    explicit CsvReportWriter(FileSink& sink) : ReportWriter(sink) {}
+
+    void beginReport(const std::string& title, const std::string& generated_by,
+                     const std::chrono::system_clock::time_point& generated_date) override;
+    void writeNote(const std::string& text) override;
+    void endReport() override;
+
+protected:
+    void writeSectionHeader() override;
+    void writeRowStart() override;
+    void writeField(const char* data, size_t size, bool numeric) override;
+    void writeRowEnd() override;
+
+private:
+    void writeEscaped(const char* data, size_t size);
+};
+
+/**
+ * @brief One JSON object per line, keyed by column name plus "section"
+ */
+class JsonLinesReportWriter : public ReportWriter {
+public:
+    explicit JsonLinesReportWriter(FileSink& sink) : ReportWriter(sink) {}
+
+    void beginReport(const std::string& title, const std::string& generated_by,
+                     const std::chrono::system_clock::time_point& generated_date) override;
+    void writeNote(const std::string& text) override;
+    void endReport() override;
+
+protected:
+    void writeSectionHeader() override;
+    void writeRowStart() override;
+    void writeField(const char* data, size_t size, bool numeric) override;
+    void writeRowEnd() override;
+
+private:
+    void writeString(const char* data, size_t size);
+};
+
+} // namespace quirkventory
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+#include "Sketches.hpp"
+
+namespace quirkventory {
+
+// Forward declarations
+class Order;
+
+/**
+ * @brief Revenue, units and order count accumulated for one aggregation key
+ */
+struct SalesTotals {
+    double revenue = 0.0;
+    long long units = 0;
+    long long orders = 0;
+
+    /**
+     * @brief Add another set of totals into this one
+     * @param other Totals to add
+     */
+    void merge(const SalesTotals& other);
+
+    /**
+     * @brief Check whether nothing has been accumulated
+     * @return true if all totals are zero
+     */
+    bool isEmpty() const { return orders == 0 && units == 0 && revenue == 0.0; }
+};
+
+/**
+ * @brief Sales aggregated over one time bucket
+ *
+ * Holds overall totals plus breakdowns by product category and by product.
+ */
+struct SalesBucket {
+    SalesTotals totals;
+    std::unordered_map<std::string, SalesTotals> by_category;
+    std::unordered_map<std::string, SalesTotals> by_product;
+
+    /**
+     * @brief Add another bucket into this one
+     * @param other Bucket to add
+     */
+    void merge(const SalesBucket& other);
+};
+
+/**
+ * @brief Approximate per-order statistics for one time bucket
+ *
+ * Distinct customers are counted with HyperLogLog and order values are
+ * summarized with a t-digest; both merge across buckets in constant memory.
+ */
+struct OrderDistribution {
+    HyperLogLog customers;
+    TDigest order_values;
+
+    /**
+     * @brief Add another distribution into this one
+     * @param other Distribution to add
+     */
+    void merge(const OrderDistribution& other);
+};
+
+/**
+ * @brief Time bucket sizes maintained by SalesAggregator
+ */
+enum class BucketGranularity {
+    HOUR,
+    DAY,
+    WEEK    // Weeks start on Monday 00:00 UTC
+};
+
+/**
+ * @brief Sales, time series and order distribution for one range, read together
+ */
+struct SalesRangeSummary {
+    SalesBucket sales;
+    std::vector<std::pair<std::chrono::system_clock::time_point, SalesTotals>> series;
+    OrderDistribution distribution;
+};
+
+/**
+ * @brief Measure used to rank products
+ */
+enum class SalesMetric {
+    UNITS,
+    REVENUE
+};
+
+/**
+ * @brief Incrementally maintained sales aggregates
+ *
+ * Orders are added when they are confirmed and subtracted again when a
+ * confirmed order is cancelled. Aggregates are kept per hour, day and week
+ * (UTC, keyed by order date), so a date-range query only merges the few
+ * coarsest buckets that tile the range instead of rescanning orders.
+ * Queries resolve at hour granularity: the hours containing the start and end
+ * of the range are included in full.
+ *
+ * All-time best sellers are tracked by Space-Saving sketches (one per
+ * metric), so a live top-K needs bounded memory however many products sell.
+ * Distinct customers and order-value quantiles are sketched per day and week;
+ * these sketches are append-only, so cancellations are not subtracted.
+ */
+class SalesAggregator {
+private:
+    std::map<long long, SalesBucket> hourly_;
+    std::map<long long, SalesBucket> daily_;
+    std::map<long long, SalesBucket> weekly_;
+    std::map<long long, OrderDistribution> daily_distributions_;
+    std::map<long long, OrderDistribution> weekly_distributions_;
+    SpaceSavingSketch top_units_;
+    SpaceSavingSketch top_revenue_;
+    mutable std::mutex aggregator_mutex_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param top_products_capacity Products tracked by each best-seller sketch
+     */
+    explicit SalesAggregator(size_t top_products_capacity = 1024);
+
+    // Disable copy constructor and assignment operator due to mutex
+    SalesAggregator(const SalesAggregator&) = delete;
+    SalesAggregator& operator=(const SalesAggregator&) = delete;
+
+    /**
+     * @brief Add a confirmed order to the aggregates
+     * @param order Order to add
+     */
+    void recordOrder(const Order& order);
+
+    /**
+     * @brief Subtract a previously recorded order from the aggregates
+     * @param order Order to subtract
+     */
+    void reverseOrder(const Order& order);
+
+    /**
+     * @brief Aggregate sales for orders dated within a range
+     * @param start Range start (inclusive)
+     * @param end Range end (inclusive)
+     * @return Merged bucket covering the range
+     */
+    SalesBucket query(const std::chrono::system_clock::time_point& start,
+                      const std::chrono::system_clock::time_point& end) const;
+
+    /**
+     * @brief Get per-bucket totals for a range
+     * @param start Range start (inclusive)
+     * @param end Range end (inclusive)
+     * @param granularity Bucket size of the series
+     * @return Non-empty buckets in time order, keyed by bucket start time
+     */
+    std::vector<std::pair<std::chrono::system_clock::time_point, SalesTotals>>
+    getTimeSeries(const std::chrono::system_clock::time_point& start,
+                  const std::chrono::system_clock::time_point& end,
+                  BucketGranularity granularity) const;
+
+    /**
+     * @brief Get approximate customer and order-value statistics for a range
+     * @param start Range start (inclusive)
+     * @param end Range end (inclusive)
+     * @return Merged distribution of confirmed orders in the range
+     *
+     * Resolves at day granularity: the days containing the start and end of
+     * the range are included in full.
+     */
+    OrderDistribution getOrderDistribution(const std::chrono::system_clock::time_point& start,
+                                           const std::chrono::system_clock::time_point& end) const;
+
+    /**
+     * @brief Read the range's sales, time series and distribution under one lock
+     * @param start Range start (inclusive)
+     * @param end Range end (inclusive)
+     * @param granularity Bucket size of the time series
+     * @return Summary in which every part reflects the same set of orders
+     */
+    SalesRangeSummary summarize(const std::chrono::system_clock::time_point& start,
+                                const std::chrono::system_clock::time_point& end,
+                                BucketGranularity granularity) const;
+
+    /**
+     * @brief Get the all-time best sellers from the streaming sketch
+     * @param k Number of products to return
+     * @param metric Ranking measure
+     * @return Up to k products, heaviest first, with error bounds
+     *
+     * Estimates never undercount; a product is guaranteed to appear if its
+     * true total exceeds the metric's overall total divided by the sketch
+     * capacity.
+     */
+    std::vector<HeavyHitter> getTopProducts(size_t k, SalesMetric metric) const;
+
+    /**
+     * @brief Get exact best sellers for orders dated within a range
+     * @param start Range start (inclusive)
+     * @param end Range end (inclusive)
+     * @param k Number of products to return
+     * @param metric Ranking measure
+     * @return Up to k (product ID, totals) pairs, heaviest first
+     */
+    std::vector<std::pair<std::string, SalesTotals>>
+    getTopProductsInRange(const std::chrono::system_clock::time_point& start,
+                          const std::chrono::system_clock::time_point& end,
+                          size_t k, SalesMetric metric) const;
+
+    /**
+     * @brief Rank the products of an aggregated bucket
+     * @param sales Bucket to rank
+     * @param k Number of products to return
+     * @param metric Ranking measure
+     * @return Up to k (product ID, totals) pairs, heaviest first
+     */
+    static std::vector<std::pair<std::string, SalesTotals>>
+    rankProducts(const SalesBucket& sales, size_t k, SalesMetric metric);
+
+    /**
+     * @brief Get number of products tracked by each best-seller sketch
+     * @return Sketch capacity
+     */
+    size_t getTopProductsCapacity() const { return top_units_.getCapacity(); }
+
+    /**
+     * @brief Get number of non-empty buckets kept at a granularity
+     * @param granularity Bucket size
+     * @return Number of buckets
+     */
+    size_t getBucketCount(BucketGranularity granularity) const;
+
+    /**
+     * @brief Remove all aggregates
+     */
+    void clear();
+
+    /**
+     * @brief Get the index of the bucket containing a time point
+     * @param time_point Time point
+     * @param granularity Bucket size
+     * @return Bucket index (floor of time since epoch divided by bucket size)
+     */
+    static long long bucketIndex(const std::chrono::system_clock::time_point& time_point,
+                                 BucketGranularity granularity);
+
+    /**
+     * @brief Get the start time of a bucket
+     * @param index Bucket index
+     * @param granularity Bucket size
+     * @return Start of the bucket
+     */
+    static std::chrono::system_clock::time_point bucketStart(long long index,
+                                                             BucketGranularity granularity);
+
+private:
+    // Range reads behind query(), getTimeSeries() and getOrderDistribution();
+    // the caller holds aggregator_mutex_
+    SalesBucket queryLocked(const std::chrono::system_clock::time_point& start,
+                            const std::chrono::system_clock::time_point& end) const;
+    std::vector<std::pair<std::chrono::system_clock::time_point, SalesTotals>>
+    getTimeSeriesLocked(const std::chrono::system_clock::time_point& start,
+                        const std::chrono::system_clock::time_point& end,
+                        BucketGranularity granularity) const;
+    OrderDistribution getOrderDistributionLocked(const std::chrono::system_clock::time_point& start,
+                                                 const std::chrono::system_clock::time_point& end) const;
+
+    /**
+     * @brief Add or subtract an order in all granularities
+     * @param order Order to apply
+     * @param sign +1 to add, -1 to subtract
+     */
+    void applyOrder(const Order& order, int sign);
+
+    /**
+     * @brief Merge all buckets with index in [first, last) into a result
+     * @param buckets Bucket map to read
+     * @param first First index (inclusive)
+     * @param last Last index (exclusive)
+     * @param result Bucket to merge into
+     */
+    static void mergeRange(const std::map<long long, SalesBucket>& buckets,
+                           long long first, long long last, SalesBucket& result);
+
+    /**
+     * @brief Merge all distributions with index in [first, last) into a result
+     */
+    static void mergeRange(const std::map<long long, OrderDistribution>& buckets,
+                           long long first, long long last, OrderDistribution& result);
+
+    /**
+     * @brief Get the bucket map for a granularity
+     */
+    const std::map<long long, SalesBucket>& bucketsFor(BucketGranularity granularity) const;
+};
+
+} // namespace quirkventory
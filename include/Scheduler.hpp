@@ -0,0 +1,237 @@
+#pragma once
+
+#include "TimingWheel.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <functional>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <cstdint>
+
+namespace quirkventory {
+
+// Forward declarations
+class ThreadPool;
+class Inventory;
+class OrderManager;
+class NotificationManager;
+
+/**
+ * @brief Runtime metrics for a scheduled job
+ */
+struct JobStats {
+    std::string name;
+    std::chrono::milliseconds interval;
+    uint64_t runs;          // Completed runs, including failed ones
+    uint64_t skipped;       // Firings dropped because the previous run was still going
+    uint64_t failures;      // Runs that threw an exception
+    std::chrono::microseconds last_duration;
+    std::chrono::microseconds max_duration;
+    std::chrono::microseconds total_duration;
+    std::chrono::system_clock::time_point last_run;
+    bool running;
+
+    /**
+     * @brief Get the mean run duration
+     * @return Average duration in microseconds (0 if never run)
+     */
+    double getAverageMicros() const {
+        return runs > 0 ? static_cast<double>(total_duration.count()) / runs : 0.0;
+    }
+};
+
+/**
+ * @brief In-process scheduler for recurring background jobs
+ *
+ * A single timer thread drives a TimingWheel and hands due jobs to a worker
+ * ThreadPool, so the timer never blocks on job bodies. Each firing is
+ * rescheduled at interval +/- a random jitter so jobs with equal intervals
+ * drift apart instead of firing in bursts. A job never overlaps itself: if
+ * it is still running when it comes due again, that firing is skipped and
+ * counted in its stats.
+ */
+class Scheduler {
+private:
+    struct Job {
+        uint64_t id;
+        std::string name;
+        std::chrono::milliseconds interval;
+        double jitter;
+        std::function<void()> task;
+        std::atomic<bool> running{false};
+
+        // Guarded by Scheduler::mutex_
+        uint64_t runs = 0;
+        uint64_t skipped = 0;
+        uint64_t failures = 0;
+        std::chrono::microseconds last_duration{0};
+        std::chrono::microseconds max_duration{0};
+        std::chrono::microseconds total_duration{0};
+        std::chrono::system_clock::time_point last_run{};
+    };
+
+    ThreadPool& pool_;
+    std::chrono::milliseconds tick_;
+    std::chrono::steady_clock::time_point origin_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable timer_condition_;
+    std::condition_variable idle_condition_;
+    TimingWheel wheel_;
+    std::unordered_map<uint64_t, std::shared_ptr<Job>> jobs_;
+    std::unordered_map<std::string, uint64_t> job_ids_;
+    uint64_t next_job_id_;
+    size_t in_flight_;
+    bool running_;
+    std::mt19937_64 rng_;
+    std::thread timer_thread_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param pool Worker pool that runs job bodies (nullptr = ThreadPool::getShared())
+     * @param tick Timer resolution
+     */
+    explicit Scheduler(ThreadPool* pool = nullptr,
+                       std::chrono::milliseconds tick = std::chrono::milliseconds(100));
+
+    /**
+     * @brief Destructor - stops the timer and waits for running jobs
+     */
+    ~Scheduler();
+
+    // Disable copy constructor and assignment operator
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    /**
+     * @brief Start the timer thread
+     * @return false if already running
+     */
+    bool start();
+
+    /**
+     * @brief Stop the timer thread and wait for running jobs to finish
+     */
+    void stop();
+
+    bool isRunning() const;
+
+    /**
+     * @brief Register a recurring job
+     * @param name Unique job name
+     * @param interval Time between runs
+     * @param task Job body, run on the worker pool
+     * @param jitter Fraction of the interval each run may be moved by (0 - 0.5)
+     * @return false if the name is taken, the interval is not positive or the task is empty
+     *
+     * The first run happens one (jittered) interval after registration.
+     */
+    bool addJob(const std::string& name, std::chrono::milliseconds interval,
+                std::function<void()> task, double jitter = 0.1);
+
+    /**
+     * @brief Unregister a job; a run already in progress is allowed to finish
+     * @param name Job name
+     * @return true if the job existed
+     */
+    bool removeJob(const std::string& name);
+
+    /**
+     * @brief Run a job now without changing its schedule
+     * @param name Job name
+     * @return false if the job does not exist or is already running
+     */
+    bool runNow(const std::string& name);
+
+    bool hasJob(const std::string& name) const;
+    size_t getJobCount() const;
+
+    /**
+     * @brief Get runtime metrics for a job
+     * @param name Job name
+     * @param stats Filled with the job's metrics
+     * @return false if the job does not exist
+     */
+    bool getJobStats(const std::string& name, JobStats& stats) const;
+
+    /**
+     * @brief Get runtime metrics for all jobs
+     * @return Stats sorted by job name
+     */
+    std::vector<JobStats> getAllJobStats() const;
+
+private:
+    /**
+     * @brief Timer thread main loop
+     */
+    void timerLoop();
+
+    /**
+     * @brief Get the wheel tick for the current time
+     */
+    uint64_t currentTick() const;
+
+    /**
+     * @brief Put a job back on the wheel one jittered interval from now
+     */
+    void scheduleNextLocked(const Job& job, uint64_t now_tick);
+
+    /**
+     * @brief Claim a job and hand it to the pool unless it is already running
+     * @return true if the job was dispatched
+     */
+    bool dispatchLocked(const std::shared_ptr<Job>& job);
+
+    /**
+     * @brief Execute a job body on a worker and record its metrics
+     */
+    void runJob(const std::shared_ptr<Job>& job);
+
+    JobStats makeStatsLocked(const Job& job) const;
+};
+
+/**
+ * @brief Intervals for the standard inventory maintenance jobs
+ *
+ * A zero interval leaves that job unregistered.
+ */
+struct MaintenanceSchedule {
+    std::chrono::milliseconds hold_expiry{std::chrono::seconds(1)};
+    std::chrono::milliseconds low_stock_alerts{std::chrono::minutes(5)};
+    std::chrono::milliseconds expiry_alerts{std::chrono::minutes(15)};
+    std::chrono::milliseconds notification_alerts{std::chrono::minutes(15)};
+    std::chrono::milliseconds order_clearing{std::chrono::hours(1)};
+    std::chrono::milliseconds version_gc{std::chrono::seconds(10)};
+};
+
+/**
+ * @brief Register the recurring inventory maintenance jobs
+ * @param scheduler Scheduler to add the jobs to
+ * @param inventory Inventory to maintain
+ * @param order_manager Orders to clear into the archive (nullptr = skip)
+ * @param notification_manager Manager for inventory notifications (nullptr = skip)
+ * @param schedule Job intervals
+ * @return Number of jobs registered
+ *
+ * Registers "hold-expiry", "low-stock-alerts", "expiry-alerts",
+ * "inventory-notifications", "order-clearing" and "version-gc" (a no-op
+ * until versioning is enabled on the inventory). The referenced objects must
+ * outlive the jobs (stop the scheduler or remove the jobs first).
+ *
+ * The jobs run on pool threads. Pass an order manager only if nothing else
+ * keeps Order pointers across the clearing, and a notification manager only
+ * if nothing else uses it, since NotificationManager has no lock.
+ */
+int scheduleInventoryMaintenance(Scheduler& scheduler, Inventory& inventory,
+                                 OrderManager* order_manager,
+                                 NotificationManager* notification_manager,
+                                 const MaintenanceSchedule& schedule = MaintenanceSchedule());
+
+} // namespace quirkventory
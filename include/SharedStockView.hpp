@@ -0,0 +1,202 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief One product's stock as read from a shared stock view
+ */
+struct SharedStockRecord {
+    int quantity;               // On hand
+    int available_quantity;     // On hand minus active holds
+    double price;
+    uint64_t product_version;   // Same version as the product's ETag
+};
+
+/**
+ * @brief Outcome of SharedStockReader::read
+ */
+enum class SharedReadResult {
+    FOUND,
+    NOT_FOUND,  // Unknown or removed product, or no segment open
+    BUSY        // The record kept changing while being read; try again
+};
+
+/**
+ * @brief Publishes product stock records into a POSIX shared-memory segment
+ *
+ * The segment is a fixed-size hash table of cache-line-aligned records.
+ * Every record is guarded by its own sequence lock: the writer makes the
+ * sequence odd, stores the fields and makes it even again, so readers in
+ * other processes get a consistent copy without locks or system calls and
+ * never hold the writer up. A record's slot is claimed for good the first
+ * time its product is published; removing the product only marks it absent.
+ *
+ * Not thread-safe: Inventory calls it with its lock held.
+ */
+class SharedStockWriter {
+private:
+    std::string name_;
+    size_t capacity_;       // Record slots, a power of two
+    int fd_;
+    void* base_;
+    size_t size_;
+
+    // Slot of every product published so far
+    std::unordered_map<std::string, size_t> slots_;
+    uint64_t overflow_;
+
+public:
+    /**
+     * @brief Longest product ID that fits in a record
+     */
+    static constexpr size_t MAX_ID_LENGTH = 47;
+
+    /**
+     * @brief Appended to the segment name to name the lock object writers take in create()
+     */
+    static constexpr const char* LOCK_SUFFIX = ".lock";
+
+    /**
+     * @brief Constructor
+     * @param name Segment name, e.g. "/quirkventory-stock" (see shm_open)
+     * @param capacity Record slots; rounded up to a power of two, and at
+     *        most three quarters of them are used so lookups stay short
+     * @throws std::invalid_argument if the name is not a valid segment name
+     *         (at most 251 bytes) or the capacity is 0 or above 2^24
+     */
+    SharedStockWriter(const std::string& name, size_t capacity);
+
+    /**
+     * @brief Destructor - retires and removes the segment
+     */
+    ~SharedStockWriter();
+
+    // Disable copy constructor and assignment operator
+    SharedStockWriter(const SharedStockWriter&) = delete;
+    SharedStockWriter& operator=(const SharedStockWriter&) = delete;
+
+    /**
+     * @brief Create the segment
+     * @return false if the segment cannot be created or mapped, or another
+     *         live writer already publishes under the same name
+     *
+     * A segment left under the name is only replaced if it was retired or
+     * the process that created it has exited. Writers of one name create
+     * and replace segments one at a time, under an exclusive flock() on a
+     * second shared-memory object named name + LOCK_SUFFIX. That object is
+     * empty and is left in place.
+     */
+    bool create();
+
+    /**
+     * @brief Retire the segment and remove its name
+     *
+     * Readers that still have it open keep the last values and see
+     * SharedStockReader::isRetired().
+     */
+    void close();
+
+    bool isOpen() const { return base_ != nullptr; }
+
+    /**
+     * @brief Write one product's stock
+     * @param product_id Product identifier (at most MAX_ID_LENGTH bytes)
+     * @param record Values to publish
+     * @return false if the segment is not open, the ID is too long or the
+     *         table is full (counted in getOverflowCount)
+     */
+    bool publish(const std::string& product_id, const SharedStockRecord& record);
+
+    /**
+     * @brief Mark a product as removed
+     * @return false if the product was never published
+     */
+    bool remove(const std::string& product_id);
+
+    const std::string& getName() const { return name_; }
+
+    size_t getCapacity() const { return capacity_; }
+
+    /**
+     * @brief Get number of products that have a slot
+     */
+    size_t getRecordCount() const { return slots_.size(); }
+
+    /**
+     * @brief Get number of products that could not be published
+     */
+    uint64_t getOverflowCount() const { return overflow_; }
+
+private:
+    /**
+     * @brief Find the empty slot a new product goes in
+     * @return Slot index, or capacity_ if the table is full
+     */
+    size_t findFreeSlot(const std::string& product_id) const;
+};
+
+/**
+ * @brief Reads a segment published by SharedStockWriter, from any process
+ *
+ * Maps the segment read-only. A read looks the product up in the mapped
+ * table and copies its record under the record's sequence lock; it never
+ * blocks or makes a system call, and gives up with BUSY after a bounded
+ * number of attempts if the writer keeps changing the record.
+ *
+ * Not thread-safe to open or close while other threads read; concurrent
+ * reads are fine.
+ */
+class SharedStockReader {
+private:
+    const void* base_;
+    size_t size_;
+    size_t capacity_;
+
+public:
+    SharedStockReader();
+
+    /**
+     * @brief Destructor - unmaps the segment
+     */
+    ~SharedStockReader();
+
+    // Disable copy constructor and assignment operator
+    SharedStockReader(const SharedStockReader&) = delete;
+    SharedStockReader& operator=(const SharedStockReader&) = delete;
+
+    /**
+     * @brief Map a published segment
+     * @param name Segment name given to SharedStockWriter
+     * @return false if there is no such segment or it is not a stock view
+     */
+    bool open(const std::string& name);
+
+    void close();
+
+    bool isOpen() const { return base_ != nullptr; }
+
+    /**
+     * @brief Check if the writer has given the segment up
+     *
+     * A retired segment is no longer updated; open the name again to pick
+     * up the writer's next segment.
+     */
+    bool isRetired() const;
+
+    /**
+     * @brief Copy one product's stock
+     * @param product_id Product identifier
+     * @param record Receives the values when FOUND
+     * @return FOUND, NOT_FOUND or BUSY
+     */
+    SharedReadResult read(const std::string& product_id, SharedStockRecord& record) const;
+
+    size_t getCapacity() const { return capacity_; }
+};
+
+} // namespace quirkventory
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief Estimated heavy hitter reported by SpaceSavingSketch
+ */
+struct HeavyHitter {
+    std::string key;
+    double count;       // Estimated weight (never below the true weight)
+    double error;       // Maximum overestimate included in count
+
+    /**
+     * @brief Get the guaranteed lower bound on the true weight
+     * @return count - error
+     */
+    double getLowerBound() const { return count - error; }
+};
+
+/**
+ * @brief Space-Saving sketch for streaming weighted top-K
+ *
+ * Tracks at most `capacity` keys in a min-heap ordered by estimated weight,
+ * with a hash index from key to heap position. When an untracked key arrives
+ * and the sketch is full, it replaces the current minimum and inherits its
+ * weight as error. Any key whose true weight exceeds total_weight / capacity
+ * is guaranteed to be tracked. Memory is O(capacity) regardless of stream
+ * length. Not thread-safe; the owner provides synchronization.
+ */
+class SpaceSavingSketch {
+private:
+    std::vector<HeavyHitter> heap_;
+    std::unordered_map<std::string, size_t> positions_;
+    size_t capacity_;
+    double total_weight_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of tracked keys
+     * @throws std::invalid_argument if capacity is zero
+     */
+    explicit SpaceSavingSketch(size_t capacity);
+
+    /**
+     * @brief Add weight to a key
+     * @param key Item key
+     * @param weight Non-negative weight to add
+     */
+    void add(const std::string& key, double weight = 1.0);
+
+    /**
+     * @brief Remove weight previously added to a key
+     * @param key Item key
+     * @param weight Weight to remove
+     *
+     * Only adjusts keys that are still tracked; weight added to an evicted key
+     * is already accounted for in the error bounds.
+     */
+    void subtract(const std::string& key, double weight = 1.0);
+
+    /**
+     * @brief Get the heaviest tracked keys
+     * @param k Number of keys to return
+     * @return Up to k entries sorted by estimated weight, heaviest first
+     */
+    std::vector<HeavyHitter> getTopK(size_t k) const;
+
+    /**
+     * @brief Add another sketch's counts into this one
+     * @param other Sketch to merge (capacities may differ)
+     *
+     * A key missing from a full sketch may have up to that sketch's minimum
+     * count there, so it is credited with that much (as error). The merged
+     * entries are cut back to this sketch's capacity, keeping the heaviest;
+     * estimates still never undercount.
+     */
+    void merge(const SpaceSavingSketch& other);
+
+    /**
+     * @brief Get the estimate for a key
+     * @param key Item key
+     * @return Estimated weight, or 0 if the key is not tracked
+     */
+    double estimate(const std::string& key) const;
+
+    size_t getCapacity() const { return capacity_; }
+    size_t size() const { return heap_.size(); }
+    double getTotalWeight() const { return total_weight_; }
+
+    /**
+     * @brief Remove all tracked keys
+     */
+    void clear();
+
+private:
+    void siftUp(size_t position);
+    void siftDown(size_t position);
+    void swapEntries(size_t a, size_t b);
+};
+
+/**
+ * @brief HyperLogLog distinct-count sketch
+ *
+ * Uses 2^precision one-byte registers, giving a standard error of about
+ * 1.04 / sqrt(2^precision) (0.81% at the default precision of 14, for 16 KB).
+ * Sketches with the same precision merge losslessly, so per-bucket counters
+ * can be combined into a count for any union of buckets. Elements cannot be
+ * removed. Not thread-safe.
+ */
+class HyperLogLog {
+private:
+    std::vector<uint8_t> registers_;
+    int precision_;
+
+public:
+    static constexpr int DEFAULT_PRECISION = 14;
+
+    /**
+     * @brief Constructor
+     * @param precision Number of index bits (4 to 18)
+     * @throws std::invalid_argument if precision is out of range
+     */
+    explicit HyperLogLog(int precision = DEFAULT_PRECISION);
+
+    /**
+     * @brief Add an element
+     * @param value Element to count
+     */
+    void add(const std::string& value);
+
+    /**
+     * @brief Merge another sketch into this one
+     * @param other Sketch to merge
+     * @return true if merged, false if precisions differ
+     */
+    bool merge(const HyperLogLog& other);
+
+    /**
+     * @brief Estimate the number of distinct elements added
+     * @return Estimated cardinality
+     */
+    double estimate() const;
+
+    int getPrecision() const { return precision_; }
+
+    /**
+     * @brief Get memory used by the registers
+     * @return Size in bytes
+     */
+    size_t getMemoryUsage() const { return registers_.size(); }
+
+    /**
+     * @brief Reset all registers
+     */
+    void clear();
+};
+
+/**
+ * @brief Merging t-digest quantile sketch
+ *
+ * Keeps a bounded set of weighted centroids that are small near the tails and
+ * larger in the middle of the distribution, so extreme quantiles such as p95
+ * or p99 stay accurate. Memory is O(compression) regardless of the number of
+ * values added, and digests merge by re-compressing their centroids. Values
+ * cannot be removed. Not thread-safe.
+ */
+class TDigest {
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    std::vector<Centroid> centroids_;
+    std::vector<Centroid> buffer_;
+    double compression_;
+    double total_weight_;
+    double min_;
+    double max_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param compression Accuracy/size trade-off (roughly the maximum centroid count)
+     * @throws std::invalid_argument if compression is below 10
+     */
+    explicit TDigest(double compression = 100.0);
+
+    /**
+     * @brief Add a value
+     * @param value Value to add
+     * @param weight Positive weight of the value
+     */
+    void add(double value, double weight = 1.0);
+
+    /**
+     * @brief Merge another digest into this one
+     * @param other Digest to merge
+     */
+    void merge(const TDigest& other);
+
+    /**
+     * @brief Estimate a quantile
+     * @param q Quantile in [0, 1]
+     * @return Estimated value at q, or 0 if the digest is empty
+     */
+    double quantile(double q) const;
+
+    /**
+     * @brief Get total weight of added values
+     * @return Total weight
+     */
+    double getCount() const { return total_weight_; }
+
+    double getMin() const { return min_; }
+    double getMax() const { return max_; }
+
+    /**
+     * @brief Get number of centroids after compression
+     * @return Centroid count
+     */
+    size_t getCentroidCount() const;
+
+    /**
+     * @brief Remove all values
+     */
+    void clear();
+
+private:
+    /**
+     * @brief Merge buffered values into the centroid list
+     */
+    void compress();
+
+    /**
+     * @brief Merge a list of centroids according to the scale function
+     * @param centroids Centroids to merge (sorted in place)
+     * @param compression Compression parameter
+     * @return Compressed centroids in mean order
+     */
+    static std::vector<Centroid> mergeCentroids(std::vector<Centroid> centroids, double compression);
+};
+
+} // namespace quirkventory
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace quirkventory {
+
+/**
+ * @brief How Inventory routes stock removals through the combiner
+ */
+enum class StockCombining {
+    AUTO,       // Combine only for keys detected as hot
+    ALWAYS,     // Combine every removal
+    OFF         // Always take the inventory lock directly
+};
+
+/**
+ * @brief Flat combiner for contended stock updates
+ *
+ * Keys hash onto a fixed set of slots. A thread publishes its request on
+ * its slot's lock-free list and then either becomes the slot's combiner
+ * (try_lock succeeds) or yields until its request is done. The combiner
+ * takes every pending request at once and hands the batch, in arrival
+ * order, to the handler, which applies them all under one acquisition of
+ * the owner's lock. Under contention the lock changes hands once per
+ * batch instead of once per request.
+ *
+ * Hot keys are detected from the updates the owner reports: a key that
+ * takes enough of them within a short window is marked hot for a while,
+ * and combined batches of more than one request keep it hot. Each slot
+ * tracks one candidate key by majority vote, so keys sharing a slot with
+ * a hot key are not combined along with it.
+ */
+class StockCombiner {
+public:
+    struct Request {
+        const std::string* key;
+        int amount;
+        bool success = false;           // Set by the batch handler
+        std::atomic<bool> done{false};
+        Request* next = nullptr;
+    };
+
+    using BatchHandler = std::function<void(const std::vector<Request*>&)>;
+
+    static constexpr int64_t HIT_WINDOW_NS = 10'000'000;          // 10 ms
+    static constexpr uint32_t HOT_THRESHOLD = 64;                 // Updates of one key per window
+    static constexpr int64_t HOT_DURATION_NS = 1'000'000'000;     // 1 s, renewed while batching
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<Request*> pending{nullptr};
+        std::mutex combiner;
+        // Approximate under races; only decides which path updates take
+        std::atomic<int64_t> window_start{0};
+        std::atomic<size_t> candidate_hash{0};    // Key currently winning the slot's vote
+        std::atomic<uint32_t> hits{0};            // Candidate's hits net of other keys' this window
+        std::atomic<size_t> hot_hash{0};          // Key the slot is hot for
+        std::atomic<int64_t> hot_until{0};
+    };
+
+    BatchHandler handler_;
+    size_t slot_mask_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<uint64_t> batches_;
+    std::atomic<uint64_t> combined_requests_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param handler Applies a batch of requests and sets each one's success
+     * @param slot_count Number of slots (rounded up to a power of two)
+     */
+    explicit StockCombiner(BatchHandler handler, size_t slot_count = 64);
+
+    // Disable copy constructor and assignment operator
+    StockCombiner(const StockCombiner&) = delete;
+    StockCombiner& operator=(const StockCombiner&) = delete;
+
+    /**
+     * @brief Apply a request through the combiner and wait for its result
+     * @param key Key the request targets
+     * @param amount Request amount, passed through to the handler
+     * @return Success flag set by the handler
+     */
+    bool submit(const std::string& key, int amount);
+
+    /**
+     * @brief Report a direct update of a key
+     * @param key Updated key
+     */
+    void recordHit(const std::string& key);
+
+    /**
+     * @brief Check whether a key is currently treated as hot
+     * @param key Key to check
+     * @return true if the key itself was recently updated often
+     */
+    bool isHot(const std::string& key) const;
+
+    /**
+     * @brief Get number of batches applied
+     * @return Batch count
+     */
+    uint64_t getBatchCount() const { return batches_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get number of requests applied through batches
+     * @return Request count
+     */
+    uint64_t getCombinedRequestCount() const { return combined_requests_.load(std::memory_order_relaxed); }
+
+private:
+    Slot& slotFor(const std::string& key) const { return slotForHash(hashOf(key)); }
+    Slot& slotForHash(size_t hash) const { return slots_[hash & slot_mask_]; }
+
+    static size_t hashOf(const std::string& key) { return std::hash<std::string>{}(key); }
+
+    /**
+     * @brief Drain and apply a slot's pending requests (combiner lock held)
+     */
+    void combine(Slot& slot, std::vector<Request*>& batch);
+
+    static int64_t nowNanos();
+};
+
+} // namespace quirkventory
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+namespace quirkventory {
+
+/**
+ * @brief Consistent copy of one product's frequently read fields
+ */
+struct ProductStock {
+    int quantity = 0;               // On hand
+    int available_quantity = 0;     // On hand minus active holds
+    double price = 0.0;
+    uint64_t product_version = 0;
+    bool perishable = false;
+    std::chrono::system_clock::time_point expiry_date;     // Only meaningful if perishable
+
+    bool isExpired(std::chrono::system_clock::time_point now = std::chrono::system_clock::now()) const {
+        return perishable && now > expiry_date;
+    }
+};
+
+/**
+ * @brief Per-product stock cells that readers look up and copy without locking
+ *
+ * Every product gets a cell holding its ProductStock fields, guarded by the
+ * cell's sequence lock: the writer makes the sequence odd, stores the
+ * fields and makes it even again, and a reader copies the fields and
+ * retries if the sequence moved. Cells are found through an open-addressed
+ * table of cell pointers that readers probe without locking.
+ *
+ * Nothing a reader may be looking at is ever freed while the table lives:
+ * a removed product's cell is only marked absent (and reused if the ID
+ * comes back), and a table outgrown by the cells is kept when a larger one
+ * replaces it. Memory therefore grows with the number of distinct product
+ * IDs ever published, not with the number present.
+ *
+ * Writers must be serialized by the caller (Inventory publishes under its
+ * own lock); any number of readers may run concurrently with them.
+ */
+class StockTable {
+private:
+    struct alignas(64) Cell {
+        explicit Cell(const std::string& product_id) : id(product_id) {}
+
+        const std::string id;
+        std::atomic<uint32_t> sequence{0};     // Odd while the writer is changing the fields below
+
+        // Guarded by sequence
+        std::atomic<bool> present{false};
+        std::atomic<int> quantity{0};
+        std::atomic<int> available_quantity{0};
+        std::atomic<uint64_t> price_bits{0};
+        std::atomic<uint64_t> product_version{0};
+        std::atomic<bool> perishable{false};
+        std::atomic<int64_t> expiry_ticks{0};  // system_clock duration count
+    };
+
+    struct Slots {
+        explicit Slots(size_t slot_count);
+
+        size_t mask;
+        std::unique_ptr<std::atomic<Cell*>[]> cells;
+    };
+
+    std::atomic<Slots*> slots_;
+    std::vector<std::unique_ptr<Slots>> tables_;      // Current one last; outgrown ones kept for readers
+    std::vector<std::unique_ptr<Cell>> cells_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param initial_slots Slots in the first table (rounded up to a power
+     *        of two); the table doubles whenever it is three quarters full
+     */
+    explicit StockTable(size_t initial_slots = 64);
+
+    // Disable copy constructor and assignment operator
+    StockTable(const StockTable&) = delete;
+    StockTable& operator=(const StockTable&) = delete;
+
+    /**
+     * @brief Store a product's fields, adding its cell if needed (writer)
+     */
+    void publish(const std::string& product_id, const ProductStock& stock);
+
+    /**
+     * @brief Mark a product as absent (writer)
+     */
+    void remove(const std::string& product_id);
+
+    /**
+     * @brief Copy a product's fields without locking
+     * @param product_id Product identifier
+     * @param stock Receives the fields if the product is present
+     * @return false if the product is unknown or removed
+     *
+     * Retries while the writer is changing the product's cell, yielding
+     * after a few spins in case the writer was preempted mid-change.
+     */
+    bool read(const std::string& product_id, ProductStock& stock) const;
+
+    /**
+     * @brief Get number of cells (products ever published, present or not)
+     *
+     * Like the writer functions, must not run concurrently with them.
+     */
+    size_t getCellCount() const { return cells_.size(); }
+
+private:
+    /**
+     * @brief Find a product's cell in a table
+     * @return The cell, or nullptr if the product was never published
+     */
+    static Cell* findCell(const Slots& slots, const std::string& product_id);
+
+    /**
+     * @brief Put a cell in the first empty slot of its probe chain
+     */
+    static void insertCell(Slots& slots, Cell* cell);
+
+    /**
+     * @brief Write a cell's fields under its sequence lock
+     */
+    static void writeCell(Cell& cell, bool present, const ProductStock& stock);
+};
+
+} // namespace quirkventory
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <atomic>
+#include <type_traits>
+
+namespace quirkventory {
+
+/**
+ * @brief Fixed-size worker thread pool
+ *
+ * Tasks are queued FIFO and executed by a fixed set of worker threads.
+ * submit() returns a future for the task's result; parallelFor() splits an
+ * index range into tasks and lets the calling thread take part, so it is
+ * safe to call from inside another pool task.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    mutable std::mutex queue_mutex_;
+    std::condition_variable queue_condition_;
+    bool stopping_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param thread_count Number of worker threads (0 = hardware concurrency)
+     */
+    explicit ThreadPool(size_t thread_count = 0);
+
+    /**
+     * @brief Destructor - finishes queued tasks and joins workers
+     */
+    ~ThreadPool();
+
+    // Disable copy constructor and assignment operator
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queue a task
+     * @param task Callable taking no arguments
+     * @return Future for the task's result
+     */
+    template <typename F>
+    auto submit(F&& task) -> std::future<typename std::invoke_result<F>::type> {
+        using Result = typename std::invoke_result<F>::type;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> result = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return result;
+    }
+
+    /**
+     * @brief Run body(index) for every index in [0, count) and wait
+     * @param count Number of indices
+     * @param body Function to run for each index
+     *
+     * Indices are claimed dynamically by pool workers and by the calling
+     * thread; the call returns once every index has run. The first exception
+     * thrown by body is rethrown here.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    /**
+     * @brief Get number of worker threads
+     * @return Worker count
+     */
+    size_t getThreadCount() const { return workers_.size(); }
+
+    /**
+     * @brief Get the process-wide pool used for report generation
+     * @return Shared pool sized to hardware concurrency
+     */
+    static ThreadPool& getShared();
+
+private:
+    /**
+     * @brief Add a task to the queue and wake a worker
+     */
+    void enqueue(std::function<void()> task);
+
+    /**
+     * @brief Worker thread main loop
+     */
+    void workerLoop();
+};
+
+} // namespace quirkventory
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "SalesAnalytics.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <chrono>
+#include <mutex>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief One raw sample of a time series
+ */
+struct TimeSeriesPoint {
+    long long timestamp;    // Seconds since epoch
+    double value;
+};
+
+/**
+ * @brief Summary of a time series over one time bucket
+ *
+ * Buckets without samples carry the previous level forward (count = 0,
+ * min = max = last).
+ */
+struct TimeSeriesRollup {
+    long long start;        // Bucket start, seconds since epoch
+    double min;
+    double max;
+    double last;            // Level at the end of the bucket
+    double sum;
+    uint32_t count;         // Samples recorded in the bucket
+
+    double getAverage() const { return count > 0 ? sum / count : last; }
+};
+
+/**
+ * @brief Gorilla-compressed block of time-ordered samples
+ *
+ * Timestamps are stored as delta-of-deltas and values as the XOR with the
+ * previous value, both with variable-length bit codes. Regular sampling and
+ * slowly changing values (typical of stock levels) take one or two bits per
+ * field, so a sample usually costs a few bytes or less.
+ */
+class GorillaBlock {
+private:
+    std::vector<uint8_t> data_;
+    size_t bit_count_;
+    size_t count_;
+    long long first_timestamp_;
+    long long last_timestamp_;
+    long long last_delta_;
+    uint64_t last_value_bits_;
+    int last_leading_zeros_;
+    int last_trailing_zeros_;
+
+public:
+    GorillaBlock();
+
+    /**
+     * @brief Append a sample
+     * @param timestamp Seconds since epoch (not earlier than the last sample)
+     * @param value Sample value
+     * @return false if the timestamp is earlier than the last sample
+     */
+    bool append(long long timestamp, double value);
+
+    /**
+     * @brief Decode samples in order
+     * @param visitor Function called for each sample; return false to stop
+     */
+    void forEach(const std::function<bool(const TimeSeriesPoint&)>& visitor) const;
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    long long getFirstTimestamp() const { return first_timestamp_; }
+    long long getLastTimestamp() const { return last_timestamp_; }
+
+    /**
+     * @brief Get encoded size
+     * @return Bytes used by the bit stream
+     */
+    size_t getByteSize() const { return data_.size(); }
+
+private:
+    void writeBits(uint64_t value, int bit_count);
+};
+
+/**
+ * @brief Compressed time series with hourly and daily rollups
+ *
+ * Raw samples live in a chain of Gorilla blocks; hourly and daily rollups
+ * are maintained on append so long-range charts read a few hundred rollups
+ * instead of decoding every sample. Not thread-safe; see TimeSeriesStore.
+ */
+class TimeSeries {
+private:
+    std::vector<GorillaBlock> blocks_;
+    std::vector<TimeSeriesRollup> hourly_;
+    std::vector<TimeSeriesRollup> daily_;
+    size_t block_capacity_;
+    size_t point_count_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param block_capacity Samples per compressed block
+     */
+    explicit TimeSeries(size_t block_capacity = 1024);
+
+    /**
+     * @brief Append a sample; earlier timestamps are clamped to the last one
+     * @param timestamp Seconds since epoch
+     * @param value Sample value
+     */
+    void append(long long timestamp, double value);
+
+    /**
+     * @brief Get raw samples within a range
+     * @param start Range start, seconds since epoch (inclusive)
+     * @param end Range end, seconds since epoch (inclusive)
+     * @return Samples in time order
+     */
+    std::vector<TimeSeriesPoint> getPoints(long long start, long long end) const;
+
+    /**
+     * @brief Get dense per-bucket rollups within a range
+     * @param start Range start, seconds since epoch (inclusive)
+     * @param end Range end, seconds since epoch (inclusive)
+     * @param granularity HOUR, DAY, or WEEK (derived from daily rollups)
+     * @return One rollup per bucket from the first sample (or range start) to
+     *         the range end, capped at the current time
+     */
+    std::vector<TimeSeriesRollup> getRollups(long long start, long long end,
+                                             BucketGranularity granularity) const;
+
+    size_t size() const { return point_count_; }
+
+    /**
+     * @brief Get memory used by compressed samples
+     * @return Bytes used by all blocks' bit streams
+     */
+    size_t getCompressedBytes() const;
+
+private:
+    static void addToRollups(std::vector<TimeSeriesRollup>& rollups, long long bucket_start, double value);
+};
+
+/**
+ * @brief Thread-safe collection of named time series
+ */
+class TimeSeriesStore {
+private:
+    std::unordered_map<std::string, TimeSeries> series_;
+    mutable std::mutex store_mutex_;
+
+public:
+    TimeSeriesStore() = default;
+
+    // Disable copy constructor and assignment operator due to mutex
+    TimeSeriesStore(const TimeSeriesStore&) = delete;
+    TimeSeriesStore& operator=(const TimeSeriesStore&) = delete;
+
+    /**
+     * @brief Record a sample, creating the series if needed
+     * @param key Series name
+     * @param time_point Sample time
+     * @param value Sample value
+     */
+    void record(const std::string& key, const std::chrono::system_clock::time_point& time_point, double value);
+
+    /**
+     * @brief Check whether a series exists
+     * @param key Series name
+     * @return true if at least one sample was recorded
+     */
+    bool hasSeries(const std::string& key) const;
+
+    /**
+     * @brief Get raw samples of a series within a range
+     * @return Samples in time order (empty if the series does not exist)
+     */
+    std::vector<TimeSeriesPoint> getPoints(const std::string& key,
+                                           const std::chrono::system_clock::time_point& start,
+                                           const std::chrono::system_clock::time_point& end) const;
+
+    /**
+     * @brief Get dense rollups of a series within a range
+     * @return Rollups in time order (empty if the series does not exist)
+     */
+    std::vector<TimeSeriesRollup> getRollups(const std::string& key,
+                                             const std::chrono::system_clock::time_point& start,
+                                             const std::chrono::system_clock::time_point& end,
+                                             BucketGranularity granularity) const;
+
+    size_t getSeriesCount() const;
+    size_t getPointCount() const;
+    size_t getCompressedBytes() const;
+};
+
+} // namespace quirkventory
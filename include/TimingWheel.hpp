@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief Hierarchical timing wheel for large numbers of timers
+ *
+ * Timers are kept in LEVELS wheels of SLOTS slots each. Level 0 holds timers
+ * due within the current SLOTS-tick window at one-tick resolution. Each
+ * higher level covers SLOTS times the span of the one below. When a lower
+ * wheel wraps, the next slot of the level above is cascaded down. Each
+ * timer is therefore touched at most once per level, which makes
+ * scheduling O(1) and expiry O(1) amortized, and there are never full
+ * scans of outstanding timers.
+ *
+ * Timers are identified by caller-chosen 64-bit ids. There is no cancel
+ * operation: callers drop cancelled ids from their own tables and ignore
+ * them when they fire. Ticks are abstract; the owner maps them to time.
+ * Not thread-safe.
+ */
+class TimingWheel {
+public:
+    static constexpr int SLOT_BITS = 8;
+    static constexpr size_t SLOTS = size_t(1) << SLOT_BITS;
+    static constexpr int LEVELS = 4;     // 2^32 ticks before timers overflow
+
+private:
+    struct Entry {
+        uint64_t id;
+        uint64_t expiry_tick;
+    };
+
+    std::vector<std::vector<Entry>> slots_;  // LEVELS * SLOTS, level-major
+    std::vector<Entry> overflow_;            // Beyond the top level's span
+    uint64_t current_tick_;
+    size_t size_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param start_tick Tick the wheel starts at
+     */
+    explicit TimingWheel(uint64_t start_tick = 0);
+
+    /**
+     * @brief Schedule a timer
+     * @param id Caller-chosen timer id
+     * @param expiry_tick Tick at which the timer fires (past ticks fire on the next advance)
+     */
+    void schedule(uint64_t id, uint64_t expiry_tick);
+
+    /**
+     * @brief Advance the wheel, firing every timer that has come due
+     * @param now_tick Tick to advance to (no-op if not after the current tick)
+     * @param on_expired Called with each expired timer's id
+     * @return Number of timers fired
+     */
+    size_t advance(uint64_t now_tick, const std::function<void(uint64_t)>& on_expired);
+
+    uint64_t getCurrentTick() const { return current_tick_; }
+
+    /**
+     * @brief Get number of scheduled timers
+     * @return Timers not yet fired
+     */
+    size_t size() const { return size_; }
+
+private:
+    /**
+     * @brief Place an entry relative to the current tick
+     */
+    void insert(const Entry& entry);
+
+    /**
+     * @brief Move one slot's entries down to lower levels
+     */
+    void cascade(int level, size_t slot);
+};
+
+} // namespace quirkventory
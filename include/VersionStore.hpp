@@ -0,0 +1,281 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief One committed state of a product
+ */
+struct ProductVersion {
+    uint64_t commit = 0;                                    // Commit that wrote this state
+    std::chrono::system_clock::time_point committed_at;
+    bool removed = false;                                   // Tombstone written when the product was removed
+    std::string id;
+    std::string name;
+    std::string category;
+    double price = 0.0;
+    int quantity = 0;
+    int low_stock_threshold = 0;
+    uint64_t product_version = 0;                           // Product::getVersion() of this state
+    bool perishable = false;
+    std::chrono::system_clock::time_point expiry_date;      // Only meaningful if perishable
+
+    // Next older state; only accessed with std::atomic_load/store since GC cuts it
+    mutable std::shared_ptr<const ProductVersion> older;
+};
+
+/**
+ * @brief Multi-version store of product states for point-in-time reads
+ *
+ * Every product maps to a chain of immutable versions, newest first. Writers
+ * append a new version instead of changing one in place, so readers never
+ * wait for writers: a reader pins a view (a commit number, and for as-of
+ * views a time) and walks each chain to the newest version visible to it.
+ * A commit becomes visible only once all of its versions are linked, and
+ * versions appended inside a Group share one commit, so a view never sees
+ * half of a multi-product change.
+ *
+ * History is trimmed by collectGarbage(): versions that no open view can
+ * see and that are older than the retention window are dropped. As-of
+ * views may therefore only be opened for times within the window.
+ *
+ * Writers must be serialized by the caller (Inventory appends under its
+ * own lock); readers and collectGarbage() may run concurrently with them.
+ */
+class VersionStore {
+public:
+    using Clock = std::chrono::system_clock;
+    using VersionPtr = std::shared_ptr<const ProductVersion>;
+
+    /**
+     * @brief Pinned read position; keeps the versions it can see from collection
+     *
+     * Movable RAII handle: the pin is released when the view is destroyed.
+     */
+    class ReadView {
+    private:
+        friend class VersionStore;
+
+        const VersionStore* store_ = nullptr;
+        uint64_t commit_ = 0;
+        Clock::time_point time_;
+        std::multiset<uint64_t>::iterator commit_pin_;
+        std::multiset<Clock::time_point>::iterator time_pin_;
+
+    public:
+        ReadView() = default;
+        ReadView(ReadView&& other) noexcept;
+        ReadView& operator=(ReadView&& other) noexcept;
+        ~ReadView();
+
+        ReadView(const ReadView&) = delete;
+        ReadView& operator=(const ReadView&) = delete;
+
+        /**
+         * @brief Check whether the view is open
+         * @return false for default-constructed, moved-from or refused views
+         */
+        bool valid() const { return store_ != nullptr; }
+
+        /**
+         * @brief Get the newest commit visible to the view
+         */
+        uint64_t getCommit() const { return commit_; }
+
+        /**
+         * @brief Get the point in time the view reads at
+         * @return As-of time, or Clock::time_point::max() for views of the latest commit
+         */
+        Clock::time_point getTime() const { return time_; }
+
+        /**
+         * @brief Release the pin early
+         */
+        void release();
+    };
+
+    /**
+     * @brief Makes every version appended during its lifetime part of one commit
+     *
+     * Null-safe so callers can pass a store that may not exist.
+     */
+    class Group {
+    private:
+        VersionStore* store_;
+
+    public:
+        explicit Group(VersionStore* store) : store_(store) {
+            if (store_) {
+                store_->beginGroup();
+            }
+        }
+        ~Group() {
+            if (store_) {
+                store_->endGroup();
+            }
+        }
+
+        Group(const Group&) = delete;
+        Group& operator=(const Group&) = delete;
+    };
+
+private:
+    std::unordered_map<std::string, VersionPtr> heads_;
+    mutable std::shared_mutex heads_mutex_;     // Exclusive only to add or erase chains
+    std::chrono::milliseconds retention_;
+
+    // Writer state (writers are serialized by the caller)
+    uint64_t last_commit_;
+    Clock::time_point last_commit_time_;
+    int group_depth_;
+    bool group_has_commit_;
+    std::atomic<uint64_t> published_commit_;
+
+    // Open views and the start of the retained history
+    mutable std::mutex pins_mutex_;
+    mutable std::multiset<uint64_t> pinned_commits_;
+    mutable std::multiset<Clock::time_point> pinned_times_;
+    Clock::time_point history_start_;
+
+    std::atomic<uint64_t> version_count_;
+    std::atomic<uint64_t> collected_count_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param retention How far back as-of views can reach
+     * @throws std::invalid_argument if retention is negative
+     */
+    explicit VersionStore(std::chrono::milliseconds retention);
+
+    /**
+     * @brief Destructor - tears chains down iteratively
+     */
+    ~VersionStore();
+
+    // Disable copy constructor and assignment operator
+    VersionStore(const VersionStore&) = delete;
+    VersionStore& operator=(const VersionStore&) = delete;
+
+    /**
+     * @brief Record the initial state as the first commit
+     * @param versions One version per existing product
+     *
+     * Stamped with the store's creation time, which is where its history
+     * starts. Must be called once, before any append().
+     */
+    void seed(std::vector<std::shared_ptr<ProductVersion>> versions);
+
+    /**
+     * @brief Append a new state of a product
+     * @param version New state; commit, committed_at and older are filled in
+     */
+    void append(std::shared_ptr<ProductVersion> version);
+
+    /**
+     * @brief Start a group of appends sharing one commit (nestable)
+     */
+    void beginGroup();
+
+    /**
+     * @brief End a group; publishes its commit once the outermost group ends
+     */
+    void endGroup();
+
+    /**
+     * @brief Open a view of the latest published commit
+     * @return Open view
+     */
+    ReadView openLatest() const;
+
+    /**
+     * @brief Open a view of the state at a point in time
+     * @param as_of Time to read at
+     * @return Open view, or an invalid one if as_of is before the retained history
+     */
+    ReadView openAsOf(Clock::time_point as_of) const;
+
+    /**
+     * @brief Get the version of a product visible to a view
+     * @param view Open view
+     * @param product_id ID of the product
+     * @return Visible version, or nullptr if the product did not exist for the view
+     */
+    VersionPtr find(const ReadView& view, const std::string& product_id) const;
+
+    /**
+     * @brief Get the versions of all products visible to a view
+     * @param view Open view
+     * @return One version per product that existed for the view (unordered)
+     */
+    std::vector<VersionPtr> collect(const ReadView& view) const;
+
+    /**
+     * @brief Drop versions no open view can see and outside the retention window
+     * @return Number of versions dropped
+     */
+    size_t collectGarbage();
+
+    /**
+     * @brief Get number of versions currently retained
+     */
+    uint64_t getVersionCount() const { return version_count_.load(); }
+
+    /**
+     * @brief Get number of versions dropped by collectGarbage()
+     */
+    uint64_t getCollectedCount() const { return collected_count_.load(); }
+
+    /**
+     * @brief Get the newest commit visible to new views
+     */
+    uint64_t getLatestCommit() const { return published_commit_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Get number of open views
+     */
+    size_t getOpenViewCount() const;
+
+    /**
+     * @brief Get the earliest time as-of views can be opened for
+     */
+    Clock::time_point getHistoryStart() const;
+
+    /**
+     * @brief Get the retention window
+     */
+    std::chrono::milliseconds getRetention() const { return retention_; }
+
+private:
+    /**
+     * @brief Take the commit number and time for the next append (writer side)
+     */
+    void assignCommit(ProductVersion& version);
+
+    void publish(uint64_t commit);
+
+    void releaseView(ReadView& view) const;
+
+    /**
+     * @brief Walk a chain to the newest version visible to a view
+     */
+    static VersionPtr visibleVersion(VersionPtr version, uint64_t commit, Clock::time_point time);
+
+    /**
+     * @brief Free a detached chain one version at a time
+     * @return Number of versions freed
+     */
+    static size_t destroyChain(VersionPtr chain);
+};
+
+} // namespace quirkventory
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "Codec.hpp"
+#include "VersionStore.hpp"
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+namespace quirkventory {
+
+/**
+ * @brief Framed binary messages over sockets, shared by replication, cluster mode and RPC
+ *
+ * A message is a 4-byte little-endian length, a type byte and a body
+ * encoded with ByteWriter; the length covers the type byte and the body.
+ * Sockets are plain blocking descriptors (IPv4 TCP or Unix domain); -1
+ * means no socket.
+ */
+namespace Wire {
+    /**
+     * @brief Outcome of receiveMessage
+     */
+    enum class ReceiveResult {
+        MESSAGE,
+        TIMEOUT,    // Nothing arrived in time
+        CLOSED      // Peer closed the connection, it failed, or the frame was invalid
+    };
+
+    /**
+     * @brief Send one message
+     * @param fd Connected socket
+     * @param type Message type
+     * @param body Encoded body
+     * @return false if the connection failed
+     */
+    bool sendMessage(int fd, uint8_t type, const ByteWriter& body);
+
+    /**
+     * @brief Wait for a message and read all of it
+     * @param fd Connected socket
+     * @param timeout How long to wait for the message to start arriving
+     * @param type Receives the message type
+     * @param body Receives the body
+     * @return MESSAGE, TIMEOUT or CLOSED
+     */
+    ReceiveResult receiveMessage(int fd, std::chrono::milliseconds timeout,
+                                 uint8_t& type, std::vector<uint8_t>& body);
+
+    /**
+     * @brief Append one framed message to a buffer, to send several with one write
+     * @param frames Buffer to append to
+     * @param type Message type
+     * @param body Encoded body
+     */
+    void appendMessage(std::vector<uint8_t>& frames, uint8_t type, const ByteWriter& body);
+
+    /**
+     * @brief Send a buffer of frames built with appendMessage
+     * @return false if the connection failed
+     */
+    bool sendFrames(int fd, const std::vector<uint8_t>& frames);
+
+    /**
+     * @brief Reads messages through a buffer, so pipelined messages cost one read together
+     */
+    class FrameReader {
+    private:
+        std::vector<uint8_t> buffer_;
+        size_t start_ = 0;      // First unread byte
+        bool invalid_ = false;  // A frame had an impossible length
+
+    public:
+        /**
+         * @brief Wait for data and read whatever has arrived
+         * @param fd Connected socket
+         * @param timeout How long to wait for data
+         * @return MESSAGE if bytes were read, TIMEOUT, or CLOSED
+         */
+        ReceiveResult fill(int fd, std::chrono::milliseconds timeout);
+
+        /**
+         * @brief Take the next complete message from the buffer
+         * @param type Receives the message type
+         * @param body Receives the body
+         * @return false if no complete message is buffered (or the stream is invalid)
+         */
+        bool next(uint8_t& type, std::vector<uint8_t>& body);
+
+        /**
+         * @brief Check whether the stream held an invalid frame; the connection should be dropped
+         */
+        bool isInvalid() const { return invalid_; }
+    };
+
+    /**
+     * @brief Open a listening socket
+     * @param address IPv4 address to bind
+     * @param port Port to bind (0 picks a free one); receives the bound port
+     * @return Listening socket, or -1 on failure
+     */
+    int listenTcp(const std::string& address, uint16_t& port);
+
+    /**
+     * @brief Open a listening Unix domain socket
+     * @param path Socket path; a stale socket file there is replaced
+     * @return Listening socket, or -1 on failure (including a non-socket file at path)
+     */
+    int listenUnix(const std::string& path);
+
+    /**
+     * @brief Accept one connection on a TCP or Unix domain listening socket
+     * @param listen_fd Listening socket
+     * @param timeout How long to wait for a connection
+     * @param peer Receives the peer's IP:port, or "unix" for a Unix domain socket
+     * @return Connected socket, or -1 if none arrived in time
+     */
+    int acceptConnection(int listen_fd, std::chrono::milliseconds timeout, std::string& peer);
+
+    /**
+     * @brief Connect to a server
+     * @param host IPv4 address
+     * @param port Port
+     * @return Connected socket, or -1 on failure
+     */
+    int connectTcp(const std::string& host, uint16_t port);
+
+    /**
+     * @brief Connect to a Unix domain socket
+     * @param path Socket path
+     * @return Connected socket, or -1 on failure
+     */
+    int connectUnix(const std::string& path);
+
+    /**
+     * @brief Wake up any thread blocked on the socket (it sees CLOSED)
+     */
+    void shutdownSocket(int fd);
+
+    /**
+     * @brief Close a socket; ignores -1
+     */
+    void closeSocket(int fd);
+
+    /**
+     * @brief Check that a string is a dotted IPv4 address
+     */
+    bool isIPv4Address(const std::string& host);
+
+    /**
+     * @brief Encode a product state
+     */
+    void putProduct(ByteWriter& writer, const ProductVersion& product);
+
+    /**
+     * @brief Decode a product state written by putProduct
+     * @return false if the input is truncated
+     */
+    bool getProduct(ByteReader& reader, ProductVersion& product);
+}
+
+} // namespace quirkventory
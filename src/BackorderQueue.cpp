@@ -0,0 +1,126 @@
+#include "../include/BackorderQueue.hpp"
+#include "../include/Order.hpp"
+#include "../include/Inventory.hpp"
+#include <algorithm>
+#include <climits>
+
+namespace quirkventory {
+
+BackorderQueue::BackorderQueue()
+    : next_ticket_(1), units_allocated_(0) {
+}
+
+void BackorderQueue::enqueue(Order& order) {
+    auto items = order.getItems();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t ticket = next_ticket_++;
+    size_t open_lines = 0;
+
+    for (const auto& item : items) {
+        if (item.backordered <= 0) {
+            continue;
+        }
+        ProductQueue& queue = queues_[item.product_id];
+        queue.lines.push_back(Line{&order, ticket, item.backordered});
+        queue.demand += item.backordered;
+        open_lines++;
+    }
+
+    // A re-queued order gets a new ticket, which retires any older lines
+    if (open_lines > 0) {
+        waiting_[&order] = WaitingOrder{ticket, open_lines};
+    }
+}
+
+void BackorderQueue::cancel(const Order& order) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    waiting_.erase(&order);
+}
+
+int BackorderQueue::match(const std::string& product_id, Inventory& inventory) {
+    int allocated = 0;
+    int leftover = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto queue_it = queues_.find(product_id);
+        if (queue_it == queues_.end()) {
+            return 0;
+        }
+        ProductQueue& queue = queue_it->second;
+
+        int wanted = static_cast<int>(std::min<long long>(queue.demand, INT_MAX));
+        int left = inventory.takeAvailableQuantity(product_id, wanted);
+
+        while (left > 0 && !queue.lines.empty()) {
+            Line& line = queue.lines.front();
+
+            // Only dereference orders whose ticket is still live
+            int filled = 0;
+            auto waiting_it = waiting_.find(line.order);
+            if (waiting_it != waiting_.end() && waiting_it->second.ticket == line.ticket) {
+                filled = line.order->fillBackorder(product_id, std::min(left, line.remaining));
+            }
+
+            if (filled == 0) {
+                // Retired, or the order left BACKORDERED: discard the line
+                queue.demand -= line.remaining;
+                closeLineLocked(line);
+                queue.lines.pop_front();
+                continue;
+            }
+
+            left -= filled;
+            allocated += filled;
+            line.remaining -= filled;
+            queue.demand -= filled;
+            if (line.remaining == 0) {
+                closeLineLocked(line);
+                queue.lines.pop_front();
+            }
+        }
+
+        if (queue.lines.empty()) {
+            queues_.erase(queue_it);
+        }
+        units_allocated_ += allocated;
+        leftover = left;
+    }
+
+    // Stock taken for discarded lines goes back; this may start another
+    // pass through the restock listener, which now sees accurate demand
+    if (leftover > 0) {
+        inventory.addQuantity(product_id, leftover);
+    }
+
+    return allocated;
+}
+
+long long BackorderQueue::getWaitingQuantity(const std::string& product_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = queues_.find(product_id);
+    return it != queues_.end() ? it->second.demand : 0;
+}
+
+size_t BackorderQueue::getWaitingOrderCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return waiting_.size();
+}
+
+long long BackorderQueue::getUnitsAllocated() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return units_allocated_;
+}
+
+void BackorderQueue::closeLineLocked(const Line& line) {
+    auto it = waiting_.find(line.order);
+    if (it == waiting_.end() || it->second.ticket != line.ticket) {
+        return;
+    }
+    if (--it->second.open_lines == 0) {
+        waiting_.erase(it);
+    }
+}
+
+} // namespace quirkventory
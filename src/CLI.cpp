@@ -1,9 +1,9 @@
 #include "../include/CLI.hpp"
+#include "../include/IdGenerator.hpp"
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
 #include <regex>
-#include <random>
 #include <chrono>
 #include <climits>
 #include <cfloat>
@@ -30,10 +30,16 @@ bool CLI::initialize() {
     try {
         // Initialize system components
         inventory_ = std::make_unique<Inventory>(5); // Low stock threshold of 5
-        order_manager_ = std::make_unique<OrderManager>();
+        order_manager_ = std::make_unique<OrderManager>(inventory_.get());
         user_manager_ = std::make_unique<UserManager>();
         notification_manager_ = std::make_unique<NotificationManager>();
 
+        // Run hold expiry and stock checks in the background. Order clearing
+        // and notifications stay on the command thread: commands keep raw Order
+        // pointers, and NotificationManager is not thread-safe
+        scheduler_ = std::make_unique<Scheduler>();
+        scheduleInventoryMaintenance(*scheduler_, *inventory_, nullptr, nullptr);
+
         // Setup CLI commands
         setupCommands();
 
@@ -43,6 +49,8 @@ bool CLI::initialize() {
         // Load sample data
         loadSampleData();
 
+        scheduler_->start();
+
         output_stream_ << "System initialized successfully!" << std::endl;
         return true;
     } catch (const std::exception& e) {
@@ -74,6 +82,7 @@ void CLI::run() {
         }
     }
 
+    scheduler_->stop();
     output_stream_ << "Thank you for using the Inventory Management System!" << std::endl;
 }
 
@@ -252,6 +261,10 @@ void CLI::setupCommands() {
         std::vector<std::string>{"VIEW_REPORTS"}, 
         [this]() { handleSystemStatus(); });
     
+    commands_.emplace_back("maintenance", "View background maintenance jobs", 
+        std::vector<std::string>{"VIEW_REPORTS"}, 
+        [this]() { handleMaintenanceStatus(); });
+    
     // System Commands
     commands_.emplace_back("help", "Show this help message", 
         std::vector<std::string>{}, 
@@ -446,6 +459,73 @@ void CLI::handleAddProduct() {
     pauseForInput();
 }
 
+void CLI::handleUpdateProduct() {
+    clearScreen();
+    output_stream_ << "=== UPDATE PRODUCT ===" << std::endl;
+    
+    std::string id = getStringInput("Product ID: ");
+    const Product* product = inventory_->getProduct(id);
+    if (!product) {
+        displayError("Product not found.");
+        pauseForInput();
+        return;
+    }
+    
+    // Remember what the edits are based on so a concurrent change is not overwritten
+    uint64_t read_version = product->getVersion();
+    output_stream_ << product->getInfo() << std::endl;
+    output_stream_ << "Leave a field blank to keep its current value." << std::endl;
+    
+    ProductUpdate update;
+    std::string name = getStringInput("Name [" + product->getName() + "]: ", false);
+    if (!name.empty()) {
+        update.name = name;
+    }
+    std::string category = getStringInput("Category [" + product->getCategory() + "]: ", false);
+    if (!category.empty()) {
+        update.category = category;
+    }
+    try {
+        std::string price = getStringInput("Price [" + CLIUtils::formatCurrency(product->getPrice()) + "]: ", false);
+        if (!price.empty()) {
+            update.price = std::stod(price);
+        }
+        std::string quantity = getStringInput("Quantity [" + std::to_string(product->getQuantity()) + "]: ", false);
+        if (!quantity.empty()) {
+            update.quantity = std::stoi(quantity);
+        }
+    } catch (const std::exception&) {
+        displayError("Invalid number.");
+        pauseForInput();
+        return;
+    }
+    
+    if (update.empty()) {
+        displayInfo("Nothing changed.");
+        pauseForInput();
+        return;
+    }
+    
+    uint64_t version;
+    switch (inventory_->updateProduct(id, update, read_version, version)) {
+        case ProductUpdateResult::UPDATED:
+            displaySuccess("Product updated successfully.");
+            break;
+        case ProductUpdateResult::NOT_FOUND:
+            displayError("Product was removed meanwhile.");
+            break;
+        case ProductUpdateResult::VERSION_MISMATCH:
+            displayError("Product was changed by someone else meanwhile; no changes were saved. "
+                         "Run update-product again to edit the current values.");
+            break;
+        case ProductUpdateResult::INVALID:
+            displayError("Invalid product data: name must be non-empty, price and quantity non-negative.");
+            break;
+    }
+    
+    pauseForInput();
+}
+
 void CLI::handleViewProducts() {
     clearScreen();
     output_stream_ << "=== PRODUCT LIST ===" << std::endl;
@@ -469,6 +549,27 @@ void CLI::handleViewInventory() {
     pauseForInput();
 }
 
+void CLI::handleMaintenanceStatus() {
+    clearScreen();
+    output_stream_ << "=== BACKGROUND MAINTENANCE ===" << std::endl;
+    
+    std::vector<int> widths = {26, 10, 8, 8, 9, 12, 12};
+    printTableHeader({"Job", "Interval", "Runs", "Skipped", "Failures", "Avg (ms)", "Max (ms)"}, widths);
+    
+    for (const auto& stats : scheduler_->getAllJobStats()) {
+        std::ostringstream interval, average, maximum;
+        interval << stats.interval.count() / 1000.0 << "s";
+        average << std::fixed << std::setprecision(2) << stats.getAverageMicros() / 1000.0;
+        maximum << std::fixed << std::setprecision(2) << stats.max_duration.count() / 1000.0;
+        
+        printTableRow({stats.name, interval.str(), std::to_string(stats.runs),
+                       std::to_string(stats.skipped), std::to_string(stats.failures),
+                       average.str(), maximum.str()}, widths);
+    }
+    
+    pauseForInput();
+}
+
 void CLI::handleCreateOrder() {
     clearScreen();
     output_stream_ << "=== CREATE NEW ORDER ===" << std::endl;
@@ -752,14 +853,7 @@ std::string toLowerCase(const std::string& str) {
 }
 
 std::string generateId(const std::string& prefix) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(1000, 9999);
-    
-    auto now = std::chrono::system_clock::now();
-    auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
-    
-    return prefix + std::to_string(timestamp % 100000) + std::to_string(dis(gen));
+    return IdGenerator::getShared().nextString(prefix);
 }
 
 std::chrono::system_clock::time_point parseDate(const std::string& date_str) {
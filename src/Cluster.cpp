@@ -0,0 +1,732 @@
+#include "../include/Cluster.hpp"
+#include "../include/Wire.hpp"
+#include <map>
+#include <stdexcept>
+#include <algorithm>
+
+namespace quirkventory {
+
+namespace {
+
+using namespace std::chrono;
+
+// How often the accept loop checks for shutdown
+constexpr milliseconds kPollInterval(200);
+
+// Prepared holds wait for the coordinator's decision rather than expire
+constexpr milliseconds kPreparedHoldTtl = Inventory::MAX_HOLD_TTL;
+
+// Aborts of transactions not (yet) prepared that a node remembers
+constexpr size_t kMaxEarlyAborts = 65536;
+
+// Pause between redelivery attempts of undelivered commit and abort decisions
+constexpr milliseconds kDecisionRetryInterval(200);
+
+// Requests of the cluster protocol (framed by Wire); replies reuse the request's type
+enum class RequestType : uint8_t {
+    ADD_PRODUCT = 1,        // Product state
+    GET_PRODUCT = 2,        // Product ID -> product state
+    ADD_QUANTITY = 3,       // Product ID, amount
+    REMOVE_QUANTITY = 4,    // Product ID, amount
+    REMOVE_PRODUCT = 5,     // Product ID
+    RESERVE = 6,            // Lines; reserved at once (single-node orders)
+    PREPARE = 7,            // Transaction ID, lines
+    COMMIT = 8,             // Transaction ID
+    ABORT = 9,              // Transaction ID
+    STATS = 10              // -> node counters
+};
+
+// Every reply body starts with the status byte
+enum class ReplyStatus : uint8_t {
+    OK = 0,
+    NOT_FOUND = 1,
+    REJECTED = 2
+};
+
+using Lines = std::vector<std::pair<std::string, int>>;
+
+uint64_t hashString(const std::string& value) {
+    // FNV-1a: stable across processes and builds, unlike std::hash
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : value) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t mix(uint64_t value) {
+    // splitmix64 finalizer
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+void putLines(ByteWriter& writer, const Lines& lines) {
+    writer.putVarUInt(lines.size());
+    for (const auto& line : lines) {
+        writer.putString(line.first);
+        writer.putVarInt(line.second);
+    }
+}
+
+bool getLines(ByteReader& reader, Lines& lines) {
+    uint64_t count;
+    if (!reader.getVarUInt(count)) {
+        return false;
+    }
+    for (uint64_t i = 0; i < count; ++i) {
+        std::string product_id;
+        int64_t quantity;
+        if (!reader.getString(product_id) || !reader.getVarInt(quantity)) {
+            return false;
+        }
+        lines.emplace_back(std::move(product_id), static_cast<int>(quantity));
+    }
+    return true;
+}
+
+void putStatus(ByteWriter& writer, ReplyStatus status) {
+    writer.putUInt8(static_cast<uint8_t>(status));
+}
+
+ReplyStatus statusOf(bool ok) {
+    return ok ? ReplyStatus::OK : ReplyStatus::REJECTED;
+}
+
+} // namespace
+
+// ClusterPartitioner Implementation
+
+ClusterPartitioner::ClusterPartitioner(size_t node_count) : node_count_(node_count) {
+    if (node_count == 0) {
+        throw std::invalid_argument("Cluster needs at least one node");
+    }
+}
+
+size_t ClusterPartitioner::ownerOf(const std::string& product_id) const {
+    uint64_t key = hashString(product_id);
+    size_t owner = 0;
+    uint64_t best = 0;
+    for (size_t node = 0; node < node_count_; ++node) {
+        uint64_t score = mix(key ^ mix(node + 1));
+        if (node == 0 || score > best) {
+            best = score;
+            owner = node;
+        }
+    }
+    return owner;
+}
+
+// ClusterNode Implementation
+
+ClusterNode::ClusterNode(Inventory& inventory, uint16_t port, const std::string& bind_address)
+    : inventory_(inventory), bind_address_(bind_address), port_(port),
+      listen_fd_(-1), running_(false), requests_(0), committed_(0), aborted_(0) {
+}
+
+ClusterNode::~ClusterNode() {
+    stop();
+}
+
+bool ClusterNode::start() {
+    if (running_.load()) {
+        return false;
+    }
+
+    uint16_t port = port_;
+    listen_fd_ = Wire::listenTcp(bind_address_, port);
+    if (listen_fd_ < 0) {
+        return false;
+    }
+    port_ = port;
+    running_.store(true);
+    accept_thread_ = std::thread(&ClusterNode::acceptLoop, this);
+    return true;
+}
+
+void ClusterNode::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (accept_thread_.joinable()) {
+        accept_thread_.join();
+    }
+    Wire::closeSocket(listen_fd_);
+    listen_fd_ = -1;
+
+    std::vector<std::unique_ptr<Session>> sessions;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        for (auto& session : sessions_) {
+            Wire::shutdownSocket(session->fd);
+        }
+        sessions.swap(sessions_);
+    }
+    for (auto& session : sessions) {
+        session->thread.join();
+        Wire::closeSocket(session->fd);
+    }
+}
+
+ClusterNodeStats ClusterNode::getStats() const {
+    ClusterNodeStats stats;
+    stats.product_count = inventory_.getTotalProductCount();
+    stats.requests = requests_.load();
+    {
+        std::lock_guard<std::mutex> lock(prepared_mutex_);
+        stats.prepared = prepared_.size();
+    }
+    stats.committed = committed_.load();
+    stats.aborted = aborted_.load();
+    return stats;
+}
+
+void ClusterNode::acceptLoop() {
+    while (running_.load()) {
+        reapSessions();
+
+        std::string peer;
+        int fd = Wire::acceptConnection(listen_fd_, kPollInterval, peer);
+        if (fd < 0) {
+            continue;
+        }
+
+        auto session = std::make_unique<Session>();
+        session->fd = fd;
+
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        Session& added = *session;
+        sessions_.push_back(std::move(session));
+        added.thread = std::thread(&ClusterNode::serve, this, std::ref(added));
+    }
+}
+
+void ClusterNode::serve(Session& session) {
+    uint8_t type;
+    std::vector<uint8_t> body;
+    while (running_.load()) {
+        Wire::ReceiveResult result = Wire::receiveMessage(session.fd, kPollInterval, type, body);
+        if (result == Wire::ReceiveResult::TIMEOUT) {
+            continue;
+        }
+        ByteWriter reply;
+        if (result == Wire::ReceiveResult::CLOSED || !handle(type, body, reply) ||
+            !Wire::sendMessage(session.fd, type, reply)) {
+            break;
+        }
+    }
+    session.finished.store(true);
+}
+
+bool ClusterNode::handle(uint8_t type, const std::vector<uint8_t>& body, ByteWriter& reply) {
+    requests_.fetch_add(1);
+    ByteReader reader(body);
+    std::string product_id;
+    int64_t amount;
+    uint64_t transaction_id;
+    Lines lines;
+
+    switch (static_cast<RequestType>(type)) {
+        case RequestType::ADD_PRODUCT: {
+            ProductVersion state;
+            if (!Wire::getProduct(reader, state)) {
+                return false;
+            }
+            try {
+                // Same convention as replication: products that do not perish get a far-off date
+                auto expiry = state.perishable ? state.expiry_date : PerishableProduct::farFutureExpiry();
+                putStatus(reply, statusOf(inventory_.addProduct(PerishableProduct::restore(
+                    state.id, state.name, state.category, state.price, state.quantity, expiry, 1))));
+            } catch (const std::exception&) {
+                putStatus(reply, ReplyStatus::REJECTED);
+            }
+            return true;
+        }
+        case RequestType::GET_PRODUCT: {
+            ProductVersion state;
+            if (!reader.getString(product_id)) {
+                return false;
+            }
+            if (!inventory_.getProductState(product_id, state)) {
+                putStatus(reply, ReplyStatus::NOT_FOUND);
+                return true;
+            }
+            putStatus(reply, ReplyStatus::OK);
+            Wire::putProduct(reply, state);
+            return true;
+        }
+        case RequestType::ADD_QUANTITY:
+        case RequestType::REMOVE_QUANTITY: {
+            if (!reader.getString(product_id) || !reader.getVarInt(amount)) {
+                return false;
+            }
+            if (!inventory_.getProduct(product_id)) {
+                putStatus(reply, ReplyStatus::NOT_FOUND);
+                return true;
+            }
+            int quantity = static_cast<int>(amount);
+            bool done = static_cast<RequestType>(type) == RequestType::ADD_QUANTITY
+                ? inventory_.addQuantity(product_id, quantity)
+                : inventory_.removeQuantity(product_id, quantity);
+            putStatus(reply, statusOf(done));
+            return true;
+        }
+        case RequestType::REMOVE_PRODUCT:
+            if (!reader.getString(product_id)) {
+                return false;
+            }
+            putStatus(reply, inventory_.removeProduct(product_id) ? ReplyStatus::OK : ReplyStatus::NOT_FOUND);
+            return true;
+        case RequestType::RESERVE: {
+            if (!getLines(reader, lines)) {
+                return false;
+            }
+            std::vector<bool> reserved;
+            putStatus(reply, statusOf(inventory_.reserveBatch({lines}, reserved) == 1));
+            return true;
+        }
+        case RequestType::PREPARE:
+            if (!reader.getFixed64(transaction_id) || !getLines(reader, lines)) {
+                return false;
+            }
+            putStatus(reply, statusOf(prepare(transaction_id, lines)));
+            return true;
+        case RequestType::COMMIT:
+            if (!reader.getFixed64(transaction_id)) {
+                return false;
+            }
+            putStatus(reply, statusOf(commit(transaction_id)));
+            return true;
+        case RequestType::ABORT:
+            if (!reader.getFixed64(transaction_id)) {
+                return false;
+            }
+            abort(transaction_id);
+            putStatus(reply, ReplyStatus::OK);
+            return true;
+        case RequestType::STATS: {
+            ClusterNodeStats stats = getStats();
+            putStatus(reply, ReplyStatus::OK);
+            reply.putVarUInt(stats.product_count);
+            reply.putVarUInt(stats.requests);
+            reply.putVarUInt(stats.prepared);
+            reply.putVarUInt(stats.committed);
+            reply.putVarUInt(stats.aborted);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ClusterNode::prepare(uint64_t transaction_id, const Lines& lines) {
+    {
+        // The coordinator gave up on this prepare and already told us to abort
+        std::lock_guard<std::mutex> lock(prepared_mutex_);
+        if (early_aborts_.erase(transaction_id)) {
+            return false;
+        }
+    }
+
+    // A yes vote binds the node, so the holds last until commit or abort arrives
+    std::vector<uint64_t> hold_ids;
+    for (const auto& line : lines) {
+        uint64_t hold_id = inventory_.placeHold(line.first, line.second, kPreparedHoldTtl);
+        if (hold_id == 0) {
+            for (uint64_t placed : hold_ids) {
+                inventory_.releaseHold(placed);
+            }
+            return false;
+        }
+        hold_ids.push_back(hold_id);
+    }
+
+    {
+        // The abort may have arrived while the holds were being placed; it found
+        // nothing prepared then, so the holds are released here instead
+        std::lock_guard<std::mutex> lock(prepared_mutex_);
+        if (!early_aborts_.erase(transaction_id)) {
+            auto& prepared = prepared_[transaction_id];
+            prepared.hold_ids.insert(prepared.hold_ids.end(), hold_ids.begin(), hold_ids.end());
+            return true;
+        }
+    }
+
+    for (uint64_t hold_id : hold_ids) {
+        inventory_.releaseHold(hold_id);
+    }
+    aborted_.fetch_add(1);
+    return false;
+}
+
+bool ClusterNode::commit(uint64_t transaction_id) {
+    PreparedTransaction prepared;
+    {
+        std::lock_guard<std::mutex> lock(prepared_mutex_);
+        auto it = prepared_.find(transaction_id);
+        if (it == prepared_.end()) {
+            return false;
+        }
+        prepared = std::move(it->second);
+        prepared_.erase(it);
+    }
+
+    bool all_confirmed = true;
+    for (uint64_t hold_id : prepared.hold_ids) {
+        all_confirmed = inventory_.confirmHold(hold_id) && all_confirmed;
+    }
+    committed_.fetch_add(1);
+    return all_confirmed;
+}
+
+void ClusterNode::abort(uint64_t transaction_id) {
+    PreparedTransaction prepared;
+    {
+        std::lock_guard<std::mutex> lock(prepared_mutex_);
+        auto it = prepared_.find(transaction_id);
+        if (it == prepared_.end()) {
+            if (early_aborts_.insert(transaction_id).second) {
+                early_abort_order_.push_back(transaction_id);
+                if (early_abort_order_.size() > kMaxEarlyAborts) {
+                    early_aborts_.erase(early_abort_order_.front());
+                    early_abort_order_.pop_front();
+                }
+            }
+            return;
+        }
+        prepared = std::move(it->second);
+        prepared_.erase(it);
+    }
+
+    for (uint64_t hold_id : prepared.hold_ids) {
+        inventory_.releaseHold(hold_id);
+    }
+    aborted_.fetch_add(1);
+}
+
+void ClusterNode::reapSessions() {
+    std::vector<std::unique_ptr<Session>> finished;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        auto it = std::partition(sessions_.begin(), sessions_.end(),
+                                 [](const std::unique_ptr<Session>& session) { return !session->finished.load(); });
+        std::move(it, sessions_.end(), std::back_inserter(finished));
+        sessions_.erase(it, sessions_.end());
+    }
+    for (auto& session : finished) {
+        session->thread.join();
+        Wire::closeSocket(session->fd);
+    }
+}
+
+// ClusterRouter Implementation
+
+ClusterRouter::ClusterRouter(const std::vector<ClusterNodeAddress>& nodes, std::chrono::milliseconds timeout)
+    : partitioner_(std::max<size_t>(nodes.size(), 1)), timeout_(timeout),
+      transaction_ids_(std::random_device{}()), stopping_(false), single_node_orders_(0), cross_node_orders_(0) {
+    if (nodes.empty()) {
+        throw std::invalid_argument("Cluster needs at least one node");
+    }
+    for (const auto& address : nodes) {
+        if (!Wire::isIPv4Address(address.host)) {
+            throw std::invalid_argument("Cluster node host must be an IPv4 address: " + address.host);
+        }
+        auto connections = std::make_unique<NodeConnections>();
+        connections->address = address;
+        nodes_.push_back(std::move(connections));
+    }
+}
+
+ClusterRouter::~ClusterRouter() {
+    {
+        std::lock_guard<std::mutex> lock(decisions_mutex_);
+        stopping_ = true;
+    }
+    decisions_cv_.notify_all();
+    if (retry_thread_.joinable()) {
+        retry_thread_.join();
+    }
+
+    for (auto& node : nodes_) {
+        for (int fd : node->idle) {
+            Wire::closeSocket(fd);
+        }
+    }
+}
+
+ClusterResult ClusterRouter::addProduct(const Product& product) {
+    ProductVersion state;
+    state.id = product.getId();
+    state.name = product.getName();
+    state.category = product.getCategory();
+    state.price = product.getPrice();
+    state.quantity = product.getQuantity();
+    if (const auto* perishable = dynamic_cast<const PerishableProduct*>(&product)) {
+        state.perishable = true;
+        state.expiry_date = perishable->getExpiryDate();
+    }
+
+    ByteWriter request;
+    Wire::putProduct(request, state);
+    return callOwner(state.id, static_cast<uint8_t>(RequestType::ADD_PRODUCT), std::move(request));
+}
+
+ClusterResult ClusterRouter::getProduct(const std::string& product_id, ProductVersion& product) {
+    ByteWriter request;
+    request.putString(product_id);
+    std::vector<uint8_t> reply;
+    ClusterResult result = callOwner(product_id, static_cast<uint8_t>(RequestType::GET_PRODUCT),
+                                     std::move(request), &reply);
+    if (result == ClusterResult::OK) {
+        ByteReader reader(reply);
+        if (!Wire::getProduct(reader, product)) {
+            return ClusterResult::UNAVAILABLE;
+        }
+    }
+    return result;
+}
+
+ClusterResult ClusterRouter::addQuantity(const std::string& product_id, int amount) {
+    ByteWriter request;
+    request.putString(product_id);
+    request.putVarInt(amount);
+    return callOwner(product_id, static_cast<uint8_t>(RequestType::ADD_QUANTITY), std::move(request));
+}
+
+ClusterResult ClusterRouter::removeQuantity(const std::string& product_id, int amount) {
+    ByteWriter request;
+    request.putString(product_id);
+    request.putVarInt(amount);
+    return callOwner(product_id, static_cast<uint8_t>(RequestType::REMOVE_QUANTITY), std::move(request));
+}
+
+ClusterResult ClusterRouter::removeProduct(const std::string& product_id) {
+    ByteWriter request;
+    request.putString(product_id);
+    return callOwner(product_id, static_cast<uint8_t>(RequestType::REMOVE_PRODUCT), std::move(request));
+}
+
+ClusterOrderResult ClusterRouter::placeOrder(const Lines& lines) {
+    if (lines.empty()) {
+        return ClusterOrderResult::INVALID;
+    }
+
+    // Group lines by owning node, merging repeated products
+    std::map<size_t, std::map<std::string, int>> by_node;
+    for (const auto& line : lines) {
+        if (line.second <= 0) {
+            return ClusterOrderResult::INVALID;
+        }
+        by_node[ownerOf(line.first)][line.first] += line.second;
+    }
+
+    std::vector<Call> calls;
+    auto addCall = [&calls](size_t node, RequestType type) -> ByteWriter& {
+        calls.emplace_back();
+        calls.back().node = node;
+        calls.back().type = static_cast<uint8_t>(type);
+        return calls.back().request;
+    };
+
+    if (by_node.size() == 1) {
+        // One node decides alone, no need for two phases
+        const auto& node_lines = by_node.begin()->second;
+        putLines(addCall(by_node.begin()->first, RequestType::RESERVE), Lines(node_lines.begin(), node_lines.end()));
+        execute(calls);
+        if (calls[0].result == ClusterResult::UNAVAILABLE) {
+            return ClusterOrderResult::UNAVAILABLE;
+        }
+        if (calls[0].result != ClusterResult::OK) {
+            return ClusterOrderResult::INSUFFICIENT_STOCK;
+        }
+        single_node_orders_.fetch_add(1);
+        return ClusterOrderResult::COMMITTED;
+    }
+
+    // Phase 1: every node holds its lines
+    uint64_t transaction_id = nextTransactionId();
+    for (const auto& node : by_node) {
+        ByteWriter& request = addCall(node.first, RequestType::PREPARE);
+        request.putFixed64(transaction_id);
+        putLines(request, Lines(node.second.begin(), node.second.end()));
+    }
+    execute(calls);
+
+    bool all_prepared = true;
+    bool any_unavailable = false;
+    for (const auto& call : calls) {
+        all_prepared = all_prepared && call.result == ClusterResult::OK;
+        any_unavailable = any_unavailable || call.result == ClusterResult::UNAVAILABLE;
+    }
+
+    // Phase 2: commit everywhere, or abort wherever holds may exist
+    std::vector<Call> prepares;
+    prepares.swap(calls);
+    for (const auto& prepare : prepares) {
+        if (all_prepared || prepare.result != ClusterResult::REJECTED) {
+            addCall(prepare.node, all_prepared ? RequestType::COMMIT : RequestType::ABORT)
+                .putFixed64(transaction_id);
+        }
+    }
+    execute(calls);
+    // The decision stands; nodes that missed it get it later
+    retryLater(calls, transaction_id);
+
+    if (!all_prepared) {
+        return any_unavailable ? ClusterOrderResult::UNAVAILABLE : ClusterOrderResult::INSUFFICIENT_STOCK;
+    }
+    cross_node_orders_.fetch_add(1);
+    for (const auto& call : calls) {
+        if (call.result == ClusterResult::REJECTED) {
+            return ClusterOrderResult::PARTIALLY_COMMITTED;
+        }
+    }
+    return ClusterOrderResult::COMMITTED;
+}
+
+ClusterResult ClusterRouter::getNodeStats(size_t node, ClusterNodeStats& stats) {
+    if (node >= nodes_.size()) {
+        return ClusterResult::NOT_FOUND;
+    }
+
+    std::vector<Call> calls(1);
+    calls[0].node = node;
+    calls[0].type = static_cast<uint8_t>(RequestType::STATS);
+    execute(calls);
+    if (calls[0].result != ClusterResult::OK) {
+        return calls[0].result;
+    }
+
+    ByteReader reader(calls[0].reply);
+    if (!reader.getVarUInt(stats.product_count) || !reader.getVarUInt(stats.requests) ||
+        !reader.getVarUInt(stats.prepared) || !reader.getVarUInt(stats.committed) ||
+        !reader.getVarUInt(stats.aborted)) {
+        return ClusterResult::UNAVAILABLE;
+    }
+    return ClusterResult::OK;
+}
+
+void ClusterRouter::execute(std::vector<Call>& calls) {
+    for (auto& call : calls) {
+        call.fd = acquire(call.node);
+        if (call.fd >= 0 && !Wire::sendMessage(call.fd, call.type, call.request)) {
+            Wire::closeSocket(call.fd);
+            call.fd = -1;
+        }
+    }
+
+    for (auto& call : calls) {
+        if (call.fd < 0) {
+            call.result = ClusterResult::UNAVAILABLE;
+            continue;
+        }
+
+        uint8_t type;
+        std::vector<uint8_t> body;
+        bool ok = Wire::receiveMessage(call.fd, timeout_, type, body) == Wire::ReceiveResult::MESSAGE &&
+                  type == call.type && !body.empty() && body[0] <= static_cast<uint8_t>(ReplyStatus::REJECTED);
+        if (!ok) {
+            // A late reply would be read as the answer to the next request, so drop the connection
+            Wire::closeSocket(call.fd);
+            call.result = ClusterResult::UNAVAILABLE;
+            continue;
+        }
+
+        switch (static_cast<ReplyStatus>(body[0])) {
+            case ReplyStatus::OK: call.result = ClusterResult::OK; break;
+            case ReplyStatus::NOT_FOUND: call.result = ClusterResult::NOT_FOUND; break;
+            case ReplyStatus::REJECTED: call.result = ClusterResult::REJECTED; break;
+        }
+        call.reply.assign(body.begin() + 1, body.end());
+        release(call.node, call.fd);
+    }
+}
+
+ClusterResult ClusterRouter::callOwner(const std::string& product_id, uint8_t type, ByteWriter request,
+                                       std::vector<uint8_t>* reply) {
+    std::vector<Call> calls(1);
+    calls[0].node = ownerOf(product_id);
+    calls[0].type = type;
+    calls[0].request = std::move(request);
+    execute(calls);
+    if (reply) {
+        *reply = std::move(calls[0].reply);
+    }
+    return calls[0].result;
+}
+
+int ClusterRouter::acquire(size_t node) {
+    NodeConnections& connections = *nodes_[node];
+    {
+        std::lock_guard<std::mutex> lock(connections.mutex);
+        if (!connections.idle.empty()) {
+            int fd = connections.idle.back();
+            connections.idle.pop_back();
+            return fd;
+        }
+    }
+    return Wire::connectTcp(connections.address.host, connections.address.port);
+}
+
+void ClusterRouter::release(size_t node, int fd) {
+    NodeConnections& connections = *nodes_[node];
+    std::lock_guard<std::mutex> lock(connections.mutex);
+    connections.idle.push_back(fd);
+}
+
+size_t ClusterRouter::getUndeliveredDecisionCount() {
+    std::lock_guard<std::mutex> lock(decisions_mutex_);
+    return undelivered_.size();
+}
+
+void ClusterRouter::retryLater(const std::vector<Call>& calls, uint64_t transaction_id) {
+    std::lock_guard<std::mutex> lock(decisions_mutex_);
+    bool queued = false;
+    for (const auto& call : calls) {
+        if (call.result == ClusterResult::UNAVAILABLE) {
+            undelivered_.push_back(Decision{call.node, call.type, transaction_id});
+            queued = true;
+        }
+    }
+    if (queued && !retry_thread_.joinable() && !stopping_) {
+        retry_thread_ = std::thread(&ClusterRouter::retryLoop, this);
+    }
+}
+
+void ClusterRouter::retryLoop() {
+    std::unique_lock<std::mutex> lock(decisions_mutex_);
+    while (!stopping_) {
+        decisions_cv_.wait_for(lock, kDecisionRetryInterval, [this]() { return stopping_; });
+        if (stopping_ || undelivered_.empty()) {
+            continue;
+        }
+
+        std::vector<Decision> pending;
+        pending.swap(undelivered_);
+        std::vector<Call> calls(pending.size());
+        for (size_t i = 0; i < pending.size(); ++i) {
+            calls[i].node = pending[i].node;
+            calls[i].type = pending[i].type;
+            calls[i].request.putFixed64(pending[i].transaction_id);
+        }
+
+        lock.unlock();
+        // Any reply settles a decision: a node that already applied it, or lost it in a restart, says so
+        execute(calls);
+        lock.lock();
+        for (size_t i = 0; i < calls.size(); ++i) {
+            if (calls[i].result == ClusterResult::UNAVAILABLE) {
+                undelivered_.push_back(pending[i]);
+            }
+        }
+    }
+}
+
+uint64_t ClusterRouter::nextTransactionId() {
+    // Random rather than sequential so concurrent routers do not collide on a node
+    std::lock_guard<std::mutex> lock(transaction_mutex_);
+    return transaction_ids_();
+}
+
+} // namespace quirkventory
@@ -0,0 +1,121 @@
+#include "../include/Codec.hpp"
+#include <cstring>
+
+namespace quirkventory {
+
+// ByteWriter Implementation
+
+void ByteWriter::putVarUInt(uint64_t value) {
+    while (value >= 0x80) {
+        buffer_.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buffer_.push_back(static_cast<uint8_t>(value));
+}
+
+void ByteWriter::putVarInt(int64_t value) {
+    // Zigzag: 0, -1, 1, -2, ... map to 0, 1, 2, 3, ...
+    putVarUInt((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void ByteWriter::putFixed64(uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        buffer_.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void ByteWriter::putDouble(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putFixed64(bits);
+}
+
+void ByteWriter::putString(const std::string& value) {
+    putVarUInt(value.size());
+    buffer_.insert(buffer_.end(), value.begin(), value.end());
+}
+
+void ByteWriter::putBytes(const uint8_t* data, size_t size) {
+    buffer_.insert(buffer_.end(), data, data + size);
+}
+
+std::vector<uint8_t> ByteWriter::release() {
+    std::vector<uint8_t> result;
+    result.swap(buffer_);
+    return result;
+}
+
+// ByteReader Implementation
+
+bool ByteReader::getUInt8(uint8_t& value) {
+    if (position_ >= size_) {
+        return false;
+    }
+    value = data_[position_++];
+    return true;
+}
+
+bool ByteReader::getVarUInt(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (position_ >= size_) {
+            return false;
+        }
+        uint8_t byte = data_[position_++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false; // More than ten bytes: corrupt
+}
+
+bool ByteReader::getVarInt(int64_t& value) {
+    uint64_t encoded;
+    if (!getVarUInt(encoded)) {
+        return false;
+    }
+    value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+    return true;
+}
+
+bool ByteReader::getFixed64(uint64_t& value) {
+    if (size_ - position_ < 8) {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(data_[position_++]) << (8 * i);
+    }
+    return true;
+}
+
+bool ByteReader::getDouble(double& value) {
+    uint64_t bits;
+    if (!getFixed64(bits)) {
+        return false;
+    }
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+bool ByteReader::getString(std::string& value) {
+    uint64_t length;
+    if (!getVarUInt(length) || length > size_ - position_) {
+        return false;
+    }
+    value.assign(reinterpret_cast<const char*>(data_ + position_), static_cast<size_t>(length));
+    position_ += static_cast<size_t>(length);
+    return true;
+}
+
+bool ByteReader::getBytes(uint8_t* data, size_t size) {
+    if (size > size_ - position_) {
+        return false;
+    }
+    std::memcpy(data, data_ + position_, size);
+    position_ += size;
+    return true;
+}
+
+} // namespace quirkventory
@@ -0,0 +1,108 @@
+#include "../include/ConcurrencyLimiter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace quirkventory {
+
+ConcurrencyLimiter::ConcurrencyLimiter(const ConcurrencyLimiterConfig& config)
+    : config_(config), limit_(config.initial_limit), in_flight_(0),
+      short_latency_us_(0.0), long_latency_us_(0.0), samples_(0) {
+    if (config.min_limit < 1 || config.initial_limit < config.min_limit ||
+        config.max_limit < config.initial_limit) {
+        throw std::invalid_argument("Concurrency limits must satisfy 1 <= min <= initial <= max");
+    }
+    if (config.tolerance < 1.0 || config.smoothing <= 0.0 || config.smoothing > 1.0) {
+        throw std::invalid_argument("Tolerance must be >= 1 and smoothing in (0, 1]");
+    }
+}
+
+bool ConcurrencyLimiter::tryAcquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (in_flight_ >= static_cast<int>(limit_)) {
+        return false;
+    }
+    in_flight_++;
+    return true;
+}
+
+void ConcurrencyLimiter::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    available_.wait(lock, [this]() { return in_flight_ < static_cast<int>(limit_); });
+    in_flight_++;
+}
+
+void ConcurrencyLimiter::onComplete(std::chrono::microseconds latency, bool dropped) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        int in_flight = in_flight_;
+        in_flight_ = std::max(0, in_flight_ - 1);
+        if (!dropped) {
+            double sample = std::max<double>(1.0, static_cast<double>(latency.count()));
+            if (samples_ == 0) {
+                short_latency_us_ = sample;
+                long_latency_us_ = sample;
+            } else {
+                short_latency_us_ += (sample - short_latency_us_) * SHORT_WEIGHT;
+                // Falls with the recent average at once, rises only slowly
+                long_latency_us_ = std::min(short_latency_us_,
+                                            long_latency_us_ + (short_latency_us_ - long_latency_us_) * LONG_WEIGHT);
+            }
+            samples_++;
+            updateLimit(in_flight);
+        }
+    }
+
+    // The limit may have grown by more than the one slot just freed
+    available_.notify_all();
+}
+
+int ConcurrencyLimiter::getLimit() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(limit_);
+}
+
+int ConcurrencyLimiter::getInFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
+
+double ConcurrencyLimiter::getLatencyMicros() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return short_latency_us_;
+}
+
+double ConcurrencyLimiter::getBaselineLatencyMicros() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return long_latency_us_;
+}
+
+uint64_t ConcurrencyLimiter::getSampleCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return samples_;
+}
+
+void ConcurrencyLimiter::updateLimit(int in_flight) {
+    // Note: This method assumes mutex_ is already locked by the caller
+
+    double gradient = std::clamp(config_.tolerance * long_latency_us_ / short_latency_us_, 0.5, 1.0);
+    double target_us = static_cast<double>(config_.latency_target.count());
+    if (target_us > 0.0 && short_latency_us_ > target_us) {
+        gradient = std::max(0.5, std::min(gradient, target_us / short_latency_us_));
+    }
+
+    // Only probe upwards while the current limit is actually in use
+    bool limit_used = in_flight * 2 >= static_cast<int>(limit_);
+    if (gradient >= 1.0 && !limit_used) {
+        return;
+    }
+
+    double queue_allowance = gradient >= 1.0 ? std::sqrt(limit_) : 0.0;
+    double estimate = limit_ * gradient + queue_allowance;
+    limit_ = std::clamp(limit_ * (1.0 - config_.smoothing) + estimate * config_.smoothing,
+                        static_cast<double>(config_.min_limit), static_cast<double>(config_.max_limit));
+}
+
+} // namespace quirkventory
@@ -0,0 +1,174 @@
+#include "../include/Downsampling.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace quirkventory {
+
+namespace {
+
+std::vector<size_t> allIndices(size_t count) {
+    std::vector<size_t> indices(count);
+    std::iota(indices.begin(), indices.end(), size_t(0));
+    return indices;
+}
+
+/**
+ * @brief Sum a contiguous range with four independent accumulators
+ *
+ * Splitting the dependency chain lets the compiler keep the partial sums in
+ * SIMD lanes without needing -ffast-math to reassociate a single sum.
+ */
+double sumRange(const double* values, size_t begin, size_t end) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        s0 += values[i];
+        s1 += values[i + 1];
+        s2 += values[i + 2];
+        s3 += values[i + 3];
+    }
+    for (; i < end; ++i) {
+        s0 += values[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+} // namespace
+
+namespace Downsampling {
+
+std::vector<size_t> largestTriangleThreeBuckets(const double* x, const double* y,
+                                                size_t count, size_t threshold) {
+    if (count <= threshold || count <= 2) {
+        return allIndices(count);
+    }
+    if (threshold < 3) {
+        return threshold == 0 ? std::vector<size_t>() : std::vector<size_t>{0, count - 1};
+    }
+
+    std::vector<size_t> selected;
+    selected.reserve(threshold);
+    selected.push_back(0);
+
+    // First and last points are fixed; the rest are split into equal buckets
+    const double bucket_size = static_cast<double>(count - 2) / static_cast<double>(threshold - 2);
+    auto bucketBegin = [&](size_t bucket) {
+        return std::min(count - 1, static_cast<size_t>(std::floor(bucket * bucket_size)) + 1);
+    };
+
+    std::vector<double> areas;
+    size_t anchor = 0;
+
+    for (size_t bucket = 0; bucket + 2 < threshold; ++bucket) {
+        size_t begin = bucketBegin(bucket);
+        size_t end = bucketBegin(bucket + 1);
+        size_t next_begin = end;
+        size_t next_end = bucket + 3 < threshold ? bucketBegin(bucket + 2) : count;
+
+        // Third vertex: centroid of the next bucket (the last point for the final bucket)
+        double next_count = static_cast<double>(next_end - next_begin);
+        double avg_x = sumRange(x, next_begin, next_end) / next_count;
+        double avg_y = sumRange(y, next_begin, next_end) / next_count;
+
+        // Doubled triangle areas in a branch-free loop, then a separate argmax
+        const double ax = x[anchor];
+        const double ay = y[anchor];
+        const double dx = ax - avg_x;
+        const double dy = avg_y - ay;
+        areas.resize(end - begin);
+        const double* bx = x + begin;
+        const double* by = y + begin;
+        for (size_t i = 0; i < areas.size(); ++i) {
+            areas[i] = std::fabs(dx * (by[i] - ay) - (ax - bx[i]) * dy);
+        }
+
+        size_t best = static_cast<size_t>(std::max_element(areas.begin(), areas.end()) - areas.begin());
+        anchor = begin + best;
+        selected.push_back(anchor);
+    }
+
+    selected.push_back(count - 1);
+    return selected;
+}
+
+std::vector<size_t> minMaxBuckets(const double* y, size_t count, size_t threshold) {
+    if (count <= threshold || count <= 2) {
+        return allIndices(count);
+    }
+    if (threshold < 4) {
+        return threshold == 0 ? std::vector<size_t>() : std::vector<size_t>{0, count - 1};
+    }
+
+    // Two points per bucket, minus the fixed first and last points
+    size_t bucket_count = (threshold - 2) / 2;
+    const double bucket_size = static_cast<double>(count - 2) / static_cast<double>(bucket_count);
+
+    std::vector<size_t> selected;
+    selected.reserve(threshold);
+    selected.push_back(0);
+
+    for (size_t bucket = 0; bucket < bucket_count; ++bucket) {
+        size_t begin = static_cast<size_t>(std::floor(bucket * bucket_size)) + 1;
+        size_t end = bucket + 1 < bucket_count
+            ? static_cast<size_t>(std::floor((bucket + 1) * bucket_size)) + 1 : count - 1;
+        if (begin >= end) {
+            continue;
+        }
+
+        // Value-only min/max reductions, then locate the first index of each
+        double min_value = y[begin];
+        double max_value = y[begin];
+        for (size_t i = begin + 1; i < end; ++i) {
+            min_value = std::min(min_value, y[i]);
+            max_value = std::max(max_value, y[i]);
+        }
+        size_t min_index = static_cast<size_t>(std::find(y + begin, y + end, min_value) - y);
+        size_t max_index = static_cast<size_t>(std::find(y + begin, y + end, max_value) - y);
+
+        // NaN buckets have no meaningful extremes; keep the bucket's first point
+        if (min_index == end || max_index == end) {
+            min_index = max_index = begin;
+        }
+
+        selected.push_back(std::min(min_index, max_index));
+        if (min_index != max_index) {
+            selected.push_back(std::max(min_index, max_index));
+        }
+    }
+
+    selected.push_back(count - 1);
+    return selected;
+}
+
+std::vector<size_t> selectIndices(const double* x, const double* y, size_t count,
+                                  size_t threshold, DownsampleMethod method) {
+    if (method == DownsampleMethod::MIN_MAX) {
+        return minMaxBuckets(y, count, threshold);
+    }
+    return largestTriangleThreeBuckets(x, y, count, threshold);
+}
+
+std::vector<TimeSeriesPoint> downsample(const std::vector<TimeSeriesPoint>& points,
+                                        size_t threshold, DownsampleMethod method) {
+    if (points.size() <= threshold) {
+        return points;
+    }
+
+    std::vector<double> x(points.size());
+    std::vector<double> y(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        x[i] = static_cast<double>(points[i].timestamp);
+        y[i] = points[i].value;
+    }
+
+    std::vector<TimeSeriesPoint> result;
+    for (size_t index : selectIndices(x.data(), y.data(), points.size(), threshold, method)) {
+        result.push_back(points[index]);
+    }
+    return result;
+}
+
+} // namespace Downsampling
+
+} // namespace quirkventory
@@ -1,8 +1,14 @@
 #include "../include/HTTPServer.hpp"
+#include "../include/Downsampling.hpp"
+#include "../include/OrderArchive.hpp"
+#include "../include/IdGenerator.hpp"
 #include <iostream>
 #include <sstream>
+#include <iomanip>
 #include <regex>
 #include <algorithm>
+#include <cmath>
+#include <cctype>
 
 // Note: This is a simplified HTTP server implementation for demonstration purposes.
 // In a production environment, you would use a proper HTTP library like:
@@ -12,6 +18,198 @@
 
 namespace quirkventory {
 
+namespace {
+
+/**
+ * @brief Parse a date query parameter
+ * @param value Epoch seconds or a UTC date in YYYY-MM-DD form
+ * @param end_of_day For YYYY-MM-DD, return the last instant of that day instead of its start
+ * @param result Parsed time point
+ * @return true if the value was parsed successfully
+ */
+bool parseDateParam(const std::string& value, bool end_of_day, std::chrono::system_clock::time_point& result) {
+    // Furthest a time point can be from the epoch without overflowing system_clock's ticks
+    // (a day is kept in reserve for end_of_day)
+    const long long max_seconds =
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::duration::max()).count() -
+        24 * 3600;
+
+    std::smatch match;
+    if (std::regex_match(value, std::regex("-?[0-9]{1,12}"))) {
+        long long seconds = std::stoll(value);
+        if (seconds > max_seconds || seconds < -max_seconds) {
+            return false;
+        }
+        result = std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+        return true;
+    }
+    if (!std::regex_match(value, match, std::regex("([0-9]{4})-([0-9]{2})-([0-9]{2})"))) {
+        return false;
+    }
+
+    long long year = std::stoll(match[1].str());
+    unsigned month = static_cast<unsigned>(std::stoul(match[2].str()));
+    unsigned day = static_cast<unsigned>(std::stoul(match[3].str()));
+    if (month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+
+    // Days since 1970-01-01 in the proleptic Gregorian calendar
+    year -= month <= 2 ? 1 : 0;
+    long long era = (year >= 0 ? year : year - 399) / 400;
+    long long year_of_era = year - era * 400;
+    long long day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long long day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    long long days = era * 146097 + day_of_era - 719468;
+    if (days > max_seconds / (24 * 3600) || days < -max_seconds / (24 * 3600)) {
+        return false;
+    }
+
+    result = std::chrono::system_clock::time_point(std::chrono::hours(24 * days));
+    if (end_of_day) {
+        result += std::chrono::hours(24) - std::chrono::microseconds(1);
+    }
+    return true;
+}
+
+/**
+ * @brief Parse a chart granularity query parameter
+ * @param value "hour", "day", or "week"
+ * @param granularity Parsed granularity
+ * @return true if the value is a known granularity
+ */
+bool parseGranularityParam(const std::string& value, BucketGranularity& granularity) {
+    if (value == "hour") {
+        granularity = BucketGranularity::HOUR;
+    } else if (value == "day") {
+        granularity = BucketGranularity::DAY;
+    } else if (value == "week") {
+        granularity = BucketGranularity::WEEK;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Parse a chart downsampling method query parameter
+ * @param value "lttb" or "minmax"
+ * @param method Parsed method
+ * @return true if the value is a known method
+ */
+bool parseDownsampleMethodParam(const std::string& value, DownsampleMethod& method) {
+    if (value == "lttb") {
+        method = DownsampleMethod::LTTB;
+    } else if (value == "minmax") {
+        method = DownsampleMethod::MIN_MAX;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Parse a chart point budget query parameter
+ * @param value Positive integer up to 100000
+ * @param points Parsed point count
+ * @return true if the value is valid
+ */
+bool parsePointsParam(const std::string& value, size_t& points) {
+    if (!std::regex_match(value, std::regex("[0-9]{1,6}"))) {
+        return false;
+    }
+    points = std::stoul(value);
+    return points >= 2 && points <= 100000;
+}
+
+/**
+ * @brief Parse the "items" array of an order request body
+ * @param body JSON body such as {"items": [{"product_id": "P1", "quantity": 2}]}
+ * @param items Parsed (product_id, quantity) pairs
+ * @return true if the array is present, non-empty, and every item is valid
+ */
+bool parseOrderItems(const std::string& body, std::vector<std::pair<std::string, int>>& items) {
+    std::smatch array_match;
+    if (!std::regex_search(body, array_match, std::regex("\"items\"\\s*:\\s*\\[([^\\]]*)\\]"))) {
+        return false;
+    }
+    
+    std::string array = array_match[1].str();
+    std::regex object_regex("\\{[^{}]*\\}");
+    for (auto it = std::sregex_iterator(array.begin(), array.end(), object_regex);
+         it != std::sregex_iterator(); ++it) {
+        std::string object = it->str();
+        std::string product_id = JSONUtils::extractJSONValue(object, "product_id");
+        std::string quantity = JSONUtils::extractJSONValue(object, "quantity");
+        
+        if (product_id.length() < 2 || product_id.front() != '"' || product_id.back() != '"' ||
+            !std::regex_match(quantity, std::regex("[0-9]{1,9}")) || std::stoi(quantity) == 0) {
+            return false;
+        }
+        items.emplace_back(product_id.substr(1, product_id.length() - 2), std::stoi(quantity));
+    }
+    
+    return !items.empty();
+}
+
+/**
+ * @brief Parse an array of strings from a JSON request body
+ * @param body JSON body
+ * @param key Key of the array
+ * @param values Receives the strings
+ * @return true if the key holds an array of strings (possibly empty)
+ */
+bool parseStringArray(const std::string& body, const std::string& key, std::vector<std::string>& values) {
+    std::smatch array_match;
+    if (!std::regex_search(body, array_match, std::regex("\"" + key + "\"\\s*:\\s*\\[([^\\]]*)\\]"))) {
+        return false;
+    }
+    
+    std::string array = array_match[1].str();
+    std::regex element_regex("\\s*\"([^\"]*)\"\\s*(,|$)");
+    auto begin = std::sregex_iterator(array.begin(), array.end(), element_regex);
+    size_t consumed = 0;
+    for (auto it = begin; it != std::sregex_iterator(); ++it) {
+        if (static_cast<size_t>(it->position()) != consumed) {
+            return false;
+        }
+        values.push_back((*it)[1].str());
+        consumed += it->length();
+    }
+    
+    return array.find_first_not_of(" \t\r\n", consumed) == std::string::npos;
+}
+
+/**
+ * @brief Format a product version as a strong ETag
+ * @param version Product version
+ * @return Quoted ETag value
+ */
+std::string formatETag(uint64_t version) {
+    return "\"" + std::to_string(version) + "\"";
+}
+
+/**
+ * @brief Parse an If-Match header naming a single product version
+ * @param value Header value: a strong ETag such as "3", or *
+ * @param version Receives the version (0 for *, which matches any version)
+ * @return true if the header was understood
+ */
+bool parseIfMatch(const std::string& value, uint64_t& version) {
+    std::smatch match;
+    if (std::regex_match(value, std::regex("\\s*\\*\\s*"))) {
+        version = 0;
+        return true;
+    }
+    if (!std::regex_match(value, match, std::regex("\\s*\"([0-9]{1,19})\"\\s*"))) {
+        return false;
+    }
+    version = std::stoull(match[1].str());
+    return version != 0;
+}
+
+} // namespace
+
 // HTTPRequest Implementation
 
 std::string HTTPRequest::getQueryParam(const std::string& key) const {
@@ -23,6 +221,26 @@ std::string HTTPRequest::getQueryParam(const std::string& key) const {
     return "";
 }
 
+std::string HTTPRequest::getHeader(const std::string& name) const {
+    auto it = headers.find(name);
+    if (it != headers.end()) {
+        return it->second;
+    }
+    
+    auto lower = [](std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return text;
+    };
+    std::string wanted = lower(name);
+    for (const auto& pair : headers) {
+        if (lower(pair.first) == wanted) {
+            return pair.second;
+        }
+    }
+    return "";
+}
+
 // HTTPResponse Implementation
 
 HTTPResponse::HTTPResponse(int code, const std::string& message)
@@ -63,7 +281,9 @@ std::string HTTPResponse::toString() const {
 HTTPServer::HTTPServer(const std::string& host, int port)
     : host_(host), port_(port), running_(false),
       inventory_(nullptr), order_manager_(nullptr),
-      user_manager_(nullptr), notification_manager_(nullptr) {
+      user_manager_(nullptr), notification_manager_(nullptr),
+      order_idempotency_(100000, std::chrono::hours(24)),
+      replication_primary_(nullptr), replication_follower_(nullptr) {
 }
 
 HTTPServer::~HTTPServer() {
@@ -80,6 +300,11 @@ void HTTPServer::setSystemComponents(Inventory* inventory,
     notification_manager_ = notification_manager;
 }
 
+void HTTPServer::setReplication(const ReplicationPrimary* primary, const ReplicationFollower* follower) {
+    replication_primary_ = primary;
+    replication_follower_ = follower;
+}
+
 bool HTTPServer::start() {
     if (running_.load()) {
         return false; // Already running
@@ -105,9 +330,17 @@ bool HTTPServer::start() {
     std::cout << "  GET    /api/orders" << std::endl;
     std::cout << "  POST   /api/orders" << std::endl;
     std::cout << "  GET    /api/orders/{id}" << std::endl;
+    std::cout << "  PUT    /api/orders/{id}" << std::endl;
+    std::cout << "  DELETE /api/orders/{id}" << std::endl;
+    std::cout << "  POST   /api/orders/cancel" << std::endl;
     std::cout << "  GET    /api/reports/sales" << std::endl;
     std::cout << "  GET    /api/reports/inventory" << std::endl;
+    std::cout << "  GET    /api/analytics/top-products" << std::endl;
+    std::cout << "  GET    /api/analytics/customers" << std::endl;
+    std::cout << "  GET    /api/charts/inventory" << std::endl;
+    std::cout << "  GET    /api/charts/sales" << std::endl;
     std::cout << "  GET    /api/system/status" << std::endl;
+    std::cout << "  GET    /api/replication/status" << std::endl;
     
     return true;
 }
@@ -130,6 +363,10 @@ std::string HTTPServer::getServerUrl() const {
     return "http://" + host_ + ":" + std::to_string(port_);
 }
 
+std::string HTTPServer::handleRawRequest(const std::string& request_data) {
+    return handleRequest(request_data).toString();
+}
+
 void HTTPServer::setupRoutes() {
     // Product endpoints
     get_handlers_["/api/products"] = [this](const HTTPRequest& req) { return handleGetProducts(req); };
@@ -147,13 +384,21 @@ void HTTPServer::setupRoutes() {
     get_handlers_["/api/orders"] = [this](const HTTPRequest& req) { return handleGetOrders(req); };
     get_handlers_["/api/orders/{id}"] = [this](const HTTPRequest& req) { return handleGetOrder(req); };
     post_handlers_["/api/orders"] = [this](const HTTPRequest& req) { return handlePostOrder(req); };
+    put_handlers_["/api/orders/{id}"] = [this](const HTTPRequest& req) { return handlePutOrder(req); };
+    delete_handlers_["/api/orders/{id}"] = [this](const HTTPRequest& req) { return handleDeleteOrder(req); };
+    post_handlers_["/api/orders/cancel"] = [this](const HTTPRequest& req) { return handleCancelOrders(req); };
     
     // Report endpoints
     get_handlers_["/api/reports/sales"] = [this](const HTTPRequest& req) { return handleGetSalesReport(req); };
     get_handlers_["/api/reports/inventory"] = [this](const HTTPRequest& req) { return handleGetInventoryReport(req); };
+    get_handlers_["/api/analytics/top-products"] = [this](const HTTPRequest& req) { return handleGetTopProducts(req); };
+    get_handlers_["/api/analytics/customers"] = [this](const HTTPRequest& req) { return handleGetCustomerAnalytics(req); };
+    get_handlers_["/api/charts/inventory"] = [this](const HTTPRequest& req) { return handleGetInventoryChart(req); };
+    get_handlers_["/api/charts/sales"] = [this](const HTTPRequest& req) { return handleGetSalesChart(req); };
     
     // System endpoints
     get_handlers_["/api/system/status"] = [this](const HTTPRequest& req) { return handleGetSystemStatus(req); };
+    get_handlers_["/api/replication/status"] = [this](const HTTPRequest& req) { return handleGetReplicationStatus(req); };
 }
 
 void HTTPServer::serverLoop() {
@@ -221,6 +466,13 @@ HTTPRequest HTTPServer::parseRequest(const std::string& request_data) {
 }
 
 HTTPResponse HTTPServer::routeRequest(const HTTPRequest& request) {
+    if (replication_follower_ && request.method != "GET") {
+        // Followers only mirror the primary; writes have to go there
+        HTTPResponse response = createErrorResponse(405, "Read-only replica: send writes to the primary");
+        response.headers["Allow"] = "GET";
+        return response;
+    }
+
     auto& handlers = (request.method == "GET") ? get_handlers_ :
                     (request.method == "POST") ? post_handlers_ :
                     (request.method == "PUT") ? put_handlers_ :
@@ -270,16 +522,26 @@ HTTPResponse HTTPServer::handleGetProducts(const HTTPRequest& request) {
         return createErrorResponse(500, "Inventory system not available");
     }
     
-    auto products = inventory_->getAllProducts();
     std::vector<std::string> product_json_list;
-    
-    for (const auto* product : products) {
-        product_json_list.push_back(productToJSON(product));
+    std::string as_of = request.getQueryParam("as_of");
+    if (!as_of.empty()) {
+        VersionStore::ReadView view;
+        HTTPResponse error;
+        if (!openAsOfView(as_of, view, error)) {
+            return error;
+        }
+        inventory_->forEachProduct(view, [&](const ProductRecord& record) {
+            product_json_list.push_back(productRecordToJSON(record));
+        });
+    } else {
+        for (const auto* product : inventory_->getAllProducts()) {
+            product_json_list.push_back(productToJSON(product));
+        }
     }
     
     std::string json_response = JSONUtils::createJSONObject({
         {"status", "\"success\""},
-        {"count", std::to_string(products.size())},
+        {"count", std::to_string(product_json_list.size())},
         {"products", JSONUtils::createJSONArray(product_json_list)}
     });
     
@@ -296,17 +558,101 @@ HTTPResponse HTTPServer::handleGetProduct(const HTTPRequest& request) {
         return createErrorResponse(400, "Invalid product ID");
     }
     
-    const Product* product = inventory_->getProduct(product_id);
-    if (!product) {
+    std::string as_of = request.getQueryParam("as_of");
+    if (!as_of.empty()) {
+        VersionStore::ReadView view;
+        HTTPResponse error;
+        if (!openAsOfView(as_of, view, error)) {
+            return error;
+        }
+        ProductRecord record;
+        if (!inventory_->getProductRecord(view, product_id, record)) {
+            return createErrorResponse(404, "Product not found at that time");
+        }
+        return createJSONResponse(JSONUtils::createJSONObject({
+            {"status", "\"success\""},
+            {"product", productRecordToJSON(record)}
+        }));
+    }
+    
+    // Body and ETag come from one copy, so a concurrent update can't pair one version's fields with another's tag
+    ProductVersion product;
+    if (!inventory_->getProductState(product_id, product)) {
         return createErrorResponse(404, "Product not found");
     }
     
     std::string json_response = JSONUtils::createJSONObject({
         {"status", "\"success\""},
-        {"product", productToJSON(product)}
+        {"product", productStateToJSON(product)}
     });
     
-    return createJSONResponse(json_response);
+    HTTPResponse response = createJSONResponse(json_response);
+    response.headers["ETag"] = formatETag(product.product_version);
+    return response;
+}
+
+HTTPResponse HTTPServer::handlePutProduct(const HTTPRequest& request) {
+    if (!inventory_) {
+        return createErrorResponse(500, "Inventory system not available");
+    }
+    
+    std::string product_id = extractPathParameter(request.path, "/api/products/([^/]+)");
+    if (product_id.empty()) {
+        return createErrorResponse(400, "Invalid product ID");
+    }
+    
+    // Without If-Match the update is unconditional, as it always was
+    uint64_t expected_version = 0;
+    std::string if_match = request.getHeader("If-Match");
+    if (!if_match.empty() && !parseIfMatch(if_match, expected_version)) {
+        return createErrorResponse(400, "If-Match must be a single strong ETag or *");
+    }
+    
+    ProductUpdate update;
+    try {
+        if (!JSONUtils::extractJSONValue(request.body, "name").empty()) {
+            update.name = parseJSONString(request.body, "name");
+        }
+        if (!JSONUtils::extractJSONValue(request.body, "category").empty()) {
+            update.category = parseJSONString(request.body, "category");
+        }
+        if (!JSONUtils::extractJSONValue(request.body, "price").empty()) {
+            update.price = parseJSONDouble(request.body, "price");
+        }
+        if (!JSONUtils::extractJSONValue(request.body, "quantity").empty()) {
+            update.quantity = parseJSONInt(request.body, "quantity");
+        }
+    } catch (const std::exception& e) {
+        return createErrorResponse(400, "Invalid product data: " + std::string(e.what()));
+    }
+    if (update.empty()) {
+        return createErrorResponse(400, "Nothing to update (expected name, category, price or quantity)");
+    }
+    
+    uint64_t version;
+    ProductVersion updated;
+    HTTPResponse response;
+    switch (inventory_->updateProduct(product_id, update, expected_version, version, &updated)) {
+        case ProductUpdateResult::UPDATED:
+            // The state this update wrote, not a later re-read that may already include someone else's change
+            response = createJSONResponse(JSONUtils::createJSONObject({
+                {"status", "\"success\""},
+                {"product", productStateToJSON(updated)}
+            }));
+            break;
+        case ProductUpdateResult::NOT_FOUND:
+            return createErrorResponse(404, "Product not found");
+        case ProductUpdateResult::VERSION_MISMATCH:
+            response = createErrorResponse(412, "Product was modified since version " +
+                                           std::to_string(expected_version) + "; re-read it and retry");
+            break;
+        case ProductUpdateResult::INVALID:
+            return createErrorResponse(400, "Invalid product data: name must be non-empty, "
+                                       "price and quantity non-negative");
+    }
+    
+    response.headers["ETag"] = formatETag(version);
+    return response;
 }
 
 HTTPResponse HTTPServer::handlePostProduct(const HTTPRequest& request) {
@@ -322,8 +668,11 @@ HTTPResponse HTTPServer::handlePostProduct(const HTTPRequest& request) {
         double price = parseJSONDouble(request.body, "price");
         int quantity = parseJSONInt(request.body, "quantity");
         
-        if (id.empty() || name.empty()) {
-            return createErrorResponse(400, "Product ID and name are required");
+        if (name.empty()) {
+            return createErrorResponse(400, "Product name is required");
+        }
+        if (id.empty()) {
+            id = IdGenerator::getShared().nextString("PRD");
         }
         
         // Use PerishableProduct with very long expiry for non-perishable products
@@ -332,7 +681,8 @@ HTTPResponse HTTPServer::handlePostProduct(const HTTPRequest& request) {
                                                           far_future, "Standard storage", 20.0);
         
         if (inventory_->addProduct(std::move(product))) {
-            return createJSONResponse(JSONUtils::formatSuccessJSON("Product created successfully"));
+            return createJSONResponse(JSONUtils::formatSuccessJSON("Product created successfully",
+                JSONUtils::createJSONObject({{"id", "\"" + JSONUtils::escapeJSON(id) + "\""}})));
         } else {
             return createErrorResponse(409, "Product ID already exists");
         }
@@ -341,6 +691,24 @@ HTTPResponse HTTPServer::handlePostProduct(const HTTPRequest& request) {
     }
 }
 
+HTTPResponse HTTPServer::handleDeleteProduct(const HTTPRequest& request) {
+    if (!inventory_) {
+        return createErrorResponse(500, "Inventory system not available");
+    }
+    
+    std::string product_id = extractPathParameter(request.path, "/api/products/([^/]+)");
+    if (product_id.empty()) {
+        return createErrorResponse(400, "Invalid product ID");
+    }
+    
+    if (!inventory_->removeProduct(product_id)) {
+        return createErrorResponse(404, "Product not found");
+    }
+    
+    return createJSONResponse(JSONUtils::formatSuccessJSON("Product deleted successfully",
+        JSONUtils::createJSONObject({{"id", "\"" + JSONUtils::escapeJSON(product_id) + "\""}})));
+}
+
 HTTPResponse HTTPServer::handleGetInventoryStatus(const HTTPRequest& request) {
     if (!inventory_) {
         return createErrorResponse(500, "Inventory system not available");
@@ -384,8 +752,670 @@ HTTPResponse HTTPServer::handleGetLowStockAlerts(const HTTPRequest& request) {
     return createJSONResponse(json_response);
 }
 
-HTTPResponse HTTPServer::handleGetSystemStatus(const HTTPRequest& request) {
+HTTPResponse HTTPServer::handleGetExpiryAlerts(const HTTPRequest& request) {
+    if (!inventory_) {
+        return createErrorResponse(500, "Inventory system not available");
+    }
+    
+    int days = 7;
+    std::string days_param = request.getQueryParam("days");
+    if (!days_param.empty()) {
+        if (!std::regex_match(days_param, std::regex("[0-9]{1,4}"))) {
+            return createErrorResponse(400, "Invalid 'days' (expected a non-negative integer)");
+        }
+        days = std::stoi(days_param);
+    }
+    
+    std::vector<std::string> alerts;
+    for (const auto* product : inventory_->getExpiredProducts()) {
+        alerts.push_back(JSONUtils::createJSONObject({
+            {"product_id", "\"" + JSONUtils::escapeJSON(product->getId()) + "\""},
+            {"product_name", "\"" + JSONUtils::escapeJSON(product->getName()) + "\""},
+            {"current_stock", std::to_string(product->getQuantity())},
+            {"expired", "true"},
+            {"expiry_info", "\"" + JSONUtils::escapeJSON(product->getExpiryInfo()) + "\""}
+        }));
+    }
+    for (const auto* product : inventory_->getExpiringSoonProducts(days)) {
+        alerts.push_back(JSONUtils::createJSONObject({
+            {"product_id", "\"" + JSONUtils::escapeJSON(product->getId()) + "\""},
+            {"product_name", "\"" + JSONUtils::escapeJSON(product->getName()) + "\""},
+            {"current_stock", std::to_string(product->getQuantity())},
+            {"expired", "false"},
+            {"expiry_info", "\"" + JSONUtils::escapeJSON(product->getExpiryInfo()) + "\""}
+        }));
+    }
+    
     std::string json_response = JSONUtils::createJSONObject({
+        {"status", "\"success\""},
+        {"days", std::to_string(days)},
+        {"alert_count", std::to_string(alerts.size())},
+        {"alerts", JSONUtils::createJSONArray(alerts)}
+    });
+    
+    return createJSONResponse(json_response);
+}
+
+HTTPResponse HTTPServer::handleGetOrders(const HTTPRequest& request) {
+    if (!order_manager_) {
+        return createErrorResponse(500, "Order system not available");
+    }
+    
+    // Customer history covers archived orders as well as live ones
+    std::string customer_id = request.getQueryParam("customer_id");
+    if (!customer_id.empty()) {
+        std::vector<std::string> order_json_list;
+        for (const auto& record : order_manager_->getCustomerHistory(customer_id)) {
+            order_json_list.push_back(orderRecordToJSON(record));
+        }
+        
+        return createJSONResponse(JSONUtils::createJSONObject({
+            {"status", "\"success\""},
+            {"customer_id", "\"" + JSONUtils::escapeJSON(customer_id) + "\""},
+            {"count", std::to_string(order_json_list.size())},
+            {"orders", JSONUtils::createJSONArray(order_json_list)}
+        }));
+    }
+    
+    std::string from = request.getQueryParam("from");
+    std::string to = request.getQueryParam("to");
+    
+    std::vector<Order*> orders;
+    if (from.empty() && to.empty()) {
+        orders = order_manager_->getAllOrders();
+    } else {
+        auto start = std::chrono::system_clock::time_point::min();
+        auto end = std::chrono::system_clock::time_point::max();
+        
+        if (!from.empty() && !parseDateParam(from, false, start)) {
+            return createErrorResponse(400, "Invalid 'from' date (expected epoch seconds or YYYY-MM-DD)");
+        }
+        if (!to.empty() && !parseDateParam(to, true, end)) {
+            return createErrorResponse(400, "Invalid 'to' date (expected epoch seconds or YYYY-MM-DD)");
+        }
+        
+        orders = order_manager_->getOrdersInDateRange(start, end);
+    }
+    
+    std::vector<std::string> order_json_list;
+    order_json_list.reserve(orders.size());
+    for (const auto* order : orders) {
+        order_json_list.push_back(orderToJSON(order));
+    }
+    
+    std::string json_response = JSONUtils::createJSONObject({
+        {"status", "\"success\""},
+        {"count", std::to_string(orders.size())},
+        {"orders", JSONUtils::createJSONArray(order_json_list)}
+    });
+    
+    return createJSONResponse(json_response);
+}
+
+HTTPResponse HTTPServer::handleGetOrder(const HTTPRequest& request) {
+    if (!order_manager_) {
+        return createErrorResponse(500, "Order system not available");
+    }
+    
+    std::string order_id = extractPathParameter(request.path, "/api/orders/([^/]+)");
+    if (order_id.empty()) {
+        return createErrorResponse(400, "Invalid order ID");
+    }
+    
+    std::string order_json;
+    if (const Order* order = order_manager_->getOrder(order_id)) {
+        order_json = orderToJSON(order);
+    } else {
+        OrderRecord record;
+        if (!order_manager_->getArchive().findOrder(order_id, record)) {
+            return createErrorResponse(404, "Order not found");
+        }
+        order_json = orderRecordToJSON(record);
+    }
+    
+    std::string json_response = JSONUtils::createJSONObject({
+        {"status", "\"success\""},
+        {"order", order_json}
+    });
+    
+    return createJSONResponse(json_response);
+}
+
+HTTPResponse HTTPServer::handlePostOrder(const HTTPRequest& request) {
+    std::string key = request.getHeader("Idempotency-Key");
+    if (key.empty()) {
+        return createOrderFromRequest(request);
+    }
+    if (key.size() > 255) {
+        return createErrorResponse(400, "Idempotency-Key must be at most 255 characters");
+    }
+    
+    // Retries must repeat the original request to get its response back
+    std::string fingerprint = std::to_string(std::hash<std::string>{}(request.body)) + ":" +
+                              std::to_string(request.body.size());
+    IdempotentResponse cached;
+    switch (order_idempotency_.begin(key, fingerprint, cached)) {
+        case IdempotencyOutcome::REPLAY: {
+            HTTPResponse response(cached.status_code, cached.status_message);
+            response.setJSONBody(cached.body);
+            response.headers["Idempotent-Replayed"] = "true";
+            return response;
+        }
+        case IdempotencyOutcome::IN_PROGRESS:
+            return createErrorResponse(409, "A request with this Idempotency-Key is still being processed");
+        case IdempotencyOutcome::MISMATCH:
+            return createErrorResponse(422, "Idempotency-Key was already used with a different request");
+        case IdempotencyOutcome::NEW:
+            break;
+    }
+    
+    HTTPResponse response;
+    try {
+        response = createOrderFromRequest(request);
+    } catch (...) {
+        order_idempotency_.abandon(key);
+        throw;
+    }
+    
+    // Server-side failures may succeed on retry, so only keep definitive answers
+    if (response.status_code >= 500) {
+        order_idempotency_.abandon(key);
+    } else {
+        order_idempotency_.complete(key, {response.status_code, response.status_message, response.body});
+    }
+    return response;
+}
+
+HTTPResponse HTTPServer::createOrderFromRequest(const HTTPRequest& request) {
+    if (!order_manager_ || !inventory_) {
+        return createErrorResponse(500, "Order system not available");
+    }
+    
+    std::string customer_id = parseJSONString(request.body, "customer_id");
+    if (customer_id.empty()) {
+        return createErrorResponse(400, "Customer ID is required");
+    }
+    
+    std::vector<std::pair<std::string, int>> items;
+    if (!parseOrderItems(request.body, items)) {
+        return createErrorResponse(400, "Items must be a non-empty array of {product_id, quantity}");
+    }
+    
+    // Prices come from the catalogue, not from the client
+    std::vector<std::pair<std::string, double>> prices;
+    for (const auto& item : items) {
+        const Product* product = inventory_->getProduct(item.first);
+        if (!product) {
+            return createErrorResponse(404, "Product not found: " + item.first);
+        }
+        prices.emplace_back(item.first, product->getPrice());
+    }
+    
+    Order* order = order_manager_->createOrderForCustomer(customer_id);
+    if (!order) {
+        return createErrorResponse(500, "Failed to create order");
+    }
+    for (size_t i = 0; i < items.size(); ++i) {
+        order->addItem(items[i].first, items[i].second, prices[i].second);
+    }
+    
+    // Short items wait for a restock instead of failing the order
+    bool allow_backorder = JSONUtils::extractJSONValue(request.body, "allow_backorder") == "true";
+    
+    if (!order->processOrder(*inventory_, allow_backorder)) {
+        return createErrorResponse(409, "Order " + order->getOrderId() + " failed: " + order->getErrorMessage());
+    }
+    
+    HTTPResponse response(201, "Created");
+    response.setJSONBody(JSONUtils::createJSONObject({
+        {"status", "\"success\""},
+        {"order", orderToJSON(order)}
+    }));
+    return response;
+}
+
+HTTPResponse HTTPServer::handlePutOrder(const HTTPRequest& request) {
+    if (!order_manager_) {
+        return createErrorResponse(500, "Order system not available");
+    }
+    
+    std::string order_id = extractPathParameter(request.path, "/api/orders/([^/]+)");
+    if (order_id.empty()) {
+        return createErrorResponse(400, "Invalid order ID");
+    }
+    
+    Order* order = order_manager_->getOrder(order_id);
+    if (!order) {
+        return createErrorResponse(404, "Order not found");
+    }
+    
+    std::string status = parseJSONString(request.body, "status");
+    bool updated;
+    if (status == "CANCELLED") {
+        updated = order_manager_->cancelOrder(order_id, parseJSONString(request.body, "reason"));
+    } else if (status == "SHIPPED") {
+        updated = order->updateStatus(OrderStatus::SHIPPED);
+    } else if (status == "DELIVERED") {
+        updated = order->updateStatus(OrderStatus::DELIVERED);
+    } else {
+        return createErrorResponse(400, "Invalid 'status' (expected CANCELLED, SHIPPED or DELIVERED)");
+    }
+    
+    if (!updated) {
+        return createErrorResponse(409, "Order " + order_id + " cannot move from " +
+                                   orderStatusToString(order->getStatus()) + " to " + status);
+    }
+    
+    std::string json_response = JSONUtils::createJSONObject({
+        {"status", "\"success\""},
+        {"order", orderToJSON(order)}
+    });
+    
+    return createJSONResponse(json_response);
+}
+
+HTTPResponse HTTPServer::handleDeleteOrder(const HTTPRequest& request) {
+    if (!order_manager_) {
+        return createErrorResponse(500, "Order system not available");
+    }
+    
+    std::string order_id = extractPathParameter(request.path, "/api/orders/([^/]+)");
+    if (order_id.empty()) {
+        return createErrorResponse(400, "Invalid order ID");
+    }
+    
+    const Order* order = order_manager_->getOrder(order_id);
+    if (!order) {
+        return createErrorResponse(404, "Order not found");
+    }
+    
+    // Cancelling keeps the order (and its history); reserved stock is returned
+    if (!order_manager_->cancelOrder(order_id, request.getQueryParam("reason"))) {
+        return createErrorResponse(409, "Order " + order_id + " cannot be cancelled once " +
+                                   orderStatusToString(order->getStatus()));
+    }
+    
+    std::string json_response = JSONUtils::createJSONObject({
+        {"status", "\"success\""},
+        {"order", orderToJSON(order)}
+    });
+    
+    return createJSONResponse(json_response);
+}
+
+HTTPResponse HTTPServer::handleCancelOrders(const HTTPRequest& request) {
+    if (!order_manager_) {
+        return createErrorResponse(500, "Order system not available");
+    }
+    
+    std::vector<std::string> order_ids;
+    if (!parseStringArray(request.body, "order_ids", order_ids) || order_ids.empty()) {
+        return createErrorResponse(400, "order_ids must be a non-empty array of order IDs");
+    }
+    
+    size_t cancelled = order_manager_->cancelOrders(order_ids, parseJSONString(request.body, "reason"));
+    
+    std::string json_response = JSONUtils::createJSONObject({
+        {"status", "\"success\""},
+        {"requested", std::to_string(order_ids.size())},
+        {"cancelled", std::to_string(cancelled)}
+    });
+    
+    return createJSONResponse(json_response);
+}
+
+HTTPResponse HTTPServer::handleGetTopProducts(const HTTPRequest& request) {
+    if (!order_manager_) {
+        return createErrorResponse(500, "Order system not available");
+    }
+    
+    const SalesAggregator& aggregator = order_manager_->getSalesAggregator();
+    
+    size_t k = 100;
+    std::string k_param = request.getQueryParam("k");
+    if (!k_param.empty()) {
+        if (!std::regex_match(k_param, std::regex("[0-9]{1,6}")) || std::stoul(k_param) == 0) {
+            return createErrorResponse(400, "Invalid 'k' (expected a positive integer)");
+        }
+        k = std::min<size_t>(std::stoul(k_param), aggregator.getTopProductsCapacity());
+    }
+    
+    std::string by = request.getQueryParam("by");
+    if (by.empty()) {
+        by = "units";
+    }
+    if (by != "units" && by != "revenue") {
+        return createErrorResponse(400, "Invalid 'by' (expected units or revenue)");
+    }
+    SalesMetric metric = by == "revenue" ? SalesMetric::REVENUE : SalesMetric::UNITS;
+    
+    std::string from = request.getQueryParam("from");
+    std::string to = request.getQueryParam("to");
+    std::vector<std::string> product_json_list;
+    bool exact = !from.empty() || !to.empty();
+    
+    if (exact) {
+        // Exact ranking from the time-bucketed aggregates
+        auto start = std::chrono::system_clock::time_point::min();
+        auto end = std::chrono::system_clock::time_point::max();
+        if (!from.empty() && !parseDateParam(from, false, start)) {
+            return createErrorResponse(400, "Invalid 'from' date (expected epoch seconds or YYYY-MM-DD)");
+        }
+        if (!to.empty() && !parseDateParam(to, true, end)) {
+            return createErrorResponse(400, "Invalid 'to' date (expected epoch seconds or YYYY-MM-DD)");
+        }
+        
+        for (const auto& pair : aggregator.getTopProductsInRange(start, end, k, metric)) {
+            product_json_list.push_back(JSONUtils::createJSONObject({
+                {"product_id", "\"" + JSONUtils::escapeJSON(pair.first) + "\""},
+                {"units", std::to_string(pair.second.units)},
+                {"revenue", std::to_string(pair.second.revenue)},
+                {"orders", std::to_string(pair.second.orders)}
+            }));
+        }
+    } else {
+        // All-time ranking from the streaming sketch
+        for (const auto& hitter : aggregator.getTopProducts(k, metric)) {
+            product_json_list.push_back(JSONUtils::createJSONObject({
+                {"product_id", "\"" + JSONUtils::escapeJSON(hitter.key) + "\""},
+                {by, std::to_string(hitter.count)},
+                {"max_error", std::to_string(hitter.error)}
+            }));
+        }
+    }
+    
+    std::string json_response = JSONUtils::createJSONObject({
+        {"status", "\"success\""},
+        {"by", "\"" + by + "\""},
+        {"exact", exact ? "true" : "false"},
+        {"count", std::to_string(product_json_list.size())},
+        {"products", JSONUtils::createJSONArray(product_json_list)}
+    });
+    
+    return createJSONResponse(json_response);
+}
+
+HTTPResponse HTTPServer::handleGetCustomerAnalytics(const HTTPRequest& request) {
+    if (!order_manager_) {
+        return createErrorResponse(500, "Order system not available");
+    }
+    
+    // Defaults to the last 30 days
+    auto end = std::chrono::system_clock::now();
+    auto start = end - std::chrono::hours(24 * 30);
+    
+    std::string from = request.getQueryParam("from");
+    std::string to = request.getQueryParam("to");
+    if (!from.empty() && !parseDateParam(from, false, start)) {
+        return createErrorResponse(400, "Invalid 'from' date (expected epoch seconds or YYYY-MM-DD)");
+    }
+    if (!to.empty() && !parseDateParam(to, true, end)) {
+        return createErrorResponse(400, "Invalid 'to' date (expected epoch seconds or YYYY-MM-DD)");
+    }
+    
+    OrderDistribution distribution = order_manager_->getSalesAggregator().getOrderDistribution(start, end);
+    const TDigest& order_values = distribution.order_values;
+    
+    std::string json_response = JSONUtils::createJSONObject({
+        {"status", "\"success\""},
+        {"unique_customers", std::to_string(static_cast<long long>(std::llround(distribution.customers.estimate())))},
+        {"orders", std::to_string(static_cast<long long>(order_values.getCount()))},
+        {"order_value_p50", std::to_string(order_values.quantile(0.5))},
+        {"order_value_p90", std::to_string(order_values.quantile(0.9))},
+        {"order_value_p95", std::to_string(order_values.quantile(0.95))},
+        {"order_value_p99", std::to_string(order_values.quantile(0.99))}
+    });
+    
+    return createJSONResponse(json_response);
+}
+
+HTTPResponse HTTPServer::handleGetInventoryChart(const HTTPRequest& request) {
+    if (!inventory_) {
+        return createErrorResponse(500, "Inventory system not available");
+    }
+    
+    std::string product_id = request.getQueryParam("product_id");
+    std::string category = request.getQueryParam("category");
+    if (product_id.empty() == category.empty()) {
+        return createErrorResponse(400, "Specify exactly one of 'product_id' or 'category'");
+    }
+    std::string series = product_id.empty() ? "category:" + category : "product:" + product_id;
+    
+    // Defaults to the last 30 days
+    auto end = std::chrono::system_clock::now();
+    auto start = end - std::chrono::hours(24 * 30);
+    
+    std::string from = request.getQueryParam("from");
+    std::string to = request.getQueryParam("to");
+    if (!from.empty() && !parseDateParam(from, false, start)) {
+        return createErrorResponse(400, "Invalid 'from' date (expected epoch seconds or YYYY-MM-DD)");
+    }
+    if (!to.empty() && !parseDateParam(to, true, end)) {
+        return createErrorResponse(400, "Invalid 'to' date (expected epoch seconds or YYYY-MM-DD)");
+    }
+    
+    std::string granularity_param = request.getQueryParam("granularity");
+    if (granularity_param.empty()) {
+        granularity_param = "day";
+    }
+    BucketGranularity granularity;
+    if (!parseGranularityParam(granularity_param, granularity)) {
+        return createErrorResponse(400, "Invalid 'granularity' (expected hour, day, or week)");
+    }
+    
+    // With a point budget, downsample the raw samples instead of returning rollups
+    size_t max_points = 0;
+    std::string points_param = request.getQueryParam("points");
+    if (!points_param.empty() && !parsePointsParam(points_param, max_points)) {
+        return createErrorResponse(400, "Invalid 'points' (expected an integer from 2 to 100000)");
+    }
+    
+    std::string method_param = request.getQueryParam("method");
+    if (method_param.empty()) {
+        method_param = "lttb";
+    }
+    DownsampleMethod method;
+    if (!parseDownsampleMethodParam(method_param, method)) {
+        return createErrorResponse(400, "Invalid 'method' (expected lttb or minmax)");
+    }
+    
+    const TimeSeriesStore& history = inventory_->getStockHistory();
+    if (!history.hasSeries(series)) {
+        return createErrorResponse(404, "No stock history for " + series);
+    }
+    
+    std::vector<std::string> point_json_list;
+    if (max_points > 0) {
+        auto samples = Downsampling::downsample(history.getPoints(series, start, end), max_points, method);
+        for (const auto& sample : samples) {
+            point_json_list.push_back(JSONUtils::createJSONObject({
+                {"timestamp", std::to_string(sample.timestamp)},
+                {"value", std::to_string(sample.value)}
+            }));
+        }
+        
+        return createJSONResponse(JSONUtils::createJSONObject({
+            {"status", "\"success\""},
+            {"series", "\"" + JSONUtils::escapeJSON(series) + "\""},
+            {"method", "\"" + method_param + "\""},
+            {"count", std::to_string(point_json_list.size())},
+            {"points", JSONUtils::createJSONArray(point_json_list)}
+        }));
+    }
+    
+    for (const auto& rollup : history.getRollups(series, start, end, granularity)) {
+        point_json_list.push_back(JSONUtils::createJSONObject({
+            {"timestamp", std::to_string(rollup.start)},
+            {"min", std::to_string(rollup.min)},
+            {"max", std::to_string(rollup.max)},
+            {"avg", std::to_string(rollup.getAverage())},
+            {"last", std::to_string(rollup.last)},
+            {"samples", std::to_string(rollup.count)}
+        }));
+    }
+    
+    std::string json_response = JSONUtils::createJSONObject({
+        {"status", "\"success\""},
+        {"series", "\"" + JSONUtils::escapeJSON(series) + "\""},
+        {"granularity", "\"" + granularity_param + "\""},
+        {"count", std::to_string(point_json_list.size())},
+        {"points", JSONUtils::createJSONArray(point_json_list)}
+    });
+    
+    return createJSONResponse(json_response);
+}
+
+HTTPResponse HTTPServer::handleGetSalesChart(const HTTPRequest& request) {
+    if (!order_manager_) {
+        return createErrorResponse(500, "Order system not available");
+    }
+    
+    // Defaults to the last 30 days
+    auto end = std::chrono::system_clock::now();
+    auto start = end - std::chrono::hours(24 * 30);
+    
+    std::string from = request.getQueryParam("from");
+    std::string to = request.getQueryParam("to");
+    if (!from.empty() && !parseDateParam(from, false, start)) {
+        return createErrorResponse(400, "Invalid 'from' date (expected epoch seconds or YYYY-MM-DD)");
+    }
+    if (!to.empty() && !parseDateParam(to, true, end)) {
+        return createErrorResponse(400, "Invalid 'to' date (expected epoch seconds or YYYY-MM-DD)");
+    }
+    
+    std::string granularity_param = request.getQueryParam("granularity");
+    if (granularity_param.empty()) {
+        granularity_param = "day";
+    }
+    BucketGranularity granularity;
+    if (!parseGranularityParam(granularity_param, granularity)) {
+        return createErrorResponse(400, "Invalid 'granularity' (expected hour, day, or week)");
+    }
+    
+    size_t max_points = 0;
+    std::string points_param = request.getQueryParam("points");
+    if (!points_param.empty() && !parsePointsParam(points_param, max_points)) {
+        return createErrorResponse(400, "Invalid 'points' (expected an integer from 2 to 100000)");
+    }
+    
+    std::string method_param = request.getQueryParam("method");
+    if (method_param.empty()) {
+        method_param = "lttb";
+    }
+    DownsampleMethod method;
+    if (!parseDownsampleMethodParam(method_param, method)) {
+        return createErrorResponse(400, "Invalid 'method' (expected lttb or minmax)");
+    }
+    
+    auto buckets = order_manager_->getSalesAggregator().getTimeSeries(start, end, granularity);
+    
+    // Downsample on revenue, keeping the selected buckets whole
+    std::vector<size_t> selected;
+    if (max_points > 0 && buckets.size() > max_points) {
+        std::vector<double> x(buckets.size());
+        std::vector<double> y(buckets.size());
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            x[i] = static_cast<double>(std::chrono::duration_cast<std::chrono::seconds>(
+                buckets[i].first.time_since_epoch()).count());
+            y[i] = buckets[i].second.revenue;
+        }
+        selected = Downsampling::selectIndices(x.data(), y.data(), buckets.size(), max_points, method);
+    } else {
+        selected.resize(buckets.size());
+        for (size_t i = 0; i < selected.size(); ++i) {
+            selected[i] = i;
+        }
+    }
+    
+    std::vector<std::string> point_json_list;
+    for (size_t index : selected) {
+        const auto& pair = buckets[index];
+        point_json_list.push_back(JSONUtils::createJSONObject({
+            {"timestamp", std::to_string(std::chrono::duration_cast<std::chrono::seconds>(
+                pair.first.time_since_epoch()).count())},
+            {"orders", std::to_string(pair.second.orders)},
+            {"units", std::to_string(pair.second.units)},
+            {"revenue", std::to_string(pair.second.revenue)}
+        }));
+    }
+    
+    std::string json_response = JSONUtils::createJSONObject({
+        {"status", "\"success\""},
+        {"granularity", "\"" + granularity_param + "\""},
+        {"count", std::to_string(point_json_list.size())},
+        {"points", JSONUtils::createJSONArray(point_json_list)}
+    });
+    
+    return createJSONResponse(json_response);
+}
+
+HTTPResponse HTTPServer::handleGetSalesReport(const HTTPRequest& request) {
+    if (!order_manager_) {
+        return createErrorResponse(500, "Order system not available");
+    }
+    
+    // Defaults to the last 30 days
+    auto end = std::chrono::system_clock::now();
+    auto start = end - std::chrono::hours(24 * 30);
+    
+    std::string from = request.getQueryParam("from");
+    std::string to = request.getQueryParam("to");
+    if (!from.empty() && !parseDateParam(from, false, start)) {
+        return createErrorResponse(400, "Invalid 'from' date (expected epoch seconds or YYYY-MM-DD)");
+    }
+    if (!to.empty() && !parseDateParam(to, true, end)) {
+        return createErrorResponse(400, "Invalid 'to' date (expected epoch seconds or YYYY-MM-DD)");
+    }
+    
+    SalesBucket sales = order_manager_->getSalesAggregator().query(start, end);
+    
+    std::vector<std::string> category_json_list;
+    for (const auto& pair : sales.by_category) {
+        category_json_list.push_back(JSONUtils::createJSONObject({
+            {"category", "\"" + JSONUtils::escapeJSON(pair.first) + "\""},
+            {"orders", std::to_string(pair.second.orders)},
+            {"units", std::to_string(pair.second.units)},
+            {"revenue", std::to_string(pair.second.revenue)}
+        }));
+    }
+    
+    std::string json_response = JSONUtils::createJSONObject({
+        {"status", "\"success\""},
+        {"from", std::to_string(std::chrono::duration_cast<std::chrono::seconds>(
+            start.time_since_epoch()).count())},
+        {"to", std::to_string(std::chrono::duration_cast<std::chrono::seconds>(
+            end.time_since_epoch()).count())},
+        {"orders", std::to_string(sales.totals.orders)},
+        {"units", std::to_string(sales.totals.units)},
+        {"revenue", std::to_string(sales.totals.revenue)},
+        {"products_sold", std::to_string(sales.by_product.size())},
+        {"categories", JSONUtils::createJSONArray(category_json_list)}
+    });
+    
+    return createJSONResponse(json_response);
+}
+
+HTTPResponse HTTPServer::handleGetInventoryReport(const HTTPRequest& /* request */) {
+    if (!inventory_) {
+        return createErrorResponse(500, "Inventory system not available");
+    }
+    
+    std::string json_response = JSONUtils::createJSONObject({
+        {"status", "\"success\""},
+        {"total_products", std::to_string(inventory_->getTotalProductCount())},
+        {"total_quantity", std::to_string(inventory_->getTotalQuantity())},
+        {"total_value", std::to_string(inventory_->getTotalValue())},
+        {"low_stock_count", std::to_string(inventory_->getLowStockProducts().size())},
+        {"expired_count", std::to_string(inventory_->getExpiredProducts().size())},
+        {"expiring_soon_count", std::to_string(inventory_->getExpiringSoonProducts().size())},
+        {"report", "\"" + JSONUtils::escapeJSON(inventory_->generateInventoryReport()) + "\""}
+    });
+    
+    return createJSONResponse(json_response);
+}
+
+HTTPResponse HTTPServer::handleGetSystemStatus(const HTTPRequest& request) {
+    std::vector<std::pair<std::string, std::string>> fields = {
         {"status", "\"success\""},
         {"server", "\"Quirkventory HTTP Server\""},
         {"version", "\"1.0.0\""},
@@ -394,11 +1424,90 @@ HTTPResponse HTTPServer::handleGetSystemStatus(const HTTPRequest& request) {
         {"order_manager_available", order_manager_ ? "true" : "false"},
         {"user_manager_available", user_manager_ ? "true" : "false"},
         {"notification_manager_available", notification_manager_ ? "true" : "false"}
-    });
+    };
+    
+    if (order_manager_) {
+        const ConcurrencyLimiter& limiter = order_manager_->getProcessingLimiter();
+        std::ostringstream latency, baseline;
+        latency << std::fixed << std::setprecision(3) << limiter.getLatencyMicros() / 1000.0;
+        baseline << std::fixed << std::setprecision(3) << limiter.getBaselineLatencyMicros() / 1000.0;
+        fields.emplace_back("order_processing", JSONUtils::createJSONObject({
+            {"concurrency_limit", std::to_string(limiter.getLimit())},
+            {"in_flight", std::to_string(limiter.getInFlight())},
+            {"queue_depth", std::to_string(order_manager_->getProcessingQueueDepth())},
+            {"latency_ms", latency.str()},
+            {"baseline_latency_ms", baseline.str()}
+        }));
+    }
+    
+    if (const VersionStore* versions = inventory_ ? inventory_->getVersionStore() : nullptr) {
+        auto history_start = std::chrono::duration_cast<std::chrono::seconds>(
+            versions->getHistoryStart().time_since_epoch()).count();
+        fields.emplace_back("inventory_versions", JSONUtils::createJSONObject({
+            {"latest_commit", std::to_string(versions->getLatestCommit())},
+            {"retained_versions", std::to_string(versions->getVersionCount())},
+            {"collected_versions", std::to_string(versions->getCollectedCount())},
+            {"open_views", std::to_string(versions->getOpenViewCount())},
+            {"history_start", std::to_string(history_start)}
+        }));
+    }
+    
+    fields.emplace_back("replication_role", replication_follower_ ? "\"follower\"" :
+                                            replication_primary_ ? "\"primary\"" : "\"none\"");
+    
+    fields.emplace_back("order_idempotency", JSONUtils::createJSONObject({
+        {"keys", std::to_string(order_idempotency_.size())},
+        {"replays", std::to_string(order_idempotency_.getReplayCount())},
+        {"evictions", std::to_string(order_idempotency_.getEvictionCount())}
+    }));
+    
+    std::string json_response = JSONUtils::createJSONObject(fields);
     
     return createJSONResponse(json_response);
 }
 
+HTTPResponse HTTPServer::handleGetReplicationStatus(const HTTPRequest& /* request */) {
+    if (replication_follower_) {
+        ReplicationStatus status = replication_follower_->getStatus();
+        std::ostringstream delay, contact;
+        delay << std::fixed << std::setprecision(3) << status.apply_delay_ms;
+        contact << std::fixed << std::setprecision(3) << status.since_contact_ms;
+        return createJSONResponse(JSONUtils::createJSONObject({
+            {"role", "\"follower\""},
+            {"connected", status.connected ? "true" : "false"},
+            {"applied_lsn", std::to_string(status.applied_lsn)},
+            {"primary_lsn", std::to_string(status.primary_lsn)},
+            {"lag_changes", std::to_string(status.lag_changes)},
+            {"apply_delay_ms", delay.str()},
+            {"since_contact_ms", contact.str()},
+            {"changes_applied", std::to_string(status.changes_applied)},
+            {"snapshots_loaded", std::to_string(status.snapshots_loaded)},
+            {"reconnects", std::to_string(status.reconnects)}
+        }));
+    }
+    
+    if (replication_primary_) {
+        std::vector<std::string> replicas;
+        for (const auto& replica : replication_primary_->getReplicas()) {
+            replicas.push_back(JSONUtils::createJSONObject({
+                {"address", "\"" + replica.address + "\""},
+                {"acked_lsn", std::to_string(replica.acked_lsn)},
+                {"lag_changes", std::to_string(replica.lag_changes)},
+                {"snapshots_sent", std::to_string(replica.snapshots_sent)}
+            }));
+        }
+        return createJSONResponse(JSONUtils::createJSONObject({
+            {"role", "\"primary\""},
+            {"port", std::to_string(replication_primary_->getPort())},
+            {"last_lsn", std::to_string(replication_primary_->getLastLsn())},
+            {"oldest_lsn", std::to_string(replication_primary_->getOldestLsn())},
+            {"replicas", JSONUtils::createJSONArray(replicas)}
+        }));
+    }
+    
+    return createJSONResponse(JSONUtils::createJSONObject({{"role", "\"none\""}}));
+}
+
 // Utility methods
 
 std::string HTTPServer::extractPathParameter(const std::string& path, const std::string& pattern) {
@@ -414,16 +1523,105 @@ std::string HTTPServer::productToJSON(const Product* product) {
     if (!product) return "{}";
     
     return JSONUtils::createJSONObject({
-        {"id", "\"" + product->getId() + "\""},
+        {"id", "\"" + JSONUtils::escapeJSON(product->getId()) + "\""},
         {"name", "\"" + JSONUtils::escapeJSON(product->getName()) + "\""},
         {"category", "\"" + JSONUtils::escapeJSON(product->getCategory()) + "\""},
         {"price", std::to_string(product->getPrice())},
         {"quantity", std::to_string(product->getQuantity())},
+        {"version", std::to_string(product->getVersion())},
         {"is_expired", product->isExpired() ? "true" : "false"},
         {"expiry_info", "\"" + JSONUtils::escapeJSON(product->getExpiryInfo()) + "\""}
     });
 }
 
+std::string HTTPServer::productStateToJSON(const ProductVersion& product) {
+    // Same fields and expiry wording as productToJSON()
+    bool expired = false;
+    std::string expiry_info = "Non-perishable";
+    if (product.perishable) {
+        auto now = std::chrono::system_clock::now();
+        expired = now > product.expiry_date;
+        expiry_info = expired ? "EXPIRED" : std::to_string(
+            std::chrono::duration_cast<std::chrono::hours>(product.expiry_date - now).count() / 24) +
+            " days remaining";
+    }
+    
+    return JSONUtils::createJSONObject({
+        {"id", "\"" + JSONUtils::escapeJSON(product.id) + "\""},
+        {"name", "\"" + JSONUtils::escapeJSON(product.name) + "\""},
+        {"category", "\"" + JSONUtils::escapeJSON(product.category) + "\""},
+        {"price", std::to_string(product.price)},
+        {"quantity", std::to_string(product.quantity)},
+        {"version", std::to_string(product.product_version)},
+        {"is_expired", expired ? "true" : "false"},
+        {"expiry_info", "\"" + JSONUtils::escapeJSON(expiry_info) + "\""}
+    });
+}
+
+std::string HTTPServer::productRecordToJSON(const ProductRecord& product) {
+    return JSONUtils::createJSONObject({
+        {"id", "\"" + JSONUtils::escapeJSON(product.id) + "\""},
+        {"name", "\"" + JSONUtils::escapeJSON(product.name) + "\""},
+        {"category", "\"" + JSONUtils::escapeJSON(product.category) + "\""},
+        {"price", std::to_string(product.price)},
+        {"quantity", std::to_string(product.quantity)},
+        {"version", std::to_string(product.product_version)},
+        {"is_expired", product.expired ? "true" : "false"},
+        {"expiry_info", "\"" + JSONUtils::escapeJSON(product.expiry_info) + "\""}
+    });
+}
+
+bool HTTPServer::openAsOfView(const std::string& as_of, VersionStore::ReadView& view, HTTPResponse& error) {
+    std::chrono::system_clock::time_point time;
+    if (!parseDateParam(as_of, false, time)) {
+        error = createErrorResponse(400, "Invalid 'as_of' (expected epoch seconds or YYYY-MM-DD)");
+        return false;
+    }
+    if (!inventory_->isVersioningEnabled()) {
+        error = createErrorResponse(400, "Point-in-time reads need inventory versioning to be enabled");
+        return false;
+    }
+    
+    view = inventory_->openReadViewAsOf(time);
+    if (!view.valid()) {
+        auto start = std::chrono::duration_cast<std::chrono::seconds>(
+            inventory_->getVersionStore()->getHistoryStart().time_since_epoch()).count();
+        error = createErrorResponse(400, "'as_of' is older than the retained history (starts at " +
+                                    std::to_string(start) + ")");
+        return false;
+    }
+    return true;
+}
+
+std::string HTTPServer::orderToJSON(const Order* order) {
+    if (!order) return "{}";
+    return orderRecordToJSON(order->toRecord());
+}
+
+std::string HTTPServer::orderRecordToJSON(const OrderRecord& order) {
+    std::vector<std::string> item_json_list;
+    for (const auto& item : order.items) {
+        item_json_list.push_back(JSONUtils::createJSONObject({
+            {"product_id", "\"" + JSONUtils::escapeJSON(item.product_id) + "\""},
+            {"quantity", std::to_string(item.quantity)},
+            {"unit_price", std::to_string(item.unit_price)},
+            {"backordered", std::to_string(item.backordered)}
+        }));
+    }
+    
+    auto order_date = std::chrono::duration_cast<std::chrono::seconds>(
+        order.order_date.time_since_epoch()).count();
+    
+    return JSONUtils::createJSONObject({
+        {"id", "\"" + JSONUtils::escapeJSON(order.order_id) + "\""},
+        {"customer_id", "\"" + JSONUtils::escapeJSON(order.customer_id) + "\""},
+        {"status", "\"" + orderStatusToString(order.status) + "\""},
+        {"order_date", std::to_string(order_date)},
+        {"total_amount", std::to_string(order.total_amount)},
+        {"items", JSONUtils::createJSONArray(item_json_list)}
+    });
+}
+
 std::string HTTPServer::parseJSONString(const std::string& json, const std::string& key) {
     std::string value = JSONUtils::extractJSONValue(json, key);
     // Remove quotes
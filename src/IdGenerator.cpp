@@ -0,0 +1,112 @@
+#include "../include/IdGenerator.hpp"
+#include <stdexcept>
+
+namespace quirkventory {
+
+namespace {
+
+constexpr uint64_t SEQUENCE_MASK = (uint64_t(1) << IdGenerator::SEQUENCE_BITS) - 1;
+
+// Crockford base32: no I, L, O or U, and digits sort before letters
+const char BASE32_ALPHABET[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+std::atomic<uint64_t> next_instance_id{1};
+
+/**
+ * @brief Per-thread block of leased counter values
+ */
+struct ThreadLease {
+    uint64_t owner = 0;     // Instance id of the generator the lease came from
+    uint64_t next = 0;
+    uint64_t end = 0;
+};
+
+thread_local ThreadLease thread_lease;
+
+} // namespace
+
+IdGenerator::IdGenerator(uint32_t node_id, uint32_t lease_size)
+    : state_(0), node_id_(node_id), lease_size_(lease_size),
+      instance_id_(next_instance_id.fetch_add(1, std::memory_order_relaxed)) {
+    if (node_id > MAX_NODE_ID) {
+        throw std::invalid_argument("Node ID must be at most " + std::to_string(MAX_NODE_ID));
+    }
+    if (lease_size == 0 || lease_size > SEQUENCE_MASK + 1) {
+        throw std::invalid_argument("Lease size must be between 1 and " + std::to_string(SEQUENCE_MASK + 1));
+    }
+}
+
+uint64_t IdGenerator::next() {
+    ThreadLease& cache = thread_lease;
+    uint64_t now_ms = currentMillis();
+
+    // Refill when the lease is used up, belongs to another generator, or is
+    // from an earlier millisecond (so IDs from quiet threads stay current)
+    if (cache.owner != instance_id_ || cache.next == cache.end ||
+        (cache.next >> SEQUENCE_BITS) < now_ms) {
+        cache.owner = instance_id_;
+        cache.next = lease(now_ms, lease_size_);
+        cache.end = cache.next + lease_size_;
+    }
+
+    uint64_t value = cache.next++;
+    uint64_t millis = value >> SEQUENCE_BITS;
+    uint64_t sequence = value & SEQUENCE_MASK;
+    return (millis << (NODE_BITS + SEQUENCE_BITS)) | (uint64_t(node_id_) << SEQUENCE_BITS) | sequence;
+}
+
+std::string IdGenerator::nextString(const std::string& prefix) {
+    return format(next(), prefix);
+}
+
+uint64_t IdGenerator::lease(uint64_t now_ms, uint32_t count) {
+    uint64_t floor = now_ms << SEQUENCE_BITS;
+    uint64_t current = state_.load(std::memory_order_relaxed);
+
+    while (true) {
+        uint64_t start = current > floor ? current : floor;
+
+        // Keep a lease inside one millisecond so its IDs share a timestamp
+        uint64_t room = (SEQUENCE_MASK + 1) - (start & SEQUENCE_MASK);
+        if (room < count) {
+            start += room;
+        }
+
+        if (state_.compare_exchange_weak(current, start + count, std::memory_order_relaxed)) {
+            return start;
+        }
+    }
+}
+
+std::string IdGenerator::format(uint64_t id, const std::string& prefix) {
+    // 13 characters cover 65 bits, enough for the 63-bit ID
+    char buffer[13];
+    for (int i = 12; i >= 0; --i) {
+        buffer[i] = BASE32_ALPHABET[id & 31];
+        id >>= 5;
+    }
+    return prefix + std::string(buffer, sizeof(buffer));
+}
+
+std::chrono::system_clock::time_point IdGenerator::getTimestamp(uint64_t id) {
+    long long millis = static_cast<long long>(id >> (NODE_BITS + SEQUENCE_BITS)) + EPOCH_MS;
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(millis)));
+}
+
+uint32_t IdGenerator::getNodeId(uint64_t id) {
+    return static_cast<uint32_t>((id >> SEQUENCE_BITS) & MAX_NODE_ID);
+}
+
+IdGenerator& IdGenerator::getShared() {
+    static IdGenerator shared_generator;
+    return shared_generator;
+}
+
+uint64_t IdGenerator::currentMillis() {
+    long long millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return millis > EPOCH_MS ? static_cast<uint64_t>(millis - EPOCH_MS) : 0;
+}
+
+} // namespace quirkventory
@@ -0,0 +1,134 @@
+#include "../include/IdempotencyCache.hpp"
+#include <stdexcept>
+
+namespace quirkventory {
+
+IdempotencyCache::IdempotencyCache(size_t capacity, std::chrono::milliseconds ttl, size_t shard_count)
+    : ttl_(ttl), replays_(0), evictions_(0) {
+    if (capacity == 0 || ttl.count() <= 0 || shard_count == 0) {
+        throw std::invalid_argument("Idempotency cache capacity, TTL and shard count must be positive");
+    }
+
+    size_t shards = 1;
+    while (shards < shard_count) {
+        shards <<= 1;
+    }
+    shard_mask_ = shards - 1;
+    shards_ = std::make_unique<Shard[]>(shards);
+    shard_capacity_ = (capacity + shards - 1) / shards;
+}
+
+IdempotencyOutcome IdempotencyCache::begin(const std::string& key, const std::string& fingerprint,
+                                           IdempotentResponse& response) {
+    Shard& shard = shardFor(key);
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end() && now - it->second.created < ttl_) {
+        const Entry& entry = it->second;
+        if (entry.fingerprint != fingerprint) {
+            return IdempotencyOutcome::MISMATCH;
+        }
+        if (!entry.completed) {
+            return IdempotencyOutcome::IN_PROGRESS;
+        }
+        response = entry.response;
+        replays_.fetch_add(1);
+        return IdempotencyOutcome::REPLAY;
+    }
+
+    // An expired entry is replaced in place; its old by_age slot is skipped when trimmed
+    trimLocked(shard, now, 1);
+
+    Entry& entry = shard.entries[key];
+    entry.fingerprint = fingerprint;
+    entry.created = now;
+    entry.completed = false;
+    entry.response = IdempotentResponse();
+    shard.by_age.emplace_back(now, key);
+    return IdempotencyOutcome::NEW;
+}
+
+void IdempotencyCache::complete(const std::string& key, const IdempotentResponse& response) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end()) {
+        it->second.completed = true;
+        it->second.response = response;
+    }
+}
+
+void IdempotencyCache::abandon(const std::string& key) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end() && !it->second.completed) {
+        // Its by_age slot no longer matches and is skipped when trimmed
+        shard.entries.erase(it);
+    }
+}
+
+size_t IdempotencyCache::evictExpired() {
+    auto now = Clock::now();
+    size_t evicted = 0;
+    for (size_t i = 0; i <= shard_mask_; ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        evicted += trimLocked(shards_[i], now, 0);
+    }
+    return evicted;
+}
+
+size_t IdempotencyCache::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i <= shard_mask_; ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        total += shards_[i].entries.size();
+    }
+    return total;
+}
+
+IdempotencyCache::Shard& IdempotencyCache::shardFor(const std::string& key) const {
+    return shards_[std::hash<std::string>{}(key) & shard_mask_];
+}
+
+size_t IdempotencyCache::trimLocked(Shard& shard, Clock::time_point now, size_t room) {
+    // Note: This method assumes shard.mutex is already locked by the caller
+    size_t evicted = 0;
+    while (!shard.by_age.empty()) {
+        const auto& oldest = shard.by_age.front();
+        auto it = shard.entries.find(oldest.second);
+        bool current = it != shard.entries.end() && it->second.created == oldest.first;
+
+        if (current) {
+            bool expired = now - oldest.first >= ttl_;
+            bool over_capacity = shard.entries.size() + room > shard_capacity_;
+            if (!expired && !over_capacity) {
+                break;
+            }
+            shard.entries.erase(it);
+            evicted++;
+        }
+        shard.by_age.pop_front();
+    }
+
+    // Abandoned keys leave stale slots behind live ones; compact before they pile up
+    if (shard.by_age.size() > 2 * shard_capacity_) {
+        std::deque<std::pair<Clock::time_point, std::string>> live;
+        for (auto& slot : shard.by_age) {
+            auto entry = shard.entries.find(slot.second);
+            if (entry != shard.entries.end() && entry->second.created == slot.first) {
+                live.push_back(std::move(slot));
+            }
+        }
+        shard.by_age.swap(live);
+    }
+
+    evictions_.fetch_add(evicted);
+    return evicted;
+}
+
+} // namespace quirkventory
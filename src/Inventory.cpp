@@ -1,13 +1,26 @@
 #include "../include/Inventory.hpp"
+#include "../include/ThreadPool.hpp"
+#include "../include/IdGenerator.hpp"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <cctype>
+#include <iterator>
 
 namespace quirkventory {
 
+namespace {
+
+// Resolution of hold expiry
+constexpr std::chrono::milliseconds HOLD_TICK(100);
+
+} // namespace
+
 Inventory::Inventory(int default_threshold)
-    : default_low_stock_threshold_(default_threshold) {
+    : default_low_stock_threshold_(default_threshold), next_restock_listener_id_(1),
+      hold_clock_origin_(std::chrono::steady_clock::now()),
+      stock_combiner_([this](const std::vector<StockCombiner::Request*>& batch) { applyRemovalBatch(batch); }),
+      combining_mode_(StockCombining::AUTO), versioning_enabled_(false) {
 }
 
 bool Inventory::addProduct(std::unique_ptr<Product> product) {
@@ -24,19 +37,38 @@ bool Inventory::addProduct(std::unique_ptr<Product> product) {
         return false; // Product ID already exists
     }
 
+    Product& added = *product;
     products_[product_id] = std::move(product);
+    recordStockLevel(added, added.getQuantity());
     return true;
 }
 
 bool Inventory::removeProduct(const std::string& product_id) {
     std::lock_guard<std::mutex> lock(inventory_mutex_);
-    
+    VersionStore::Group version_group(versions_.get());
+    return removeProductLocked(product_id);
+}
+
+bool Inventory::removeProductLocked(const std::string& product_id) {
+    // Note: This method assumes inventory_mutex_ is already locked by the caller
     auto it = products_.find(product_id);
     if (it == products_.end()) {
         return false; // Product not found
     }
 
+    // Close the product's series at zero and drop its stock from the category
+    int quantity = it->second->getQuantity();
+    it->second->setQuantity(0);
+    recordStockLevel(*it->second, -quantity);
+    publishVersionLocked(*it->second, true);
     products_.erase(it);
+    low_stock_ids_.erase(product_id);
+    
+    // Holds on a removed product can no longer be confirmed
+    for (auto hold_it = holds_.begin(); hold_it != holds_.end();) {
+        hold_it = hold_it->second.product_id == product_id ? holds_.erase(hold_it) : std::next(hold_it);
+    }
+    held_quantities_.erase(product_id);
     return true;
 }
 
@@ -45,6 +77,130 @@ bool Inventory::updateQuantity(const std::string& product_id, int new_quantity)
         return false;
     }
 
+    int old_quantity;
+    {
+        std::lock_guard<std::mutex> lock(inventory_mutex_);
+        
+        auto it = products_.find(product_id);
+        if (it == products_.end()) {
+            return false; // Product not found
+        }
+
+        try {
+            old_quantity = it->second->getQuantity();
+            it->second->setQuantity(new_quantity);
+            recordStockLevel(*it->second, new_quantity - old_quantity);
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    if (new_quantity > old_quantity) {
+        notifyRestock(product_id);
+    }
+    return true;
+}
+
+ProductUpdateResult Inventory::updateProduct(const std::string& product_id, const ProductUpdate& update,
+                                             uint64_t expected_version, uint64_t& current_version,
+                                             ProductVersion* updated_state) {
+    current_version = 0;
+    if ((update.name && update.name->empty()) || (update.price && *update.price < 0) ||
+        (update.quantity && *update.quantity < 0)) {
+        return ProductUpdateResult::INVALID;
+    }
+
+    int old_quantity;
+    int new_quantity;
+    {
+        std::lock_guard<std::mutex> lock(inventory_mutex_);
+
+        auto it = products_.find(product_id);
+        if (it == products_.end()) {
+            return ProductUpdateResult::NOT_FOUND;
+        }
+
+        Product& product = *it->second;
+        current_version = product.getVersion();
+        if (expected_version != 0 && expected_version != current_version) {
+            return ProductUpdateResult::VERSION_MISMATCH;
+        }
+
+        old_quantity = product.getQuantity();
+        new_quantity = update.quantity ? *update.quantity : old_quantity;
+
+        if (update.name) {
+            product.setName(*update.name);
+        }
+        if (update.price) {
+            product.setPrice(*update.price);
+        }
+        if (update.category && *update.category != product.getCategory()) {
+            moveCategoryLocked(product, *update.category);
+        }
+        if (update.quantity) {
+            product.setQuantity(new_quantity);
+        }
+        if (update.category || update.quantity) {
+            // Records the stock level and re-checks the (possibly new category's) threshold
+            recordStockLevel(product, new_quantity - old_quantity);
+        } else {
+            publishVersionLocked(product);
+        }
+        current_version = product.getVersion();
+        if (updated_state) {
+            *updated_state = *makeVersionLocked(product);
+        }
+    }
+
+    if (new_quantity > old_quantity) {
+        notifyRestock(product_id);
+    }
+    return ProductUpdateResult::UPDATED;
+}
+
+bool Inventory::addQuantity(const std::string& product_id, int amount) {
+    if (amount < 0) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(inventory_mutex_);
+        
+        auto it = products_.find(product_id);
+        if (it == products_.end()) {
+            return false; // Product not found
+        }
+
+        try {
+            it->second->addQuantity(amount);
+            recordStockLevel(*it->second, amount);
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    if (amount > 0) {
+        notifyRestock(product_id);
+    }
+    return true;
+}
+
+bool Inventory::removeQuantity(const std::string& product_id, int amount) {
+    if (amount < 0) {
+        return false;
+    }
+
+    StockCombining mode = combining_mode_.load(std::memory_order_relaxed);
+    if (mode == StockCombining::ALWAYS ||
+        (mode == StockCombining::AUTO && stock_combiner_.isHot(product_id))) {
+        return stock_combiner_.submit(product_id, amount);
+    }
+
+    if (mode == StockCombining::AUTO) {
+        stock_combiner_.recordHit(product_id);
+    }
+
     std::lock_guard<std::mutex> lock(inventory_mutex_);
     
     auto it = products_.find(product_id);
@@ -53,67 +209,328 @@ bool Inventory::updateQuantity(const std::string& product_id, int new_quantity)
     }
 
     try {
-        it->second->setQuantity(new_quantity);
+        if (it->second->getQuantity() - heldQuantityLocked(product_id) < amount) {
+            return false; // Insufficient quantity (held stock is not available)
+        }
+        removeStockLocked(*it->second, amount);
         return true;
     } catch (const std::exception&) {
         return false;
     }
 }
 
-bool Inventory::addQuantity(const std::string& product_id, int amount) {
-    if (amount < 0) {
-        return false;
+int Inventory::releaseQuantities(const std::vector<std::pair<std::string, int>>& releases) {
+    std::unordered_map<std::string, int> totals;
+    for (const auto& release : releases) {
+        if (release.second > 0) {
+            totals[release.first] += release.second;
+        }
     }
 
+    int released = 0;
+    std::vector<std::string> restocked;
+    restocked.reserve(totals.size());
+    {
+        std::lock_guard<std::mutex> lock(inventory_mutex_);
+        VersionStore::Group version_group(versions_.get());
+
+        for (const auto& total : totals) {
+            auto it = products_.find(total.first);
+            if (it == products_.end()) {
+                continue; // Product removed since the stock was reserved
+            }
+
+            try {
+                it->second->addQuantity(total.second);
+                recordStockLevel(*it->second, total.second);
+            } catch (const std::exception&) {
+                continue;
+            }
+            released += total.second;
+            restocked.push_back(total.first);
+        }
+    }
+
+    for (const auto& product_id : restocked) {
+        notifyRestock(product_id);
+    }
+    return released;
+}
+
+void Inventory::setStockCombining(StockCombining mode) {
+    combining_mode_.store(mode, std::memory_order_relaxed);
+}
+
+size_t Inventory::reserveBatch(const std::vector<std::vector<std::pair<std::string, int>>>& orders,
+                               std::vector<bool>& reserved) {
+    reserved.assign(orders.size(), false);
+    size_t reserved_count = 0;
+
+    struct Allocation {
+        Product* product;
+        int available;
+        int taken;
+    };
+    std::unordered_map<std::string, Allocation> allocations;
+
     std::lock_guard<std::mutex> lock(inventory_mutex_);
-    
+    VersionStore::Group version_group(versions_.get());
+
+    for (size_t i = 0; i < orders.size(); ++i) {
+        const auto& lines = orders[i];
+        size_t applied = 0;
+        bool ok = !lines.empty();
+
+        for (; ok && applied < lines.size(); ++applied) {
+            const auto& line = lines[applied];
+            auto it = allocations.find(line.first);
+            if (it == allocations.end()) {
+                auto product_it = products_.find(line.first);
+                Product* product = product_it != products_.end() ? product_it->second.get() : nullptr;
+                int available = product ? product->getQuantity() - heldQuantityLocked(line.first) : 0;
+                it = allocations.emplace(line.first, Allocation{product, available, 0}).first;
+            }
+
+            Allocation& allocation = it->second;
+            ok = allocation.product && line.second > 0 &&
+                 allocation.taken + line.second <= allocation.available;
+            if (ok) {
+                allocation.taken += line.second;
+            }
+        }
+
+        if (!ok) {
+            // Undo the lines this order had already taken
+            for (size_t j = 0; j + 1 < applied; ++j) {
+                allocations[lines[j].first].taken -= lines[j].second;
+            }
+            continue;
+        }
+        reserved[i] = true;
+        reserved_count++;
+    }
+
+    for (auto& pair : allocations) {
+        if (pair.second.taken > 0) {
+            removeStockLocked(*pair.second.product, pair.second.taken);
+        }
+    }
+    return reserved_count;
+}
+
+void Inventory::applyRemovalBatch(const std::vector<StockCombiner::Request*>& batch) {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    VersionStore::Group version_group(versions_.get());
+
+    // Requests in a slot are nearly always for one product, so check stock once
+    // per run of the same product and remove the run's total in one update
+    Product* product = nullptr;
+    const std::string* run_key = nullptr;
+    int available = 0;
+    int removed = 0;
+
+    auto flush = [&]() {
+        if (product && removed > 0) {
+            removeStockLocked(*product, removed);
+        }
+    };
+
+    for (StockCombiner::Request* request : batch) {
+        if (!run_key || *request->key != *run_key) {
+            flush();
+            run_key = request->key;
+            removed = 0;
+            auto it = products_.find(*run_key);
+            product = it != products_.end() ? it->second.get() : nullptr;
+            available = product ? product->getQuantity() - heldQuantityLocked(*run_key) : 0;
+        }
+
+        request->success = product && request->amount <= available;
+        if (request->success) {
+            available -= request->amount;
+            removed += request->amount;
+        }
+    }
+    flush();
+}
+
+int Inventory::takeAvailableQuantity(const std::string& product_id, int max_quantity) {
+    if (max_quantity <= 0) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+
     auto it = products_.find(product_id);
     if (it == products_.end()) {
-        return false; // Product not found
+        return 0;
+    }
+
+    int taken = std::min(max_quantity, it->second->getQuantity() - heldQuantityLocked(product_id));
+    if (taken <= 0) {
+        return 0;
     }
 
     try {
-        it->second->addQuantity(amount);
-        return true;
+        removeStockLocked(*it->second, taken);
     } catch (const std::exception&) {
-        return false;
+        return 0;
     }
+    return taken;
 }
 
-bool Inventory::removeQuantity(const std::string& product_id, int amount) {
-    if (amount < 0) {
-        return false;
+void Inventory::removeStockLocked(Product& product, int amount) {
+    product.removeQuantity(amount);
+    recordStockLevel(product, -amount);
+    
+    // Check if this creates a low stock situation
+    int threshold = getThreshold(product.getId());
+    if (product.getQuantity() < threshold) {
+        std::string alert = "LOW STOCK ALERT: Product '" + 
+                          product.getName() + "' (ID: " + product.getId() + 
+                          ") is now at " + std::to_string(product.getQuantity()) + 
+                          " units (threshold: " + std::to_string(threshold) + ")";
+        sendAlert(alert);
+    }
+}
+
+uint64_t Inventory::placeHold(const std::string& product_id, int quantity, std::chrono::milliseconds ttl) {
+    if (quantity <= 0 || ttl <= std::chrono::milliseconds::zero()) {
+        return 0;
     }
+    // Keeps the deadline and expiry tick below from overflowing
+    ttl = std::min(ttl, MAX_HOLD_TTL);
 
     std::lock_guard<std::mutex> lock(inventory_mutex_);
-    
+    expireHoldsLocked();
+
     auto it = products_.find(product_id);
-    if (it == products_.end()) {
-        return false; // Product not found
+    if (it == products_.end() || it->second->getQuantity() - heldQuantityLocked(product_id) < quantity) {
+        return 0;
+    }
+
+    uint64_t hold_id = IdGenerator::getShared().next();
+    holds_[hold_id] = StockHold{hold_id, product_id, quantity, std::chrono::system_clock::now() + ttl};
+    held_quantities_[product_id] += quantity;
+    publishStockLocked(*it->second);
+
+    // Round up so a hold never expires before its TTL
+    auto due = std::chrono::steady_clock::now() - hold_clock_origin_ + ttl;
+    uint64_t expiry_tick = static_cast<uint64_t>((due + HOLD_TICK - std::chrono::nanoseconds(1)) / HOLD_TICK);
+    hold_expiry_.schedule(hold_id, expiry_tick);
+
+    return hold_id;
+}
+
+bool Inventory::confirmHold(uint64_t hold_id) {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    expireHoldsLocked();
+
+    auto hold_it = holds_.find(hold_id);
+    if (hold_it == holds_.end()) {
+        return false; // Unknown, already settled, or expired
+    }
+
+    auto product_it = products_.find(hold_it->second.product_id);
+    int quantity = hold_it->second.quantity;
+    // Publishing now would briefly show the held stock as available again
+    dropHoldLocked(hold_it, false);
+
+    // The product may have been removed or recounted below the hold since it was placed
+    if (product_it == products_.end()) {
+        return false;
+    }
+    if (product_it->second->getQuantity() < quantity) {
+        publishStockLocked(*product_it->second);
+        return false;
     }
 
     try {
-        if (it->second->getQuantity() < amount) {
-            return false; // Insufficient quantity
-        }
-        it->second->removeQuantity(amount);
-        
-        // Check if this creates a low stock situation
-        int threshold = getThreshold(product_id);
-        if (it->second->getQuantity() < threshold) {
-            std::string alert = "LOW STOCK ALERT: Product '" + 
-                              it->second->getName() + "' (ID: " + product_id + 
-                              ") is now at " + std::to_string(it->second->getQuantity()) + 
-                              " units (threshold: " + std::to_string(threshold) + ")";
-            sendAlert(alert);
-        }
-        
+        removeStockLocked(*product_it->second, quantity);
         return true;
     } catch (const std::exception&) {
+        publishStockLocked(*product_it->second);
         return false;
     }
 }
 
+bool Inventory::releaseHold(uint64_t hold_id) {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    expireHoldsLocked();
+
+    auto it = holds_.find(hold_id);
+    if (it == holds_.end()) {
+        return false;
+    }
+
+    dropHoldLocked(it);
+    return true;
+}
+
+size_t Inventory::expireHolds() {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    return expireHoldsLocked();
+}
+
+bool Inventory::getHold(uint64_t hold_id, StockHold& hold) const {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+
+    auto it = holds_.find(hold_id);
+    if (it == holds_.end()) {
+        return false;
+    }
+    hold = it->second;
+    return true;
+}
+
+int Inventory::getHeldQuantity(const std::string& product_id) const {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    return heldQuantityLocked(product_id);
+}
+
+size_t Inventory::getHoldCount() const {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    return holds_.size();
+}
+
+void Inventory::dropHoldLocked(std::unordered_map<uint64_t, StockHold>::iterator it, bool publish) {
+    // The wheel entry stays behind and is ignored when it fires
+    auto held_it = held_quantities_.find(it->second.product_id);
+    if (held_it != held_quantities_.end()) {
+        held_it->second -= it->second.quantity;
+        if (held_it->second <= 0) {
+            held_quantities_.erase(held_it);
+        }
+    }
+
+    if (publish) {
+        auto product_it = products_.find(it->second.product_id);
+        if (product_it != products_.end()) {
+            publishStockLocked(*product_it->second);
+        }
+    }
+    holds_.erase(it);
+}
+
+size_t Inventory::expireHoldsLocked() {
+    uint64_t now_tick = static_cast<uint64_t>((std::chrono::steady_clock::now() - hold_clock_origin_) / HOLD_TICK);
+
+    size_t expired = 0;
+    hold_expiry_.advance(now_tick, [this, &expired](uint64_t hold_id) {
+        auto it = holds_.find(hold_id);
+        if (it != holds_.end()) {
+            dropHoldLocked(it);
+            expired++;
+        }
+    });
+    return expired;
+}
+
+int Inventory::heldQuantityLocked(const std::string& product_id) const {
+    auto it = held_quantities_.find(product_id);
+    return it != held_quantities_.end() ? it->second : 0;
+}
+
 const Product* Inventory::getProduct(const std::string& product_id) const {
     std::lock_guard<std::mutex> lock(inventory_mutex_);
     
@@ -125,6 +542,17 @@ const Product* Inventory::getProduct(const std::string& product_id) const {
     return it->second.get();
 }
 
+bool Inventory::getProductState(const std::string& product_id, ProductVersion& state) const {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+
+    auto it = products_.find(product_id);
+    if (it == products_.end()) {
+        return false;
+    }
+    state = *makeVersionLocked(*it->second);
+    return true;
+}
+
 std::vector<const Product*> Inventory::getAllProducts() const {
     std::lock_guard<std::mutex> lock(inventory_mutex_);
     
@@ -172,11 +600,12 @@ std::vector<const Product*> Inventory::getLowStockProducts() const {
     std::lock_guard<std::mutex> lock(inventory_mutex_);
     
     std::vector<const Product*> result;
+    result.reserve(low_stock_ids_.size());
     
-    for (const auto& pair : products_) {
-        int threshold = getThreshold(pair.first);
-        if (pair.second->getQuantity() < threshold) {
-            result.push_back(pair.second.get());
+    for (const auto& product_id : low_stock_ids_) {
+        auto it = products_.find(product_id);
+        if (it != products_.end()) {
+            result.push_back(it->second.get());
         }
     }
     
@@ -257,7 +686,21 @@ std::unordered_map<std::string, double> Inventory::getValueByCategory() const {
 
 void Inventory::setCategoryThreshold(const std::string& category, int threshold) {
     std::lock_guard<std::mutex> lock(inventory_mutex_);
+    VersionStore::Group version_group(versions_.get());
     category_thresholds_[category] = threshold;
+
+    InventoryChange change;
+    change.kind = InventoryChange::Kind::THRESHOLD;
+    change.category = category;
+    change.threshold = threshold;
+    notifyChangeLocked(change);
+
+    for (const auto& pair : products_) {
+        if (pair.second->getCategory() == category) {
+            updateLowStockLocked(*pair.second);
+            publishVersionLocked(*pair.second);
+        }
+    }
 }
 
 int Inventory::getThreshold(const std::string& product_id) const {
@@ -282,6 +725,18 @@ void Inventory::registerAlertCallback(std::function<void(const std::string&)> ca
     alert_callbacks_.push_back(callback);
 }
 
+uint64_t Inventory::addRestockListener(RestockListener listener) {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    uint64_t listener_id = next_restock_listener_id_++;
+    restock_listeners_[listener_id] = std::move(listener);
+    return listener_id;
+}
+
+void Inventory::removeRestockListener(uint64_t listener_id) {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    restock_listeners_.erase(listener_id);
+}
+
 void Inventory::checkAndSendLowStockAlerts() {
     auto low_stock_products = getLowStockProducts();
     
@@ -418,19 +873,20 @@ std::string Inventory::generateExpiryReport() const {
 }
 
 bool Inventory::hasProduct(const std::string& product_id) const {
-    std::lock_guard<std::mutex> lock(inventory_mutex_);
-    return products_.find(product_id) != products_.end();
+    ProductStock stock;
+    return stock_table_.read(product_id, stock);
 }
 
 int Inventory::getAvailableQuantity(const std::string& product_id) const {
-    std::lock_guard<std::mutex> lock(inventory_mutex_);
-    
-    auto it = products_.find(product_id);
-    if (it == products_.end()) {
+    ProductStock stock;
+    if (!stock_table_.read(product_id, stock)) {
         return -1; // Product not found
     }
-    
-    return it->second->getQuantity();
+    return stock.available_quantity;
+}
+
+bool Inventory::readStock(const std::string& product_id, ProductStock& stock) const {
+    return stock_table_.read(product_id, stock);
 }
 
 std::vector<std::string> Inventory::validateInventory() const {
@@ -463,6 +919,436 @@ std::vector<std::string> Inventory::validateInventory() const {
     return errors;
 }
 
+InventorySnapshot Inventory::snapshot(int expiring_days, ThreadPool* pool) const {
+    InventorySnapshot result;
+    if (isVersioningEnabled()) {
+        VersionStore::ReadView view = versions_->openLatest();
+        result.taken_at = std::chrono::system_clock::now();
+        auto versions = versions_->collect(view);
+        result.products.reserve(versions.size());
+        for (const auto& version : versions) {
+            result.products.push_back(makeVersionRecord(*version, result.taken_at, expiring_days));
+        }
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    result.taken_at = std::chrono::system_clock::now();
+    
+    // Shard the hash table by bucket so shards can be copied independently
+    size_t bucket_count = products_.bucket_count();
+    size_t shard_count = pool ? std::min(bucket_count, pool->getThreadCount() * 4) : 1;
+    std::vector<std::vector<ProductRecord>> shards(shard_count);
+    
+    auto copy_shard = [&](size_t shard) {
+        size_t first_bucket = bucket_count * shard / shard_count;
+        size_t last_bucket = bucket_count * (shard + 1) / shard_count;
+        std::vector<ProductRecord>& records = shards[shard];
+        
+        for (size_t bucket = first_bucket; bucket < last_bucket; ++bucket) {
+            for (auto it = products_.begin(bucket); it != products_.end(bucket); ++it) {
+                records.push_back(makeProductRecord(*it->second, expiring_days));
+            }
+        }
+    };
+    
+    if (pool && shard_count > 1) {
+        pool->parallelFor(shard_count, copy_shard);
+    } else if (shard_count > 0) {
+        copy_shard(0);
+    }
+    
+    if (shards.size() == 1) {
+        result.products = std::move(shards[0]);
+    } else {
+        result.products.reserve(products_.size());
+        for (auto& records : shards) {
+            std::move(records.begin(), records.end(), std::back_inserter(result.products));
+        }
+    }
+    
+    return result;
+}
+
+void Inventory::forEachProduct(const std::function<void(const ProductRecord&)>& visitor,
+                               int expiring_days, size_t batch_size) const {
+    if (isVersioningEnabled()) {
+        forEachProduct(openReadView(), visitor, expiring_days);
+        return;
+    }
+
+    std::vector<ProductRecord> batch;
+    batch.reserve(batch_size);
+    size_t bucket = 0;
+    bool done = false;
+    
+    while (!done) {
+        batch.clear();
+        {
+            std::lock_guard<std::mutex> lock(inventory_mutex_);
+            size_t bucket_count = products_.bucket_count();
+            
+            while (bucket < bucket_count && batch.size() < batch_size) {
+                for (auto it = products_.begin(bucket); it != products_.end(bucket); ++it) {
+                    batch.push_back(makeProductRecord(*it->second, expiring_days));
+                }
+                ++bucket;
+            }
+            done = bucket >= bucket_count;
+        }
+        
+        for (const auto& record : batch) {
+            visitor(record);
+        }
+    }
+}
+
+bool Inventory::enableVersioning(std::chrono::milliseconds retention) {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    if (versions_) {
+        return false;
+    }
+
+    auto versions = std::make_unique<VersionStore>(retention);
+    std::vector<std::shared_ptr<ProductVersion>> initial;
+    initial.reserve(products_.size());
+    for (const auto& pair : products_) {
+        initial.push_back(makeVersionLocked(*pair.second));
+    }
+    versions->seed(std::move(initial));
+
+    versions_ = std::move(versions);
+    versioning_enabled_.store(true, std::memory_order_release);
+    return true;
+}
+
+void Inventory::setChangeListener(ChangeListener listener) {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    change_listener_ = std::move(listener);
+}
+
+bool Inventory::publishSharedView(const std::string& name, size_t capacity) {
+    auto view = std::make_unique<SharedStockWriter>(name, capacity);
+    if (isPublishingSharedView() || !view->create()) {
+        return false;
+    }
+
+    // Only the records are written under the lock; the segment was set up above
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    if (shared_view_) {
+        return false;   // Lost to a concurrent call; view is removed after the lock is released
+    }
+    shared_view_ = std::move(view);
+    for (const auto& pair : products_) {
+        publishStockLocked(*pair.second);
+    }
+    return true;
+}
+
+void Inventory::stopSharedView() {
+    std::unique_ptr<SharedStockWriter> view;
+    {
+        std::lock_guard<std::mutex> lock(inventory_mutex_);
+        view = std::move(shared_view_);
+    }
+    // Unmapped outside the lock
+}
+
+bool Inventory::isPublishingSharedView() const {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    return shared_view_ != nullptr;
+}
+
+InventoryState Inventory::captureState(const std::function<void()>& on_captured) const {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+
+    InventoryState state;
+    state.products.reserve(products_.size());
+    for (const auto& pair : products_) {
+        state.products.push_back(makeVersionLocked(*pair.second));
+    }
+    state.category_thresholds = category_thresholds_;
+    state.default_threshold = default_low_stock_threshold_;
+
+    if (on_captured) {
+        on_captured();
+    }
+    return state;
+}
+
+void Inventory::restoreState(const InventoryState& state) {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    VersionStore::Group version_group(versions_.get());
+
+    default_low_stock_threshold_ = state.default_threshold;
+    category_thresholds_ = state.category_thresholds;
+
+    std::unordered_set<std::string> kept;
+    for (const auto& product : state.products) {
+        if (!product->removed) {
+            kept.insert(product->id);
+        }
+    }
+    std::vector<std::string> dropped;
+    for (const auto& pair : products_) {
+        if (kept.count(pair.first) == 0) {
+            dropped.push_back(pair.first);
+        }
+    }
+    for (const auto& product_id : dropped) {
+        removeProductLocked(product_id);
+    }
+
+    // Thresholds may have changed for every product, so all are re-applied
+    for (const auto& product : state.products) {
+        applyProductStateLocked(*product);
+    }
+}
+
+bool Inventory::applyProductState(const ProductVersion& state) {
+    std::lock_guard<std::mutex> lock(inventory_mutex_);
+    VersionStore::Group version_group(versions_.get());
+    return applyProductStateLocked(state);
+}
+
+bool Inventory::applyProductStateLocked(const ProductVersion& state) {
+    // Note: This method assumes inventory_mutex_ is already locked by the caller
+    if (state.removed) {
+        removeProductLocked(state.id);
+        return true;
+    }
+
+    std::unique_ptr<PerishableProduct> restored;
+    try {
+        // Every concrete product is perishable; others get an expiry that never arrives
+        auto expiry = state.perishable ? state.expiry_date : PerishableProduct::farFutureExpiry();
+        restored = PerishableProduct::restore(state.id, state.name, state.category, state.price,
+                                              state.quantity, expiry, state.product_version);
+    } catch (const std::exception&) {
+        return false;
+    }
+
+    int old_quantity = 0;
+    auto it = products_.find(state.id);
+    if (it != products_.end()) {
+        auto* existing = dynamic_cast<PerishableProduct*>(it->second.get());
+        if (!existing) {
+            return false;
+        }
+        old_quantity = existing->getQuantity();
+        if (existing->getCategory() != state.category) {
+            moveCategoryLocked(*existing, state.category);
+        }
+        // Readers may hold pointers from getProduct(), so the product is updated, not replaced
+        existing->restoreState(*restored);
+    } else {
+        it = products_.emplace(state.id, std::move(restored)).first;
+    }
+    recordStockLevel(*it->second, state.quantity - old_quantity);
+    return true;
+}
+
+VersionStore::ReadView Inventory::openReadView() const {
+    return isVersioningEnabled() ? versions_->openLatest() : VersionStore::ReadView();
+}
+
+VersionStore::ReadView Inventory::openReadViewAsOf(std::chrono::system_clock::time_point as_of) const {
+    return isVersioningEnabled() ? versions_->openAsOf(as_of) : VersionStore::ReadView();
+}
+
+bool Inventory::getProductRecord(const VersionStore::ReadView& view, const std::string& product_id,
+                                 ProductRecord& record, int expiring_days) const {
+    if (!isVersioningEnabled() || !view.valid()) {
+        return false;
+    }
+
+    auto version = versions_->find(view, product_id);
+    if (!version) {
+        return false;
+    }
+    auto at = std::min(view.getTime(), std::chrono::system_clock::now());
+    record = makeVersionRecord(*version, at, expiring_days);
+    return true;
+}
+
+void Inventory::forEachProduct(const VersionStore::ReadView& view,
+                               const std::function<void(const ProductRecord&)>& visitor,
+                               int expiring_days) const {
+    if (!isVersioningEnabled() || !view.valid()) {
+        return;
+    }
+
+    auto at = std::min(view.getTime(), std::chrono::system_clock::now());
+    for (const auto& version : versions_->collect(view)) {
+        visitor(makeVersionRecord(*version, at, expiring_days));
+    }
+}
+
+bool Inventory::snapshotAsOf(std::chrono::system_clock::time_point as_of, InventorySnapshot& result,
+                             int expiring_days) const {
+    VersionStore::ReadView view = openReadViewAsOf(as_of);
+    if (!view.valid()) {
+        return false;
+    }
+
+    result.products.clear();
+    result.taken_at = as_of;
+    forEachProduct(view, [&result](const ProductRecord& record) {
+        result.products.push_back(record);
+    }, expiring_days);
+    return true;
+}
+
+size_t Inventory::collectVersionGarbage() {
+    return isVersioningEnabled() ? versions_->collectGarbage() : 0;
+}
+
+ProductRecord Inventory::makeProductRecord(const Product& product, int expiring_days) const {
+    // Note: This method assumes inventory_mutex_ is already locked by the caller
+    auto threshold_it = category_thresholds_.find(product.getCategory());
+    int threshold = threshold_it != category_thresholds_.end()
+        ? threshold_it->second : default_low_stock_threshold_;
+    
+    const PerishableProduct* perishable = dynamic_cast<const PerishableProduct*>(&product);
+    bool expired = product.isExpired();
+    bool expiring_soon = perishable && perishable->expiresSoon(expiring_days);
+    
+    return {product.getId(), product.getName(), product.getCategory(),
+            product.getPrice(), product.getQuantity(), threshold,
+            expired, expiring_soon,
+            (expired || expiring_soon) ? product.getExpiryInfo() : std::string(),
+            product.getVersion()};
+}
+
+void Inventory::publishVersionLocked(const Product& product, bool removed) {
+    publishStockLocked(product, removed);
+    if (!versions_ && !change_listener_) {
+        return;
+    }
+    auto version = makeVersionLocked(product);
+    version->removed = removed;
+
+    if (change_listener_) {
+        InventoryChange change;
+        change.product = version;
+        notifyChangeLocked(change);
+    }
+    if (versions_) {
+        versions_->append(std::move(version));
+    }
+}
+
+void Inventory::publishStockLocked(const Product& product, bool removed) {
+    // Note: This method assumes inventory_mutex_ is already locked by the caller
+    if (removed) {
+        stock_table_.remove(product.getId());
+        if (shared_view_) {
+            shared_view_->remove(product.getId());
+        }
+        return;
+    }
+
+    ProductStock stock;
+    stock.quantity = product.getQuantity();
+    stock.available_quantity = std::max(0, stock.quantity - heldQuantityLocked(product.getId()));
+    stock.price = product.getPrice();
+    stock.product_version = product.getVersion();
+    if (const auto* perishable = dynamic_cast<const PerishableProduct*>(&product)) {
+        stock.perishable = true;
+        stock.expiry_date = perishable->getExpiryDate();
+    }
+    stock_table_.publish(product.getId(), stock);
+
+    if (shared_view_) {
+        shared_view_->publish(product.getId(), SharedStockRecord{stock.quantity, stock.available_quantity,
+                                                                 stock.price, stock.product_version});
+    }
+}
+
+void Inventory::notifyChangeLocked(const InventoryChange& change) {
+    // Note: This method assumes inventory_mutex_ is already locked by the caller
+    if (change_listener_) {
+        change_listener_(change);
+    }
+}
+
+void Inventory::moveCategoryLocked(Product& product, const std::string& category) {
+    // Move the stock between category totals before the category changes
+    int quantity = product.getQuantity();
+    int& old_category_quantity = category_quantities_[product.getCategory()];
+    old_category_quantity -= quantity;
+    stock_history_.record("category:" + product.getCategory(), std::chrono::system_clock::now(),
+                          old_category_quantity);
+    product.setCategory(category);
+    category_quantities_[product.getCategory()] += quantity;
+}
+
+std::shared_ptr<ProductVersion> Inventory::makeVersionLocked(const Product& product) const {
+    // Note: This method assumes inventory_mutex_ is already locked by the caller
+    auto version = std::make_shared<ProductVersion>();
+    version->id = product.getId();
+    version->name = product.getName();
+    version->category = product.getCategory();
+    version->price = product.getPrice();
+    version->quantity = product.getQuantity();
+    version->low_stock_threshold = getThreshold(product.getId());
+    version->product_version = product.getVersion();
+
+    if (const auto* perishable = dynamic_cast<const PerishableProduct*>(&product)) {
+        version->perishable = true;
+        version->expiry_date = perishable->getExpiryDate();
+    }
+    return version;
+}
+
+ProductRecord Inventory::makeVersionRecord(const ProductVersion& version,
+                                           std::chrono::system_clock::time_point at, int expiring_days) {
+    // Same flags as makeProductRecord(), evaluated at the given time instead of now
+    bool expired = version.perishable && at > version.expiry_date;
+    int days_left = static_cast<int>(
+        std::chrono::duration_cast<std::chrono::hours>(version.expiry_date - at).count() / 24);
+    bool expiring_soon = version.perishable && (expired || days_left <= expiring_days);
+
+    std::string expiry_info;
+    if (expired) {
+        expiry_info = "EXPIRED";
+    } else if (expiring_soon) {
+        expiry_info = std::to_string(days_left) + " days remaining";
+    }
+
+    return {version.id, version.name, version.category, version.price, version.quantity,
+            version.low_stock_threshold, expired, expiring_soon, expiry_info, version.product_version};
+}
+
+void Inventory::recordStockLevel(const Product& product, int quantity_change) {
+    auto now = std::chrono::system_clock::now();
+    int& category_quantity = category_quantities_[product.getCategory()];
+    category_quantity += quantity_change;
+
+    stock_history_.record("product:" + product.getId(), now, product.getQuantity());
+    stock_history_.record("category:" + product.getCategory(), now, category_quantity);
+
+    // Every stock change passes through here, which keeps the low-stock set exact
+    updateLowStockLocked(product);
+    publishVersionLocked(product);
+}
+
+void Inventory::updateLowStockLocked(const Product& product) {
+    int threshold = getThreshold(product.getId());
+    if (product.getQuantity() < threshold) {
+        low_stock_ids_.insert(product.getId());
+        return;
+    }
+
+    if (low_stock_ids_.erase(product.getId()) == 0) {
+        return;
+    }
+
+    sendAlert("LOW STOCK CLEARED: Product '" + product.getName() + "' (ID: " + product.getId() +
+              ") is back at " + std::to_string(product.getQuantity()) +
+              " units (threshold: " + std::to_string(threshold) + ")");
+}
+
 void Inventory::sendAlert(const std::string& message) {
     // Note: This method assumes inventory_mutex_ is already locked by the caller
     for (const auto& callback : alert_callbacks_) {
@@ -474,6 +1360,28 @@ void Inventory::sendAlert(const std::string& message) {
     }
 }
 
+void Inventory::notifyRestock(const std::string& product_id) {
+    std::vector<RestockListener> listeners;
+    {
+        std::lock_guard<std::mutex> lock(inventory_mutex_);
+        if (restock_listeners_.empty()) {
+            return;
+        }
+        listeners.reserve(restock_listeners_.size());
+        for (const auto& pair : restock_listeners_) {
+            listeners.push_back(pair.second);
+        }
+    }
+
+    for (const auto& listener : listeners) {
+        try {
+            listener(product_id);
+        } catch (const std::exception&) {
+            // Silently ignore listener errors to prevent system instability
+        }
+    }
+}
+
 std::string Inventory::toLowerCase(const std::string& str) const {
     std::string result = str;
     std::transform(result.begin(), result.end(), result.begin(), 
@@ -1,12 +1,13 @@
 #include "../include/NotificationSystem.hpp"
 #include "../include/Inventory.hpp"
 #include "../include/Order.hpp"
+#include "../include/ThreadPool.hpp"
 #include <sstream>
 #include <iomanip>
-#include <fstream>
 #include <iostream>
 #include <algorithm>
 #include <unordered_map>
+#include <cmath>
 
 namespace quirkventory {
 
@@ -199,19 +200,21 @@ Report::Report(const std::string& title, const std::string& generated_by)
 }
 
 bool Report::exportToFile(const std::string& filename) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
+    return exportToFile(filename, ReportFormat::TEXT);
+}
+
+bool Report::exportToFile(const std::string& filename, ReportFormat format) const {
+    FileSink sink;
+    if (!sink.open(filename)) {
         return false;
     }
     
-    // This would typically call generate(), but we need the derived class implementation
-    // For now, just export the header and footer
-    file << getHeader() << std::endl;
-    file << "Report content would be generated here..." << std::endl;
-    file << getFooter() << std::endl;
+    auto writer = ReportWriter::create(format, sink);
+    writer->beginReport(title_, generated_by_, generated_date_);
+    writeContent(*writer);
+    writer->endReport();
     
-    file.close();
-    return true;
+    return sink.close();
 }
 
 std::string Report::getHeader() const {
@@ -245,8 +248,42 @@ void Report::clearSections() {
     sections_.clear();
 }
 
+namespace {
+
+// Smallest shard worth handing to another thread
+constexpr size_t MIN_REPORT_SHARD_SIZE = 16384;
+
+size_t reportShardCount(size_t item_count, const ThreadPool& pool) {
+    size_t max_shards = pool.getThreadCount() * 4;
+    size_t shards = (item_count + MIN_REPORT_SHARD_SIZE - 1) / MIN_REPORT_SHARD_SIZE;
+    return std::max<size_t>(1, std::min(shards, max_shards));
+}
+
+/**
+ * @brief Format report sections concurrently, preserving section order
+ */
+std::vector<std::string> generateSections(ThreadPool& pool,
+                                          const std::vector<std::function<std::string()>>& sections) {
+    std::vector<std::string> results(sections.size());
+    pool.parallelFor(sections.size(), [&](size_t index) {
+        results[index] = sections[index]();
+    });
+    return results;
+}
+
+} // namespace
+
 // SalesReport Implementation
 
+void SalesReport::PeriodOrderTotals::merge(const PeriodOrderTotals& other) {
+    order_count += other.order_count;
+    revenue += other.revenue;
+    for (const auto& pair : other.status_counts) {
+        status_counts[pair.first] += pair.second;
+    }
+    customer_revenue.merge(other.customer_revenue);
+}
+
 SalesReport::SalesReport(const OrderManager* order_manager,
                         const std::chrono::system_clock::time_point& start_date,
                         const std::chrono::system_clock::time_point& end_date,
@@ -267,17 +304,74 @@ std::string SalesReport::generate() {
     oss << "Report Period: " << std::put_time(std::localtime(&start_time_t), "%Y-%m-%d") 
         << " to " << std::put_time(std::localtime(&end_time_t), "%Y-%m-%d") << std::endl << std::endl;
     
-    // Generate sections
-    oss << generateOrderSummary() << std::endl;
-    oss << generateRevenueAnalysis() << std::endl;
-    oss << generateCustomerAnalysis() << std::endl;
+    // Capture once, then format the sections concurrently
+    SalesSnapshot snapshot = captureSnapshot();
+    
+    auto sections = generateSections(ThreadPool::getShared(), {
+        [&]() { return generateOrderSummary(snapshot.orders); },
+        [&]() { return generateRevenueAnalysis(snapshot.sales); },
+        [&]() { return generateCustomerAnalysis(snapshot); }
+    });
+    
+    for (const auto& section : sections) {
+        oss << section << std::endl;
+    }
     
     oss << getFooter();
     
     return oss.str();
 }
 
-std::string SalesReport::generateOrderSummary() const {
+SalesReport::SalesSnapshot SalesReport::captureSnapshot() const {
+    SalesSnapshot snapshot;
+    if (!order_manager_) {
+        return snapshot;
+    }
+    
+    snapshot.orders = collectOrderTotals(order_manager_->getOrderSummariesInDateRange(start_date_, end_date_));
+    snapshot.sales = order_manager_->getSalesAggregator().summarize(start_date_, end_date_, getSeriesGranularity());
+    return snapshot;
+}
+
+SalesReport::PeriodOrderTotals SalesReport::collectOrderTotals(const std::vector<OrderSummaryRow>& rows) {
+    ThreadPool& pool = ThreadPool::getShared();
+    size_t shard_count = reportShardCount(rows.size(), pool);
+    std::vector<PeriodOrderTotals> shards(shard_count);
+    
+    pool.parallelFor(shard_count, [&](size_t shard) {
+        size_t first = rows.size() * shard / shard_count;
+        size_t last = rows.size() * (shard + 1) / shard_count;
+        PeriodOrderTotals& partial = shards[shard];
+        
+        for (size_t i = first; i < last; ++i) {
+            const OrderSummaryRow& order = rows[i];
+            partial.order_count++;
+            partial.status_counts[order.status]++;
+            if (order.status == OrderStatus::CONFIRMED || 
+                order.status == OrderStatus::SHIPPED ||
+                order.status == OrderStatus::DELIVERED) {
+                partial.revenue += order.total_amount;
+                partial.customer_revenue.add(order.customer_id, order.total_amount);
+            }
+        }
+    });
+    
+    PeriodOrderTotals totals;
+    for (const auto& partial : shards) {
+        totals.merge(partial);
+    }
+    return totals;
+}
+
+BucketGranularity SalesReport::getSeriesGranularity() const {
+    auto range_hours = std::chrono::duration_cast<std::chrono::hours>(end_date_ - start_date_).count();
+    if (range_hours <= 48) {
+        return BucketGranularity::HOUR;
+    }
+    return range_hours > 24 * 62 ? BucketGranularity::WEEK : BucketGranularity::DAY;
+}
+
+std::string SalesReport::generateOrderSummary(const PeriodOrderTotals& totals) const {
     std::ostringstream oss;
     oss << "ORDER SUMMARY" << std::endl;
     oss << "-------------" << std::endl;
@@ -287,44 +381,20 @@ std::string SalesReport::generateOrderSummary() const {
         return oss.str();
     }
     
-    auto all_orders = order_manager_->getAllOrders();
-    
-    // Filter orders by date range
-    std::vector<Order*> period_orders;
-    for (auto* order : all_orders) {
-        auto order_date = order->getOrderDate();
-        if (order_date >= start_date_ && order_date <= end_date_) {
-            period_orders.push_back(order);
-        }
-    }
-    
-    oss << "Total Orders in Period: " << period_orders.size() << std::endl;
-    
-    // Count by status
-    std::unordered_map<OrderStatus, int> status_counts;
-    double total_revenue = 0.0;
-    
-    for (auto* order : period_orders) {
-        status_counts[order->getStatus()]++;
-        if (order->getStatus() == OrderStatus::CONFIRMED || 
-            order->getStatus() == OrderStatus::SHIPPED ||
-            order->getStatus() == OrderStatus::DELIVERED) {
-            total_revenue += order->getTotalAmount();
-        }
-    }
+    oss << "Total Orders in Period: " << totals.order_count << std::endl;
     
     oss << std::fixed << std::setprecision(2);
-    oss << "Total Revenue: $" << total_revenue << std::endl << std::endl;
+    oss << "Total Revenue: $" << totals.revenue << std::endl << std::endl;
     
     oss << "Orders by Status:" << std::endl;
-    for (const auto& pair : status_counts) {
+    for (const auto& pair : totals.status_counts) {
         oss << "- " << orderStatusToString(pair.first) << ": " << pair.second << std::endl;
     }
     
     return oss.str();
 }
 
-std::string SalesReport::generateRevenueAnalysis() const {
+std::string SalesReport::generateRevenueAnalysis(const SalesRangeSummary& summary) const {
     std::ostringstream oss;
     oss << std::endl << "REVENUE ANALYSIS" << std::endl;
     oss << "----------------" << std::endl;
@@ -334,15 +404,141 @@ std::string SalesReport::generateRevenueAnalysis() const {
         return oss.str();
     }
     
-    // This would contain more detailed revenue analysis
-    // For now, provide basic information
-    oss << "Detailed revenue breakdown by product category, time period, etc." << std::endl;
-    oss << "would be implemented here with real order data analysis." << std::endl;
+    // Answered from pre-aggregated buckets rather than by rescanning orders
+    const SalesBucket& sales = summary.sales;
+    
+    oss << std::fixed << std::setprecision(2);
+    oss << "Confirmed Revenue: $" << sales.totals.revenue << std::endl;
+    oss << "Units Sold: " << sales.totals.units << std::endl;
+    oss << "Confirmed Orders: " << sales.totals.orders << std::endl;
+    
+    if (sales.totals.orders == 0) {
+        oss << "No confirmed sales in this period." << std::endl;
+        return oss.str();
+    }
+    
+    oss << "Average Order Value: $" << sales.totals.revenue / sales.totals.orders << std::endl;
+    
+    auto by_revenue = [](const std::pair<std::string, SalesTotals>& a,
+                         const std::pair<std::string, SalesTotals>& b) {
+        return a.second.revenue > b.second.revenue;
+    };
+    
+    std::vector<std::pair<std::string, SalesTotals>> categories(sales.by_category.begin(),
+                                                                sales.by_category.end());
+    std::sort(categories.begin(), categories.end(), by_revenue);
+    
+    oss << std::endl << "Revenue by Category:" << std::endl;
+    for (const auto& pair : categories) {
+        oss << "- " << pair.first << ": $" << pair.second.revenue 
+            << " (" << pair.second.units << " units)" << std::endl;
+    }
+    
+    oss << std::endl << "Top Products by Revenue:" << std::endl;
+    for (const auto& pair : SalesAggregator::rankProducts(sales, 10, SalesMetric::REVENUE)) {
+        oss << "- " << pair.first << ": $" << pair.second.revenue 
+            << " (" << pair.second.units << " units)" << std::endl;
+    }
+    
+    BucketGranularity granularity = getSeriesGranularity();
+    const char* time_format = granularity == BucketGranularity::HOUR ? "%Y-%m-%d %H:00" : "%Y-%m-%d";
+    const char* bucket_label = granularity == BucketGranularity::HOUR ? "Hour"
+                             : granularity == BucketGranularity::WEEK ? "Week" : "Day";
+    
+    oss << std::endl << "Revenue by " << bucket_label << " (UTC):" << std::endl;
+    for (const auto& point : summary.series) {
+        auto bucket_time_t = std::chrono::system_clock::to_time_t(point.first);
+        oss << "- " << std::put_time(std::gmtime(&bucket_time_t), time_format) 
+            << ": $" << point.second.revenue 
+            << " (" << point.second.orders << " orders)" << std::endl;
+    }
     
     return oss.str();
 }
 
-std::string SalesReport::generateCustomerAnalysis() const {
+void SalesReport::writeContent(ReportWriter& writer) const {
+    if (!order_manager_) {
+        writer.beginSection("order_summary", {"metric", "value"});
+        writer.writeNote("No order data available.");
+        return;
+    }
+    
+    SalesSnapshot snapshot = captureSnapshot();
+    const PeriodOrderTotals& totals = snapshot.orders;
+    const SalesBucket& sales = snapshot.sales.sales;
+    
+    writer.beginSection("order_summary", {"metric", "value"});
+    writer.beginRow();
+    writer.addField("total_orders");
+    writer.addField(totals.order_count);
+    writer.endRow();
+    writer.beginRow();
+    writer.addField("total_revenue");
+    writer.addField(totals.revenue);
+    writer.endRow();
+    
+    writer.beginSection("orders_by_status", {"status", "orders"});
+    for (const auto& pair : totals.status_counts) {
+        writer.beginRow();
+        writer.addField(orderStatusToString(pair.first));
+        writer.addField(pair.second);
+        writer.endRow();
+    }
+    
+    std::vector<std::pair<std::string, SalesTotals>> categories(sales.by_category.begin(),
+                                                                sales.by_category.end());
+    std::sort(categories.begin(), categories.end(), [](const auto& a, const auto& b) {
+        return a.second.revenue > b.second.revenue;
+    });
+    
+    writer.beginSection("revenue_by_category", {"category", "revenue", "units", "orders"});
+    for (const auto& pair : categories) {
+        writer.beginRow();
+        writer.addField(pair.first);
+        writer.addField(pair.second.revenue);
+        writer.addField(pair.second.units);
+        writer.addField(pair.second.orders);
+        writer.endRow();
+    }
+    
+    writer.beginSection("top_products", {"product_id", "revenue", "units", "orders"});
+    for (const auto& pair : SalesAggregator::rankProducts(sales, 10, SalesMetric::REVENUE)) {
+        writer.beginRow();
+        writer.addField(pair.first);
+        writer.addField(pair.second.revenue);
+        writer.addField(pair.second.units);
+        writer.addField(pair.second.orders);
+        writer.endRow();
+    }
+    
+    const OrderDistribution& distribution = snapshot.sales.distribution;
+    
+    writer.beginSection("customer_analysis", {"metric", "value"});
+    writer.beginRow();
+    writer.addField("unique_customers_estimate");
+    writer.addField(static_cast<long long>(std::llround(distribution.customers.estimate())));
+    writer.endRow();
+    if (distribution.order_values.getCount() > 0) {
+        const std::pair<const char*, double> quantiles[] = {{"order_value_p50", 0.5},
+                                                            {"order_value_p95", 0.95},
+                                                            {"order_value_p99", 0.99}};
+        for (const auto& quantile : quantiles) {
+            writer.beginRow();
+            writer.addField(quantile.first);
+            writer.addField(distribution.order_values.quantile(quantile.second));
+            writer.endRow();
+        }
+    }
+    auto top_customers = totals.customer_revenue.getTopK(1);
+    if (!top_customers.empty()) {
+        writer.beginRow();
+        writer.addField("top_customer");
+        writer.addField(top_customers[0].key);
+        writer.endRow();
+    }
+}
+
+std::string SalesReport::generateCustomerAnalysis(const SalesSnapshot& snapshot) const {
     std::ostringstream oss;
     oss << std::endl << "CUSTOMER ANALYSIS" << std::endl;
     oss << "-----------------" << std::endl;
@@ -352,33 +548,25 @@ std::string SalesReport::generateCustomerAnalysis() const {
         return oss.str();
     }
     
-    auto all_orders = order_manager_->getAllOrders();
-    std::unordered_map<std::string, int> customer_order_counts;
-    std::unordered_map<std::string, double> customer_totals;
+    // Distinct customers and order-value quantiles come from the per-bucket
+    // sketches (day resolution, ~1% error) instead of a per-customer scan
+    const OrderDistribution& distribution = snapshot.sales.distribution;
+    const TDigest& order_values = distribution.order_values;
     
-    for (auto* order : all_orders) {
-        auto order_date = order->getOrderDate();
-        if (order_date >= start_date_ && order_date <= end_date_) {
-            const std::string& customer_id = order->getCustomerId();
-            customer_order_counts[customer_id]++;
-            if (order->getStatus() == OrderStatus::CONFIRMED || 
-                order->getStatus() == OrderStatus::SHIPPED ||
-                order->getStatus() == OrderStatus::DELIVERED) {
-                customer_totals[customer_id] += order->getTotalAmount();
-            }
-        }
-    }
-    
-    oss << "Unique Customers: " << customer_order_counts.size() << std::endl;
+    oss << "Unique Customers (est.): " << static_cast<long long>(std::llround(distribution.customers.estimate())) << std::endl;
     oss << std::fixed << std::setprecision(2);
     
-    if (!customer_totals.empty()) {
-        // Find top customer by revenue
-        auto top_customer = std::max_element(customer_totals.begin(), customer_totals.end(),
-            [](const auto& a, const auto& b) { return a.second < b.second; });
-        
-        oss << "Top Customer by Revenue: " << top_customer->first 
-            << " ($" << top_customer->second << ")" << std::endl;
+    if (order_values.getCount() > 0) {
+        oss << "Order Value Median: $" << order_values.quantile(0.5) << std::endl;
+        oss << "Order Value p95: $" << order_values.quantile(0.95) << std::endl;
+        oss << "Order Value p99: $" << order_values.quantile(0.99) << std::endl;
+    }
+    
+    // Estimated from the customer sketch; never below the true revenue
+    auto top_customers = snapshot.orders.customer_revenue.getTopK(1);
+    if (!top_customers.empty()) {
+        oss << "Top Customer by Revenue: " << top_customers[0].key 
+            << " ($" << top_customers[0].count << ")" << std::endl;
     }
     
     return oss.str();
@@ -389,9 +577,11 @@ std::string SalesReport::generateCustomerAnalysis() const {
 InventoryReport::InventoryReport(const Inventory* inventory,
                                const std::string& generated_by,
                                bool include_low_stock,
-                               bool include_expired)
+                               bool include_expired,
+                               bool include_product_listing)
     : Report("Inventory Report", generated_by), inventory_(inventory),
-      include_low_stock_(include_low_stock), include_expired_(include_expired) {
+      include_low_stock_(include_low_stock), include_expired_(include_expired),
+      include_product_listing_(include_product_listing) {
 }
 
 std::string InventoryReport::generate() {
@@ -400,16 +590,27 @@ std::string InventoryReport::generate() {
     std::ostringstream oss;
     oss << getHeader() << std::endl;
     
-    // Generate sections
-    oss << generateInventoryOverview() << std::endl;
-    oss << generateCategoryBreakdown() << std::endl;
+    // Every section works from the same snapshot of the inventory
+    ThreadPool& pool = ThreadPool::getShared();
+    InventorySnapshot snapshot;
+    if (inventory_) {
+        snapshot = inventory_->snapshot(7, &pool);
+    }
+    InventoryTotals totals = collectInventoryTotals(snapshot.products);
     
+    std::vector<std::function<std::string()>> section_generators = {
+        [&]() { return generateInventoryOverview(totals); },
+        [&]() { return generateCategoryBreakdown(totals); }
+    };
     if (include_low_stock_) {
-        oss << generateLowStockSection() << std::endl;
+        section_generators.push_back([&]() { return generateLowStockSection(totals); });
     }
-    
     if (include_expired_) {
-        oss << generateExpiredSection() << std::endl;
+        section_generators.push_back([&]() { return generateExpiredSection(totals); });
+    }
+    
+    for (const auto& section : generateSections(pool, section_generators)) {
+        oss << section << std::endl;
     }
     
     oss << getFooter();
@@ -417,7 +618,54 @@ std::string InventoryReport::generate() {
     return oss.str();
 }
 
-std::string InventoryReport::generateInventoryOverview() const {
+void InventoryReport::InventoryTotals::merge(const InventoryTotals& other) {
+    product_count += other.product_count;
+    total_quantity += other.total_quantity;
+    total_value += other.total_value;
+    for (const auto& pair : other.category_values) {
+        category_values[pair.first] += pair.second;
+    }
+    low_stock.insert(low_stock.end(), other.low_stock.begin(), other.low_stock.end());
+    expired.insert(expired.end(), other.expired.begin(), other.expired.end());
+    expiring_soon.insert(expiring_soon.end(), other.expiring_soon.begin(), other.expiring_soon.end());
+}
+
+InventoryReport::InventoryTotals InventoryReport::collectInventoryTotals(const std::vector<ProductRecord>& products) {
+    ThreadPool& pool = ThreadPool::getShared();
+    size_t shard_count = reportShardCount(products.size(), pool);
+    std::vector<InventoryTotals> shards(shard_count);
+    
+    pool.parallelFor(shard_count, [&](size_t shard) {
+        size_t first = products.size() * shard / shard_count;
+        size_t last = products.size() * (shard + 1) / shard_count;
+        InventoryTotals& partial = shards[shard];
+        
+        for (size_t i = first; i < last; ++i) {
+            const ProductRecord& product = products[i];
+            partial.product_count++;
+            partial.total_quantity += product.quantity;
+            partial.total_value += product.getTotalValue();
+            partial.category_values[product.category] += product.getTotalValue();
+            if (product.isLowStock()) {
+                partial.low_stock.push_back(&product);
+            }
+            if (product.expired) {
+                partial.expired.push_back(&product);
+            }
+            if (product.expiring_soon) {
+                partial.expiring_soon.push_back(&product);
+            }
+        }
+    });
+    
+    InventoryTotals totals;
+    for (const auto& partial : shards) {
+        totals.merge(partial);
+    }
+    return totals;
+}
+
+std::string InventoryReport::generateInventoryOverview(const InventoryTotals& totals) const {
     std::ostringstream oss;
     oss << "INVENTORY OVERVIEW" << std::endl;
     oss << "------------------" << std::endl;
@@ -428,22 +676,18 @@ std::string InventoryReport::generateInventoryOverview() const {
     }
     
     oss << std::fixed << std::setprecision(2);
-    oss << "Total Products: " << inventory_->getTotalProductCount() << std::endl;
-    oss << "Total Quantity: " << inventory_->getTotalQuantity() << std::endl;
-    oss << "Total Value: $" << inventory_->getTotalValue() << std::endl;
+    oss << "Total Products: " << totals.product_count << std::endl;
+    oss << "Total Quantity: " << totals.total_quantity << std::endl;
+    oss << "Total Value: $" << totals.total_value << std::endl;
     
-    auto low_stock = inventory_->getLowStockProducts();
-    auto expired = inventory_->getExpiredProducts();
-    auto expiring = inventory_->getExpiringSoonProducts();
-    
-    oss << "Low Stock Items: " << low_stock.size() << std::endl;
-    oss << "Expired Items: " << expired.size() << std::endl;
-    oss << "Items Expiring Soon: " << expiring.size() << std::endl;
+    oss << "Low Stock Items: " << totals.low_stock.size() << std::endl;
+    oss << "Expired Items: " << totals.expired.size() << std::endl;
+    oss << "Items Expiring Soon: " << totals.expiring_soon.size() << std::endl;
     
     return oss.str();
 }
 
-std::string InventoryReport::generateCategoryBreakdown() const {
+std::string InventoryReport::generateCategoryBreakdown(const InventoryTotals& totals) const {
     std::ostringstream oss;
     oss << std::endl << "CATEGORY BREAKDOWN" << std::endl;
     oss << "------------------" << std::endl;
@@ -453,18 +697,16 @@ std::string InventoryReport::generateCategoryBreakdown() const {
         return oss.str();
     }
     
-    auto category_values = inventory_->getValueByCategory();
-    
     oss << std::fixed << std::setprecision(2);
     oss << "Value by Category:" << std::endl;
-    for (const auto& pair : category_values) {
+    for (const auto& pair : totals.category_values) {
         oss << "- " << pair.first << ": $" << pair.second << std::endl;
     }
     
     return oss.str();
 }
 
-std::string InventoryReport::generateLowStockSection() const {
+std::string InventoryReport::generateLowStockSection(const InventoryTotals& totals) const {
     std::ostringstream oss;
     oss << std::endl << "LOW STOCK ANALYSIS" << std::endl;
     oss << "------------------" << std::endl;
@@ -474,22 +716,22 @@ std::string InventoryReport::generateLowStockSection() const {
         return oss.str();
     }
     
-    auto low_stock_products = inventory_->getLowStockProducts();
+    const auto& low_stock_products = totals.low_stock;
     
     if (low_stock_products.empty()) {
         oss << "No products are currently low in stock." << std::endl;
     } else {
         oss << "Products requiring attention (" << low_stock_products.size() << "):" << std::endl;
         for (const auto* product : low_stock_products) {
-            oss << "- " << product->getName() << " (ID: " << product->getId() 
-                << ") - Stock: " << product->getQuantity() << std::endl;
+            oss << "- " << product->name << " (ID: " << product->id 
+                << ") - Stock: " << product->quantity << std::endl;
         }
     }
     
     return oss.str();
 }
 
-std::string InventoryReport::generateExpiredSection() const {
+std::string InventoryReport::generateExpiredSection(const InventoryTotals& totals) const {
     std::ostringstream oss;
     oss << std::endl << "EXPIRY ANALYSIS" << std::endl;
     oss << "---------------" << std::endl;
@@ -499,14 +741,14 @@ std::string InventoryReport::generateExpiredSection() const {
         return oss.str();
     }
     
-    auto expired_products = inventory_->getExpiredProducts();
-    auto expiring_products = inventory_->getExpiringSoonProducts();
+    const auto& expired_products = totals.expired;
+    const auto& expiring_products = totals.expiring_soon;
     
     if (!expired_products.empty()) {
         oss << "EXPIRED PRODUCTS (" << expired_products.size() << "):" << std::endl;
         for (const auto* product : expired_products) {
-            oss << "- " << product->getName() << " (ID: " << product->getId() 
-                << ") - " << product->getExpiryInfo() << std::endl;
+            oss << "- " << product->name << " (ID: " << product->id 
+                << ") - " << product->expiry_info << std::endl;
         }
         oss << std::endl;
     }
@@ -514,8 +756,8 @@ std::string InventoryReport::generateExpiredSection() const {
     if (!expiring_products.empty()) {
         oss << "EXPIRING SOON (" << expiring_products.size() << "):" << std::endl;
         for (const auto* product : expiring_products) {
-            oss << "- " << product->getName() << " (ID: " << product->getId() 
-                << ") - " << product->getExpiryInfo() << std::endl;
+            oss << "- " << product->name << " (ID: " << product->id 
+                << ") - " << product->expiry_info << std::endl;
         }
     }
     
@@ -526,6 +768,128 @@ std::string InventoryReport::generateExpiredSection() const {
     return oss.str();
 }
 
+void InventoryReport::writeContent(ReportWriter& writer) const {
+    if (!inventory_) {
+        writer.beginSection("inventory_overview", {"metric", "value"});
+        writer.writeNote("No inventory data available.");
+        return;
+    }
+    
+    // Every pass reads the same state: a pinned view when the inventory keeps
+    // versions (streamed in bounded memory), otherwise one snapshot
+    VersionStore::ReadView view = inventory_->openReadView();
+    InventorySnapshot snapshot;
+    if (!view.valid()) {
+        snapshot = inventory_->snapshot(7, &ThreadPool::getShared());
+    }
+    auto for_each_product = [&](const std::function<void(const ProductRecord&)>& visitor) {
+        if (view.valid()) {
+            inventory_->forEachProduct(view, visitor);
+        } else {
+            for (const auto& product : snapshot.products) {
+                visitor(product);
+            }
+        }
+    };
+    
+    // First pass: totals only (no per-product lists)
+    size_t product_count = 0;
+    long long total_quantity = 0;
+    double total_value = 0.0;
+    size_t low_stock_count = 0;
+    size_t expired_count = 0;
+    size_t expiring_count = 0;
+    std::map<std::string, double> category_values;
+    
+    for_each_product([&](const ProductRecord& product) {
+        product_count++;
+        total_quantity += product.quantity;
+        total_value += product.getTotalValue();
+        category_values[product.category] += product.getTotalValue();
+        low_stock_count += product.isLowStock() ? 1 : 0;
+        expired_count += product.expired ? 1 : 0;
+        expiring_count += product.expiring_soon ? 1 : 0;
+    });
+    
+    writer.beginSection("inventory_overview", {"metric", "value"});
+    const std::pair<const char*, long long> counts[] = {
+        {"total_products", static_cast<long long>(product_count)},
+        {"total_quantity", total_quantity},
+        {"low_stock_items", static_cast<long long>(low_stock_count)},
+        {"expired_items", static_cast<long long>(expired_count)},
+        {"expiring_soon_items", static_cast<long long>(expiring_count)}
+    };
+    for (const auto& count : counts) {
+        writer.beginRow();
+        writer.addField(count.first);
+        writer.addField(count.second);
+        writer.endRow();
+    }
+    writer.beginRow();
+    writer.addField("total_value");
+    writer.addField(total_value);
+    writer.endRow();
+    
+    writer.beginSection("category_breakdown", {"category", "value"});
+    for (const auto& pair : category_values) {
+        writer.beginRow();
+        writer.addField(pair.first);
+        writer.addField(pair.second);
+        writer.endRow();
+    }
+    
+    if (include_low_stock_) {
+        writer.beginSection("low_stock", {"id", "name", "category", "quantity", "threshold"});
+        for_each_product([&writer](const ProductRecord& product) {
+            if (!product.isLowStock()) {
+                return;
+            }
+            writer.beginRow();
+            writer.addField(product.id);
+            writer.addField(product.name);
+            writer.addField(product.category);
+            writer.addField(product.quantity);
+            writer.addField(product.low_stock_threshold);
+            writer.endRow();
+        });
+        if (low_stock_count == 0) {
+            writer.writeNote("No products are currently low in stock.");
+        }
+    }
+    
+    if (include_expired_) {
+        writer.beginSection("expiry", {"id", "name", "status", "expiry_info"});
+        for_each_product([&writer](const ProductRecord& product) {
+            if (!product.expired && !product.expiring_soon) {
+                return;
+            }
+            writer.beginRow();
+            writer.addField(product.id);
+            writer.addField(product.name);
+            writer.addField(product.expired ? "expired" : "expiring_soon");
+            writer.addField(product.expiry_info);
+            writer.endRow();
+        });
+        if (expired_count == 0 && expiring_count == 0) {
+            writer.writeNote("No products are expired or expiring soon.");
+        }
+    }
+    
+    if (include_product_listing_) {
+        writer.beginSection("products", {"id", "name", "category", "price", "quantity", "value"});
+        for_each_product([&writer](const ProductRecord& product) {
+            writer.beginRow();
+            writer.addField(product.id);
+            writer.addField(product.name);
+            writer.addField(product.category);
+            writer.addField(product.price);
+            writer.addField(product.quantity);
+            writer.addField(product.getTotalValue());
+            writer.endRow();
+        });
+    }
+}
+
 // NotificationManager Implementation
 
 NotificationManager::NotificationManager(size_t max_history)
@@ -1,4 +1,8 @@
 #include "../include/Order.hpp"
+#include "../include/OrderArchive.hpp"
+#include "../include/BackorderQueue.hpp"
+#include "../include/IdGenerator.hpp"
+#include "../include/ThreadPool.hpp"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
@@ -17,16 +21,18 @@ std::string orderStatusToString(OrderStatus status) {
         case OrderStatus::DELIVERED: return "DELIVERED";
         case OrderStatus::CANCELLED: return "CANCELLED";
         case OrderStatus::FAILED: return "FAILED";
+        case OrderStatus::BACKORDERED: return "BACKORDERED";
         default: return "UNKNOWN";
     }
 }
 
 // Order Implementation
 
-Order::Order(const std::string& order_id, const std::string& customer_id)
+Order::Order(const std::string& order_id, const std::string& customer_id,
+             const std::chrono::system_clock::time_point& order_date)
     : order_id_(order_id), customer_id_(customer_id), status_(OrderStatus::PENDING),
-      order_date_(std::chrono::system_clock::now()), total_amount_(0.0),
-      processing_flag_(false) {
+      order_date_(order_date), total_amount_(0.0),
+      processing_flag_(false), delivering_changes_(false) {
     
     if (order_id.empty()) {
         throw std::invalid_argument("Order ID cannot be empty");
@@ -51,6 +57,11 @@ void Order::setNotes(const std::string& notes) {
     notes_ = notes;
 }
 
+void Order::setStatusListener(OrderStatusListener listener) {
+    std::lock_guard<std::mutex> lock(order_mutex_);
+    status_listener_ = std::move(listener);
+}
+
 void Order::setCustomerId(const std::string& customer_id) {
     if (customer_id.empty()) {
         throw std::invalid_argument("Customer ID cannot be empty");
@@ -154,7 +165,7 @@ const OrderItem* Order::getItem(const std::string& product_id) const {
     return (it != items_.end()) ? &(*it) : nullptr;
 }
 
-std::vector<std::string> Order::validateOrder(const Inventory& inventory) const {
+std::vector<std::string> Order::validateOrder(const Inventory& inventory, bool check_availability) const {
     std::lock_guard<std::mutex> lock(order_mutex_);
     
     std::vector<std::string> errors;
@@ -164,40 +175,42 @@ std::vector<std::string> Order::validateOrder(const Inventory& inventory) const
         return errors;
     }
 
+    auto now = std::chrono::system_clock::now();
     for (const auto& item : items_) {
-        // Check if product exists in inventory
-        const Product* product = inventory.getProduct(item.product_id);
-        if (!product) {
+        // One consistent, lock-free read of the product's stock, price and expiry
+        ProductStock stock;
+        if (!inventory.readStock(item.product_id, stock)) {
             errors.push_back("Product not found: " + item.product_id);
             continue;
         }
 
-        // Check if sufficient quantity is available
-        if (product->getQuantity() < item.quantity) {
+        // Check if sufficient quantity is available (stock held for checkouts excluded)
+        int available = stock.available_quantity;
+        if (check_availability && available < item.quantity) {
             errors.push_back("Insufficient quantity for product " + item.product_id + 
                            ": requested " + std::to_string(item.quantity) + 
-                           ", available " + std::to_string(product->getQuantity()));
+                           ", available " + std::to_string(available));
         }
 
         // Check if product is expired
-        if (product->isExpired()) {
+        if (stock.isExpired(now)) {
             errors.push_back("Product is expired: " + item.product_id);
         }
 
         // Check price consistency (within 5% tolerance)
-        double price_diff = std::abs(product->getPrice() - item.unit_price);
-        double price_tolerance = product->getPrice() * 0.05;
+        double price_diff = std::abs(stock.price - item.unit_price);
+        double price_tolerance = stock.price * 0.05;
         if (price_diff > price_tolerance) {
             errors.push_back("Price mismatch for product " + item.product_id + 
                            ": order price $" + std::to_string(item.unit_price) + 
-                           ", current price $" + std::to_string(product->getPrice()));
+                           ", current price $" + std::to_string(stock.price));
         }
     }
 
     return errors;
 }
 
-bool Order::processOrder(Inventory& inventory) {
+bool Order::processOrder(Inventory& inventory, bool allow_backorder) {
     // Check if already processing
     bool expected = false;
     if (!processing_flag_.compare_exchange_strong(expected, true)) {
@@ -205,7 +218,7 @@ bool Order::processOrder(Inventory& inventory) {
         return false;
     }
 
-    bool result = processOrderInternal(inventory);
+    bool result = processOrderInternal(inventory, allow_backorder);
     processing_flag_.store(false);
     return result;
 }
@@ -216,23 +229,56 @@ std::future<bool> Order::processOrderAsync(Inventory& inventory) {
     });
 }
 
-bool Order::cancelOrder(const std::string& reason) {
-    std::lock_guard<std::mutex> lock(order_mutex_);
+bool Order::cancelOrder(const std::string& reason, StockReleases* releases) {
+    std::unique_lock<std::mutex> lock(order_mutex_);
     
     if (status_ == OrderStatus::DELIVERED || status_ == OrderStatus::SHIPPED) {
         return false; // Cannot cancel delivered or shipped orders
     }
 
+    OrderStatus old_status = status_;
     status_ = OrderStatus::CANCELLED;
     if (!reason.empty()) {
         notes_ = reason;
     }
-    
+
+    // Another thread delivering this order's changes may get to ours after
+    // we return, when the caller's collector is no longer being filled
+    queueStatusChange(old_status, OrderStatus::CANCELLED, delivering_changes_ ? nullptr : releases);
+    deliverStatusChanges(lock);
     return true;
 }
 
+int Order::fillBackorder(const std::string& product_id, int quantity) {
+    std::unique_lock<std::mutex> lock(order_mutex_);
+    
+    if (status_ != OrderStatus::BACKORDERED || quantity <= 0) {
+        return 0;
+    }
+
+    int filled = 0;
+    bool waiting = false;
+    for (auto& item : items_) {
+        if (item.product_id == product_id && item.backordered > 0 && filled < quantity) {
+            int units = std::min(item.backordered, quantity - filled);
+            item.backordered -= units;
+            filled += units;
+        }
+        waiting = waiting || item.backordered > 0;
+    }
+
+    if (filled > 0 && !waiting) {
+        status_ = OrderStatus::CONFIRMED;
+        processed_date_ = std::chrono::system_clock::now();
+        queueStatusChange(OrderStatus::BACKORDERED, OrderStatus::CONFIRMED);
+        deliverStatusChanges(lock);
+    }
+    
+    return filled;
+}
+
 bool Order::updateStatus(OrderStatus new_status) {
-    std::lock_guard<std::mutex> lock(order_mutex_);
+    std::unique_lock<std::mutex> lock(order_mutex_);
     
     // Validate status transition
     switch (status_) {
@@ -245,11 +291,18 @@ bool Order::updateStatus(OrderStatus new_status) {
             break;
         case OrderStatus::PROCESSING:
             if (new_status != OrderStatus::CONFIRMED && 
+                new_status != OrderStatus::BACKORDERED &&
                 new_status != OrderStatus::FAILED &&
                 new_status != OrderStatus::CANCELLED) {
                 return false;
             }
             break;
+        case OrderStatus::BACKORDERED:
+            if (new_status != OrderStatus::CONFIRMED && 
+                new_status != OrderStatus::CANCELLED) {
+                return false;
+            }
+            break;
         case OrderStatus::CONFIRMED:
             if (new_status != OrderStatus::SHIPPED && 
                 new_status != OrderStatus::CANCELLED) {
@@ -267,23 +320,20 @@ bool Order::updateStatus(OrderStatus new_status) {
             return false; // Terminal states
     }
 
+    OrderStatus old_status = status_;
     status_ = new_status;
     if (new_status == OrderStatus::CONFIRMED || new_status == OrderStatus::FAILED) {
         processed_date_ = std::chrono::system_clock::now();
     }
     
+    queueStatusChange(old_status, new_status);
+    deliverStatusChanges(lock);
     return true;
 }
 
 double Order::calculateTotal() const {
     std::lock_guard<std::mutex> lock(order_mutex_);
-    
-    double total = 0.0;
-    for (const auto& item : items_) {
-        total += item.getTotalPrice();
-    }
-    
-    return total;
+    return sumItemTotals();
 }
 
 std::string Order::getOrderSummary() const {
@@ -353,6 +403,12 @@ bool Order::canModify() const {
     return status_ == OrderStatus::PENDING;
 }
 
+OrderRecord Order::toRecord() const {
+    std::lock_guard<std::mutex> lock(order_mutex_);
+    return OrderRecord{order_id_, customer_id_, status_, order_date_, processed_date_,
+                       items_, total_amount_, notes_};
+}
+
 long long Order::getProcessingDuration() const {
     std::lock_guard<std::mutex> lock(order_mutex_);
     
@@ -364,18 +420,15 @@ long long Order::getProcessingDuration() const {
     return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
 }
 
-bool Order::processOrderInternal(Inventory& inventory) {
+bool Order::beginProcessing(const Inventory& inventory, bool check_availability) {
     // Update status to processing
-    {
+    if (!updateStatus(OrderStatus::PROCESSING)) {
         std::lock_guard<std::mutex> lock(order_mutex_);
-        if (!updateStatus(OrderStatus::PROCESSING)) {
-            setError("Cannot process order in current status");
-            return false;
-        }
+        setError("Cannot process order in current status");
+        return false;
     }
 
-    // Validate order
-    auto validation_errors = validateOrder(inventory);
+    auto validation_errors = validateOrder(inventory, check_availability);
     if (!validation_errors.empty()) {
         std::ostringstream error_stream;
         error_stream << "Validation failed: ";
@@ -388,6 +441,33 @@ bool Order::processOrderInternal(Inventory& inventory) {
         return false;
     }
 
+    captureItemCategories(inventory);
+    return true;
+}
+
+bool Order::completeProcessing(bool reserved) {
+    if (!reserved) {
+        {
+            std::lock_guard<std::mutex> lock(order_mutex_);
+            setError("Failed to reserve inventory for order");
+        }
+        updateStatus(OrderStatus::FAILED);
+        return false;
+    }
+    
+    return updateStatus(OrderStatus::CONFIRMED);
+}
+
+bool Order::processOrderInternal(Inventory& inventory, bool allow_backorder) {
+    // A shortfall is not an error when it can be backordered
+    if (!beginProcessing(inventory, !allow_backorder)) {
+        return false;
+    }
+
+    if (allow_backorder) {
+        return reserveWithBackorders(inventory);
+    }
+
     // Process each item and update inventory
     std::vector<std::pair<std::string, int>> processed_items;
     
@@ -414,8 +494,38 @@ bool Order::processOrderInternal(Inventory& inventory) {
         return false;
     }
 
-    // Order processed successfully
-    updateStatus(OrderStatus::CONFIRMED);
+    // Cancelled while reserving: the cancellation left PROCESSING stock alone
+    if (!updateStatus(OrderStatus::CONFIRMED)) {
+        inventory.releaseQuantities(processed_items);
+        std::lock_guard<std::mutex> lock(order_mutex_);
+        setError("Order was cancelled during processing");
+        return false;
+    }
+    return true;
+}
+
+bool Order::reserveWithBackorders(Inventory& inventory) {
+    // Items are fixed once PROCESSING, so stock is taken without the order lock
+    StockReleases taken;
+    for (const auto& item : items_) {
+        taken.emplace_back(item.product_id, inventory.takeAvailableQuantity(item.product_id, item.quantity));
+    }
+
+    int waiting_units = 0;
+    {
+        std::lock_guard<std::mutex> lock(order_mutex_);
+        for (size_t i = 0; i < items_.size(); ++i) {
+            items_[i].backordered = items_[i].quantity - taken[i].second;
+            waiting_units += items_[i].backordered;
+        }
+    }
+
+    if (!updateStatus(waiting_units > 0 ? OrderStatus::BACKORDERED : OrderStatus::CONFIRMED)) {
+        inventory.releaseQuantities(taken);
+        std::lock_guard<std::mutex> lock(order_mutex_);
+        setError("Order was cancelled during processing");
+        return false;
+    }
     return true;
 }
 
@@ -424,31 +534,105 @@ void Order::setError(const std::string& message) {
     error_message_ = message;
 }
 
+void Order::captureItemCategories(const Inventory& inventory) {
+    std::lock_guard<std::mutex> lock(order_mutex_);
+    for (auto& item : items_) {
+        const Product* product = inventory.getProduct(item.product_id);
+        if (product) {
+            item.category = product->getCategory();
+        }
+    }
+}
+
+void Order::queueStatusChange(OrderStatus old_status, OrderStatus new_status, StockReleases* releases) {
+    // Note: This method assumes order_mutex_ is already locked by the caller
+    if (status_listener_) {
+        pending_changes_.push_back(StatusChange{old_status, new_status, releases});
+    }
+}
+
+void Order::deliverStatusChanges(std::unique_lock<std::mutex>& lock) {
+    // A listener that changes this order again lands here re-entrantly;
+    // its change is queued behind the one being delivered
+    if (delivering_changes_) {
+        return;
+    }
+
+    delivering_changes_ = true;
+    while (!pending_changes_.empty()) {
+        StatusChange change = pending_changes_.front();
+        pending_changes_.pop_front();
+        lock.unlock();
+        try {
+            status_listener_(*this, change.old_status, change.new_status, change.releases);
+        } catch (const std::exception&) {
+            // Silently ignore listener errors to prevent system instability
+        }
+        lock.lock();
+    }
+    delivering_changes_ = false;
+}
+
 void Order::updateTotalAmount() {
     // Note: This method assumes order_mutex_ is already locked by the caller
-    total_amount_ = calculateTotal();
+    total_amount_ = sumItemTotals();
+}
+
+double Order::sumItemTotals() const {
+    // Note: This method assumes order_mutex_ is already locked by the caller
+    double total = 0.0;
+    for (const auto& item : items_) {
+        total += item.getTotalPrice();
+    }
+    
+    return total;
 }
 
 // OrderManager Implementation
 
-OrderManager::OrderManager()
-    : total_orders_processed_(0), successful_orders_(0), failed_orders_(0) {
+OrderManager::OrderManager(Inventory* inventory)
+    : total_orders_processed_(0), successful_orders_(0), failed_orders_(0),
+      archive_(std::make_unique<OrderArchive>()), inventory_(inventory),
+      restock_listener_id_(0), processing_queue_depth_(0) {
+    if (inventory_) {
+        backorders_ = std::make_unique<BackorderQueue>();
+        restock_listener_id_ = inventory_->addRestockListener([this](const std::string& product_id) {
+            backorders_->match(product_id, *inventory_);
+        });
+    }
+}
+
+OrderManager::~OrderManager() {
+    if (inventory_) {
+        inventory_->removeRestockListener(restock_listener_id_);
+    }
 }
 
-Order* OrderManager::createOrder(const std::string& order_id, const std::string& customer_id) {
+Order* OrderManager::createOrder(const std::string& order_id, const std::string& customer_id,
+                                 const std::chrono::system_clock::time_point& order_date) {
     std::lock_guard<std::mutex> lock(orders_mutex_);
     
     if (orders_.find(order_id) != orders_.end()) {
         return nullptr; // Order ID already exists
     }
 
-    auto order = std::make_unique<Order>(order_id, customer_id);
+    auto order = std::make_unique<Order>(order_id, customer_id, order_date);
+    order->setStatusListener([this](const Order& changed, OrderStatus old_status, OrderStatus new_status,
+                                    StockReleases* releases) {
+        onOrderStatusChanged(changed, old_status, new_status, releases);
+    });
     Order* order_ptr = order.get();
     orders_[order_id] = std::move(order);
+    orders_by_date_.insert(order_date, order_ptr);
     
     return order_ptr;
 }
 
+Order* OrderManager::createOrderForCustomer(const std::string& customer_id,
+                                            const std::chrono::system_clock::time_point& order_date) {
+    return createOrder(IdGenerator::getShared().nextString("ORD"), customer_id, order_date);
+}
+
 Order* OrderManager::getOrder(const std::string& order_id) {
     std::lock_guard<std::mutex> lock(orders_mutex_);
     
@@ -497,6 +681,28 @@ std::vector<Order*> OrderManager::getOrdersByCustomer(const std::string& custome
     return result;
 }
 
+std::vector<Order*> OrderManager::getOrdersInDateRange(const std::chrono::system_clock::time_point& start,
+                                                     const std::chrono::system_clock::time_point& end) const {
+    std::lock_guard<std::mutex> lock(orders_mutex_);
+    return orders_by_date_.getRange(start, end);
+}
+
+std::vector<OrderSummaryRow> OrderManager::getOrderSummariesInDateRange(
+        const std::chrono::system_clock::time_point& start,
+        const std::chrono::system_clock::time_point& end) const {
+    std::lock_guard<std::mutex> lock(orders_mutex_);
+    
+    std::vector<OrderSummaryRow> rows;
+    for (const Order* order : orders_by_date_.getRange(start, end)) {
+        rows.push_back(OrderSummaryRow{order->getCustomerId(), order->getStatus(), order->getTotalAmount()});
+    }
+    archive_->forEachInRange(start, end, [&rows](const OrderRecord& record) {
+        rows.push_back(OrderSummaryRow{record.customer_id, record.status, record.total_amount});
+    });
+    
+    return rows;
+}
+
 int OrderManager::processAllPendingOrders(Inventory& inventory, int max_concurrent) {
     auto pending_orders = getOrdersByStatus(OrderStatus::PENDING);
     
@@ -504,6 +710,10 @@ int OrderManager::processAllPendingOrders(Inventory& inventory, int max_concurre
         return 0;
     }
 
+    if (max_concurrent <= 0) {
+        return processAdaptively(pending_orders, inventory);
+    }
+
     std::vector<std::future<bool>> futures;
     int successful_count = 0;
     
@@ -531,6 +741,83 @@ int OrderManager::processAllPendingOrders(Inventory& inventory, int max_concurre
     return successful_count;
 }
 
+int OrderManager::processAdaptively(const std::vector<Order*>& orders, Inventory& inventory) {
+    ThreadPool& pool = ThreadPool::getShared();
+    std::mutex done_mutex;
+    std::condition_variable done_condition;
+    size_t completed = 0;
+    std::atomic<int> successful_count(0);
+
+    processing_queue_depth_.fetch_add(orders.size());
+    for (Order* order : orders) {
+        processing_limiter_.acquire();
+        processing_queue_depth_.fetch_sub(1);
+
+        auto admitted = std::chrono::steady_clock::now();
+        pool.submit([&, order, admitted]() {
+            bool success = false;
+            try {
+                success = order->processOrder(inventory);
+            } catch (const std::exception&) {
+                success = false;
+            }
+
+            // Latency includes time queued in the pool, which is what rises
+            // once the limit exceeds what the cores can run at once
+            auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - admitted);
+            processing_limiter_.onComplete(latency);
+            updateStatistics(success);
+            if (success) {
+                successful_count++;
+            }
+
+            std::lock_guard<std::mutex> lock(done_mutex);
+            if (++completed == orders.size()) {
+                done_condition.notify_all();
+            }
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done_condition.wait(lock, [&]() { return completed == orders.size(); });
+    return successful_count.load();
+}
+
+bool OrderManager::cancelOrder(const std::string& order_id, const std::string& reason) {
+    Order* order = getOrder(order_id);
+    return order && order->cancelOrder(reason);
+}
+
+size_t OrderManager::cancelOrders(const std::vector<std::string>& order_ids, const std::string& reason) {
+    std::vector<Order*> targets;
+    targets.reserve(order_ids.size());
+    {
+        std::lock_guard<std::mutex> lock(orders_mutex_);
+        for (const auto& order_id : order_ids) {
+            auto it = orders_.find(order_id);
+            if (it != orders_.end()) {
+                targets.push_back(it->second.get());
+            }
+        }
+    }
+
+    // Collect every order's returned stock for one batched release
+    StockReleases releases;
+    size_t cancelled = 0;
+    for (Order* order : targets) {
+        if (order->getStatus() != OrderStatus::CANCELLED && order->cancelOrder(reason, &releases)) {
+            cancelled++;
+        }
+    }
+
+    if (inventory_ && !releases.empty()) {
+        inventory_->releaseQuantities(releases);
+    }
+    
+    return cancelled;
+}
+
 bool OrderManager::removeOrder(const std::string& order_id) {
     std::lock_guard<std::mutex> lock(orders_mutex_);
     
@@ -539,6 +826,10 @@ bool OrderManager::removeOrder(const std::string& order_id) {
         return false;
     }
     
+    if (backorders_) {
+        backorders_->cancel(*it->second);
+    }
+    orders_by_date_.remove(it->second->getOrderDate(), it->second.get());
     orders_.erase(it);
     return true;
 }
@@ -551,6 +842,14 @@ std::string OrderManager::getStatistics() const {
     oss << "Orders Processed: " << total_orders_processed_.load() << "\n";
     oss << "Successful Orders: " << successful_orders_.load() << "\n";
     oss << "Failed Orders: " << failed_orders_.load() << "\n";
+    oss << "Archived Orders: " << archive_->size() << " ("
+        << archive_->getMemoryUsage() / 1024 << " KB)\n";
+    if (backorders_) {
+        oss << "Orders Awaiting Backorders: " << backorders_->getWaitingOrderCount() << "\n";
+    }
+    oss << "Processing Concurrency Limit: " << processing_limiter_.getLimit()
+        << " (in flight: " << processing_limiter_.getInFlight()
+        << ", queued: " << processing_queue_depth_.load() << ")\n";
     
     int total = total_orders_processed_.load();
     if (total > 0) {
@@ -582,22 +881,100 @@ size_t OrderManager::getTotalOrderCount() const {
 int OrderManager::clearCompletedOrders() {
     std::lock_guard<std::mutex> lock(orders_mutex_);
     
-    int cleared_count = 0;
+    std::vector<OrderRecord> archived;
     auto it = orders_.begin();
     
     while (it != orders_.end()) {
         OrderStatus status = it->second->getStatus();
         if (status == OrderStatus::DELIVERED || status == OrderStatus::CANCELLED) {
+            archived.push_back(it->second->toRecord());
+            if (backorders_) {
+                backorders_->cancel(*it->second);
+            }
+            orders_by_date_.remove(it->second->getOrderDate(), it->second.get());
             it = orders_.erase(it);
-            cleared_count++;
         } else {
             ++it;
         }
     }
     
+    int cleared_count = static_cast<int>(archived.size());
+    archive_->archive(std::move(archived));
+    
     return cleared_count;
 }
 
+std::vector<OrderRecord> OrderManager::getCustomerHistory(const std::string& customer_id) const {
+    std::vector<OrderRecord> history = archive_->getOrdersByCustomer(customer_id);
+    
+    for (const auto* order : getOrdersByCustomer(customer_id)) {
+        history.push_back(order->toRecord());
+    }
+    
+    std::stable_sort(history.begin(), history.end(), [](const OrderRecord& a, const OrderRecord& b) {
+        return a.order_date < b.order_date;
+    });
+    
+    return history;
+}
+
+const OrderArchive& OrderManager::getArchive() const {
+    return *archive_;
+}
+
+void OrderManager::onOrderStatusChanged(const Order& order, OrderStatus old_status, OrderStatus new_status,
+                                        StockReleases* releases) {
+    // Revenue is recognised once on confirmation; SHIPPED/DELIVERED only follow CONFIRMED
+    if (new_status == OrderStatus::CONFIRMED) {
+        sales_aggregator_.recordOrder(order);
+    } else if (new_status == OrderStatus::CANCELLED && old_status == OrderStatus::CONFIRMED) {
+        sales_aggregator_.reverseOrder(order);
+    }
+
+    if (!inventory_) {
+        return;
+    }
+
+    if (new_status == OrderStatus::BACKORDERED) {
+        // The listener only gets a const view; the queue needs the order itself
+        Order* queued = getOrder(order.getOrderId());
+        if (!queued) {
+            return;
+        }
+        backorders_->enqueue(*queued);
+
+        // Stock may have arrived between reserving and queueing
+        for (const auto& item : queued->getItems()) {
+            if (item.backordered > 0) {
+                backorders_->match(item.product_id, *inventory_);
+            }
+        }
+    } else if (new_status == OrderStatus::CANCELLED &&
+               (old_status == OrderStatus::CONFIRMED || old_status == OrderStatus::BACKORDERED)) {
+        if (old_status == OrderStatus::BACKORDERED) {
+            backorders_->cancel(order);
+        }
+        releaseReservedStock(order, releases);
+    }
+}
+
+void OrderManager::releaseReservedStock(const Order& order, StockReleases* releases) {
+    // Backordered units were never taken from stock
+    StockReleases order_releases;
+    for (const auto& item : order.getItems()) {
+        int allocated = item.quantity - item.backordered;
+        if (allocated > 0) {
+            order_releases.emplace_back(item.product_id, allocated);
+        }
+    }
+
+    if (releases) {
+        releases->insert(releases->end(), order_releases.begin(), order_releases.end());
+    } else if (!order_releases.empty()) {
+        inventory_->releaseQuantities(order_releases);
+    }
+}
+
 void OrderManager::updateStatistics(bool success) {
     total_orders_processed_.fetch_add(1);
     if (success) {
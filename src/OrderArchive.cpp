@@ -0,0 +1,420 @@
+#include "../include/OrderArchive.hpp"
+#include "../include/Codec.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace quirkventory {
+
+namespace {
+
+constexpr long long MICROS_PER_DAY = 86400LL * 1000000LL;
+constexpr uint8_t PROCESSED_FLAG = 0x80;
+
+long long toMicros(const std::chrono::system_clock::time_point& time_point) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time_point.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point fromMicros(long long micros) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(micros)));
+}
+
+long long dayOf(long long micros) {
+    long long day = micros / MICROS_PER_DAY;
+    return (micros % MICROS_PER_DAY < 0) ? day - 1 : day;
+}
+
+/**
+ * @brief Write a price as whole cents when that is exact, otherwise as a raw double
+ *
+ * The low bit of the varint tags the form: 0 for zigzag cents, 1 for a
+ * following 8-byte double.
+ */
+void putMoney(ByteWriter& writer, double value) {
+    double scaled = value * 100.0;
+    if (std::isfinite(scaled) && std::fabs(scaled) < 1e15) {
+        long long cents = std::llround(scaled);
+        if (static_cast<double>(cents) / 100.0 == value) {
+            uint64_t zigzag = (static_cast<uint64_t>(cents) << 1) ^ static_cast<uint64_t>(cents >> 63);
+            writer.putVarUInt(zigzag << 1);
+            return;
+        }
+    }
+    writer.putVarUInt(1);
+    writer.putDouble(value);
+}
+
+bool getMoney(ByteReader& reader, double& value) {
+    uint64_t tagged;
+    if (!reader.getVarUInt(tagged)) {
+        return false;
+    }
+    if (tagged & 1) {
+        return reader.getDouble(value);
+    }
+    uint64_t zigzag = tagged >> 1;
+    long long cents = static_cast<long long>(zigzag >> 1) ^ -static_cast<long long>(zigzag & 1);
+    value = static_cast<double>(cents) / 100.0;
+    return true;
+}
+
+} // namespace
+
+// StringDictionary Implementation
+
+uint32_t StringDictionary::intern(const std::string& value) {
+    auto it = ids_.find(value);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(values_.size());
+    values_.push_back(value);
+    ids_.emplace(values_.back(), id);
+    string_bytes_ += value.capacity() + 1;
+    return id;
+}
+
+bool StringDictionary::find(const std::string& value, uint32_t& id) const {
+    auto it = ids_.find(value);
+    if (it == ids_.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+size_t StringDictionary::getMemoryUsage() const {
+    // String objects and heap buffers, plus roughly one hash node per entry
+    return values_.size() * (sizeof(std::string) + sizeof(std::string_view) + sizeof(uint32_t) + 2 * sizeof(void*))
+        + string_bytes_;
+}
+
+// OrderArchive Implementation
+
+size_t OrderArchive::Segment::getByteSize() const {
+    return order_ids.capacity() + timestamps.capacity() + customers.capacity() + statuses.capacity()
+        + items.capacity() + notes.capacity() + customer_set.capacity() * sizeof(uint32_t) + sizeof(Segment);
+}
+
+OrderArchive::OrderArchive() : order_count_(0) {
+}
+
+size_t OrderArchive::archive(std::vector<OrderRecord> records) {
+    if (records.empty()) {
+        return 0;
+    }
+
+    std::sort(records.begin(), records.end(), [](const OrderRecord& a, const OrderRecord& b) {
+        return a.order_date < b.order_date;
+    });
+
+    std::lock_guard<std::mutex> lock(archive_mutex_);
+
+    // Rows are sorted, so each day is a contiguous run
+    std::vector<const OrderRecord*> rows;
+    long long current_day = dayOf(toMicros(records.front().order_date));
+    for (const auto& record : records) {
+        long long day = dayOf(toMicros(record.order_date));
+        if (day != current_day) {
+            segments_by_day_[current_day].push_back(buildSegment(current_day, rows));
+            rows.clear();
+            current_day = day;
+        }
+        rows.push_back(&record);
+    }
+    segments_by_day_[current_day].push_back(buildSegment(current_day, rows));
+
+    order_count_ += records.size();
+    return records.size();
+}
+
+OrderArchive::Segment OrderArchive::buildSegment(long long day, const std::vector<const OrderRecord*>& rows) {
+    Segment segment;
+    segment.day = day;
+    segment.row_count = rows.size();
+    segment.first_timestamp = toMicros(rows.front()->order_date);
+    segment.last_timestamp = toMicros(rows.back()->order_date);
+
+    ByteWriter order_ids, timestamps, customers, statuses, items, notes;
+    std::string previous_id;
+    long long previous_timestamp = day * MICROS_PER_DAY;
+
+    for (const OrderRecord* row : rows) {
+        // Front-code the id: shared prefix length, then the rest
+        size_t shared = 0;
+        size_t limit = std::min(previous_id.size(), row->order_id.size());
+        while (shared < limit && previous_id[shared] == row->order_id[shared]) {
+            ++shared;
+        }
+        order_ids.putVarUInt(shared);
+        order_ids.putString(row->order_id.substr(shared));
+        previous_id = row->order_id;
+
+        long long timestamp = toMicros(row->order_date);
+        timestamps.putVarInt(timestamp - previous_timestamp);
+        previous_timestamp = timestamp;
+
+        uint32_t customer_id = customers_.intern(row->customer_id);
+        customers.putVarUInt(customer_id);
+        segment.customer_set.push_back(customer_id);
+
+        bool processed = row->processed_date != std::chrono::system_clock::time_point{};
+        statuses.putUInt8(static_cast<uint8_t>(static_cast<int>(row->status) | (processed ? PROCESSED_FLAG : 0)));
+        if (processed) {
+            statuses.putVarInt(toMicros(row->processed_date) - timestamp);
+        }
+
+        items.putVarUInt(row->items.size());
+        for (const auto& item : row->items) {
+            items.putVarUInt(products_.intern(item.product_id));
+            items.putVarUInt(categories_.intern(item.category));
+            items.putVarInt(item.quantity);
+            putMoney(items, item.unit_price);
+        }
+
+        notes.putString(row->notes);
+    }
+
+    std::sort(segment.customer_set.begin(), segment.customer_set.end());
+    segment.customer_set.erase(std::unique(segment.customer_set.begin(), segment.customer_set.end()),
+                               segment.customer_set.end());
+    segment.customer_set.shrink_to_fit();
+
+    segment.order_ids = order_ids.release();
+    segment.timestamps = timestamps.release();
+    segment.customers = customers.release();
+    segment.statuses = statuses.release();
+    segment.items = items.release();
+    segment.notes = notes.release();
+    for (auto* column : {&segment.order_ids, &segment.timestamps, &segment.customers,
+                         &segment.statuses, &segment.items, &segment.notes}) {
+        column->shrink_to_fit();
+    }
+
+    return segment;
+}
+
+void OrderArchive::decodeSegment(const Segment& segment,
+                                 const std::function<bool(long long, const OrderRecord&)>& visitor,
+                                 uint32_t customer_filter) const {
+    ByteReader order_ids(segment.order_ids);
+    ByteReader timestamps(segment.timestamps);
+    ByteReader customers(segment.customers);
+    ByteReader statuses(segment.statuses);
+    ByteReader items(segment.items);
+    ByteReader notes(segment.notes);
+
+    OrderRecord record;
+    std::string suffix;
+    long long timestamp = segment.day * MICROS_PER_DAY;
+
+    for (size_t row = 0; row < segment.row_count; ++row) {
+        uint64_t shared, customer_id, item_count;
+        int64_t delta;
+        uint8_t status_byte;
+        if (!order_ids.getVarUInt(shared) || !order_ids.getString(suffix) ||
+            !timestamps.getVarInt(delta) || !customers.getVarUInt(customer_id) ||
+            !statuses.getUInt8(status_byte) || !items.getVarUInt(item_count)) {
+            return; // Corrupt segment
+        }
+
+        record.order_id.resize(std::min<size_t>(shared, record.order_id.size()));
+        record.order_id += suffix;
+        timestamp += delta;
+
+        int64_t processed_delta = 0;
+        bool processed = (status_byte & PROCESSED_FLAG) != 0;
+        if (processed && !statuses.getVarInt(processed_delta)) {
+            return;
+        }
+
+        // Rows of other customers are skipped without materializing them
+        bool wanted = customer_filter == UINT32_MAX || customer_id == customer_filter;
+        if (wanted) {
+            record.items.clear();
+            record.total_amount = 0.0;
+        }
+
+        for (uint64_t i = 0; i < item_count; ++i) {
+            uint64_t product_id, category_id;
+            int64_t quantity;
+            double unit_price;
+            if (!items.getVarUInt(product_id) || !items.getVarUInt(category_id) ||
+                !items.getVarInt(quantity) || !getMoney(items, unit_price)) {
+                return;
+            }
+            if (wanted) {
+                record.items.emplace_back(products_.get(static_cast<uint32_t>(product_id)),
+                                          static_cast<int>(quantity), unit_price);
+                record.items.back().category = categories_.get(static_cast<uint32_t>(category_id));
+                record.total_amount += record.items.back().getTotalPrice();
+            }
+        }
+
+        if (!notes.getString(record.notes)) {
+            return;
+        }
+
+        if (!wanted) {
+            continue;
+        }
+
+        record.customer_id = customers_.get(static_cast<uint32_t>(customer_id));
+        record.status = static_cast<OrderStatus>(status_byte & ~PROCESSED_FLAG);
+        record.order_date = fromMicros(timestamp);
+        record.processed_date = processed ? fromMicros(timestamp + processed_delta)
+                                          : std::chrono::system_clock::time_point{};
+
+        if (!visitor(timestamp, record)) {
+            return;
+        }
+    }
+}
+
+void OrderArchive::forEachInRange(const std::chrono::system_clock::time_point& start,
+                                  const std::chrono::system_clock::time_point& end,
+                                  const std::function<void(const OrderRecord&)>& visitor) const {
+    long long first = toMicros(start);
+    long long last = toMicros(end);
+    if (last < first) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(archive_mutex_);
+
+    auto day_end = segments_by_day_.upper_bound(dayOf(last));
+    for (auto it = segments_by_day_.lower_bound(dayOf(first)); it != day_end; ++it) {
+        // Several batches may have archived orders for the same day; merge them by date
+        std::vector<std::pair<long long, OrderRecord>> day_rows;
+        bool merge = it->second.size() > 1;
+
+        for (const auto& segment : it->second) {
+            if (segment.last_timestamp < first || segment.first_timestamp > last) {
+                continue;
+            }
+            decodeSegment(segment, [&](long long timestamp, const OrderRecord& record) {
+                if (timestamp > last) {
+                    return false;
+                }
+                if (timestamp >= first) {
+                    if (merge) {
+                        day_rows.emplace_back(timestamp, record);
+                    } else {
+                        visitor(record);
+                    }
+                }
+                return true;
+            });
+        }
+
+        std::stable_sort(day_rows.begin(), day_rows.end(),
+            [](const std::pair<long long, OrderRecord>& a, const std::pair<long long, OrderRecord>& b) {
+                return a.first < b.first;
+            });
+        for (const auto& row : day_rows) {
+            visitor(row.second);
+        }
+    }
+}
+
+std::vector<OrderRecord> OrderArchive::getOrdersInDateRange(const std::chrono::system_clock::time_point& start,
+                                                            const std::chrono::system_clock::time_point& end) const {
+    std::vector<OrderRecord> result;
+    forEachInRange(start, end, [&result](const OrderRecord& record) { result.push_back(record); });
+    return result;
+}
+
+std::vector<OrderRecord> OrderArchive::getOrdersByCustomer(const std::string& customer_id) const {
+    std::vector<OrderRecord> result;
+    std::lock_guard<std::mutex> lock(archive_mutex_);
+
+    uint32_t id;
+    if (!customers_.find(customer_id, id)) {
+        return result;
+    }
+
+    for (const auto& pair : segments_by_day_) {
+        for (const auto& segment : pair.second) {
+            if (!std::binary_search(segment.customer_set.begin(), segment.customer_set.end(), id)) {
+                continue;
+            }
+            decodeSegment(segment, [&result](long long, const OrderRecord& record) {
+                result.push_back(record);
+                return true;
+            }, id);
+        }
+    }
+
+    std::stable_sort(result.begin(), result.end(), [](const OrderRecord& a, const OrderRecord& b) {
+        return a.order_date < b.order_date;
+    });
+    return result;
+}
+
+bool OrderArchive::findOrder(const std::string& order_id, OrderRecord& record) const {
+    std::lock_guard<std::mutex> lock(archive_mutex_);
+
+    for (const auto& pair : segments_by_day_) {
+        for (const auto& segment : pair.second) {
+            // Walk the front-coded id column before decoding anything else
+            ByteReader reader(segment.order_ids);
+            std::string current;
+            std::string suffix;
+            bool found = false;
+            for (size_t row = 0; row < segment.row_count; ++row) {
+                uint64_t shared;
+                if (!reader.getVarUInt(shared) || !reader.getString(suffix)) {
+                    break;
+                }
+                current.resize(std::min<size_t>(shared, current.size()));
+                current += suffix;
+                if (current == order_id) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                continue;
+            }
+
+            decodeSegment(segment, [&](long long, const OrderRecord& row) {
+                if (row.order_id != order_id) {
+                    return true;
+                }
+                record = row;
+                return false;
+            });
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t OrderArchive::size() const {
+    std::lock_guard<std::mutex> lock(archive_mutex_);
+    return order_count_;
+}
+
+size_t OrderArchive::getSegmentCount() const {
+    std::lock_guard<std::mutex> lock(archive_mutex_);
+    size_t count = 0;
+    for (const auto& pair : segments_by_day_) {
+        count += pair.second.size();
+    }
+    return count;
+}
+
+size_t OrderArchive::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(archive_mutex_);
+    size_t bytes = customers_.getMemoryUsage() + products_.getMemoryUsage() + categories_.getMemoryUsage();
+    for (const auto& pair : segments_by_day_) {
+        for (const auto& segment : pair.second) {
+            bytes += segment.getByteSize();
+        }
+    }
+    return bytes;
+}
+
+} // namespace quirkventory
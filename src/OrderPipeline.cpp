@@ -0,0 +1,224 @@
+#include "../include/OrderPipeline.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace quirkventory {
+
+OrderPipeline::OrderPipeline(Inventory& inventory, const OrderPipelineConfig& config, BatchListener listener)
+    : inventory_(inventory), config_(config), listener_(std::move(listener)),
+      validate_(config.queue_capacity, nullptr), reserve_(config.queue_capacity, &validate_),
+      confirm_(config.queue_capacity, &reserve_), notify_(config.queue_capacity, &confirm_),
+      running_(true), submitted_(0), rejected_(0), completed_(0), confirmed_(0), failed_(0),
+      reserve_batches_(0), total_latency_us_(0), max_latency_us_(0) {
+    if (config.batch_size == 0) {
+        throw std::invalid_argument("Pipeline batch size must be positive");
+    }
+
+    validate_.worker = std::thread([this]() {
+        runStage(validate_, [this](std::vector<Ticket>& batch) { validateBatch(batch); });
+    });
+    reserve_.worker = std::thread([this]() {
+        runStage(reserve_, [this](std::vector<Ticket>& batch) { reserveBatch(batch); });
+    });
+    confirm_.worker = std::thread([this]() {
+        runStage(confirm_, [this](std::vector<Ticket>& batch) { confirmBatch(batch); });
+    });
+    notify_.worker = std::thread([this]() {
+        runStage(notify_, [this](std::vector<Ticket>& batch) { notifyBatch(batch); });
+    });
+}
+
+OrderPipeline::~OrderPipeline() {
+    // Stages only exit once their input is empty, so nothing submitted is lost
+    running_.store(false);
+    for (Stage* stage : {&validate_, &reserve_, &confirm_, &notify_}) {
+        if (stage->worker.joinable()) {
+            stage->worker.join();
+        }
+    }
+}
+
+bool OrderPipeline::submit(Order* order) {
+    if (!order || !running_.load()) {
+        return false;
+    }
+
+    Ticket ticket;
+    ticket.order = order;
+    ticket.submitted = std::chrono::steady_clock::now();
+
+    // Count first so waitUntilIdle never sees completed > submitted
+    submitted_.fetch_add(1);
+    if (!validate_.input.tryPush(ticket)) {
+        submitted_.fetch_sub(1);
+        rejected_.fetch_add(1);
+        return false;
+    }
+    return true;
+}
+
+bool OrderPipeline::waitUntilIdle(std::chrono::milliseconds timeout) const {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (getInFlight() > 0) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return true;
+}
+
+uint64_t OrderPipeline::getInFlight() const {
+    uint64_t completed = completed_.load();
+    uint64_t submitted = submitted_.load();
+    return submitted > completed ? submitted - completed : 0;
+}
+
+OrderPipelineStats OrderPipeline::getStats() const {
+    OrderPipelineStats stats;
+    stats.submitted = submitted_.load();
+    stats.rejected = rejected_.load();
+    stats.confirmed = confirmed_.load();
+    stats.failed = failed_.load();
+    stats.reserve_batches = reserve_batches_.load();
+    uint64_t completed = completed_.load();
+    stats.average_latency_us = completed > 0 ? static_cast<double>(total_latency_us_.load()) / completed : 0.0;
+    stats.max_latency_us = max_latency_us_.load();
+    return stats;
+}
+
+void OrderPipeline::runStage(Stage& stage, const std::function<void(std::vector<Ticket>&)>& step) {
+    std::vector<Ticket> batch;
+    batch.reserve(config_.batch_size);
+    auto batch_started = std::chrono::steady_clock::now();
+    auto poll_interval = std::max(std::chrono::microseconds(20), config_.flush_interval / 8);
+
+    for (;;) {
+        // Read before popping: once upstream has finished, anything it
+        // forwarded is already visible in the queue
+        bool stopping = !running_.load();
+        bool drained = stopping && (!stage.upstream || stage.upstream->finished.load());
+
+        bool was_empty = batch.empty();
+        stage.input.popBatch(batch, config_.batch_size - batch.size());
+        auto now = std::chrono::steady_clock::now();
+        if (was_empty && !batch.empty()) {
+            batch_started = now;
+        }
+
+        if (batch.size() == config_.batch_size ||
+            (!batch.empty() && (stopping || now - batch_started >= config_.flush_interval))) {
+            step(batch);
+            batch.clear();
+            continue;
+        }
+        if (drained && batch.empty()) {
+            stage.finished.store(true);
+            return;
+        }
+
+        std::this_thread::sleep_for(poll_interval);
+    }
+}
+
+void OrderPipeline::forward(Stage& next, std::vector<Ticket>& batch) {
+    for (Ticket& ticket : batch) {
+        while (!next.input.tryPush(ticket)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void OrderPipeline::validateBatch(std::vector<Ticket>& batch) {
+    for (Ticket& ticket : batch) {
+        // Availability is checked atomically by the reserve stage
+        ticket.ok = ticket.order->beginProcessing(inventory_, false);
+    }
+    forward(reserve_, batch);
+}
+
+void OrderPipeline::reserveBatch(std::vector<Ticket>& batch) {
+    std::vector<std::vector<std::pair<std::string, int>>> requests;
+    std::vector<Ticket*> requesting;
+    requests.reserve(batch.size());
+    requesting.reserve(batch.size());
+
+    for (Ticket& ticket : batch) {
+        if (!ticket.ok) {
+            continue;
+        }
+        std::vector<std::pair<std::string, int>> lines;
+        for (const auto& item : ticket.order->getItems()) {
+            lines.emplace_back(item.product_id, item.quantity);
+        }
+        requests.push_back(std::move(lines));
+        requesting.push_back(&ticket);
+    }
+
+    if (!requests.empty()) {
+        std::vector<bool> reserved;
+        inventory_.reserveBatch(requests, reserved);
+        reserve_batches_.fetch_add(1);
+        for (size_t i = 0; i < requesting.size(); ++i) {
+            requesting[i]->reserved = reserved[i];
+        }
+    }
+    forward(confirm_, batch);
+}
+
+void OrderPipeline::confirmBatch(std::vector<Ticket>& batch) {
+    std::vector<std::pair<std::string, int>> releases;
+    for (Ticket& ticket : batch) {
+        if (!ticket.ok) {
+            continue;
+        }
+        ticket.ok = ticket.order->completeProcessing(ticket.reserved);
+
+        // Cancelled while in the pipeline: give the reserved stock back
+        if (!ticket.ok && ticket.reserved) {
+            for (const auto& item : ticket.order->getItems()) {
+                releases.emplace_back(item.product_id, item.quantity);
+            }
+        }
+    }
+    if (!releases.empty()) {
+        inventory_.releaseQuantities(releases);
+    }
+    forward(notify_, batch);
+}
+
+void OrderPipeline::notifyBatch(std::vector<Ticket>& batch) {
+    std::vector<Order*> orders;
+    orders.reserve(batch.size());
+    auto now = std::chrono::steady_clock::now();
+    uint64_t confirmed = 0;
+    uint64_t total_latency_us = 0;
+    uint64_t max_latency_us = 0;
+
+    for (const Ticket& ticket : batch) {
+        orders.push_back(ticket.order);
+        confirmed += ticket.ok ? 1 : 0;
+        auto latency = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - ticket.submitted).count());
+        total_latency_us += latency;
+        max_latency_us = std::max(max_latency_us, latency);
+    }
+
+    if (listener_) {
+        try {
+            listener_(orders);
+        } catch (const std::exception&) {
+            // A failing listener must not stall the pipeline
+        }
+    }
+
+    confirmed_.fetch_add(confirmed);
+    failed_.fetch_add(batch.size() - confirmed);
+    total_latency_us_.fetch_add(total_latency_us);
+    uint64_t previous_max = max_latency_us_.load();
+    while (previous_max < max_latency_us && !max_latency_us_.compare_exchange_weak(previous_max, max_latency_us)) {
+    }
+    completed_.fetch_add(batch.size());
+}
+
+} // namespace quirkventory
@@ -0,0 +1,153 @@
+#include "../include/OrderTimeIndex.hpp"
+#include <algorithm>
+
+namespace quirkventory {
+
+OrderTimeIndex::OrderTimeIndex(size_t segment_capacity)
+    : segment_capacity_(std::max<size_t>(segment_capacity, 2)), size_(0) {
+}
+
+void OrderTimeIndex::insert(const std::chrono::system_clock::time_point& order_date, Order* order) {
+    if (!order) {
+        return;
+    }
+
+    Entry entry{toTimestamp(order_date), order};
+
+    // Fast path: dates are monotonic at creation, so append to the last segment
+    if (segments_.empty() || segments_.back().entries.empty() ||
+        segments_.back().entries.back().timestamp <= entry.timestamp) {
+        if (segments_.empty() || segments_.back().entries.size() >= segment_capacity_) {
+            segments_.emplace_back();
+            segments_.back().entries.reserve(segment_capacity_);
+        }
+        segments_.back().entries.push_back(entry);
+        segments_.back().live_count++;
+        size_++;
+        return;
+    }
+
+    // Out-of-order insert (backfilled or clock-adjusted dates): place it in the
+    // segment covering its date, splitting the segment if it grows too large
+    size_t segment_index = findSegment(entry.timestamp);
+    if (segment_index == segments_.size()) {
+        segment_index = segments_.size() - 1;
+    }
+
+    Segment& segment = segments_[segment_index];
+    auto position = std::upper_bound(segment.entries.begin(), segment.entries.end(), entry.timestamp,
+        [](long long timestamp, const Entry& e) { return timestamp < e.timestamp; });
+    segment.entries.insert(position, entry);
+    segment.live_count++;
+    size_++;
+
+    if (segment.entries.size() >= segment_capacity_ * 2) {
+        Segment upper;
+        size_t half = segment.entries.size() / 2;
+        upper.entries.assign(segment.entries.begin() + half, segment.entries.end());
+        segment.entries.resize(half);
+
+        upper.live_count = std::count_if(upper.entries.begin(), upper.entries.end(),
+            [](const Entry& e) { return e.order != nullptr; });
+        segment.live_count -= upper.live_count;
+
+        segments_.insert(segments_.begin() + segment_index + 1, std::move(upper));
+    }
+}
+
+bool OrderTimeIndex::remove(const std::chrono::system_clock::time_point& order_date, const Order* order) {
+    long long timestamp = toTimestamp(order_date);
+
+    for (size_t i = findSegment(timestamp); i < segments_.size(); ++i) {
+        Segment& segment = segments_[i];
+        if (segment.entries.empty() || segment.entries.front().timestamp > timestamp) {
+            break;
+        }
+
+        auto it = std::lower_bound(segment.entries.begin(), segment.entries.end(), timestamp,
+            [](const Entry& e, long long ts) { return e.timestamp < ts; });
+
+        for (; it != segment.entries.end() && it->timestamp == timestamp; ++it) {
+            if (it->order == order) {
+                it->order = nullptr;
+                segment.live_count--;
+                size_--;
+
+                if (segment.live_count * 2 < segment.entries.size()) {
+                    compactSegment(i);
+                }
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void OrderTimeIndex::forEachInRange(const std::chrono::system_clock::time_point& start,
+                                    const std::chrono::system_clock::time_point& end,
+                                    const std::function<void(Order*)>& visitor) const {
+    long long first = toTimestamp(start);
+    long long last = toTimestamp(end);
+    if (last < first) {
+        return;
+    }
+
+    for (size_t i = findSegment(first); i < segments_.size(); ++i) {
+        const Segment& segment = segments_[i];
+        if (segment.entries.empty()) {
+            continue;
+        }
+        if (segment.entries.front().timestamp > last) {
+            break;
+        }
+
+        auto it = std::lower_bound(segment.entries.begin(), segment.entries.end(), first,
+            [](const Entry& e, long long ts) { return e.timestamp < ts; });
+
+        for (; it != segment.entries.end() && it->timestamp <= last; ++it) {
+            if (it->order) {
+                visitor(it->order);
+            }
+        }
+    }
+}
+
+std::vector<Order*> OrderTimeIndex::getRange(const std::chrono::system_clock::time_point& start,
+                                             const std::chrono::system_clock::time_point& end) const {
+    std::vector<Order*> result;
+    forEachInRange(start, end, [&result](Order* order) { result.push_back(order); });
+    return result;
+}
+
+void OrderTimeIndex::clear() {
+    segments_.clear();
+    size_ = 0;
+}
+
+long long OrderTimeIndex::toTimestamp(const std::chrono::system_clock::time_point& time_point) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time_point.time_since_epoch()).count();
+}
+
+size_t OrderTimeIndex::findSegment(long long timestamp) const {
+    // Segments are sorted and non-overlapping, so partition on each segment's last key
+    auto it = std::partition_point(segments_.begin(), segments_.end(),
+        [timestamp](const Segment& segment) {
+            return !segment.entries.empty() && segment.entries.back().timestamp < timestamp;
+        });
+    return static_cast<size_t>(it - segments_.begin());
+}
+
+void OrderTimeIndex::compactSegment(size_t segment_index) {
+    Segment& segment = segments_[segment_index];
+
+    if (segment.live_count == 0) {
+        segments_.erase(segments_.begin() + segment_index);
+        return;
+    }
+
+    segment.entries.erase(std::remove_if(segment.entries.begin(), segment.entries.end(),
+        [](const Entry& e) { return e.order == nullptr; }), segment.entries.end());
+}
+
+} // namespace quirkventory
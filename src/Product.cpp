@@ -13,7 +13,7 @@ Product::Product(const std::string& id,
                 double price,
                 int quantity)
     : id_(id), name_(name), category_(category), price_(price), quantity_(quantity),
-      created_date_(std::chrono::system_clock::now()) {
+      created_date_(std::chrono::system_clock::now()), version_(1) {
     
     if (id.empty()) {
         throw std::invalid_argument("Product ID cannot be empty");
@@ -34,10 +34,12 @@ void Product::setName(const std::string& name) {
         throw std::invalid_argument("Product name cannot be empty");
     }
     name_ = name;
+    ++version_;
 }
 
 void Product::setCategory(const std::string& category) {
     category_ = category;
+    ++version_;
 }
 
 void Product::setPrice(double price) {
@@ -45,6 +47,7 @@ void Product::setPrice(double price) {
         throw std::invalid_argument("Product price cannot be negative");
     }
     price_ = price;
+    ++version_;
 }
 
 void Product::setQuantity(int quantity) {
@@ -52,6 +55,7 @@ void Product::setQuantity(int quantity) {
         throw std::invalid_argument("Product quantity cannot be negative");
     }
     quantity_ = quantity;
+    ++version_;
 }
 
 void Product::addQuantity(int amount) {
@@ -59,6 +63,7 @@ void Product::addQuantity(int amount) {
         throw std::invalid_argument("Amount to add cannot be negative");
     }
     quantity_ += amount;
+    ++version_;
 }
 
 void Product::removeQuantity(int amount) {
@@ -69,6 +74,7 @@ void Product::removeQuantity(int amount) {
         throw std::invalid_argument("Cannot remove more quantity than available");
     }
     quantity_ -= amount;
+    ++version_;
 }
 
 std::string Product::getInfo() const {
@@ -110,20 +116,51 @@ PerishableProduct::PerishableProduct(const std::string& id,
     }
 }
 
+std::unique_ptr<PerishableProduct> PerishableProduct::restore(const std::string& id,
+                                                              const std::string& name,
+                                                              const std::string& category,
+                                                              double price,
+                                                              int quantity,
+                                                              const std::chrono::system_clock::time_point& expiry_date,
+                                                              uint64_t version) {
+    // Construct with a valid date, then put the stored (possibly past) one back
+    auto product = std::make_unique<PerishableProduct>(id, name, category, price, quantity,
+                                                       std::chrono::system_clock::time_point::max());
+    product->expiry_date_ = expiry_date;
+    product->version_ = version;
+    return product;
+}
+
+std::chrono::system_clock::time_point PerishableProduct::farFutureExpiry() {
+    return std::chrono::system_clock::now() + std::chrono::hours(24 * 365 * 100);
+}
+
+void PerishableProduct::restoreState(const PerishableProduct& state) {
+    name_ = state.name_;
+    category_ = state.category_;
+    price_ = state.price_;
+    quantity_ = state.quantity_;
+    expiry_date_ = state.expiry_date_;
+    version_ = state.version_;
+}
+
 void PerishableProduct::setExpiryDate(const std::chrono::system_clock::time_point& expiry_date) {
     auto now = std::chrono::system_clock::now();
     if (expiry_date < now) {
         throw std::invalid_argument("Expiry date cannot be in the past");
     }
     expiry_date_ = expiry_date;
+    ++version_;
 }
 
 void PerishableProduct::setStorageRequirements(const std::string& requirements) {
     storage_requirements_ = requirements;
+    ++version_;
 }
 
 void PerishableProduct::setStorageTemperature(double temperature) {
     storage_temperature_ = temperature;
+    ++version_;
 }
 
 bool PerishableProduct::isExpired() const {
@@ -0,0 +1,574 @@
+#include "../include/Replication.hpp"
+#include "../include/Wire.hpp"
+#include <random>
+#include <stdexcept>
+#include <algorithm>
+
+namespace quirkventory {
+
+namespace {
+
+using namespace std::chrono;
+
+constexpr uint64_t kProtocolVersion = 1;
+constexpr size_t kMaxChangesPerMessage = 512;
+
+// The primary speaks at least every heartbeat; a follower gives up on it after the timeout
+constexpr milliseconds kHeartbeatInterval(200);
+constexpr milliseconds kPrimaryTimeout(2000);
+constexpr milliseconds kMinReconnectDelay(50);
+constexpr milliseconds kMaxReconnectDelay(2000);
+
+// Message types of the replication protocol (framed by Wire)
+enum class MessageType : uint8_t {
+    HELLO = 1,      // Follower: protocol version, log ID, last applied LSN
+    SNAPSHOT = 2,   // Primary: log ID, LSN, default threshold, category thresholds, products
+    CHANGES = 3,    // Primary: last LSN, send time, changes (none for a heartbeat)
+    ACK = 4         // Follower: last applied LSN
+};
+
+enum class ChangeKind : uint8_t {
+    PRODUCT = 1,
+    THRESHOLD = 2
+};
+
+int64_t toMicros(system_clock::time_point time) {
+    return duration_cast<microseconds>(time.time_since_epoch()).count();
+}
+
+void encodeChange(ByteWriter& writer, const InventoryChange& change) {
+    if (change.kind == InventoryChange::Kind::THRESHOLD) {
+        writer.putUInt8(static_cast<uint8_t>(ChangeKind::THRESHOLD));
+        writer.putString(change.category);
+        writer.putVarInt(change.threshold);
+    } else {
+        writer.putUInt8(static_cast<uint8_t>(ChangeKind::PRODUCT));
+        Wire::putProduct(writer, *change.product);
+    }
+}
+
+bool decodeChange(ByteReader& reader, InventoryChange& change) {
+    uint8_t kind;
+    if (!reader.getUInt8(kind)) {
+        return false;
+    }
+    if (kind == static_cast<uint8_t>(ChangeKind::THRESHOLD)) {
+        int64_t threshold;
+        change.kind = InventoryChange::Kind::THRESHOLD;
+        if (!reader.getString(change.category) || !reader.getVarInt(threshold)) {
+            return false;
+        }
+        change.threshold = static_cast<int>(threshold);
+        return true;
+    }
+    if (kind == static_cast<uint8_t>(ChangeKind::PRODUCT)) {
+        auto product = std::make_shared<ProductVersion>();
+        change.kind = InventoryChange::Kind::PRODUCT;
+        change.product = product;
+        return Wire::getProduct(reader, *product);
+    }
+    return false;
+}
+
+bool sendMessage(int fd, MessageType type, const ByteWriter& body) {
+    return Wire::sendMessage(fd, static_cast<uint8_t>(type), body);
+}
+
+Wire::ReceiveResult receiveMessage(int fd, milliseconds timeout, MessageType& type, std::vector<uint8_t>& body) {
+    uint8_t raw = 0;
+    Wire::ReceiveResult result = Wire::receiveMessage(fd, timeout, raw, body);
+    type = static_cast<MessageType>(raw);
+    return result;
+}
+
+} // namespace
+
+// ReplicationPrimary Implementation
+
+ReplicationPrimary::ReplicationPrimary(Inventory& inventory, uint16_t port,
+                                       const std::string& bind_address, size_t log_capacity)
+    : inventory_(inventory), bind_address_(bind_address), port_(port), log_capacity_(log_capacity),
+      log_id_(0), last_lsn_(0), listen_fd_(-1), running_(false) {
+    if (log_capacity == 0) {
+        throw std::invalid_argument("Replication log capacity must be positive");
+    }
+
+    std::random_device random;
+    while (log_id_ == 0) {
+        log_id_ = (static_cast<uint64_t>(random()) << 32) | random();
+    }
+    inventory_.setChangeListener([this](const InventoryChange& change) { onChange(change); });
+}
+
+ReplicationPrimary::~ReplicationPrimary() {
+    stop();
+    inventory_.setChangeListener(nullptr);
+}
+
+bool ReplicationPrimary::start() {
+    if (running_.load()) {
+        return false;
+    }
+
+    uint16_t port = port_;
+    listen_fd_ = Wire::listenTcp(bind_address_, port);
+    if (listen_fd_ < 0) {
+        return false;
+    }
+    port_ = port;
+    running_.store(true);
+    accept_thread_ = std::thread(&ReplicationPrimary::acceptLoop, this);
+    return true;
+}
+
+void ReplicationPrimary::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    {
+        // Taking the lock orders the flag before any session's wait
+        std::lock_guard<std::mutex> lock(log_mutex_);
+    }
+    log_cv_.notify_all();
+
+    if (accept_thread_.joinable()) {
+        accept_thread_.join();
+    }
+    Wire::closeSocket(listen_fd_);
+    listen_fd_ = -1;
+
+    std::vector<std::unique_ptr<Session>> sessions;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        for (auto& session : sessions_) {
+            // Unblocks a session stuck sending to a slow follower
+            Wire::shutdownSocket(session->fd);
+        }
+        sessions.swap(sessions_);
+    }
+    for (auto& session : sessions) {
+        session->thread.join();
+        Wire::closeSocket(session->fd);
+    }
+}
+
+uint64_t ReplicationPrimary::getLastLsn() const {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    return last_lsn_;
+}
+
+uint64_t ReplicationPrimary::getOldestLsn() const {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    return log_.empty() ? last_lsn_ + 1 : log_.front().lsn;
+}
+
+std::vector<ReplicaStatus> ReplicationPrimary::getReplicas() const {
+    uint64_t last_lsn = getLastLsn();
+    std::vector<ReplicaStatus> replicas;
+
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    for (const auto& session : sessions_) {
+        if (session->finished.load()) {
+            continue;
+        }
+        uint64_t acked = session->acked_lsn.load();
+        replicas.push_back({session->address, acked, last_lsn > acked ? last_lsn - acked : 0,
+                            session->snapshots_sent.load()});
+    }
+    return replicas;
+}
+
+void ReplicationPrimary::onChange(const InventoryChange& change) {
+    // Note: Called with the inventory lock held, which orders LSNs like commits
+    ByteWriter writer;
+    encodeChange(writer, change);
+    int64_t now = toMicros(system_clock::now());
+
+    {
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        log_.push_back({++last_lsn_, now, writer.release()});
+        if (log_.size() > log_capacity_) {
+            log_.pop_front();
+        }
+    }
+    log_cv_.notify_all();
+}
+
+void ReplicationPrimary::acceptLoop() {
+    while (running_.load()) {
+        reapSessions();
+
+        std::string peer;
+        int fd = Wire::acceptConnection(listen_fd_, kHeartbeatInterval, peer);
+        if (fd < 0) {
+            continue;
+        }
+
+        auto session = std::make_unique<Session>();
+        session->fd = fd;
+        session->address = peer;
+
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        Session& added = *session;
+        sessions_.push_back(std::move(session));
+        added.thread = std::thread(&ReplicationPrimary::serveFollower, this, std::ref(added));
+    }
+}
+
+void ReplicationPrimary::serveFollower(Session& session) {
+    MessageType type;
+    std::vector<uint8_t> body;
+    uint64_t version = 0;
+    uint64_t log_id = 0;
+    uint64_t sent_lsn = 0;
+
+    bool ok = receiveMessage(session.fd, kPrimaryTimeout, type, body) == Wire::ReceiveResult::MESSAGE &&
+              type == MessageType::HELLO;
+    if (ok) {
+        ByteReader reader(body);
+        ok = reader.getVarUInt(version) && reader.getFixed64(log_id) && reader.getVarUInt(sent_lsn) &&
+             version == kProtocolVersion;
+    }
+    if (ok) {
+        // A follower of another log (or ahead of this one) has to start over
+        if (log_id != log_id_ || sent_lsn > getLastLsn()) {
+            ok = sendSnapshot(session, sent_lsn);
+        }
+        session.acked_lsn.store(sent_lsn);
+    }
+
+    std::vector<LogEntry> entries;
+    while (ok && running_.load()) {
+        {
+            std::unique_lock<std::mutex> lock(log_mutex_);
+            log_cv_.wait_for(lock, kHeartbeatInterval, [this, sent_lsn]() {
+                return !running_.load() || last_lsn_ > sent_lsn;
+            });
+        }
+        if (!running_.load()) {
+            break;
+        }
+
+        if (!readLog(sent_lsn, kMaxChangesPerMessage, entries)) {
+            // The follower fell behind what the log keeps
+            ok = sendSnapshot(session, sent_lsn);
+            continue;
+        }
+
+        ByteWriter writer;
+        writer.putVarUInt(getLastLsn());
+        writer.putVarInt(toMicros(system_clock::now()));
+        writer.putVarUInt(entries.size());
+        for (const auto& entry : entries) {
+            writer.putVarUInt(entry.lsn);
+            writer.putVarInt(entry.committed_at_us);
+            writer.putBytes(entry.change.data(), entry.change.size());
+        }
+        ok = sendMessage(session.fd, MessageType::CHANGES, writer);
+        if (!entries.empty()) {
+            sent_lsn = entries.back().lsn;
+        }
+
+        // Take in acknowledgements without waiting for them
+        Wire::ReceiveResult result;
+        while (ok && (result = receiveMessage(session.fd, milliseconds(0), type, body)) != Wire::ReceiveResult::TIMEOUT) {
+            ByteReader reader(body);
+            uint64_t acked;
+            ok = result == Wire::ReceiveResult::MESSAGE && type == MessageType::ACK && reader.getVarUInt(acked);
+            if (ok) {
+                session.acked_lsn.store(acked);
+            }
+        }
+    }
+    session.finished.store(true);
+}
+
+bool ReplicationPrimary::sendSnapshot(Session& session, uint64_t& lsn) {
+    // Changes are logged under the inventory lock, so this LSN matches the copy exactly
+    uint64_t snapshot_lsn = 0;
+    InventoryState state = inventory_.captureState([this, &snapshot_lsn]() { snapshot_lsn = getLastLsn(); });
+
+    ByteWriter writer;
+    writer.putFixed64(log_id_);
+    writer.putVarUInt(snapshot_lsn);
+    writer.putVarInt(state.default_threshold);
+    writer.putVarUInt(state.category_thresholds.size());
+    for (const auto& pair : state.category_thresholds) {
+        writer.putString(pair.first);
+        writer.putVarInt(pair.second);
+    }
+    writer.putVarUInt(state.products.size());
+    for (const auto& product : state.products) {
+        Wire::putProduct(writer, *product);
+    }
+
+    if (!sendMessage(session.fd, MessageType::SNAPSHOT, writer)) {
+        return false;
+    }
+    lsn = snapshot_lsn;
+    session.snapshots_sent.fetch_add(1);
+    return true;
+}
+
+bool ReplicationPrimary::readLog(uint64_t after_lsn, size_t max_entries, std::vector<LogEntry>& entries) const {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    entries.clear();
+
+    uint64_t oldest = log_.empty() ? last_lsn_ + 1 : log_.front().lsn;
+    if (after_lsn + 1 < oldest) {
+        return false;
+    }
+
+    // LSNs in the log are consecutive, so the position follows from the LSN
+    for (size_t i = after_lsn + 1 - oldest; i < log_.size() && entries.size() < max_entries; ++i) {
+        entries.push_back(log_[i]);
+    }
+    return true;
+}
+
+void ReplicationPrimary::reapSessions() {
+    std::vector<std::unique_ptr<Session>> finished;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        auto it = std::partition(sessions_.begin(), sessions_.end(),
+                                 [](const std::unique_ptr<Session>& session) { return !session->finished.load(); });
+        std::move(it, sessions_.end(), std::back_inserter(finished));
+        sessions_.erase(it, sessions_.end());
+    }
+    for (auto& session : finished) {
+        session->thread.join();
+        Wire::closeSocket(session->fd);
+    }
+}
+
+// ReplicationFollower Implementation
+
+ReplicationFollower::ReplicationFollower(Inventory& inventory, const std::string& primary_host, uint16_t primary_port)
+    : inventory_(inventory), primary_host_(primary_host), primary_port_(primary_port),
+      running_(false), fd_(-1), log_id_(0), applied_lsn_(0), primary_lsn_(0), connected_(false),
+      last_contact_(steady_clock::now()), apply_delay_ms_(0.0), changes_applied_(0),
+      snapshots_loaded_(0), reconnects_(0) {
+}
+
+ReplicationFollower::~ReplicationFollower() {
+    stop();
+}
+
+bool ReplicationFollower::start() {
+    if (running_.load() || !Wire::isIPv4Address(primary_host_)) {
+        return false;
+    }
+    running_.store(true);
+    thread_ = std::thread(&ReplicationFollower::run, this);
+    return true;
+}
+
+void ReplicationFollower::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    Wire::shutdownSocket(fd_.load());
+    {
+        // Taking the lock orders the flag before a reconnect wait
+        std::lock_guard<std::mutex> lock(status_mutex_);
+    }
+    applied_cv_.notify_all();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+ReplicationStatus ReplicationFollower::getStatus() const {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    ReplicationStatus status;
+    status.connected = connected_;
+    status.applied_lsn = applied_lsn_;
+    status.primary_lsn = primary_lsn_;
+    status.lag_changes = primary_lsn_ > applied_lsn_ ? primary_lsn_ - applied_lsn_ : 0;
+    status.apply_delay_ms = apply_delay_ms_;
+    status.since_contact_ms = duration<double, std::milli>(steady_clock::now() - last_contact_).count();
+    status.changes_applied = changes_applied_;
+    status.snapshots_loaded = snapshots_loaded_;
+    status.reconnects = reconnects_;
+    return status;
+}
+
+bool ReplicationFollower::waitForLsn(uint64_t lsn, milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(status_mutex_);
+    return applied_cv_.wait_for(lock, timeout, [this, lsn]() { return applied_lsn_ >= lsn; });
+}
+
+void ReplicationFollower::run() {
+    milliseconds delay = kMinReconnectDelay;
+    bool connected_before = false;
+    while (running_.load()) {
+        int fd = Wire::connectTcp(primary_host_, primary_port_);
+        if (fd >= 0) {
+            if (connected_before) {
+                std::lock_guard<std::mutex> lock(status_mutex_);
+                reconnects_++;
+            }
+            connected_before = true;
+            delay = kMinReconnectDelay;
+
+            fd_.store(fd);
+            if (running_.load()) {
+                follow(fd);
+            }
+            fd_.store(-1);
+            Wire::closeSocket(fd);
+        }
+
+        std::unique_lock<std::mutex> lock(status_mutex_);
+        connected_ = false;
+        applied_cv_.wait_for(lock, delay, [this]() { return !running_.load(); });
+        delay = std::min(delay * 2, kMaxReconnectDelay);
+    }
+}
+
+void ReplicationFollower::follow(int fd) {
+    ByteWriter hello;
+    {
+        std::lock_guard<std::mutex> lock(status_mutex_);
+        hello.putVarUInt(kProtocolVersion);
+        hello.putFixed64(log_id_);
+        hello.putVarUInt(applied_lsn_);
+    }
+    if (!sendMessage(fd, MessageType::HELLO, hello)) {
+        return;
+    }
+
+    auto last_message = steady_clock::now();
+    MessageType type;
+    std::vector<uint8_t> body;
+    while (running_.load()) {
+        Wire::ReceiveResult result = receiveMessage(fd, kHeartbeatInterval, type, body);
+        if (result == Wire::ReceiveResult::CLOSED) {
+            return;
+        }
+        if (result == Wire::ReceiveResult::TIMEOUT) {
+            // Heartbeats stopped: the primary or the network is gone
+            if (steady_clock::now() - last_message > kPrimaryTimeout) {
+                return;
+            }
+            continue;
+        }
+        last_message = steady_clock::now();
+
+        bool ok = (type == MessageType::SNAPSHOT && loadSnapshot(body)) ||
+                  (type == MessageType::CHANGES && applyChanges(body));
+        if (!ok) {
+            // Reconnecting resumes from the last change applied intact
+            return;
+        }
+
+        ByteWriter ack;
+        {
+            std::lock_guard<std::mutex> lock(status_mutex_);
+            connected_ = true;
+            last_contact_ = last_message;
+            ack.putVarUInt(applied_lsn_);
+        }
+        if (!sendMessage(fd, MessageType::ACK, ack)) {
+            return;
+        }
+    }
+}
+
+bool ReplicationFollower::loadSnapshot(const std::vector<uint8_t>& body) {
+    ByteReader reader(body);
+    uint64_t log_id;
+    uint64_t lsn;
+    int64_t default_threshold;
+    uint64_t count;
+    if (!reader.getFixed64(log_id) || !reader.getVarUInt(lsn) || !reader.getVarInt(default_threshold) ||
+        !reader.getVarUInt(count)) {
+        return false;
+    }
+
+    InventoryState state;
+    state.default_threshold = static_cast<int>(default_threshold);
+    for (uint64_t i = 0; i < count; ++i) {
+        std::string category;
+        int64_t threshold;
+        if (!reader.getString(category) || !reader.getVarInt(threshold)) {
+            return false;
+        }
+        state.category_thresholds[category] = static_cast<int>(threshold);
+    }
+    if (!reader.getVarUInt(count)) {
+        return false;
+    }
+    for (uint64_t i = 0; i < count; ++i) {
+        auto product = std::make_shared<ProductVersion>();
+        if (!Wire::getProduct(reader, *product)) {
+            return false;
+        }
+        state.products.push_back(std::move(product));
+    }
+
+    inventory_.restoreState(state);
+
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    log_id_ = log_id;
+    applied_lsn_ = lsn;
+    primary_lsn_ = lsn;
+    apply_delay_ms_ = 0.0;
+    snapshots_loaded_++;
+    applied_cv_.notify_all();
+    return true;
+}
+
+bool ReplicationFollower::applyChanges(const std::vector<uint8_t>& body) {
+    ByteReader reader(body);
+    uint64_t primary_lsn;
+    int64_t sent_at_us;
+    uint64_t count;
+    if (!reader.getVarUInt(primary_lsn) || !reader.getVarInt(sent_at_us) || !reader.getVarUInt(count)) {
+        return false;
+    }
+
+    uint64_t applied_lsn;
+    {
+        std::lock_guard<std::mutex> lock(status_mutex_);
+        applied_lsn = applied_lsn_;
+    }
+
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t lsn;
+        int64_t committed_at_us;
+        InventoryChange change;
+        if (!reader.getVarUInt(lsn) || !reader.getVarInt(committed_at_us) || !decodeChange(reader, change)) {
+            return false;
+        }
+        if (lsn <= applied_lsn) {
+            continue;
+        }
+        if (lsn != applied_lsn + 1) {
+            return false;
+        }
+
+        if (change.kind == InventoryChange::Kind::THRESHOLD) {
+            inventory_.setCategoryThreshold(change.category, change.threshold);
+        } else {
+            // A rejected state is skipped rather than stalling replication
+            inventory_.applyProductState(*change.product);
+        }
+        applied_lsn = lsn;
+
+        // Assumes the clocks agree, as they do over loopback
+        double delay_ms = std::max(0.0, (toMicros(system_clock::now()) - committed_at_us) / 1000.0);
+        std::lock_guard<std::mutex> lock(status_mutex_);
+        applied_lsn_ = lsn;
+        apply_delay_ms_ = delay_ms;
+        changes_applied_++;
+        applied_cv_.notify_all();
+    }
+
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    primary_lsn_ = std::max(primary_lsn, applied_lsn_);
+    return true;
+}
+
+} // namespace quirkventory
@@ -0,0 +1,334 @@
+#include "../include/ReportWriter.hpp"
+#include <cstring>
+#include <cctype>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace quirkventory {
+
+// FileSink Implementation
+
+FileSink::FileSink(size_t buffer_size)
+    : file_(nullptr), buffer_(buffer_size > 0 ? buffer_size : 1), used_(0),
+      bytes_written_(0), failed_(false) {
+}
+
+FileSink::~FileSink() {
+    close();
+}
+
+bool FileSink::open(const std::string& filename) {
+    close();
+    file_ = std::fopen(filename.c_str(), "wb");
+    used_ = 0;
+    bytes_written_ = 0;
+    failed_ = (file_ == nullptr);
+    return file_ != nullptr;
+}
+
+void FileSink::write(const char* data, size_t size) {
+    bytes_written_ += size;
+
+    // Large writes bypass the buffer once it has been drained
+    if (size >= buffer_.size()) {
+        flush();
+        if (file_ && std::fwrite(data, 1, size, file_) != size) {
+            failed_ = true;
+        }
+        return;
+    }
+
+    if (used_ + size > buffer_.size()) {
+        flush();
+    }
+    std::memcpy(buffer_.data() + used_, data, size);
+    used_ += size;
+}
+
+bool FileSink::flush() {
+    if (file_ && used_ > 0) {
+        if (std::fwrite(buffer_.data(), 1, used_, file_) != used_) {
+            failed_ = true;
+        }
+    }
+    used_ = 0;
+    return !failed_;
+}
+
+bool FileSink::close() {
+    if (!file_) {
+        return !failed_;
+    }
+    flush();
+    if (std::fclose(file_) != 0) {
+        failed_ = true;
+    }
+    file_ = nullptr;
+    return !failed_;
+}
+
+// ReportWriter Implementation
+
+ReportWriter::ReportWriter(FileSink& sink) : sink_(sink), field_index_(0) {
+}
+
+std::unique_ptr<ReportWriter> ReportWriter::create(ReportFormat format, FileSink& sink) {
+    switch (format) {
+        case ReportFormat::CSV:
+            return std::make_unique<CsvReportWriter>(sink);
+        case ReportFormat::JSON_LINES:
+            return std::make_unique<JsonLinesReportWriter>(sink);
+        case ReportFormat::TEXT:
+        default:
+            return std::make_unique<TextReportWriter>(sink);
+    }
+}
+
+void ReportWriter::beginSection(const std::string& name, const std::vector<std::string>& columns) {
+    section_ = name;
+    columns_ = columns;
+    writeSectionHeader();
+}
+
+void ReportWriter::beginRow() {
+    field_index_ = 0;
+    writeRowStart();
+}
+
+void ReportWriter::addField(const std::string& value) {
+    writeField(value.data(), value.size(), false);
+    field_index_++;
+}
+
+void ReportWriter::addField(const char* value) {
+    writeField(value, std::strlen(value), false);
+    field_index_++;
+}
+
+void ReportWriter::addField(long long value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%lld", value);
+    writeField(buffer, static_cast<size_t>(length), true);
+    field_index_++;
+}
+
+void ReportWriter::addField(double value) {
+    char buffer[64];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.2f", value);
+    writeField(buffer, static_cast<size_t>(length), true);
+    field_index_++;
+}
+
+void ReportWriter::endRow() {
+    writeRowEnd();
+}
+
+// TextReportWriter Implementation
+
+void TextReportWriter::beginReport(const std::string& title, const std::string& generated_by,
+                                   const std::chrono::system_clock::time_point& generated_date) {
+    std::ostringstream oss;
+    auto time_t = std::chrono::system_clock::to_time_t(generated_date);
+    oss << "========================================\n";
+    oss << title << "\n";
+    oss << "========================================\n";
+    oss << "Generated: " << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S") << "\n";
+    oss << "Generated by: " << generated_by << "\n";
+    oss << "========================================\n";
+    sink_.write(oss.str());
+}
+
+void TextReportWriter::writeNote(const std::string& text) {
+    sink_.write(text);
+    sink_.put('\n');
+}
+
+void TextReportWriter::endReport() {
+    sink_.write("\n========================================\n"
+                "End of Report\n"
+                "========================================\n");
+}
+
+void TextReportWriter::writeSectionHeader() {
+    std::string heading = section_;
+    for (char& c : heading) {
+        c = (c == '_') ? ' ' : static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    sink_.put('\n');
+    sink_.write(heading);
+    sink_.put('\n');
+    sink_.write(std::string(heading.size(), '-'));
+    sink_.put('\n');
+
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        if (i > 0) {
+            sink_.write(" | ", 3);
+        }
+        sink_.write(columns_[i]);
+    }
+    sink_.put('\n');
+}
+
+void TextReportWriter::writeRowStart() {
+}
+
+void TextReportWriter::writeField(const char* data, size_t size, bool) {
+    if (field_index_ > 0) {
+        sink_.write(" | ", 3);
+    }
+    sink_.write(data, size);
+}
+
+void TextReportWriter::writeRowEnd() {
+    sink_.put('\n');
+}
+
+// CsvReportWriter Implementation
+
+void CsvReportWriter::beginReport(const std::string& title, const std::string& generated_by,
+                                  const std::chrono::system_clock::time_point& generated_date) {
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(generated_date.time_since_epoch()).count();
+    writeNote(title + " (generated by " + generated_by + " at " + std::to_string(seconds) + ")");
+}
+
+void CsvReportWriter::writeNote(const std::string& text) {
+    sink_.write("# ", 2);
+    for (char c : text) {
+        sink_.put(c == '\n' ? ' ' : c);
+    }
+    sink_.put('\n');
+}
+
+void CsvReportWriter::endReport() {
+}
+
+void CsvReportWriter::writeSectionHeader() {
+    sink_.write("section", 7);
+    for (const auto& column : columns_) {
+        sink_.put(',');
+        writeEscaped(column.data(), column.size());
+    }
+    sink_.put('\n');
+}
+
+void CsvReportWriter::writeRowStart() {
+    writeEscaped(section_.data(), section_.size());
+}
+
+void CsvReportWriter::writeField(const char* data, size_t size, bool numeric) {
+    sink_.put(',');
+    if (numeric) {
+        sink_.write(data, size);
+    } else {
+        writeEscaped(data, size);
+    }
+}
+
+void CsvReportWriter::writeRowEnd() {
+    sink_.put('\n');
+}
+
+void CsvReportWriter::writeEscaped(const char* data, size_t size) {
+    bool needs_quotes = false;
+    for (size_t i = 0; i < size; ++i) {
+        char c = data[i];
+        if (c == ',' || c == '"' || c == '\n' || c == '\r') {
+            needs_quotes = true;
+            break;
+        }
+    }
+
+    if (!needs_quotes) {
+        sink_.write(data, size);
+        return;
+    }
+
+    sink_.put('"');
+    for (size_t i = 0; i < size; ++i) {
+        if (data[i] == '"') {
+            sink_.put('"');
+        }
+        sink_.put(data[i]);
+    }
+    sink_.put('"');
+}
+
+// JsonLinesReportWriter Implementation
+
+void JsonLinesReportWriter::beginReport(const std::string& title, const std::string& generated_by,
+                                        const std::chrono::system_clock::time_point& generated_date) {
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(generated_date.time_since_epoch()).count();
+    sink_.write("{\"section\":\"report\",\"title\":", 28);
+    writeString(title.data(), title.size());
+    sink_.write(",\"generated_by\":", 16);
+    writeString(generated_by.data(), generated_by.size());
+    sink_.write(",\"generated\":", 13);
+    sink_.write(std::to_string(seconds));
+    sink_.write("}\n", 2);
+}
+
+void JsonLinesReportWriter::writeNote(const std::string& text) {
+    sink_.write("{\"section\":", 11);
+    writeString(section_.data(), section_.size());
+    sink_.write(",\"note\":", 8);
+    writeString(text.data(), text.size());
+    sink_.write("}\n", 2);
+}
+
+void JsonLinesReportWriter::endReport() {
+}
+
+void JsonLinesReportWriter::writeSectionHeader() {
+}
+
+void JsonLinesReportWriter::writeRowStart() {
+    sink_.write("{\"section\":", 11);
+    writeString(section_.data(), section_.size());
+}
+
+void JsonLinesReportWriter::writeField(const char* data, size_t size, bool numeric) {
+    sink_.put(',');
+    if (field_index_ < columns_.size()) {
+        writeString(columns_[field_index_].data(), columns_[field_index_].size());
+    } else {
+        std::string column = "field" + std::to_string(field_index_);
+        writeString(column.data(), column.size());
+    }
+    sink_.put(':');
+    if (numeric) {
+        sink_.write(data, size);
+    } else {
+        writeString(data, size);
+    }
+}
+
+void JsonLinesReportWriter::writeRowEnd() {
+    sink_.write("}\n", 2);
+}
+
+void JsonLinesReportWriter::writeString(const char* data, size_t size) {
+    static const char hex[] = "0123456789abcdef";
+    sink_.put('"');
+    for (size_t i = 0; i < size; ++i) {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        switch (c) {
+            case '"': sink_.write("\\\"", 2); break;
+            case '\\': sink_.write("\\\\", 2); break;
+            case '\n': sink_.write("\\n", 2); break;
+            case '\r': sink_.write("\\r", 2); break;
+            case '\t': sink_.write("\\t", 2); break;
+            default:
+                if (c < 0x20) {
+                    char escaped[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                    sink_.write(escaped, 6);
+                } else {
+                    sink_.put(static_cast<char>(c));
+                }
+                break;
+        }
+    }
+    sink_.put('"');
+}
+
+} // namespace quirkventory
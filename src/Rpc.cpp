@@ -0,0 +1,577 @@
+#include "../include/Rpc.hpp"
+#include "../include/Wire.hpp"
+#include <algorithm>
+#include <unistd.h>
+
+namespace quirkventory {
+
+namespace {
+
+using namespace std::chrono;
+
+// How often the accept loop and sessions check for shutdown
+constexpr milliseconds kPollInterval(200);
+
+// Requests start with a request ID; replies echo the request's type and ID,
+// then a status byte, then the payload (OK) or an error message (REJECTED, BAD_REQUEST)
+enum class RpcType : uint8_t {
+    GET_PRODUCT = 1,        // Product ID -> product state, available quantity
+    RESERVE = 2,            // Product ID, quantity, ttl in ms -> hold ID
+    CONFIRM = 3,            // Hold ID
+    RELEASE = 4,            // Hold ID
+    CREATE_ORDER = 5,       // Customer ID, items, flags -> order
+    PROCESS_ORDER = 6       // Order ID, flags -> order
+};
+
+// Flags of CREATE_ORDER and PROCESS_ORDER
+constexpr uint8_t kProcessFlag = 1;
+constexpr uint8_t kBackorderFlag = 2;
+
+void putStatus(ByteWriter& reply, RpcStatus status) {
+    reply.putUInt8(static_cast<uint8_t>(status));
+}
+
+void putError(ByteWriter& reply, RpcStatus status, const std::string& message) {
+    putStatus(reply, status);
+    reply.putString(message);
+}
+
+void putOrder(ByteWriter& reply, const Order& order) {
+    putStatus(reply, RpcStatus::OK);
+    reply.putString(order.getOrderId());
+    reply.putUInt8(static_cast<uint8_t>(order.getStatus()));
+    reply.putDouble(order.getTotalAmount());
+}
+
+bool getOrder(ByteReader& reader, RpcOrder& order) {
+    uint8_t status;
+    if (!reader.getString(order.order_id) || !reader.getUInt8(status) ||
+        status > static_cast<uint8_t>(OrderStatus::BACKORDERED) || !reader.getDouble(order.total_amount)) {
+        return false;
+    }
+    order.status = static_cast<OrderStatus>(status);
+    return true;
+}
+
+/**
+ * @brief Decode a reply's status and payload into a call's result
+ * @return false if the reply is malformed
+ */
+bool decodeReply(uint8_t type, ByteReader& reader, RpcResult& result) {
+    uint8_t status;
+    if (!reader.getUInt8(status) || status > static_cast<uint8_t>(RpcStatus::BAD_REQUEST)) {
+        return false;
+    }
+    result.status = static_cast<RpcStatus>(status);
+    if (result.status == RpcStatus::REJECTED || result.status == RpcStatus::BAD_REQUEST) {
+        return reader.getString(result.error);
+    }
+    if (result.status != RpcStatus::OK) {
+        return true;
+    }
+
+    switch (static_cast<RpcType>(type)) {
+        case RpcType::GET_PRODUCT: {
+            int64_t available;
+            if (!Wire::getProduct(reader, result.product.state) || !reader.getVarInt(available)) {
+                return false;
+            }
+            result.product.available_quantity = static_cast<int>(available);
+            return true;
+        }
+        case RpcType::RESERVE:
+            return reader.getVarUInt(result.hold_id);
+        case RpcType::CONFIRM:
+        case RpcType::RELEASE:
+            return true;
+        case RpcType::CREATE_ORDER:
+        case RpcType::PROCESS_ORDER:
+            return getOrder(reader, result.order);
+    }
+    return false;
+}
+
+} // namespace
+
+// RpcBatch Implementation
+
+size_t RpcBatch::add(uint8_t type, ByteWriter request) {
+    calls_.push_back({type, std::move(request)});
+    results_.emplace_back();
+    return calls_.size() - 1;
+}
+
+size_t RpcBatch::getProduct(const std::string& product_id) {
+    ByteWriter request;
+    request.putString(product_id);
+    return add(static_cast<uint8_t>(RpcType::GET_PRODUCT), std::move(request));
+}
+
+size_t RpcBatch::reserve(const std::string& product_id, int quantity, std::chrono::milliseconds ttl) {
+    ByteWriter request;
+    request.putString(product_id);
+    request.putVarInt(quantity);
+    request.putVarInt(ttl.count());
+    return add(static_cast<uint8_t>(RpcType::RESERVE), std::move(request));
+}
+
+size_t RpcBatch::confirm(uint64_t hold_id) {
+    ByteWriter request;
+    request.putVarUInt(hold_id);
+    return add(static_cast<uint8_t>(RpcType::CONFIRM), std::move(request));
+}
+
+size_t RpcBatch::release(uint64_t hold_id) {
+    ByteWriter request;
+    request.putVarUInt(hold_id);
+    return add(static_cast<uint8_t>(RpcType::RELEASE), std::move(request));
+}
+
+size_t RpcBatch::createOrder(const std::string& customer_id, const std::vector<std::pair<std::string, int>>& items,
+                             bool process, bool allow_backorder) {
+    ByteWriter request;
+    request.putString(customer_id);
+    request.putVarUInt(items.size());
+    for (const auto& item : items) {
+        request.putString(item.first);
+        request.putVarInt(item.second);
+    }
+    request.putUInt8((process ? kProcessFlag : 0) | (allow_backorder ? kBackorderFlag : 0));
+    return add(static_cast<uint8_t>(RpcType::CREATE_ORDER), std::move(request));
+}
+
+size_t RpcBatch::processOrder(const std::string& order_id, bool allow_backorder) {
+    ByteWriter request;
+    request.putString(order_id);
+    request.putUInt8(allow_backorder ? kBackorderFlag : 0);
+    return add(static_cast<uint8_t>(RpcType::PROCESS_ORDER), std::move(request));
+}
+
+void RpcBatch::clear() {
+    calls_.clear();
+    results_.clear();
+}
+
+// RpcServer Implementation
+
+RpcServer::RpcServer(Inventory& inventory, OrderManager& order_manager)
+    : inventory_(inventory), order_manager_(order_manager), port_(0), listen_fd_(-1),
+      running_(false), requests_(0), writes_(0) {
+}
+
+RpcServer::~RpcServer() {
+    stop();
+}
+
+bool RpcServer::start(uint16_t port, const std::string& bind_address) {
+    if (running_.load()) {
+        return false;
+    }
+    int fd = Wire::listenTcp(bind_address, port);
+    if (fd < 0) {
+        return false;
+    }
+    port_ = port;
+    return startAccepting(fd);
+}
+
+bool RpcServer::startUnix(const std::string& path) {
+    if (running_.load()) {
+        return false;
+    }
+    int fd = Wire::listenUnix(path);
+    if (fd < 0) {
+        return false;
+    }
+    unix_path_ = path;
+    port_ = 0;
+    return startAccepting(fd);
+}
+
+bool RpcServer::startAccepting(int listen_fd) {
+    listen_fd_ = listen_fd;
+    running_.store(true);
+    accept_thread_ = std::thread(&RpcServer::acceptLoop, this);
+    return true;
+}
+
+void RpcServer::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (accept_thread_.joinable()) {
+        accept_thread_.join();
+    }
+    Wire::closeSocket(listen_fd_);
+    listen_fd_ = -1;
+    if (!unix_path_.empty()) {
+        ::unlink(unix_path_.c_str());
+        unix_path_.clear();
+    }
+
+    std::vector<std::unique_ptr<Session>> sessions;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        for (auto& session : sessions_) {
+            Wire::shutdownSocket(session->fd);
+        }
+        sessions.swap(sessions_);
+    }
+    for (auto& session : sessions) {
+        session->thread.join();
+        Wire::closeSocket(session->fd);
+    }
+}
+
+void RpcServer::acceptLoop() {
+    while (running_.load()) {
+        reapSessions();
+
+        std::string peer;
+        int fd = Wire::acceptConnection(listen_fd_, kPollInterval, peer);
+        if (fd < 0) {
+            continue;
+        }
+
+        auto session = std::make_unique<Session>();
+        session->fd = fd;
+
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        Session& added = *session;
+        sessions_.push_back(std::move(session));
+        added.thread = std::thread(&RpcServer::serve, this, std::ref(added));
+    }
+}
+
+void RpcServer::serve(Session& session) {
+    Wire::FrameReader reader;
+    std::vector<uint8_t> replies;
+    uint8_t type;
+    std::vector<uint8_t> body;
+
+    while (running_.load()) {
+        Wire::ReceiveResult result = reader.fill(session.fd, kPollInterval);
+        if (result == Wire::ReceiveResult::TIMEOUT) {
+            continue;
+        }
+        if (result == Wire::ReceiveResult::CLOSED) {
+            break;
+        }
+
+        // Answer everything that arrived together with a single write
+        bool valid = true;
+        replies.clear();
+        while (valid && reader.next(type, body)) {
+            ByteWriter reply;
+            valid = handle(type, body, reply);
+            Wire::appendMessage(replies, type, reply);
+        }
+        if (!valid || reader.isInvalid()) {
+            break;
+        }
+        if (!replies.empty()) {
+            if (!Wire::sendFrames(session.fd, replies)) {
+                break;
+            }
+            writes_.fetch_add(1);
+        }
+    }
+    session.finished.store(true);
+}
+
+bool RpcServer::handle(uint8_t type, const std::vector<uint8_t>& body, ByteWriter& reply) {
+    ByteReader reader(body);
+    uint64_t request_id;
+    if (!reader.getVarUInt(request_id)) {
+        return false;
+    }
+    requests_.fetch_add(1);
+    reply.putVarUInt(request_id);
+
+    std::string id;
+    int64_t quantity;
+    int64_t ttl_ms;
+    uint64_t hold_id;
+    uint8_t flags;
+
+    switch (static_cast<RpcType>(type)) {
+        case RpcType::GET_PRODUCT: {
+            if (!reader.getString(id)) {
+                break;
+            }
+            ProductVersion state;
+            if (!inventory_.getProductState(id, state)) {
+                putStatus(reply, RpcStatus::NOT_FOUND);
+                return true;
+            }
+            putStatus(reply, RpcStatus::OK);
+            Wire::putProduct(reply, state);
+            reply.putVarInt(inventory_.getAvailableQuantity(id));
+            return true;
+        }
+        case RpcType::RESERVE: {
+            if (!reader.getString(id) || !reader.getVarInt(quantity) || !reader.getVarInt(ttl_ms)) {
+                break;
+            }
+            if (quantity <= 0 || quantity > INT32_MAX || ttl_ms <= 0) {
+                putError(reply, RpcStatus::BAD_REQUEST, "Quantity and ttl must be positive");
+                return true;
+            }
+            if (ttl_ms > MAX_HOLD_TTL.count()) {
+                putError(reply, RpcStatus::BAD_REQUEST,
+                         "ttl must be at most " + std::to_string(MAX_HOLD_TTL.count()) + " ms");
+                return true;
+            }
+            if (!inventory_.hasProduct(id)) {
+                putStatus(reply, RpcStatus::NOT_FOUND);
+                return true;
+            }
+            uint64_t placed = inventory_.placeHold(id, static_cast<int>(quantity), milliseconds(ttl_ms));
+            if (placed == 0) {
+                putError(reply, RpcStatus::REJECTED, "Not enough available stock for " + id);
+                return true;
+            }
+            putStatus(reply, RpcStatus::OK);
+            reply.putVarUInt(placed);
+            return true;
+        }
+        case RpcType::CONFIRM:
+        case RpcType::RELEASE: {
+            if (!reader.getVarUInt(hold_id)) {
+                break;
+            }
+            bool done = static_cast<RpcType>(type) == RpcType::CONFIRM
+                ? inventory_.confirmHold(hold_id)
+                : inventory_.releaseHold(hold_id);
+            putStatus(reply, done ? RpcStatus::OK : RpcStatus::NOT_FOUND);
+            return true;
+        }
+        case RpcType::CREATE_ORDER: {
+            std::string customer_id;
+            uint64_t count;
+            if (!reader.getString(customer_id) || !reader.getVarUInt(count)) {
+                break;
+            }
+            std::vector<std::pair<std::string, int64_t>> items;
+            bool valid = true;
+            for (uint64_t i = 0; valid && i < count; ++i) {
+                valid = reader.getString(id) && reader.getVarInt(quantity);
+                items.emplace_back(id, quantity);
+            }
+            if (!valid || !reader.getUInt8(flags)) {
+                break;
+            }
+            bool quantities_valid = std::all_of(items.begin(), items.end(), [](const std::pair<std::string, int64_t>& item) {
+                return item.second > 0 && item.second <= INT32_MAX;
+            });
+            if (customer_id.empty() || items.empty() || !quantities_valid) {
+                putError(reply, RpcStatus::BAD_REQUEST, "Customer ID and items with positive quantities are required");
+                return true;
+            }
+
+            // Prices come from the catalogue, not from the client
+            std::vector<double> prices;
+            for (const auto& item : items) {
+                ProductVersion state;
+                if (!inventory_.getProductState(item.first, state)) {
+                    putError(reply, RpcStatus::NOT_FOUND, "Product not found: " + item.first);
+                    return true;
+                }
+                prices.push_back(state.price);
+            }
+
+            Order* order = order_manager_.createOrderForCustomer(customer_id);
+            if (!order) {
+                putError(reply, RpcStatus::REJECTED, "Failed to create order");
+                return true;
+            }
+            for (size_t i = 0; i < items.size(); ++i) {
+                order->addItem(items[i].first, static_cast<int>(items[i].second), prices[i]);
+            }
+            if ((flags & kProcessFlag) && !order->processOrder(inventory_, (flags & kBackorderFlag) != 0)) {
+                putError(reply, RpcStatus::REJECTED,
+                         "Order " + order->getOrderId() + " failed: " + order->getErrorMessage());
+                return true;
+            }
+            putOrder(reply, *order);
+            return true;
+        }
+        case RpcType::PROCESS_ORDER: {
+            if (!reader.getString(id) || !reader.getUInt8(flags)) {
+                break;
+            }
+            Order* order = order_manager_.getOrder(id);
+            if (!order) {
+                putStatus(reply, RpcStatus::NOT_FOUND);
+                return true;
+            }
+            if (!order->processOrder(inventory_, (flags & kBackorderFlag) != 0)) {
+                putError(reply, RpcStatus::REJECTED, "Order " + id + " failed: " + order->getErrorMessage());
+                return true;
+            }
+            putOrder(reply, *order);
+            return true;
+        }
+        default:
+            putError(reply, RpcStatus::BAD_REQUEST, "Unknown request type " + std::to_string(type));
+            return true;
+    }
+
+    putError(reply, RpcStatus::BAD_REQUEST, "Malformed request");
+    return true;
+}
+
+void RpcServer::reapSessions() {
+    std::vector<std::unique_ptr<Session>> finished;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        auto it = std::partition(sessions_.begin(), sessions_.end(),
+                                 [](const std::unique_ptr<Session>& session) { return !session->finished.load(); });
+        std::move(it, sessions_.end(), std::back_inserter(finished));
+        sessions_.erase(it, sessions_.end());
+    }
+    for (auto& session : finished) {
+        session->thread.join();
+        Wire::closeSocket(session->fd);
+    }
+}
+
+// RpcClient Implementation
+
+RpcClient::RpcClient(std::chrono::milliseconds timeout)
+    : fd_(-1), timeout_(timeout), next_request_id_(1) {
+}
+
+RpcClient::~RpcClient() {
+    close();
+}
+
+bool RpcClient::connect(const std::string& host, uint16_t port) {
+    close();
+    fd_ = Wire::connectTcp(host, port);
+    return fd_ >= 0;
+}
+
+bool RpcClient::connectUnix(const std::string& path) {
+    close();
+    fd_ = Wire::connectUnix(path);
+    return fd_ >= 0;
+}
+
+void RpcClient::close() {
+    Wire::closeSocket(fd_);
+    fd_ = -1;
+}
+
+bool RpcClient::execute(RpcBatch& batch) {
+    for (auto& result : batch.results_) {
+        result = RpcResult();
+    }
+    if (fd_ < 0) {
+        return false;
+    }
+    if (batch.calls_.empty()) {
+        return true;
+    }
+
+    uint64_t first_id = next_request_id_;
+    next_request_id_ += batch.calls_.size();
+
+    std::vector<uint8_t> frames;
+    for (size_t i = 0; i < batch.calls_.size(); ++i) {
+        const auto& call = batch.calls_[i];
+        ByteWriter body;
+        body.putVarUInt(first_id + i);
+        body.putBytes(call.request.getBuffer().data(), call.request.size());
+        Wire::appendMessage(frames, call.type, body);
+    }
+    if (!Wire::sendFrames(fd_, frames)) {
+        close();
+        return false;
+    }
+
+    // Replies come back in request order
+    Wire::FrameReader reader;
+    uint8_t type;
+    std::vector<uint8_t> body;
+    for (size_t i = 0; i < batch.calls_.size(); ++i) {
+        while (!reader.next(type, body)) {
+            if (reader.isInvalid() || reader.fill(fd_, timeout_) != Wire::ReceiveResult::MESSAGE) {
+                close();
+                return false;
+            }
+        }
+
+        ByteReader decoder(body);
+        uint64_t request_id;
+        RpcResult& result = batch.results_[i];
+        if (type != batch.calls_[i].type || !decoder.getVarUInt(request_id) || request_id != first_id + i ||
+            !decodeReply(type, decoder, result)) {
+            result = RpcResult();
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+const RpcResult& RpcClient::call(RpcBatch& batch) {
+    execute(batch);
+    return batch.result(0);
+}
+
+RpcStatus RpcClient::getProduct(const std::string& product_id, RpcProduct& product) {
+    RpcBatch batch;
+    batch.getProduct(product_id);
+    const RpcResult& result = call(batch);
+    if (result.status == RpcStatus::OK) {
+        product = result.product;
+    }
+    return result.status;
+}
+
+RpcStatus RpcClient::reserve(const std::string& product_id, int quantity, std::chrono::milliseconds ttl,
+                             uint64_t& hold_id) {
+    RpcBatch batch;
+    batch.reserve(product_id, quantity, ttl);
+    const RpcResult& result = call(batch);
+    if (result.status == RpcStatus::OK) {
+        hold_id = result.hold_id;
+    }
+    return result.status;
+}
+
+RpcStatus RpcClient::confirm(uint64_t hold_id) {
+    RpcBatch batch;
+    batch.confirm(hold_id);
+    return call(batch).status;
+}
+
+RpcStatus RpcClient::release(uint64_t hold_id) {
+    RpcBatch batch;
+    batch.release(hold_id);
+    return call(batch).status;
+}
+
+RpcStatus RpcClient::createOrder(const std::string& customer_id, const std::vector<std::pair<std::string, int>>& items,
+                                 RpcOrder& order, bool process, bool allow_backorder) {
+    RpcBatch batch;
+    batch.createOrder(customer_id, items, process, allow_backorder);
+    const RpcResult& result = call(batch);
+    if (result.status == RpcStatus::OK) {
+        order = result.order;
+    }
+    return result.status;
+}
+
+RpcStatus RpcClient::processOrder(const std::string& order_id, RpcOrder& order, bool allow_backorder) {
+    RpcBatch batch;
+    batch.processOrder(order_id, allow_backorder);
+    const RpcResult& result = call(batch);
+    if (result.status == RpcStatus::OK) {
+        order = result.order;
+    }
+    return result.status;
+}
+
+} // namespace quirkventory
@@ -0,0 +1,381 @@
+#include "../include/SalesAnalytics.hpp"
+#include "../include/Order.hpp"
+#include <algorithm>
+
+namespace quirkventory {
+
+namespace {
+
+constexpr long long SECONDS_PER_HOUR = 3600;
+constexpr long long HOURS_PER_DAY = 24;
+constexpr long long DAYS_PER_WEEK = 7;
+// 1970-01-01 was a Thursday; shifting by 3 days makes weeks start on Monday
+constexpr long long WEEK_DAY_OFFSET = 3;
+
+long long floorDiv(long long a, long long b) {
+    long long q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) {
+        --q;
+    }
+    return q;
+}
+
+long long ceilDiv(long long a, long long b) {
+    return -floorDiv(-a, b);
+}
+
+long long hourIndex(const std::chrono::system_clock::time_point& time_point) {
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        time_point.time_since_epoch()).count();
+    return floorDiv(seconds, SECONDS_PER_HOUR);
+}
+
+void applyTotals(SalesTotals& totals, double revenue, long long units, int sign) {
+    totals.revenue += sign * revenue;
+    totals.units += sign * units;
+    totals.orders += sign;
+}
+
+void applyToBucket(std::map<long long, SalesBucket>& buckets, long long index,
+                   const std::vector<OrderItem>& items, double order_revenue,
+                   long long order_units, int sign) {
+    SalesBucket& bucket = buckets[index];
+    applyTotals(bucket.totals, order_revenue, order_units, sign);
+
+    // Per-category totals count each order once per category it touches
+    std::unordered_map<std::string, std::pair<double, long long>> category_sums;
+    for (const auto& item : items) {
+        applyTotals(bucket.by_product[item.product_id], item.getTotalPrice(), item.quantity, sign);
+        const std::string& category = item.category.empty() ? std::string("Uncategorized") : item.category;
+        auto& sums = category_sums[category];
+        sums.first += item.getTotalPrice();
+        sums.second += item.quantity;
+    }
+    for (const auto& pair : category_sums) {
+        applyTotals(bucket.by_category[pair.first], pair.second.first, pair.second.second, sign);
+    }
+
+    if (sign < 0) {
+        // Drop entries that no longer hold any orders; only this order's can have changed
+        if (bucket.totals.orders <= 0) {
+            buckets.erase(index);
+            return;
+        }
+        for (const auto& item : items) {
+            auto it = bucket.by_product.find(item.product_id);
+            if (it != bucket.by_product.end() && it->second.orders <= 0) {
+                bucket.by_product.erase(it);
+            }
+        }
+        for (const auto& pair : category_sums) {
+            auto it = bucket.by_category.find(pair.first);
+            if (it != bucket.by_category.end() && it->second.orders <= 0) {
+                bucket.by_category.erase(it);
+            }
+        }
+    }
+}
+
+} // namespace
+
+// SalesTotals / SalesBucket Implementation
+
+void SalesTotals::merge(const SalesTotals& other) {
+    revenue += other.revenue;
+    units += other.units;
+    orders += other.orders;
+}
+
+void SalesBucket::merge(const SalesBucket& other) {
+    totals.merge(other.totals);
+    for (const auto& pair : other.by_category) {
+        by_category[pair.first].merge(pair.second);
+    }
+    for (const auto& pair : other.by_product) {
+        by_product[pair.first].merge(pair.second);
+    }
+}
+
+void OrderDistribution::merge(const OrderDistribution& other) {
+    customers.merge(other.customers);
+    order_values.merge(other.order_values);
+}
+
+// SalesAggregator Implementation
+
+SalesAggregator::SalesAggregator(size_t top_products_capacity)
+    : top_units_(top_products_capacity), top_revenue_(top_products_capacity) {
+}
+
+void SalesAggregator::recordOrder(const Order& order) {
+    applyOrder(order, 1);
+}
+
+void SalesAggregator::reverseOrder(const Order& order) {
+    applyOrder(order, -1);
+}
+
+SalesBucket SalesAggregator::query(const std::chrono::system_clock::time_point& start,
+                                   const std::chrono::system_clock::time_point& end) const {
+    std::lock_guard<std::mutex> lock(aggregator_mutex_);
+    return queryLocked(start, end);
+}
+
+SalesRangeSummary SalesAggregator::summarize(const std::chrono::system_clock::time_point& start,
+                                             const std::chrono::system_clock::time_point& end,
+                                             BucketGranularity granularity) const {
+    SalesRangeSummary summary;
+    {
+        std::lock_guard<std::mutex> lock(aggregator_mutex_);
+        summary.sales = queryLocked(start, end);
+        summary.series = getTimeSeriesLocked(start, end, granularity);
+        summary.distribution = getOrderDistributionLocked(start, end);
+    }
+    return summary;
+}
+
+SalesBucket SalesAggregator::queryLocked(const std::chrono::system_clock::time_point& start,
+                                         const std::chrono::system_clock::time_point& end) const {
+    // Note: This method assumes aggregator_mutex_ is already locked by the caller
+    SalesBucket result;
+    if (end < start) {
+        return result;
+    }
+
+    // Tile [first_hour, last_hour) with whole weeks, then whole days, then hours
+    long long first_hour = hourIndex(start);
+    long long last_hour = hourIndex(end) + 1;
+    long long first_day = ceilDiv(first_hour, HOURS_PER_DAY);
+    long long last_day = floorDiv(last_hour, HOURS_PER_DAY);
+
+    if (first_day >= last_day) {
+        mergeRange(hourly_, first_hour, last_hour, result);
+        return result;
+    }
+
+    mergeRange(hourly_, first_hour, first_day * HOURS_PER_DAY, result);
+    mergeRange(hourly_, last_day * HOURS_PER_DAY, last_hour, result);
+
+    long long first_week = ceilDiv(first_day + WEEK_DAY_OFFSET, DAYS_PER_WEEK);
+    long long last_week = floorDiv(last_day + WEEK_DAY_OFFSET, DAYS_PER_WEEK);
+
+    if (first_week >= last_week) {
+        mergeRange(daily_, first_day, last_day, result);
+        return result;
+    }
+
+    mergeRange(daily_, first_day, first_week * DAYS_PER_WEEK - WEEK_DAY_OFFSET, result);
+    mergeRange(daily_, last_week * DAYS_PER_WEEK - WEEK_DAY_OFFSET, last_day, result);
+    mergeRange(weekly_, first_week, last_week, result);
+
+    return result;
+}
+
+std::vector<std::pair<std::chrono::system_clock::time_point, SalesTotals>>
+SalesAggregator::getTimeSeries(const std::chrono::system_clock::time_point& start,
+                               const std::chrono::system_clock::time_point& end,
+                               BucketGranularity granularity) const {
+    std::lock_guard<std::mutex> lock(aggregator_mutex_);
+    return getTimeSeriesLocked(start, end, granularity);
+}
+
+std::vector<std::pair<std::chrono::system_clock::time_point, SalesTotals>>
+SalesAggregator::getTimeSeriesLocked(const std::chrono::system_clock::time_point& start,
+                                     const std::chrono::system_clock::time_point& end,
+                                     BucketGranularity granularity) const {
+    // Note: This method assumes aggregator_mutex_ is already locked by the caller
+    std::vector<std::pair<std::chrono::system_clock::time_point, SalesTotals>> series;
+    if (end < start) {
+        return series;
+    }
+
+    long long first = bucketIndex(start, granularity);
+    long long last = bucketIndex(end, granularity);
+
+    const auto& buckets = bucketsFor(granularity);
+
+    for (auto it = buckets.lower_bound(first); it != buckets.end() && it->first <= last; ++it) {
+        series.emplace_back(bucketStart(it->first, granularity), it->second.totals);
+    }
+
+    return series;
+}
+
+OrderDistribution SalesAggregator::getOrderDistribution(const std::chrono::system_clock::time_point& start,
+                                                       const std::chrono::system_clock::time_point& end) const {
+    std::lock_guard<std::mutex> lock(aggregator_mutex_);
+    return getOrderDistributionLocked(start, end);
+}
+
+OrderDistribution SalesAggregator::getOrderDistributionLocked(const std::chrono::system_clock::time_point& start,
+                                                             const std::chrono::system_clock::time_point& end) const {
+    // Note: This method assumes aggregator_mutex_ is already locked by the caller
+    OrderDistribution result;
+    if (end < start) {
+        return result;
+    }
+
+    // Tile [first_day, last_day) with whole weeks, then days
+    long long first_day = bucketIndex(start, BucketGranularity::DAY);
+    long long last_day = bucketIndex(end, BucketGranularity::DAY) + 1;
+    long long first_week = ceilDiv(first_day + WEEK_DAY_OFFSET, DAYS_PER_WEEK);
+    long long last_week = floorDiv(last_day + WEEK_DAY_OFFSET, DAYS_PER_WEEK);
+
+    if (first_week >= last_week) {
+        mergeRange(daily_distributions_, first_day, last_day, result);
+        return result;
+    }
+
+    mergeRange(daily_distributions_, first_day, first_week * DAYS_PER_WEEK - WEEK_DAY_OFFSET, result);
+    mergeRange(daily_distributions_, last_week * DAYS_PER_WEEK - WEEK_DAY_OFFSET, last_day, result);
+    mergeRange(weekly_distributions_, first_week, last_week, result);
+
+    return result;
+}
+
+std::vector<HeavyHitter> SalesAggregator::getTopProducts(size_t k, SalesMetric metric) const {
+    std::lock_guard<std::mutex> lock(aggregator_mutex_);
+    return metric == SalesMetric::REVENUE ? top_revenue_.getTopK(k) : top_units_.getTopK(k);
+}
+
+std::vector<std::pair<std::string, SalesTotals>>
+SalesAggregator::getTopProductsInRange(const std::chrono::system_clock::time_point& start,
+                                       const std::chrono::system_clock::time_point& end,
+                                       size_t k, SalesMetric metric) const {
+    return rankProducts(query(start, end), k, metric);
+}
+
+std::vector<std::pair<std::string, SalesTotals>>
+SalesAggregator::rankProducts(const SalesBucket& sales, size_t k, SalesMetric metric) {
+    std::vector<std::pair<std::string, SalesTotals>> ranked(sales.by_product.begin(), sales.by_product.end());
+
+    auto value = [metric](const SalesTotals& totals) {
+        return metric == SalesMetric::REVENUE ? totals.revenue : static_cast<double>(totals.units);
+    };
+
+    size_t count = std::min(k, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end(),
+        [&value](const auto& a, const auto& b) {
+            double value_a = value(a.second);
+            double value_b = value(b.second);
+            return value_a != value_b ? value_a > value_b : a.first < b.first;
+        });
+    ranked.resize(count);
+    return ranked;
+}
+
+size_t SalesAggregator::getBucketCount(BucketGranularity granularity) const {
+    std::lock_guard<std::mutex> lock(aggregator_mutex_);
+    return bucketsFor(granularity).size();
+}
+
+void SalesAggregator::clear() {
+    std::lock_guard<std::mutex> lock(aggregator_mutex_);
+    hourly_.clear();
+    daily_.clear();
+    weekly_.clear();
+    daily_distributions_.clear();
+    weekly_distributions_.clear();
+    top_units_.clear();
+    top_revenue_.clear();
+}
+
+long long SalesAggregator::bucketIndex(const std::chrono::system_clock::time_point& time_point,
+                                       BucketGranularity granularity) {
+    long long hour = hourIndex(time_point);
+    switch (granularity) {
+        case BucketGranularity::HOUR:
+            return hour;
+        case BucketGranularity::DAY:
+            return floorDiv(hour, HOURS_PER_DAY);
+        case BucketGranularity::WEEK:
+            return floorDiv(floorDiv(hour, HOURS_PER_DAY) + WEEK_DAY_OFFSET, DAYS_PER_WEEK);
+    }
+    return hour;
+}
+
+std::chrono::system_clock::time_point SalesAggregator::bucketStart(long long index,
+                                                                   BucketGranularity granularity) {
+    long long hour = index;
+    switch (granularity) {
+        case BucketGranularity::HOUR:
+            break;
+        case BucketGranularity::DAY:
+            hour = index * HOURS_PER_DAY;
+            break;
+        case BucketGranularity::WEEK:
+            hour = (index * DAYS_PER_WEEK - WEEK_DAY_OFFSET) * HOURS_PER_DAY;
+            break;
+    }
+    return std::chrono::system_clock::time_point(std::chrono::seconds(hour * SECONDS_PER_HOUR));
+}
+
+void SalesAggregator::applyOrder(const Order& order, int sign) {
+    std::vector<OrderItem> items = order.getItems();
+    if (items.empty()) {
+        return;
+    }
+
+    double order_revenue = 0.0;
+    long long order_units = 0;
+    for (const auto& item : items) {
+        order_revenue += item.getTotalPrice();
+        order_units += item.quantity;
+    }
+
+    auto order_date = order.getOrderDate();
+
+    std::lock_guard<std::mutex> lock(aggregator_mutex_);
+    applyToBucket(hourly_, bucketIndex(order_date, BucketGranularity::HOUR),
+                  items, order_revenue, order_units, sign);
+    applyToBucket(daily_, bucketIndex(order_date, BucketGranularity::DAY),
+                  items, order_revenue, order_units, sign);
+    applyToBucket(weekly_, bucketIndex(order_date, BucketGranularity::WEEK),
+                  items, order_revenue, order_units, sign);
+
+    if (sign > 0) {
+        OrderDistribution& daily = daily_distributions_[bucketIndex(order_date, BucketGranularity::DAY)];
+        daily.customers.add(order.getCustomerId());
+        daily.order_values.add(order_revenue);
+
+        OrderDistribution& weekly = weekly_distributions_[bucketIndex(order_date, BucketGranularity::WEEK)];
+        weekly.customers.add(order.getCustomerId());
+        weekly.order_values.add(order_revenue);
+    }
+
+    for (const auto& item : items) {
+        if (sign > 0) {
+            top_units_.add(item.product_id, item.quantity);
+            top_revenue_.add(item.product_id, item.getTotalPrice());
+        } else {
+            top_units_.subtract(item.product_id, item.quantity);
+            top_revenue_.subtract(item.product_id, item.getTotalPrice());
+        }
+    }
+}
+
+void SalesAggregator::mergeRange(const std::map<long long, SalesBucket>& buckets,
+                                 long long first, long long last, SalesBucket& result) {
+    for (auto it = buckets.lower_bound(first); it != buckets.end() && it->first < last; ++it) {
+        result.merge(it->second);
+    }
+}
+
+void SalesAggregator::mergeRange(const std::map<long long, OrderDistribution>& buckets,
+                                 long long first, long long last, OrderDistribution& result) {
+    for (auto it = buckets.lower_bound(first); it != buckets.end() && it->first < last; ++it) {
+        result.merge(it->second);
+    }
+}
+
+const std::map<long long, SalesBucket>& SalesAggregator::bucketsFor(BucketGranularity granularity) const {
+    // Note: This method assumes aggregator_mutex_ is already locked by the caller
+    switch (granularity) {
+        case BucketGranularity::DAY: return daily_;
+        case BucketGranularity::WEEK: return weekly_;
+        case BucketGranularity::HOUR:
+        default: return hourly_;
+    }
+}
+
+} // namespace quirkventory
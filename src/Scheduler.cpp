@@ -0,0 +1,277 @@
+#include "../include/Scheduler.hpp"
+#include "../include/ThreadPool.hpp"
+#include "../include/Inventory.hpp"
+#include "../include/Order.hpp"
+#include "../include/NotificationSystem.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace quirkventory {
+
+Scheduler::Scheduler(ThreadPool* pool, std::chrono::milliseconds tick)
+    : pool_(pool ? *pool : ThreadPool::getShared()),
+      tick_(std::max(tick, std::chrono::milliseconds(1))),
+      origin_(std::chrono::steady_clock::now()),
+      wheel_(0), next_job_id_(1), in_flight_(0), running_(false),
+      rng_(std::random_device{}()) {
+}
+
+Scheduler::~Scheduler() {
+    stop();
+}
+
+bool Scheduler::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return false;
+    }
+
+    running_ = true;
+    timer_thread_ = std::thread(&Scheduler::timerLoop, this);
+    return true;
+}
+
+void Scheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    timer_condition_.notify_all();
+
+    if (timer_thread_.joinable()) {
+        timer_thread_.join();
+    }
+
+    // Jobs already handed to the pool capture this scheduler, so wait them out
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_condition_.wait(lock, [this]() { return in_flight_ == 0; });
+}
+
+bool Scheduler::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+bool Scheduler::addJob(const std::string& name, std::chrono::milliseconds interval,
+                       std::function<void()> task, double jitter) {
+    if (name.empty() || interval.count() <= 0 || !task) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (job_ids_.count(name)) {
+        return false;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->id = next_job_id_++;
+    job->name = name;
+    job->interval = interval;
+    job->jitter = std::clamp(jitter, 0.0, 0.5);
+    job->task = std::move(task);
+
+    jobs_[job->id] = job;
+    job_ids_[name] = job->id;
+    scheduleNextLocked(*job, std::max(currentTick(), wheel_.getCurrentTick()));
+
+    // The new job may be due sooner than whatever the timer is waiting on
+    timer_condition_.notify_all();
+    return true;
+}
+
+bool Scheduler::removeJob(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = job_ids_.find(name);
+    if (it == job_ids_.end()) {
+        return false;
+    }
+
+    // The wheel entry is left in place and ignored when it fires
+    jobs_.erase(it->second);
+    job_ids_.erase(it);
+    return true;
+}
+
+bool Scheduler::runNow(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = job_ids_.find(name);
+    if (it == job_ids_.end()) {
+        return false;
+    }
+    return dispatchLocked(jobs_[it->second]);
+}
+
+bool Scheduler::hasJob(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return job_ids_.count(name) > 0;
+}
+
+size_t Scheduler::getJobCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.size();
+}
+
+bool Scheduler::getJobStats(const std::string& name, JobStats& stats) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = job_ids_.find(name);
+    if (it == job_ids_.end()) {
+        return false;
+    }
+
+    stats = makeStatsLocked(*jobs_.at(it->second));
+    return true;
+}
+
+std::vector<JobStats> Scheduler::getAllJobStats() const {
+    std::vector<JobStats> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.reserve(jobs_.size());
+        for (const auto& pair : jobs_) {
+            result.push_back(makeStatsLocked(*pair.second));
+        }
+    }
+
+    std::sort(result.begin(), result.end(),
+        [](const JobStats& a, const JobStats& b) { return a.name < b.name; });
+    return result;
+}
+
+void Scheduler::timerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::vector<uint64_t> due;
+
+    while (running_) {
+        auto next_deadline = origin_ + tick_ * (wheel_.getCurrentTick() + 1);
+        timer_condition_.wait_until(lock, next_deadline);
+        if (!running_) {
+            break;
+        }
+
+        uint64_t now_tick = currentTick();
+        if (now_tick <= wheel_.getCurrentTick()) {
+            continue;
+        }
+
+        due.clear();
+        wheel_.advance(now_tick, [&due](uint64_t id) { due.push_back(id); });
+
+        for (uint64_t id : due) {
+            auto it = jobs_.find(id);
+            if (it == jobs_.end()) {
+                continue;   // Removed since it was scheduled
+            }
+
+            const std::shared_ptr<Job>& job = it->second;
+            scheduleNextLocked(*job, now_tick);
+            if (!dispatchLocked(job)) {
+                job->skipped++;
+            }
+        }
+    }
+}
+
+uint64_t Scheduler::currentTick() const {
+    auto elapsed = std::chrono::steady_clock::now() - origin_;
+    return static_cast<uint64_t>(elapsed / tick_);
+}
+
+void Scheduler::scheduleNextLocked(const Job& job, uint64_t now_tick) {
+    double delay_ms = static_cast<double>(job.interval.count());
+    if (job.jitter > 0.0) {
+        std::uniform_real_distribution<double> offset(-job.jitter, job.jitter);
+        delay_ms *= 1.0 + offset(rng_);
+    }
+
+    auto ticks = static_cast<uint64_t>(std::ceil(delay_ms / static_cast<double>(tick_.count())));
+    wheel_.schedule(job.id, now_tick + std::max<uint64_t>(ticks, 1));
+}
+
+bool Scheduler::dispatchLocked(const std::shared_ptr<Job>& job) {
+    bool expected = false;
+    if (!job->running.compare_exchange_strong(expected, true)) {
+        return false;
+    }
+
+    in_flight_++;
+    pool_.submit([this, job]() { runJob(job); });
+    return true;
+}
+
+void Scheduler::runJob(const std::shared_ptr<Job>& job) {
+    auto started = std::chrono::system_clock::now();
+    auto start_time = std::chrono::steady_clock::now();
+
+    bool failed = false;
+    try {
+        job->task();
+    } catch (...) {
+        failed = true;
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_time);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    job->runs++;
+    if (failed) {
+        job->failures++;
+    }
+    job->last_duration = duration;
+    job->max_duration = std::max(job->max_duration, duration);
+    job->total_duration += duration;
+    job->last_run = started;
+    job->running = false;
+
+    // Notify under the lock: stop() may destroy the scheduler as soon as it sees zero
+    in_flight_--;
+    idle_condition_.notify_all();
+}
+
+JobStats Scheduler::makeStatsLocked(const Job& job) const {
+    JobStats stats;
+    stats.name = job.name;
+    stats.interval = job.interval;
+    stats.runs = job.runs;
+    stats.skipped = job.skipped;
+    stats.failures = job.failures;
+    stats.last_duration = job.last_duration;
+    stats.max_duration = job.max_duration;
+    stats.total_duration = job.total_duration;
+    stats.last_run = job.last_run;
+    stats.running = job.running.load();
+    return stats;
+}
+
+int scheduleInventoryMaintenance(Scheduler& scheduler, Inventory& inventory,
+                                 OrderManager* order_manager,
+                                 NotificationManager* notification_manager,
+                                 const MaintenanceSchedule& schedule) {
+    int registered = 0;
+    auto add = [&](const std::string& name, std::chrono::milliseconds interval,
+                   std::function<void()> task) {
+        if (interval.count() > 0 && scheduler.addJob(name, interval, std::move(task))) {
+            registered++;
+        }
+    };
+
+    add("hold-expiry", schedule.hold_expiry, [&inventory]() { inventory.expireHolds(); });
+    add("low-stock-alerts", schedule.low_stock_alerts,
+        [&inventory]() { inventory.checkAndSendLowStockAlerts(); });
+    add("expiry-alerts", schedule.expiry_alerts,
+        [&inventory]() { inventory.checkAndSendExpiryAlerts(); });
+    add("version-gc", schedule.version_gc, [&inventory]() { inventory.collectVersionGarbage(); });
+
+    if (notification_manager) {
+        add("inventory-notifications", schedule.notification_alerts,
+            [notification_manager, &inventory]() { notification_manager->sendInventoryAlerts(inventory); });
+    }
+    if (order_manager) {
+        add("order-clearing", schedule.order_clearing,
+            [order_manager]() { order_manager->clearCompletedOrders(); });
+    }
+
+    return registered;
+}
+
+} // namespace quirkventory
@@ -0,0 +1,427 @@
+#include "../include/SharedStockView.hpp"
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace quirkventory {
+
+namespace {
+
+constexpr uint64_t kMagic = 0x31574b5453565151ull;     // "QQVSTKW1"
+constexpr uint32_t kLayoutVersion = 2;
+constexpr size_t kMaxCapacity = size_t(1) << 24;
+constexpr size_t kIdBytes = SharedStockWriter::MAX_ID_LENGTH + 1;
+constexpr int kMaxReadAttempts = 1000;
+
+enum SegmentState : uint32_t {
+    SEGMENT_INITIALIZING = 0,
+    SEGMENT_READY = 1,
+    SEGMENT_RETIRED = 2
+};
+
+// Other processes share these, so every atomic must work without a lock
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared records need lock-free 32-bit atomics");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared records need lock-free 64-bit atomics");
+
+struct alignas(64) SegmentHeader {
+    uint64_t magic;
+    uint32_t layout_version;
+    uint32_t record_size;
+    uint64_t capacity;
+    std::atomic<uint32_t> state;
+    std::atomic<int32_t> owner_pid;     // Writer's process
+};
+
+// ftruncate() zero-fills the segment, and all zeroes is an unclaimed record
+struct alignas(64) StockRecord {
+    std::atomic<uint32_t> sequence;     // Odd while the writer is changing the fields below
+    std::atomic<uint32_t> claimed;      // Set once, after id is written
+    char id[kIdBytes];                  // NUL-terminated, never changes once claimed
+
+    // Guarded by sequence
+    std::atomic<uint32_t> present;
+    std::atomic<int32_t> quantity;
+    std::atomic<int32_t> available_quantity;
+    std::atomic<uint64_t> price_bits;
+    std::atomic<uint64_t> product_version;
+};
+
+uint64_t hashId(const std::string& product_id) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : product_id) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+size_t segmentSize(size_t capacity) {
+    return sizeof(SegmentHeader) + capacity * sizeof(StockRecord);
+}
+
+StockRecord* recordsOf(void* base) {
+    return reinterpret_cast<StockRecord*>(static_cast<char*>(base) + sizeof(SegmentHeader));
+}
+
+const StockRecord* recordsOf(const void* base) {
+    return reinterpret_cast<const StockRecord*>(static_cast<const char*>(base) + sizeof(SegmentHeader));
+}
+
+bool matchesId(const StockRecord& record, const std::string& product_id) {
+    return std::memcmp(record.id, product_id.c_str(), product_id.size() + 1) == 0;
+}
+
+void writeFields(StockRecord& record, bool present, const SharedStockRecord& values) {
+    uint32_t sequence = record.sequence.load(std::memory_order_relaxed);
+    record.sequence.store(sequence + 1, std::memory_order_relaxed);
+    // Keeps the field stores below from becoming visible before the odd sequence
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t price_bits;
+    std::memcpy(&price_bits, &values.price, sizeof(price_bits));
+    record.present.store(present ? 1 : 0, std::memory_order_relaxed);
+    record.quantity.store(values.quantity, std::memory_order_relaxed);
+    record.available_quantity.store(values.available_quantity, std::memory_order_relaxed);
+    record.price_bits.store(price_bits, std::memory_order_relaxed);
+    record.product_version.store(values.product_version, std::memory_order_relaxed);
+
+    record.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool ownerIsGone(pid_t owner) {
+    // EPERM means the process exists but belongs to another user
+    return owner > 0 && ::kill(owner, 0) != 0 && errno == ESRCH;
+}
+
+// A segment under our name may only be replaced once nothing writes it any more
+bool isAbandoned(const std::string& name) {
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    bool abandoned = false;
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(SegmentHeader)) {
+        void* base = ::mmap(nullptr, sizeof(SegmentHeader), PROT_READ, MAP_SHARED, fd, 0);
+        if (base != MAP_FAILED) {
+            const auto* header = static_cast<const SegmentHeader*>(base);
+            // The owner is stored before the magic, so a segment still being set up is left
+            // alone; layout 1 segments have no owner and are only replaced once retired
+            if (header->magic == kMagic) {
+                abandoned = header->state.load(std::memory_order_acquire) == SEGMENT_RETIRED ||
+                            ownerIsGone(header->owner_pid.load(std::memory_order_acquire));
+            }
+            ::munmap(base, sizeof(SegmentHeader));
+        }
+    }
+    ::close(fd);
+    return abandoned;
+}
+
+// Writers of one name hold this while they create or replace its segment. Without it two
+// writers could both find the same segment abandoned, and the second would unlink the
+// first one's new segment. The lock object is never removed: removing it would let a
+// writer lock a new object while another still holds the old one.
+class NameLock {
+public:
+    explicit NameLock(const std::string& name)
+        : fd_(::shm_open((name + SharedStockWriter::LOCK_SUFFIX).c_str(), O_RDONLY | O_CREAT, 0644)) {
+        // flock() works on a read-only descriptor, so writers running as other users can lock it too
+        while (fd_ >= 0 && ::flock(fd_, LOCK_EX) != 0) {
+            if (errno != EINTR) {
+                ::close(fd_);
+                fd_ = -1;
+            }
+        }
+    }
+
+    // Closing the descriptor releases the lock
+    ~NameLock() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    NameLock(const NameLock&) = delete;
+    NameLock& operator=(const NameLock&) = delete;
+
+    bool isLocked() const { return fd_ >= 0; }
+
+private:
+    int fd_;
+};
+
+void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+} // namespace
+
+// SharedStockWriter
+
+SharedStockWriter::SharedStockWriter(const std::string& name, size_t capacity)
+    : name_(name), capacity_(1), fd_(-1), base_(nullptr), size_(0), overflow_(0) {
+    // Leaves room for LOCK_SUFFIX within the 255-byte file name limit
+    if (name.size() < 2 || name.size() > 251 || name[0] != '/' || name.find('/', 1) != std::string::npos) {
+        throw std::invalid_argument("Shared stock view name must be '/' followed by up to 250 other characters");
+    }
+    if (capacity == 0 || capacity > kMaxCapacity) {
+        throw std::invalid_argument("Shared stock view capacity must be between 1 and 2^24");
+    }
+    while (capacity_ < capacity) {
+        capacity_ <<= 1;
+    }
+}
+
+SharedStockWriter::~SharedStockWriter() {
+    close();
+}
+
+bool SharedStockWriter::create() {
+    if (base_) {
+        return false;
+    }
+
+    // Held until the header is written, so the next writer sees this segment as live
+    NameLock lock(name_);
+    if (!lock.isLocked()) {
+        return false;
+    }
+
+    fd_ = ::shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd_ < 0 && errno == EEXIST && isAbandoned(name_)) {
+        // Left behind by a writer that retired or died without removing it
+        ::shm_unlink(name_.c_str());
+        fd_ = ::shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    }
+    if (fd_ < 0) {
+        return false;
+    }
+
+    size_t size = segmentSize(capacity_);
+    void* base = MAP_FAILED;
+    if (::ftruncate(fd_, static_cast<off_t>(size)) == 0) {
+        base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    }
+    if (base == MAP_FAILED) {
+        ::close(fd_);
+        fd_ = -1;
+        ::shm_unlink(name_.c_str());
+        return false;
+    }
+
+    base_ = base;
+    size_ = size;
+    slots_.clear();
+    overflow_ = 0;
+
+    auto* header = static_cast<SegmentHeader*>(base_);
+    header->owner_pid.store(static_cast<int32_t>(::getpid()), std::memory_order_relaxed);
+    header->magic = kMagic;
+    header->layout_version = kLayoutVersion;
+    header->record_size = static_cast<uint32_t>(sizeof(StockRecord));
+    header->capacity = capacity_;
+    header->state.store(SEGMENT_READY, std::memory_order_release);
+    return true;
+}
+
+void SharedStockWriter::close() {
+    if (!base_) {
+        return;
+    }
+
+    // Remove the name first, so it never refers to a retired segment another writer could replace
+    ::shm_unlink(name_.c_str());
+    static_cast<SegmentHeader*>(base_)->state.store(SEGMENT_RETIRED, std::memory_order_release);
+    ::munmap(base_, size_);
+    ::close(fd_);
+    base_ = nullptr;
+    fd_ = -1;
+    size_ = 0;
+    slots_.clear();
+}
+
+bool SharedStockWriter::publish(const std::string& product_id, const SharedStockRecord& record) {
+    if (!base_) {
+        return false;
+    }
+    if (product_id.size() > MAX_ID_LENGTH) {
+        overflow_++;
+        return false;
+    }
+
+    StockRecord* records = recordsOf(base_);
+    auto it = slots_.find(product_id);
+    if (it != slots_.end()) {
+        writeFields(records[it->second], true, record);
+        return true;
+    }
+
+    size_t slot = findFreeSlot(product_id);
+    if (slot == capacity_) {
+        overflow_++;
+        return false;
+    }
+
+    // Fill the record before claiming it, so a reader that finds the ID finds the values too
+    StockRecord& claimed = records[slot];
+    std::memcpy(claimed.id, product_id.c_str(), product_id.size() + 1);
+    writeFields(claimed, true, record);
+    claimed.claimed.store(1, std::memory_order_release);
+    slots_.emplace(product_id, slot);
+    return true;
+}
+
+bool SharedStockWriter::remove(const std::string& product_id) {
+    auto it = slots_.find(product_id);
+    if (!base_ || it == slots_.end()) {
+        return false;
+    }
+
+    // The slot stays claimed so probe chains through it are not cut
+    writeFields(recordsOf(base_)[it->second], false, SharedStockRecord{0, 0, 0.0, 0});
+    return true;
+}
+
+size_t SharedStockWriter::findFreeSlot(const std::string& product_id) const {
+    // Keep a quarter of the table free so readers' probe chains stay short
+    if (slots_.size() >= capacity_ - capacity_ / 4) {
+        return capacity_;
+    }
+
+    const StockRecord* records = recordsOf(base_);
+    size_t mask = capacity_ - 1;
+    for (size_t slot = hashId(product_id) & mask;; slot = (slot + 1) & mask) {
+        if (records[slot].claimed.load(std::memory_order_relaxed) == 0) {
+            return slot;
+        }
+    }
+}
+
+// SharedStockReader
+
+SharedStockReader::SharedStockReader() : base_(nullptr), size_(0), capacity_(0) {
+}
+
+SharedStockReader::~SharedStockReader() {
+    close();
+}
+
+bool SharedStockReader::open(const std::string& name) {
+    close();
+
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    struct stat info;
+    void* base = MAP_FAILED;
+    if (::fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(SegmentHeader)) {
+        base = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    const auto* header = static_cast<const SegmentHeader*>(base);
+    uint32_t state = header->state.load(std::memory_order_acquire);
+    uint64_t capacity = header->capacity;
+    bool valid = state != SEGMENT_INITIALIZING && header->magic == kMagic &&
+                 header->layout_version == kLayoutVersion && header->record_size == sizeof(StockRecord) &&
+                 capacity > 0 && capacity <= kMaxCapacity && (capacity & (capacity - 1)) == 0 &&
+                 size >= segmentSize(static_cast<size_t>(capacity));
+    if (!valid) {
+        ::munmap(base, size);
+        return false;
+    }
+
+    base_ = base;
+    size_ = size;
+    capacity_ = static_cast<size_t>(capacity);
+    return true;
+}
+
+void SharedStockReader::close() {
+    if (base_) {
+        ::munmap(const_cast<void*>(base_), size_);
+        base_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+    }
+}
+
+bool SharedStockReader::isRetired() const {
+    return base_ &&
+           static_cast<const SegmentHeader*>(base_)->state.load(std::memory_order_acquire) == SEGMENT_RETIRED;
+}
+
+SharedReadResult SharedStockReader::read(const std::string& product_id, SharedStockRecord& record) const {
+    if (!base_ || product_id.size() > SharedStockWriter::MAX_ID_LENGTH) {
+        return SharedReadResult::NOT_FOUND;
+    }
+
+    // Claimed slots are never freed, so the first unclaimed slot ends the probe chain
+    const StockRecord* records = recordsOf(base_);
+    size_t mask = capacity_ - 1;
+    size_t slot = hashId(product_id) & mask;
+    const StockRecord* found = nullptr;
+    for (size_t probes = 0; probes < capacity_; ++probes, slot = (slot + 1) & mask) {
+        if (records[slot].claimed.load(std::memory_order_acquire) == 0) {
+            return SharedReadResult::NOT_FOUND;
+        }
+        if (matchesId(records[slot], product_id)) {
+            found = &records[slot];
+            break;
+        }
+    }
+    if (!found) {
+        return SharedReadResult::NOT_FOUND;
+    }
+
+    for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+        uint32_t before = found->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            cpuRelax();
+            continue;
+        }
+
+        bool present = found->present.load(std::memory_order_relaxed) != 0;
+        int quantity = found->quantity.load(std::memory_order_relaxed);
+        int available = found->available_quantity.load(std::memory_order_relaxed);
+        uint64_t price_bits = found->price_bits.load(std::memory_order_relaxed);
+        uint64_t version = found->product_version.load(std::memory_order_relaxed);
+
+        // Keeps the field loads above from moving past the second sequence load
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (found->sequence.load(std::memory_order_relaxed) != before) {
+            continue;
+        }
+
+        if (!present) {
+            return SharedReadResult::NOT_FOUND;
+        }
+        record.quantity = quantity;
+        record.available_quantity = available;
+        std::memcpy(&record.price, &price_bits, sizeof(record.price));
+        record.product_version = version;
+        return SharedReadResult::FOUND;
+    }
+    return SharedReadResult::BUSY;
+}
+
+} // namespace quirkventory
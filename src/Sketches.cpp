@@ -0,0 +1,400 @@
+#include "../include/Sketches.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <cmath>
+#include <limits>
+
+namespace quirkventory {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+/**
+ * @brief Finalize a hash so every output bit depends on every input bit
+ */
+uint64_t mixHash(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+} // namespace
+
+// SpaceSavingSketch Implementation
+
+SpaceSavingSketch::SpaceSavingSketch(size_t capacity)
+    : capacity_(capacity), total_weight_(0.0) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Sketch capacity must be positive");
+    }
+    heap_.reserve(capacity);
+    positions_.reserve(capacity);
+}
+
+void SpaceSavingSketch::add(const std::string& key, double weight) {
+    if (weight <= 0.0) {
+        return;
+    }
+    total_weight_ += weight;
+
+    auto it = positions_.find(key);
+    if (it != positions_.end()) {
+        heap_[it->second].count += weight;
+        siftDown(it->second);
+        return;
+    }
+
+    if (heap_.size() < capacity_) {
+        heap_.push_back({key, weight, 0.0});
+        positions_[key] = heap_.size() - 1;
+        siftUp(heap_.size() - 1);
+        return;
+    }
+
+    // Evict the minimum; the newcomer inherits its count as error
+    HeavyHitter& minimum = heap_[0];
+    positions_.erase(minimum.key);
+    minimum.error = minimum.count;
+    minimum.count += weight;
+    minimum.key = key;
+    positions_[key] = 0;
+    siftDown(0);
+}
+
+void SpaceSavingSketch::subtract(const std::string& key, double weight) {
+    if (weight <= 0.0) {
+        return;
+    }
+    total_weight_ = std::max(0.0, total_weight_ - weight);
+
+    auto it = positions_.find(key);
+    if (it == positions_.end()) {
+        return;
+    }
+
+    HeavyHitter& entry = heap_[it->second];
+    entry.count = std::max(entry.error, entry.count - weight);
+    siftUp(it->second);
+}
+
+std::vector<HeavyHitter> SpaceSavingSketch::getTopK(size_t k) const {
+    std::vector<HeavyHitter> result(heap_);
+    size_t count = std::min(k, result.size());
+    std::partial_sort(result.begin(), result.begin() + count, result.end(),
+        [](const HeavyHitter& a, const HeavyHitter& b) {
+            return a.count != b.count ? a.count > b.count : a.key < b.key;
+        });
+    result.resize(count);
+    return result;
+}
+
+void SpaceSavingSketch::merge(const SpaceSavingSketch& other) {
+    // The root of a full sketch bounds the weight of any key it does not track
+    double own_minimum = heap_.size() == capacity_ ? heap_[0].count : 0.0;
+    double other_minimum = other.heap_.size() == other.capacity_ ? other.heap_[0].count : 0.0;
+
+    std::vector<HeavyHitter> merged;
+    merged.reserve(heap_.size() + other.heap_.size());
+    for (const auto& entry : heap_) {
+        if (other.positions_.count(entry.key) == 0) {
+            merged.push_back({entry.key, entry.count + other_minimum, entry.error + other_minimum});
+        }
+    }
+    for (const auto& entry : other.heap_) {
+        auto it = positions_.find(entry.key);
+        if (it != positions_.end()) {
+            const HeavyHitter& own = heap_[it->second];
+            merged.push_back({entry.key, own.count + entry.count, own.error + entry.error});
+        } else {
+            merged.push_back({entry.key, entry.count + own_minimum, entry.error + own_minimum});
+        }
+    }
+
+    if (merged.size() > capacity_) {
+        std::nth_element(merged.begin(), merged.begin() + capacity_, merged.end(),
+            [](const HeavyHitter& a, const HeavyHitter& b) { return a.count > b.count; });
+        merged.resize(capacity_);
+    }
+
+    heap_ = std::move(merged);
+    positions_.clear();
+    for (size_t i = 0; i < heap_.size(); ++i) {
+        positions_[heap_[i].key] = i;
+    }
+    for (size_t i = heap_.size() / 2; i-- > 0;) {
+        siftDown(i);
+    }
+    total_weight_ += other.total_weight_;
+}
+
+double SpaceSavingSketch::estimate(const std::string& key) const {
+    auto it = positions_.find(key);
+    return it != positions_.end() ? heap_[it->second].count : 0.0;
+}
+
+void SpaceSavingSketch::clear() {
+    heap_.clear();
+    positions_.clear();
+    total_weight_ = 0.0;
+}
+
+void SpaceSavingSketch::siftUp(size_t position) {
+    while (position > 0) {
+        size_t parent = (position - 1) / 2;
+        if (heap_[parent].count <= heap_[position].count) {
+            break;
+        }
+        swapEntries(parent, position);
+        position = parent;
+    }
+}
+
+void SpaceSavingSketch::siftDown(size_t position) {
+    size_t count = heap_.size();
+    while (true) {
+        size_t smallest = position;
+        size_t left = 2 * position + 1;
+        size_t right = left + 1;
+        if (left < count && heap_[left].count < heap_[smallest].count) {
+            smallest = left;
+        }
+        if (right < count && heap_[right].count < heap_[smallest].count) {
+            smallest = right;
+        }
+        if (smallest == position) {
+            break;
+        }
+        swapEntries(smallest, position);
+        position = smallest;
+    }
+}
+
+void SpaceSavingSketch::swapEntries(size_t a, size_t b) {
+    std::swap(heap_[a], heap_[b]);
+    positions_[heap_[a].key] = a;
+    positions_[heap_[b].key] = b;
+}
+
+// HyperLogLog Implementation
+
+HyperLogLog::HyperLogLog(int precision) : precision_(precision) {
+    if (precision < 4 || precision > 18) {
+        throw std::invalid_argument("HyperLogLog precision must be between 4 and 18");
+    }
+    registers_.assign(size_t(1) << precision, 0);
+}
+
+void HyperLogLog::add(const std::string& value) {
+    uint64_t hash = mixHash(std::hash<std::string>{}(value));
+    size_t index = static_cast<size_t>(hash >> (64 - precision_));
+
+    // Rank = position of the first set bit in the remaining bits
+    uint64_t remaining = (hash << precision_) | (uint64_t(1) << (precision_ - 1));
+    uint8_t rank = 1;
+    while ((remaining & (uint64_t(1) << 63)) == 0) {
+        remaining <<= 1;
+        ++rank;
+    }
+
+    if (rank > registers_[index]) {
+        registers_[index] = rank;
+    }
+}
+
+bool HyperLogLog::merge(const HyperLogLog& other) {
+    if (other.precision_ != precision_) {
+        return false;
+    }
+    for (size_t i = 0; i < registers_.size(); ++i) {
+        registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+    return true;
+}
+
+double HyperLogLog::estimate() const {
+    double m = static_cast<double>(registers_.size());
+    double sum = 0.0;
+    size_t zero_registers = 0;
+
+    for (uint8_t value : registers_) {
+        sum += std::ldexp(1.0, -value);
+        if (value == 0) {
+            ++zero_registers;
+        }
+    }
+
+    double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double raw = alpha * m * m / sum;
+
+    // Linear counting is more accurate for small cardinalities
+    if (raw <= 2.5 * m && zero_registers > 0) {
+        return m * std::log(m / static_cast<double>(zero_registers));
+    }
+    return raw;
+}
+
+void HyperLogLog::clear() {
+    std::fill(registers_.begin(), registers_.end(), 0);
+}
+
+// TDigest Implementation
+
+TDigest::TDigest(double compression)
+    : compression_(compression), total_weight_(0.0),
+      min_(std::numeric_limits<double>::infinity()),
+      max_(-std::numeric_limits<double>::infinity()) {
+    if (compression < 10.0) {
+        throw std::invalid_argument("TDigest compression must be at least 10");
+    }
+}
+
+void TDigest::add(double value, double weight) {
+    if (weight <= 0.0 || std::isnan(value)) {
+        return;
+    }
+
+    buffer_.push_back({value, weight});
+    total_weight_ += weight;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+
+    if (buffer_.size() >= static_cast<size_t>(compression_ * 4)) {
+        compress();
+    }
+}
+
+void TDigest::merge(const TDigest& other) {
+    if (other.total_weight_ <= 0.0) {
+        return;
+    }
+
+    buffer_.insert(buffer_.end(), other.centroids_.begin(), other.centroids_.end());
+    buffer_.insert(buffer_.end(), other.buffer_.begin(), other.buffer_.end());
+    total_weight_ += other.total_weight_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    compress();
+}
+
+double TDigest::quantile(double q) const {
+    if (total_weight_ <= 0.0) {
+        return 0.0;
+    }
+    q = std::min(1.0, std::max(0.0, q));
+
+    std::vector<Centroid> merged;
+    const std::vector<Centroid>* centroids = &centroids_;
+    if (!buffer_.empty()) {
+        merged = centroids_;
+        merged.insert(merged.end(), buffer_.begin(), buffer_.end());
+        merged = mergeCentroids(std::move(merged), compression_);
+        centroids = &merged;
+    }
+
+    const std::vector<Centroid>& c = *centroids;
+    if (c.size() == 1) {
+        return c[0].mean;
+    }
+
+    double target = q * total_weight_;
+
+    // Before the first centroid's center: interpolate from the minimum
+    if (target < c[0].weight / 2) {
+        return min_ + (c[0].mean - min_) * (target / (c[0].weight / 2));
+    }
+
+    // Interpolate between adjacent centroid centers
+    double cumulative = 0.0;
+    for (size_t i = 0; i + 1 < c.size(); ++i) {
+        double left_center = cumulative + c[i].weight / 2;
+        double right_center = cumulative + c[i].weight + c[i + 1].weight / 2;
+        if (target <= right_center) {
+            double t = (target - left_center) / (right_center - left_center);
+            return c[i].mean + t * (c[i + 1].mean - c[i].mean);
+        }
+        cumulative += c[i].weight;
+    }
+
+    // After the last centroid's center: interpolate towards the maximum
+    const Centroid& last = c.back();
+    double last_center = total_weight_ - last.weight / 2;
+    double t = (target - last_center) / (last.weight / 2);
+    return last.mean + std::min(1.0, t) * (max_ - last.mean);
+}
+
+size_t TDigest::getCentroidCount() const {
+    if (buffer_.empty()) {
+        return centroids_.size();
+    }
+    std::vector<Centroid> merged(centroids_);
+    merged.insert(merged.end(), buffer_.begin(), buffer_.end());
+    return mergeCentroids(std::move(merged), compression_).size();
+}
+
+void TDigest::clear() {
+    centroids_.clear();
+    buffer_.clear();
+    total_weight_ = 0.0;
+    min_ = std::numeric_limits<double>::infinity();
+    max_ = -std::numeric_limits<double>::infinity();
+}
+
+void TDigest::compress() {
+    if (buffer_.empty()) {
+        return;
+    }
+    buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+    centroids_ = mergeCentroids(std::move(buffer_), compression_);
+    buffer_.clear();
+}
+
+std::vector<TDigest::Centroid> TDigest::mergeCentroids(std::vector<Centroid> centroids, double compression) {
+    std::vector<Centroid> result;
+    if (centroids.empty()) {
+        return result;
+    }
+
+    std::sort(centroids.begin(), centroids.end(),
+        [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+
+    double total = 0.0;
+    for (const auto& centroid : centroids) {
+        total += centroid.weight;
+    }
+
+    // k1 scale function: k(q) = compression / (2 pi) * asin(2q - 1); each
+    // centroid may span at most one unit of k, keeping tail centroids small
+    auto scale = [compression](double q) { return compression / (2 * PI) * std::asin(2 * q - 1); };
+    auto inverse_scale = [compression](double k) {
+        k = std::min(k, compression / 4);
+        return (std::sin(k * 2 * PI / compression) + 1) / 2;
+    };
+
+    double weight_before = 0.0;
+    double weight_limit = total * inverse_scale(scale(0.0) + 1);
+    Centroid current = centroids[0];
+
+    for (size_t i = 1; i < centroids.size(); ++i) {
+        const Centroid& next = centroids[i];
+        if (weight_before + current.weight + next.weight <= weight_limit) {
+            double weight = current.weight + next.weight;
+            current.mean += (next.mean - current.mean) * next.weight / weight;
+            current.weight = weight;
+        } else {
+            weight_before += current.weight;
+            result.push_back(current);
+            weight_limit = total * inverse_scale(scale(std::min(1.0, weight_before / total)) + 1);
+            current = next;
+        }
+    }
+    result.push_back(current);
+
+    return result;
+}
+
+} // namespace quirkventory
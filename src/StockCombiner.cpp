@@ -0,0 +1,119 @@
+#include "../include/StockCombiner.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace quirkventory {
+
+StockCombiner::StockCombiner(BatchHandler handler, size_t slot_count)
+    : handler_(std::move(handler)), batches_(0), combined_requests_(0) {
+    size_t slots = 1;
+    while (slots < slot_count) {
+        slots <<= 1;
+    }
+    slot_mask_ = slots - 1;
+    slots_ = std::make_unique<Slot[]>(slots);
+}
+
+bool StockCombiner::submit(const std::string& key, int amount) {
+    Request request;
+    request.key = &key;
+    request.amount = amount;
+
+    Slot& slot = slotFor(key);
+    Request* head = slot.pending.load(std::memory_order_relaxed);
+    do {
+        request.next = head;
+    } while (!slot.pending.compare_exchange_weak(head, &request,
+                                                 std::memory_order_release, std::memory_order_relaxed));
+
+    // Reused across calls so combining does not allocate
+    thread_local std::vector<Request*> batch;
+    while (!request.done.load(std::memory_order_acquire)) {
+        std::unique_lock<std::mutex> combiner(slot.combiner, std::try_to_lock);
+        if (combiner.owns_lock()) {
+            combine(slot, batch);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    return request.success;
+}
+
+void StockCombiner::combine(Slot& slot, std::vector<Request*>& batch) {
+    Request* head = slot.pending.exchange(nullptr, std::memory_order_acquire);
+    if (!head) {
+        return;
+    }
+
+    // The list is newest-first; apply in arrival order
+    batch.clear();
+    for (Request* request = head; request; request = request->next) {
+        batch.push_back(request);
+    }
+    std::reverse(batch.begin(), batch.end());
+
+    try {
+        handler_(batch);
+    } catch (...) {
+        // Requests the handler did not reach keep success == false
+    }
+
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    combined_requests_.fetch_add(batch.size(), std::memory_order_relaxed);
+    if (batch.size() > 1) {
+        slot.hot_until.store(nowNanos() + HOT_DURATION_NS, std::memory_order_relaxed);
+    }
+
+    // A waiter may return as soon as it sees done, so publish it last
+    for (Request* request : batch) {
+        request->done.store(true, std::memory_order_release);
+    }
+}
+
+void StockCombiner::recordHit(const std::string& key) {
+    size_t hash = hashOf(key);
+    Slot& slot = slotForHash(hash);
+    int64_t now = nowNanos();
+
+    int64_t window_start = slot.window_start.load(std::memory_order_relaxed);
+    if (now - window_start > HIT_WINDOW_NS) {
+        slot.window_start.store(now, std::memory_order_relaxed);
+        slot.candidate_hash.store(hash, std::memory_order_relaxed);
+        slot.hits.store(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (slot.candidate_hash.load(std::memory_order_relaxed) != hash) {
+        // Another key's hit counts against the candidate, which it replaces once the count runs out
+        uint32_t hits = slot.hits.load(std::memory_order_relaxed);
+        if (hits <= 1) {
+            slot.candidate_hash.store(hash, std::memory_order_relaxed);
+            slot.hits.store(1, std::memory_order_relaxed);
+        } else {
+            slot.hits.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    if (slot.hits.fetch_add(1, std::memory_order_relaxed) + 1 >= HOT_THRESHOLD) {
+        slot.hot_hash.store(hash, std::memory_order_relaxed);
+        slot.hot_until.store(now + HOT_DURATION_NS, std::memory_order_relaxed);
+    }
+}
+
+bool StockCombiner::isHot(const std::string& key) const {
+    size_t hash = hashOf(key);
+    const Slot& slot = slotForHash(hash);
+    int64_t hot_until = slot.hot_until.load(std::memory_order_relaxed);
+    return hot_until != 0 && nowNanos() < hot_until &&
+           slot.hot_hash.load(std::memory_order_relaxed) == hash;
+}
+
+int64_t StockCombiner::nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace quirkventory
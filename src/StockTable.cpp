@@ -0,0 +1,150 @@
+#include "../include/StockTable.hpp"
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace quirkventory {
+
+namespace {
+
+// Spins before a reader starts yielding to a writer that may have been preempted
+constexpr int kSpinsBeforeYield = 64;
+
+size_t slotOf(const std::string& product_id, size_t mask) {
+    return std::hash<std::string>{}(product_id) & mask;
+}
+
+void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+} // namespace
+
+StockTable::Slots::Slots(size_t slot_count)
+    : mask(slot_count - 1), cells(new std::atomic<Cell*>[slot_count]) {
+    for (size_t i = 0; i < slot_count; ++i) {
+        cells[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+StockTable::StockTable(size_t initial_slots) {
+    size_t slot_count = 8;
+    while (slot_count < initial_slots) {
+        slot_count <<= 1;
+    }
+    tables_.push_back(std::make_unique<Slots>(slot_count));
+    slots_.store(tables_.back().get(), std::memory_order_release);
+}
+
+void StockTable::publish(const std::string& product_id, const ProductStock& stock) {
+    Slots* slots = slots_.load(std::memory_order_relaxed);
+    if (Cell* existing = findCell(*slots, product_id)) {
+        writeCell(*existing, true, stock);
+        return;
+    }
+
+    // Fill the cell before linking it, so a reader that finds it finds the fields too
+    cells_.push_back(std::make_unique<Cell>(product_id));
+    Cell* cell = cells_.back().get();
+    writeCell(*cell, true, stock);
+
+    if (cells_.size() > (slots->mask + 1) - (slots->mask + 1) / 4) {
+        // Readers still probing the old table keep using it; it stays allocated
+        auto grown = std::make_unique<Slots>((slots->mask + 1) * 2);
+        for (const auto& existing : cells_) {
+            insertCell(*grown, existing.get());
+        }
+        tables_.push_back(std::move(grown));
+        slots_.store(tables_.back().get(), std::memory_order_release);
+        return;
+    }
+    insertCell(*slots, cell);
+}
+
+void StockTable::remove(const std::string& product_id) {
+    if (Cell* cell = findCell(*slots_.load(std::memory_order_relaxed), product_id)) {
+        writeCell(*cell, false, ProductStock());
+    }
+}
+
+bool StockTable::read(const std::string& product_id, ProductStock& stock) const {
+    const Cell* cell = findCell(*slots_.load(std::memory_order_acquire), product_id);
+    if (!cell) {
+        return false;
+    }
+
+    for (int attempt = 1;; ++attempt) {
+        uint32_t before = cell->sequence.load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+            bool present = cell->present.load(std::memory_order_relaxed);
+            int quantity = cell->quantity.load(std::memory_order_relaxed);
+            int available = cell->available_quantity.load(std::memory_order_relaxed);
+            uint64_t price_bits = cell->price_bits.load(std::memory_order_relaxed);
+            uint64_t version = cell->product_version.load(std::memory_order_relaxed);
+            bool perishable = cell->perishable.load(std::memory_order_relaxed);
+            int64_t expiry_ticks = cell->expiry_ticks.load(std::memory_order_relaxed);
+
+            // Keeps the field loads above from moving past the second sequence load
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (cell->sequence.load(std::memory_order_relaxed) == before) {
+                if (!present) {
+                    return false;
+                }
+                stock.quantity = quantity;
+                stock.available_quantity = available;
+                std::memcpy(&stock.price, &price_bits, sizeof(stock.price));
+                stock.product_version = version;
+                stock.perishable = perishable;
+                stock.expiry_date = std::chrono::system_clock::time_point(
+                    std::chrono::system_clock::duration(expiry_ticks));
+                return true;
+            }
+        }
+
+        if (attempt % kSpinsBeforeYield == 0) {
+            std::this_thread::yield();
+        } else {
+            cpuRelax();
+        }
+    }
+}
+
+StockTable::Cell* StockTable::findCell(const Slots& slots, const std::string& product_id) {
+    for (size_t slot = slotOf(product_id, slots.mask);; slot = (slot + 1) & slots.mask) {
+        Cell* cell = slots.cells[slot].load(std::memory_order_acquire);
+        if (!cell || cell->id == product_id) {
+            return cell;    // Tables never fill up, so every probe chain ends in an empty slot
+        }
+    }
+}
+
+void StockTable::insertCell(Slots& slots, Cell* cell) {
+    size_t slot = slotOf(cell->id, slots.mask);
+    while (slots.cells[slot].load(std::memory_order_relaxed)) {
+        slot = (slot + 1) & slots.mask;
+    }
+    slots.cells[slot].store(cell, std::memory_order_release);
+}
+
+void StockTable::writeCell(Cell& cell, bool present, const ProductStock& stock) {
+    uint32_t sequence = cell.sequence.load(std::memory_order_relaxed);
+    cell.sequence.store(sequence + 1, std::memory_order_relaxed);
+    // Keeps the field stores below from becoming visible before the odd sequence
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t price_bits;
+    std::memcpy(&price_bits, &stock.price, sizeof(price_bits));
+    cell.present.store(present, std::memory_order_relaxed);
+    cell.quantity.store(stock.quantity, std::memory_order_relaxed);
+    cell.available_quantity.store(stock.available_quantity, std::memory_order_relaxed);
+    cell.price_bits.store(price_bits, std::memory_order_relaxed);
+    cell.product_version.store(stock.product_version, std::memory_order_relaxed);
+    cell.perishable.store(stock.perishable, std::memory_order_relaxed);
+    cell.expiry_ticks.store(stock.expiry_date.time_since_epoch().count(), std::memory_order_relaxed);
+
+    cell.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+} // namespace quirkventory
@@ -0,0 +1,136 @@
+#include "../include/ThreadPool.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace quirkventory {
+
+namespace {
+
+/**
+ * @brief Shared state for one parallelFor call
+ *
+ * Helper tasks may start after the call has returned (when the caller ran
+ * every index itself), so the state is reference counted and body is only
+ * touched after successfully claiming an index.
+ */
+struct ParallelForState {
+    const std::function<void(size_t)>* body = nullptr;
+    size_t count = 0;
+    std::atomic<size_t> next_index{0};
+    size_t completed = 0;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable done;
+
+    void runAvailable() {
+        size_t finished = 0;
+        std::exception_ptr local_error;
+        for (size_t index = next_index.fetch_add(1); index < count; index = next_index.fetch_add(1)) {
+            try {
+                (*body)(index);
+            } catch (...) {
+                if (!local_error) {
+                    local_error = std::current_exception();
+                }
+            }
+            ++finished;
+        }
+        if (finished == 0) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (local_error && !error) {
+            error = local_error;
+        }
+        completed += finished;
+        if (completed == count) {
+            done.notify_all();
+        }
+    }
+};
+
+} // namespace
+
+// ThreadPool Implementation
+
+ThreadPool::ThreadPool(size_t thread_count) : stopping_(false) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workers_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stopping_ = true;
+    }
+    queue_condition_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>();
+    state->body = &body;
+    state->count = count;
+
+    // One helper per worker at most; the caller works through indices too
+    size_t helpers = std::min(count - 1, workers_.size());
+    for (size_t i = 0; i < helpers; ++i) {
+        enqueue([state]() { state->runAvailable(); });
+    }
+
+    state->runAvailable();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state]() { return state->completed == state->count; });
+
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+ThreadPool& ThreadPool::getShared() {
+    static ThreadPool shared_pool;
+    return shared_pool;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        tasks_.push(std::move(task));
+    }
+    queue_condition_.notify_one();
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_condition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (stopping_ && tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+        task();
+    }
+}
+
+} // namespace quirkventory
@@ -0,0 +1,423 @@
+#include "../include/TimeSeries.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace quirkventory {
+
+namespace {
+
+constexpr long long SECONDS_PER_HOUR = 3600;
+constexpr long long SECONDS_PER_DAY = 24 * SECONDS_PER_HOUR;
+
+uint64_t doubleToBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsToDouble(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+int countLeadingZeros(uint64_t value) {
+    int count = 0;
+    for (uint64_t mask = uint64_t(1) << 63; mask != 0 && (value & mask) == 0; mask >>= 1) {
+        ++count;
+    }
+    return count;
+}
+
+int countTrailingZeros(uint64_t value) {
+    int count = 0;
+    for (uint64_t mask = 1; mask != 0 && (value & mask) == 0; mask <<= 1) {
+        ++count;
+    }
+    return count;
+}
+
+long long floorDiv(long long a, long long b) {
+    long long q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) {
+        --q;
+    }
+    return q;
+}
+
+/**
+ * @brief MSB-first bit reader over a GorillaBlock's bit stream
+ */
+class BitReader {
+private:
+    const uint8_t* data_;
+    size_t position_;
+
+public:
+    explicit BitReader(const uint8_t* data) : data_(data), position_(0) {}
+
+    uint64_t readBits(int bit_count) {
+        uint64_t value = 0;
+        while (bit_count > 0) {
+            size_t byte_index = position_ / 8;
+            int bit_offset = static_cast<int>(position_ % 8);
+            int available = 8 - bit_offset;
+            int take = std::min(available, bit_count);
+            uint8_t byte = data_[byte_index];
+            uint8_t bits = static_cast<uint8_t>((byte >> (available - take)) & ((1u << take) - 1));
+            value = (value << take) | bits;
+            position_ += take;
+            bit_count -= take;
+        }
+        return value;
+    }
+
+    bool readBit() { return readBits(1) != 0; }
+};
+
+// Delta-of-delta buckets: control prefix, payload bits and value offset
+struct DeltaCode {
+    uint64_t prefix;
+    int prefix_bits;
+    int payload_bits;
+    long long min_value;
+    long long max_value;
+};
+
+const DeltaCode DELTA_CODES[] = {
+    {0b10, 2, 7, -63, 64},
+    {0b110, 3, 9, -255, 256},
+    {0b1110, 4, 12, -2047, 2048}
+};
+
+} // namespace
+
+// GorillaBlock Implementation
+
+GorillaBlock::GorillaBlock()
+    : bit_count_(0), count_(0), first_timestamp_(0), last_timestamp_(0), last_delta_(0),
+      last_value_bits_(0), last_leading_zeros_(-1), last_trailing_zeros_(0) {
+}
+
+bool GorillaBlock::append(long long timestamp, double value) {
+    uint64_t value_bits = doubleToBits(value);
+
+    if (count_ == 0) {
+        writeBits(static_cast<uint64_t>(timestamp), 64);
+        writeBits(value_bits, 64);
+        first_timestamp_ = timestamp;
+        last_timestamp_ = timestamp;
+        last_value_bits_ = value_bits;
+        count_ = 1;
+        return true;
+    }
+
+    if (timestamp < last_timestamp_) {
+        return false;
+    }
+
+    // Timestamp: delta-of-delta with variable-length codes
+    long long delta = timestamp - last_timestamp_;
+    long long delta_of_delta = delta - last_delta_;
+    if (delta_of_delta == 0) {
+        writeBits(0, 1);
+    } else {
+        bool encoded = false;
+        for (const auto& code : DELTA_CODES) {
+            if (delta_of_delta >= code.min_value && delta_of_delta <= code.max_value) {
+                writeBits(code.prefix, code.prefix_bits);
+                writeBits(static_cast<uint64_t>(delta_of_delta - code.min_value), code.payload_bits);
+                encoded = true;
+                break;
+            }
+        }
+        if (!encoded) {
+            writeBits(0b1111, 4);
+            writeBits(static_cast<uint64_t>(delta_of_delta), 64);
+        }
+    }
+
+    // Value: XOR with the previous value, reusing the previous bit window when it fits
+    uint64_t xored = value_bits ^ last_value_bits_;
+    if (xored == 0) {
+        writeBits(0, 1);
+    } else {
+        writeBits(1, 1);
+        int leading = std::min(countLeadingZeros(xored), 31);
+        int trailing = countTrailingZeros(xored);
+
+        if (last_leading_zeros_ >= 0 && leading >= last_leading_zeros_ && trailing >= last_trailing_zeros_) {
+            writeBits(0, 1);
+            int meaningful = 64 - last_leading_zeros_ - last_trailing_zeros_;
+            writeBits(xored >> last_trailing_zeros_, meaningful);
+        } else {
+            int meaningful = 64 - leading - trailing;
+            writeBits(1, 1);
+            writeBits(static_cast<uint64_t>(leading), 5);
+            writeBits(static_cast<uint64_t>(meaningful - 1), 6);
+            writeBits(xored >> trailing, meaningful);
+            last_leading_zeros_ = leading;
+            last_trailing_zeros_ = trailing;
+        }
+    }
+
+    last_delta_ = delta;
+    last_timestamp_ = timestamp;
+    last_value_bits_ = value_bits;
+    count_++;
+    return true;
+}
+
+void GorillaBlock::forEach(const std::function<bool(const TimeSeriesPoint&)>& visitor) const {
+    if (count_ == 0) {
+        return;
+    }
+
+    BitReader reader(data_.data());
+    long long timestamp = static_cast<long long>(reader.readBits(64));
+    uint64_t value_bits = reader.readBits(64);
+    long long delta = 0;
+    int leading = 0;
+    int trailing = 0;
+
+    if (!visitor({timestamp, bitsToDouble(value_bits)})) {
+        return;
+    }
+
+    for (size_t i = 1; i < count_; ++i) {
+        long long delta_of_delta = 0;
+        if (reader.readBit()) {
+            bool decoded = false;
+            for (const auto& code : DELTA_CODES) {
+                if (!reader.readBit()) {
+                    delta_of_delta = static_cast<long long>(reader.readBits(code.payload_bits)) + code.min_value;
+                    decoded = true;
+                    break;
+                }
+            }
+            if (!decoded) {
+                delta_of_delta = static_cast<long long>(reader.readBits(64));
+            }
+        }
+        delta += delta_of_delta;
+        timestamp += delta;
+
+        if (reader.readBit()) {
+            if (reader.readBit()) {
+                leading = static_cast<int>(reader.readBits(5));
+                int meaningful = static_cast<int>(reader.readBits(6)) + 1;
+                trailing = 64 - leading - meaningful;
+            }
+            int meaningful = 64 - leading - trailing;
+            value_bits ^= reader.readBits(meaningful) << trailing;
+        }
+
+        if (!visitor({timestamp, bitsToDouble(value_bits)})) {
+            return;
+        }
+    }
+}
+
+void GorillaBlock::writeBits(uint64_t value, int bit_count) {
+    while (bit_count > 0) {
+        if (bit_count_ % 8 == 0) {
+            data_.push_back(0);
+        }
+        int bit_offset = static_cast<int>(bit_count_ % 8);
+        int available = 8 - bit_offset;
+        int take = std::min(available, bit_count);
+        uint8_t bits = static_cast<uint8_t>((value >> (bit_count - take)) & ((1u << take) - 1));
+        data_.back() |= static_cast<uint8_t>(bits << (available - take));
+        bit_count_ += take;
+        bit_count -= take;
+    }
+}
+
+// TimeSeries Implementation
+
+TimeSeries::TimeSeries(size_t block_capacity)
+    : block_capacity_(std::max<size_t>(block_capacity, 2)), point_count_(0) {
+}
+
+void TimeSeries::append(long long timestamp, double value) {
+    if (!blocks_.empty()) {
+        timestamp = std::max(timestamp, blocks_.back().getLastTimestamp());
+    }
+    if (blocks_.empty() || blocks_.back().size() >= block_capacity_) {
+        blocks_.emplace_back();
+    }
+
+    blocks_.back().append(timestamp, value);
+    point_count_++;
+
+    addToRollups(hourly_, floorDiv(timestamp, SECONDS_PER_HOUR) * SECONDS_PER_HOUR, value);
+    addToRollups(daily_, floorDiv(timestamp, SECONDS_PER_DAY) * SECONDS_PER_DAY, value);
+}
+
+std::vector<TimeSeriesPoint> TimeSeries::getPoints(long long start, long long end) const {
+    std::vector<TimeSeriesPoint> points;
+    if (end < start) {
+        return points;
+    }
+
+    // Skip whole blocks that end before the range
+    auto block = std::partition_point(blocks_.begin(), blocks_.end(),
+        [start](const GorillaBlock& b) { return b.getLastTimestamp() < start; });
+
+    for (; block != blocks_.end() && block->getFirstTimestamp() <= end; ++block) {
+        block->forEach([&](const TimeSeriesPoint& point) {
+            if (point.timestamp > end) {
+                return false;
+            }
+            if (point.timestamp >= start) {
+                points.push_back(point);
+            }
+            return true;
+        });
+    }
+
+    return points;
+}
+
+std::vector<TimeSeriesRollup> TimeSeries::getRollups(long long start, long long end,
+                                                     BucketGranularity granularity) const {
+    std::vector<TimeSeriesRollup> result;
+    if (end < start || point_count_ == 0) {
+        return result;
+    }
+
+    const std::vector<TimeSeriesRollup>& source = (granularity == BucketGranularity::HOUR) ? hourly_ : daily_;
+    long long source_size = (granularity == BucketGranularity::HOUR) ? SECONDS_PER_HOUR : SECONDS_PER_DAY;
+    long long bucket_size = (granularity == BucketGranularity::WEEK) ? 7 * SECONDS_PER_DAY : source_size;
+    // Weeks start on Monday; 1970-01-01 was a Thursday
+    long long bucket_offset = (granularity == BucketGranularity::WEEK) ? -3 * SECONDS_PER_DAY : 0;
+
+    auto bucketOf = [&](long long timestamp) {
+        return floorDiv(timestamp - bucket_offset, bucket_size) * bucket_size + bucket_offset;
+    };
+
+    // Never report buckets before the first sample or after the current time
+    long long now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    long long first_bucket = bucketOf(std::max(start, source.front().start));
+    long long last_bucket = bucketOf(std::min(end, std::max(now, source.back().start)));
+    if (last_bucket < first_bucket) {
+        return result;
+    }
+
+    // Level carried into the range from the last rollup before it
+    auto it = std::lower_bound(source.begin(), source.end(), first_bucket,
+        [](const TimeSeriesRollup& rollup, long long value) { return rollup.start < value; });
+    double level = (it != source.begin()) ? std::prev(it)->last : it->last;
+
+    for (long long bucket = first_bucket; bucket <= last_bucket; bucket += bucket_size) {
+        TimeSeriesRollup rollup{bucket, level, level, level, 0.0, 0};
+        bool has_samples = false;
+
+        for (; it != source.end() && it->start < bucket + bucket_size; ++it) {
+            if (!has_samples) {
+                rollup.min = it->min;
+                rollup.max = it->max;
+                has_samples = true;
+            } else {
+                rollup.min = std::min(rollup.min, it->min);
+                rollup.max = std::max(rollup.max, it->max);
+            }
+            // Buckets carried forward inside a coarser bucket still hold the level
+            rollup.min = std::min(rollup.min, level);
+            rollup.max = std::max(rollup.max, level);
+            rollup.sum += it->sum;
+            rollup.count += it->count;
+            rollup.last = it->last;
+            level = it->last;
+        }
+
+        result.push_back(rollup);
+    }
+
+    return result;
+}
+
+size_t TimeSeries::getCompressedBytes() const {
+    size_t bytes = 0;
+    for (const auto& block : blocks_) {
+        bytes += block.getByteSize();
+    }
+    return bytes;
+}
+
+void TimeSeries::addToRollups(std::vector<TimeSeriesRollup>& rollups, long long bucket_start, double value) {
+    if (rollups.empty() || rollups.back().start != bucket_start) {
+        rollups.push_back({bucket_start, value, value, value, value, 1});
+        return;
+    }
+
+    TimeSeriesRollup& rollup = rollups.back();
+    rollup.min = std::min(rollup.min, value);
+    rollup.max = std::max(rollup.max, value);
+    rollup.last = value;
+    rollup.sum += value;
+    rollup.count++;
+}
+
+// TimeSeriesStore Implementation
+
+void TimeSeriesStore::record(const std::string& key, const std::chrono::system_clock::time_point& time_point,
+                             double value) {
+    long long timestamp = std::chrono::duration_cast<std::chrono::seconds>(time_point.time_since_epoch()).count();
+    std::lock_guard<std::mutex> lock(store_mutex_);
+    series_[key].append(timestamp, value);
+}
+
+bool TimeSeriesStore::hasSeries(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(store_mutex_);
+    return series_.find(key) != series_.end();
+}
+
+std::vector<TimeSeriesPoint> TimeSeriesStore::getPoints(const std::string& key,
+                                                        const std::chrono::system_clock::time_point& start,
+                                                        const std::chrono::system_clock::time_point& end) const {
+    long long first = std::chrono::duration_cast<std::chrono::seconds>(start.time_since_epoch()).count();
+    long long last = std::chrono::duration_cast<std::chrono::seconds>(end.time_since_epoch()).count();
+
+    std::lock_guard<std::mutex> lock(store_mutex_);
+    auto it = series_.find(key);
+    return it != series_.end() ? it->second.getPoints(first, last) : std::vector<TimeSeriesPoint>();
+}
+
+std::vector<TimeSeriesRollup> TimeSeriesStore::getRollups(const std::string& key,
+                                                          const std::chrono::system_clock::time_point& start,
+                                                          const std::chrono::system_clock::time_point& end,
+                                                          BucketGranularity granularity) const {
+    long long first = std::chrono::duration_cast<std::chrono::seconds>(start.time_since_epoch()).count();
+    long long last = std::chrono::duration_cast<std::chrono::seconds>(end.time_since_epoch()).count();
+
+    std::lock_guard<std::mutex> lock(store_mutex_);
+    auto it = series_.find(key);
+    return it != series_.end() ? it->second.getRollups(first, last, granularity) : std::vector<TimeSeriesRollup>();
+}
+
+size_t TimeSeriesStore::getSeriesCount() const {
+    std::lock_guard<std::mutex> lock(store_mutex_);
+    return series_.size();
+}
+
+size_t TimeSeriesStore::getPointCount() const {
+    std::lock_guard<std::mutex> lock(store_mutex_);
+    size_t count = 0;
+    for (const auto& pair : series_) {
+        count += pair.second.size();
+    }
+    return count;
+}
+
+size_t TimeSeriesStore::getCompressedBytes() const {
+    std::lock_guard<std::mutex> lock(store_mutex_);
+    size_t bytes = 0;
+    for (const auto& pair : series_) {
+        bytes += pair.second.getCompressedBytes();
+    }
+    return bytes;
+}
+
+} // namespace quirkventory
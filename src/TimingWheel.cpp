@@ -0,0 +1,81 @@
+#include "../include/TimingWheel.hpp"
+#include <utility>
+
+namespace quirkventory {
+
+TimingWheel::TimingWheel(uint64_t start_tick)
+    : slots_(LEVELS * SLOTS), current_tick_(start_tick), size_(0) {
+}
+
+void TimingWheel::schedule(uint64_t id, uint64_t expiry_tick) {
+    // The current tick's slot has already fired, so the earliest is the next tick
+    if (expiry_tick <= current_tick_) {
+        expiry_tick = current_tick_ + 1;
+    }
+    insert(Entry{id, expiry_tick});
+    size_++;
+}
+
+size_t TimingWheel::advance(uint64_t now_tick, const std::function<void(uint64_t)>& on_expired) {
+    size_t fired = 0;
+
+    while (current_tick_ < now_tick) {
+        // Skip whole level-0 windows when nothing is scheduled at all
+        if (size_ == 0) {
+            current_tick_ = now_tick;
+            break;
+        }
+
+        current_tick_++;
+
+        // When a level wraps, pull the next slot of the level above down
+        for (int level = 1; level < LEVELS; ++level) {
+            int shift = SLOT_BITS * level;
+            if ((current_tick_ & ((uint64_t(1) << shift) - 1)) != 0) {
+                break;
+            }
+            cascade(level, (current_tick_ >> shift) & (SLOTS - 1));
+
+            if (level == LEVELS - 1 && ((current_tick_ >> (shift + SLOT_BITS)) << (shift + SLOT_BITS)) == current_tick_) {
+                std::vector<Entry> overflow;
+                overflow.swap(overflow_);
+                for (const auto& entry : overflow) {
+                    insert(entry);
+                }
+            }
+        }
+
+        std::vector<Entry> due;
+        due.swap(slots_[current_tick_ & (SLOTS - 1)]);
+        for (const auto& entry : due) {
+            on_expired(entry.id);
+        }
+        size_ -= due.size();
+        fired += due.size();
+    }
+
+    return fired;
+}
+
+void TimingWheel::insert(const Entry& entry) {
+    // Use the lowest level whose enclosing window also contains the current tick
+    for (int level = 0; level < LEVELS; ++level) {
+        int window_shift = SLOT_BITS * (level + 1);
+        if ((entry.expiry_tick >> window_shift) == (current_tick_ >> window_shift)) {
+            size_t slot = (entry.expiry_tick >> (SLOT_BITS * level)) & (SLOTS - 1);
+            slots_[level * SLOTS + slot].push_back(entry);
+            return;
+        }
+    }
+    overflow_.push_back(entry);
+}
+
+void TimingWheel::cascade(int level, size_t slot) {
+    std::vector<Entry> entries;
+    entries.swap(slots_[level * SLOTS + slot]);
+    for (const auto& entry : entries) {
+        insert(entry);
+    }
+}
+
+} // namespace quirkventory
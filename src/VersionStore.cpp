@@ -0,0 +1,277 @@
+#include "../include/VersionStore.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace quirkventory {
+
+// ReadView Implementation
+
+VersionStore::ReadView::ReadView(ReadView&& other) noexcept
+    : store_(other.store_), commit_(other.commit_), time_(other.time_),
+      commit_pin_(other.commit_pin_), time_pin_(other.time_pin_) {
+    other.store_ = nullptr;
+}
+
+VersionStore::ReadView& VersionStore::ReadView::operator=(ReadView&& other) noexcept {
+    if (this != &other) {
+        release();
+        store_ = other.store_;
+        commit_ = other.commit_;
+        time_ = other.time_;
+        commit_pin_ = other.commit_pin_;
+        time_pin_ = other.time_pin_;
+        other.store_ = nullptr;
+    }
+    return *this;
+}
+
+VersionStore::ReadView::~ReadView() {
+    release();
+}
+
+void VersionStore::ReadView::release() {
+    if (store_) {
+        store_->releaseView(*this);
+        store_ = nullptr;
+    }
+}
+
+// VersionStore Implementation
+
+VersionStore::VersionStore(std::chrono::milliseconds retention)
+    : retention_(retention), last_commit_(0), last_commit_time_(Clock::now()),
+      group_depth_(0), group_has_commit_(false), published_commit_(0),
+      history_start_(last_commit_time_), version_count_(0), collected_count_(0) {
+    if (retention.count() < 0) {
+        throw std::invalid_argument("Version retention cannot be negative");
+    }
+}
+
+VersionStore::~VersionStore() {
+    for (auto& pair : heads_) {
+        destroyChain(std::move(pair.second));
+    }
+}
+
+void VersionStore::seed(std::vector<std::shared_ptr<ProductVersion>> versions) {
+    std::unique_lock<std::shared_mutex> lock(heads_mutex_);
+
+    last_commit_ = 1;
+    for (auto& version : versions) {
+        version->commit = last_commit_;
+        version->committed_at = history_start_;
+        std::string id = version->id;
+        heads_[id] = std::move(version);
+    }
+    version_count_.fetch_add(versions.size());
+    lock.unlock();
+
+    publish(last_commit_);
+}
+
+void VersionStore::append(std::shared_ptr<ProductVersion> version) {
+    assignCommit(*version);
+    version_count_.fetch_add(1);
+
+    {
+        std::shared_lock<std::shared_mutex> lock(heads_mutex_);
+        auto it = heads_.find(version->id);
+        if (it != heads_.end()) {
+            // Readers see the new head only together with its link to the old one
+            version->older = std::atomic_load(&it->second);
+            std::atomic_store(&it->second, VersionPtr(std::move(version)));
+        }
+    }
+    if (version) {
+        std::unique_lock<std::shared_mutex> lock(heads_mutex_);
+        std::string id = version->id;
+        heads_[id] = std::move(version);
+    }
+
+    if (group_depth_ == 0) {
+        publish(last_commit_);
+    }
+}
+
+void VersionStore::beginGroup() {
+    group_depth_++;
+}
+
+void VersionStore::endGroup() {
+    if (group_depth_ > 0 && --group_depth_ == 0 && group_has_commit_) {
+        group_has_commit_ = false;
+        publish(last_commit_);
+    }
+}
+
+VersionStore::ReadView VersionStore::openLatest() const {
+    ReadView view;
+    std::lock_guard<std::mutex> lock(pins_mutex_);
+    view.store_ = this;
+    view.commit_ = published_commit_.load(std::memory_order_acquire);
+    view.time_ = Clock::time_point::max();
+    view.commit_pin_ = pinned_commits_.insert(view.commit_);
+    view.time_pin_ = pinned_times_.insert(view.time_);
+    return view;
+}
+
+VersionStore::ReadView VersionStore::openAsOf(Clock::time_point as_of) const {
+    ReadView view;
+    std::lock_guard<std::mutex> lock(pins_mutex_);
+    if (as_of < history_start_) {
+        return view;
+    }
+    view.store_ = this;
+    view.commit_ = published_commit_.load(std::memory_order_acquire);
+    view.time_ = as_of;
+    view.commit_pin_ = pinned_commits_.insert(view.commit_);
+    view.time_pin_ = pinned_times_.insert(view.time_);
+    return view;
+}
+
+VersionStore::VersionPtr VersionStore::find(const ReadView& view, const std::string& product_id) const {
+    if (view.store_ != this) {
+        return nullptr;
+    }
+
+    VersionPtr head;
+    {
+        std::shared_lock<std::shared_mutex> lock(heads_mutex_);
+        auto it = heads_.find(product_id);
+        if (it == heads_.end()) {
+            return nullptr;
+        }
+        head = std::atomic_load(&it->second);
+    }
+
+    VersionPtr version = visibleVersion(std::move(head), view.commit_, view.time_);
+    return version && !version->removed ? version : nullptr;
+}
+
+std::vector<VersionStore::VersionPtr> VersionStore::collect(const ReadView& view) const {
+    std::vector<VersionPtr> result;
+    if (view.store_ != this) {
+        return result;
+    }
+
+    // Copy the heads so the chains are walked without holding the map lock
+    {
+        std::shared_lock<std::shared_mutex> lock(heads_mutex_);
+        result.reserve(heads_.size());
+        for (const auto& pair : heads_) {
+            result.push_back(std::atomic_load(&pair.second));
+        }
+    }
+
+    size_t kept = 0;
+    for (auto& head : result) {
+        VersionPtr version = visibleVersion(std::move(head), view.commit_, view.time_);
+        if (version && !version->removed) {
+            result[kept++] = std::move(version);
+        }
+    }
+    result.resize(kept);
+    return result;
+}
+
+size_t VersionStore::collectGarbage() {
+    uint64_t min_commit;
+    Clock::time_point min_time;
+    {
+        std::lock_guard<std::mutex> lock(pins_mutex_);
+        Clock::time_point horizon = Clock::now() - retention_;
+        history_start_ = std::max(history_start_, horizon);
+
+        // Views opened from now on pin at least the current commit and history start
+        min_commit = pinned_commits_.empty() ? published_commit_.load(std::memory_order_acquire)
+                                             : *pinned_commits_.begin();
+        min_time = pinned_times_.empty() ? history_start_ : std::min(history_start_, *pinned_times_.begin());
+    }
+
+    size_t dropped = 0;
+    std::vector<std::pair<std::string, VersionPtr>> removable;
+    {
+        std::shared_lock<std::shared_mutex> lock(heads_mutex_);
+        for (const auto& pair : heads_) {
+            VersionPtr head = std::atomic_load(&pair.second);
+
+            // Every view sees this version or a newer one, so older ones are unreachable
+            VersionPtr cutoff = visibleVersion(head, min_commit, min_time);
+            if (!cutoff) {
+                continue;
+            }
+            dropped += destroyChain(std::atomic_exchange(&cutoff->older, VersionPtr()));
+            if (cutoff == head && head->removed) {
+                removable.emplace_back(pair.first, std::move(head));
+            }
+        }
+    }
+
+    if (!removable.empty()) {
+        std::unique_lock<std::shared_mutex> lock(heads_mutex_);
+        for (auto& entry : removable) {
+            auto it = heads_.find(entry.first);
+            // Skip products re-added since the scan
+            if (it != heads_.end() && it->second == entry.second) {
+                heads_.erase(it);
+                dropped++;
+            }
+        }
+    }
+
+    version_count_.fetch_sub(dropped);
+    collected_count_.fetch_add(dropped);
+    return dropped;
+}
+
+size_t VersionStore::getOpenViewCount() const {
+    std::lock_guard<std::mutex> lock(pins_mutex_);
+    return pinned_commits_.size();
+}
+
+VersionStore::Clock::time_point VersionStore::getHistoryStart() const {
+    std::lock_guard<std::mutex> lock(pins_mutex_);
+    return history_start_;
+}
+
+void VersionStore::assignCommit(ProductVersion& version) {
+    // Note: Writers are serialized by the caller
+    if (group_depth_ == 0 || !group_has_commit_) {
+        last_commit_++;
+        // Keep commit times ordered like commit numbers even if the clock steps back
+        last_commit_time_ = std::max(Clock::now(), last_commit_time_);
+        group_has_commit_ = group_depth_ > 0;
+    }
+    version.commit = last_commit_;
+    version.committed_at = last_commit_time_;
+}
+
+void VersionStore::publish(uint64_t commit) {
+    published_commit_.store(commit, std::memory_order_release);
+}
+
+void VersionStore::releaseView(ReadView& view) const {
+    std::lock_guard<std::mutex> lock(pins_mutex_);
+    pinned_commits_.erase(view.commit_pin_);
+    pinned_times_.erase(view.time_pin_);
+}
+
+VersionStore::VersionPtr VersionStore::visibleVersion(VersionPtr version, uint64_t commit, Clock::time_point time) {
+    while (version && (version->commit > commit || version->committed_at > time)) {
+        version = std::atomic_load(&version->older);
+    }
+    return version;
+}
+
+size_t VersionStore::destroyChain(VersionPtr chain) {
+    // Unlink before release so a long chain is not freed recursively
+    size_t count = 0;
+    while (chain) {
+        VersionPtr older = std::atomic_exchange(&chain->older, VersionPtr());
+        chain = std::move(older);
+        count++;
+    }
+    return count;
+}
+
+} // namespace quirkventory
@@ -0,0 +1,340 @@
+#include "../include/Wire.hpp"
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace quirkventory {
+
+namespace {
+
+constexpr uint32_t kMaxMessageSize = 256u << 20;
+
+bool sendAll(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool receiveAll(int fd, uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t received = ::recv(fd, data, size, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+int64_t toMicros(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+}
+
+uint32_t readLength(const uint8_t* data) {
+    uint32_t length = 0;
+    for (int i = 0; i < 4; ++i) {
+        length |= static_cast<uint32_t>(data[i]) << (8 * i);
+    }
+    return length;
+}
+
+bool toUnixAddress(const std::string& path, sockaddr_un& address) {
+    address = sockaddr_un{};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+void setNoDelay(int fd) {
+    // Messages are small and answered one by one; don't let Nagle hold them back
+    int no_delay = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+}
+
+} // namespace
+
+namespace Wire {
+
+bool sendMessage(int fd, uint8_t type, const ByteWriter& body) {
+    std::vector<uint8_t> frame;
+    frame.reserve(body.getBuffer().size() + 5);
+    appendMessage(frame, type, body);
+    return sendFrames(fd, frame);
+}
+
+ReceiveResult receiveMessage(int fd, std::chrono::milliseconds timeout, uint8_t& type, std::vector<uint8_t>& body) {
+    pollfd descriptor{fd, POLLIN, 0};
+    int ready = ::poll(&descriptor, 1, static_cast<int>(timeout.count()));
+    if (ready == 0 || (ready < 0 && errno == EINTR)) {
+        return ReceiveResult::TIMEOUT;
+    }
+    if (ready < 0) {
+        return ReceiveResult::CLOSED;
+    }
+
+    uint8_t header[5];
+    if (!receiveAll(fd, header, sizeof(header))) {
+        return ReceiveResult::CLOSED;
+    }
+    uint32_t length = readLength(header);
+    if (length == 0 || length > kMaxMessageSize) {
+        return ReceiveResult::CLOSED;
+    }
+
+    type = header[4];
+    body.resize(length - 1);
+    if (!body.empty() && !receiveAll(fd, body.data(), body.size())) {
+        return ReceiveResult::CLOSED;
+    }
+    return ReceiveResult::MESSAGE;
+}
+
+void appendMessage(std::vector<uint8_t>& frames, uint8_t type, const ByteWriter& body) {
+    const std::vector<uint8_t>& payload = body.getBuffer();
+    uint32_t length = static_cast<uint32_t>(payload.size() + 1);
+    for (int i = 0; i < 4; ++i) {
+        frames.push_back(static_cast<uint8_t>(length >> (8 * i)));
+    }
+    frames.push_back(type);
+    frames.insert(frames.end(), payload.begin(), payload.end());
+}
+
+bool sendFrames(int fd, const std::vector<uint8_t>& frames) {
+    return sendAll(fd, frames.data(), frames.size());
+}
+
+ReceiveResult FrameReader::fill(int fd, std::chrono::milliseconds timeout) {
+    pollfd descriptor{fd, POLLIN, 0};
+    int ready = ::poll(&descriptor, 1, static_cast<int>(timeout.count()));
+    if (ready == 0 || (ready < 0 && errno == EINTR)) {
+        return ReceiveResult::TIMEOUT;
+    }
+    if (ready < 0) {
+        return ReceiveResult::CLOSED;
+    }
+
+    // Drop consumed bytes before growing the buffer
+    if (start_ > 0) {
+        buffer_.erase(buffer_.begin(), buffer_.begin() + static_cast<std::ptrdiff_t>(start_));
+        start_ = 0;
+    }
+    size_t used = buffer_.size();
+    buffer_.resize(used + 64 * 1024);
+    ssize_t received;
+    do {
+        received = ::recv(fd, buffer_.data() + used, buffer_.size() - used, 0);
+    } while (received < 0 && errno == EINTR);
+    buffer_.resize(used + static_cast<size_t>(received > 0 ? received : 0));
+    return received > 0 ? ReceiveResult::MESSAGE : ReceiveResult::CLOSED;
+}
+
+bool FrameReader::next(uint8_t& type, std::vector<uint8_t>& body) {
+    size_t available = buffer_.size() - start_;
+    if (invalid_ || available < 5) {
+        return false;
+    }
+    uint32_t length = readLength(buffer_.data() + start_);
+    if (length == 0 || length > kMaxMessageSize) {
+        invalid_ = true;
+        return false;
+    }
+    if (available < 4 + static_cast<size_t>(length)) {
+        return false;
+    }
+
+    type = buffer_[start_ + 4];
+    body.assign(buffer_.begin() + static_cast<std::ptrdiff_t>(start_ + 5),
+                buffer_.begin() + static_cast<std::ptrdiff_t>(start_ + 4 + length));
+    start_ += 4 + length;
+    return true;
+}
+
+int listenTcp(const std::string& address, uint16_t& port) {
+    sockaddr_in bound{};
+    bound.sin_family = AF_INET;
+    bound.sin_port = htons(port);
+    if (::inet_pton(AF_INET, address.c_str(), &bound.sin_addr) != 1) {
+        return -1;
+    }
+
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    socklen_t length = sizeof(bound);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&bound), sizeof(bound)) < 0 ||
+        ::listen(fd, 64) < 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&bound), &length) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    port = ntohs(bound.sin_port);
+    return fd;
+}
+
+int listenUnix(const std::string& path) {
+    sockaddr_un address;
+    if (!toUnixAddress(path, address)) {
+        return -1;
+    }
+
+    // Replace a socket left behind by an earlier run, but never another kind of file
+    struct stat existing;
+    if (::lstat(path.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            return -1;
+        }
+        ::unlink(path.c_str());
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(fd, 64) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int acceptConnection(int listen_fd, std::chrono::milliseconds timeout, std::string& peer) {
+    pollfd descriptor{listen_fd, POLLIN, 0};
+    if (::poll(&descriptor, 1, static_cast<int>(timeout.count())) <= 0) {
+        return -1;
+    }
+
+    sockaddr_storage address{};
+    socklen_t length = sizeof(address);
+    int fd = ::accept(listen_fd, reinterpret_cast<sockaddr*>(&address), &length);
+    if (fd < 0) {
+        return -1;
+    }
+    if (address.ss_family != AF_INET) {
+        peer = "unix";
+        return fd;
+    }
+    setNoDelay(fd);
+
+    const sockaddr_in& inet = reinterpret_cast<const sockaddr_in&>(address);
+    char host[INET_ADDRSTRLEN] = {0};
+    ::inet_ntop(AF_INET, &inet.sin_addr, host, sizeof(host));
+    peer = std::string(host) + ":" + std::to_string(ntohs(inet.sin_port));
+    return fd;
+}
+
+int connectTcp(const std::string& host, uint16_t port) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (::inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+        return -1;
+    }
+
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    setNoDelay(fd);
+    return fd;
+}
+
+int connectUnix(const std::string& path) {
+    sockaddr_un address;
+    if (!toUnixAddress(path, address)) {
+        return -1;
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void shutdownSocket(int fd) {
+    if (fd >= 0) {
+        ::shutdown(fd, SHUT_RDWR);
+    }
+}
+
+void closeSocket(int fd) {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+bool isIPv4Address(const std::string& host) {
+    in_addr address;
+    return ::inet_pton(AF_INET, host.c_str(), &address) == 1;
+}
+
+void putProduct(ByteWriter& writer, const ProductVersion& product) {
+    writer.putUInt8((product.removed ? 1 : 0) | (product.perishable ? 2 : 0));
+    writer.putString(product.id);
+    writer.putString(product.name);
+    writer.putString(product.category);
+    writer.putDouble(product.price);
+    writer.putVarInt(product.quantity);
+    writer.putVarInt(product.low_stock_threshold);
+    writer.putVarUInt(product.product_version);
+    writer.putVarInt(product.perishable ? toMicros(product.expiry_date) : 0);
+}
+
+bool getProduct(ByteReader& reader, ProductVersion& product) {
+    uint8_t flags;
+    int64_t quantity;
+    int64_t threshold;
+    int64_t expiry_us;
+    if (!reader.getUInt8(flags) || !reader.getString(product.id) || !reader.getString(product.name) ||
+        !reader.getString(product.category) || !reader.getDouble(product.price) ||
+        !reader.getVarInt(quantity) || !reader.getVarInt(threshold) ||
+        !reader.getVarUInt(product.product_version) || !reader.getVarInt(expiry_us)) {
+        return false;
+    }
+    product.removed = (flags & 1) != 0;
+    product.perishable = (flags & 2) != 0;
+    product.quantity = static_cast<int>(quantity);
+    product.low_stock_threshold = static_cast<int>(threshold);
+    product.expiry_date = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(expiry_us)));
+    return true;
+}
+
+} // namespace Wire
+
+} // namespace quirkventory
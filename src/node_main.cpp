@@ -0,0 +1,57 @@
+#include "Cluster.hpp"
+#include <iostream>
+#include <exception>
+#include <string>
+#include <csignal>
+#include <pthread.h>
+
+/**
+ * @brief Entry point of a cluster node process
+ *
+ * Usage: quirkventory_node <port> [bind_address]
+ *
+ * Serves one partition of a clustered inventory until SIGINT or SIGTERM.
+ * Port 0 picks a free port; the bound port is printed on the first line of
+ * output so scripts can hand it to the routers. Start one process per node
+ * and give every router the node addresses in the same order.
+ *
+ * @return 0 on clean shutdown, 1 on error
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <port> [bind_address]" << std::endl;
+        return 1;
+    }
+
+    try {
+        int port = std::stoi(argv[1]);
+        if (port < 0 || port > 65535) {
+            std::cerr << "Invalid port: " << argv[1] << std::endl;
+            return 1;
+        }
+        std::string bind_address = argc == 3 ? argv[2] : "127.0.0.1";
+
+        // Block the shutdown signals before any thread starts so only sigwait sees them
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+        quirkventory::Inventory inventory;
+        quirkventory::ClusterNode node(inventory, static_cast<uint16_t>(port), bind_address);
+        if (!node.start()) {
+            std::cerr << "Cannot listen on " << bind_address << ":" << port << std::endl;
+            return 1;
+        }
+        std::cout << node.getPort() << std::endl;
+
+        int signal = 0;
+        sigwait(&signals, &signal);
+        node.stop();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include "../../include/BackorderQueue.hpp"
+#include "../../include/Order.hpp"
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+// Test Fixture for Backorder Tests
+class BackorderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        inventory = std::make_unique<Inventory>();
+        order_manager = std::make_unique<OrderManager>(inventory.get());
+
+        auto expiry = system_clock::now() + hours(24 * 30);
+        inventory->addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 3, expiry));
+        inventory->addProduct(std::make_unique<PerishableProduct>("BREAD001", "Bread", "Bakery", 2.0, 10, expiry));
+    }
+
+    Order* placeOrder(const std::string& id, const std::string& product_id, int quantity, double price) {
+        Order* order = order_manager->createOrder(id, "CUST-" + id);
+        order->addItem(product_id, quantity, price);
+        EXPECT_TRUE(order->processOrder(*inventory, true));
+        return order;
+    }
+
+    int backordered(const Order* order, const std::string& product_id) {
+        const OrderItem* item = order->getItem(product_id);
+        return item ? item->backordered : -1;
+    }
+
+    std::unique_ptr<Inventory> inventory;
+    std::unique_ptr<OrderManager> order_manager;
+};
+
+TEST_F(BackorderTest, ShortOrderFailsWithoutBackorder) {
+    Order* order = order_manager->createOrder("ORD001", "CUST001");
+    order->addItem("MILK001", 5, 5.0);
+
+    EXPECT_FALSE(order->processOrder(*inventory));
+    EXPECT_EQ(order->getStatus(), OrderStatus::FAILED);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 3);
+}
+
+TEST_F(BackorderTest, ShortfallIsBackorderedAndAvailableStockReserved) {
+    Order* order = order_manager->createOrder("ORD001", "CUST001");
+    order->addItem("MILK001", 5, 5.0);
+    order->addItem("BREAD001", 2, 2.0);
+
+    EXPECT_TRUE(order->processOrder(*inventory, true));
+    EXPECT_EQ(order->getStatus(), OrderStatus::BACKORDERED);
+    EXPECT_EQ(backordered(order, "MILK001"), 2);
+    EXPECT_EQ(backordered(order, "BREAD001"), 0);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 0);
+    EXPECT_EQ(inventory->getProduct("BREAD001")->getQuantity(), 8);
+
+    const BackorderQueue* backorders = order_manager->getBackorders();
+    ASSERT_NE(backorders, nullptr);
+    EXPECT_EQ(backorders->getWaitingQuantity("MILK001"), 2);
+    EXPECT_EQ(backorders->getWaitingOrderCount(), 1u);
+}
+
+TEST_F(BackorderTest, RestockFillsWaitingOrdersInArrivalOrder) {
+    inventory->updateQuantity("MILK001", 0);
+    Order* first = placeOrder("ORD001", "MILK001", 4, 5.0);
+    Order* second = placeOrder("ORD002", "MILK001", 4, 5.0);
+
+    // Enough for the first order and half of the second
+    EXPECT_TRUE(inventory->addQuantity("MILK001", 6));
+
+    EXPECT_EQ(first->getStatus(), OrderStatus::CONFIRMED);
+    EXPECT_EQ(second->getStatus(), OrderStatus::BACKORDERED);
+    EXPECT_EQ(backordered(second, "MILK001"), 2);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 0);
+    EXPECT_EQ(order_manager->getBackorders()->getWaitingQuantity("MILK001"), 2);
+
+    // updateQuantity counts as a restock too; surplus stays on hand
+    EXPECT_TRUE(inventory->updateQuantity("MILK001", 5));
+    EXPECT_EQ(second->getStatus(), OrderStatus::CONFIRMED);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 3);
+    EXPECT_EQ(order_manager->getBackorders()->getWaitingOrderCount(), 0u);
+    EXPECT_EQ(order_manager->getBackorders()->getUnitsAllocated(), 8);
+}
+
+TEST_F(BackorderTest, FilledBackorderIsCountedAsSale) {
+    inventory->updateQuantity("MILK001", 0);
+    placeOrder("ORD001", "MILK001", 2, 5.0);
+
+    auto now = system_clock::now();
+    EXPECT_EQ(order_manager->getSalesAggregator().query(now - hours(1), now + hours(1)).totals.orders, 0);
+
+    inventory->addQuantity("MILK001", 2);
+    now = system_clock::now();
+    SalesBucket sales = order_manager->getSalesAggregator().query(now - hours(1), now + hours(1));
+    EXPECT_EQ(sales.totals.orders, 1);
+    EXPECT_DOUBLE_EQ(sales.totals.revenue, 10.0);
+}
+
+TEST_F(BackorderTest, CancelledBackorderReturnsStockAndIsSkipped) {
+    Order* cancelled = placeOrder("ORD001", "MILK001", 5, 5.0);   // Takes 3, waits for 2
+    Order* waiting = placeOrder("ORD002", "MILK001", 2, 5.0);
+
+    EXPECT_TRUE(cancelled->cancelOrder("Customer request"));
+
+    // The 3 returned units restock the product and go to the next order in line
+    EXPECT_EQ(waiting->getStatus(), OrderStatus::CONFIRMED);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 1);
+
+    // Later restocks skip the cancelled order's line and stay on hand
+    inventory->addQuantity("MILK001", 4);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 5);
+    EXPECT_EQ(order_manager->getBackorders()->getWaitingQuantity("MILK001"), 0);
+    EXPECT_EQ(order_manager->getBackorders()->getWaitingOrderCount(), 0u);
+}
+
+TEST_F(BackorderTest, ClearedOrdersAreDroppedFromQueue) {
+    inventory->updateQuantity("MILK001", 0);
+    Order* order = placeOrder("ORD001", "MILK001", 2, 5.0);
+    EXPECT_TRUE(order->cancelOrder());
+    EXPECT_EQ(order_manager->clearCompletedOrders(), 1);
+
+    EXPECT_TRUE(inventory->addQuantity("MILK001", 5));
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 5);
+}
+
+TEST(BackorderManagerTest, ManagerWithoutInventoryHasNoQueue) {
+    OrderManager manager;
+    EXPECT_EQ(manager.getBackorders(), nullptr);
+}
@@ -0,0 +1,347 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+#include "../../include/Cluster.hpp"
+#include "../../include/Wire.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+// Test Fixture for Cluster Tests (in-process nodes over loopback)
+class ClusterTest : public ::testing::Test {
+protected:
+    static constexpr size_t kNodeCount = 3;
+
+    void SetUp() override {
+        for (size_t i = 0; i < kNodeCount; ++i) {
+            inventories.push_back(std::make_unique<Inventory>());
+            nodes.push_back(std::make_unique<ClusterNode>(*inventories.back(), 0));
+            ASSERT_TRUE(nodes.back()->start());
+            addresses.push_back({"127.0.0.1", nodes.back()->getPort()});
+        }
+        router = std::make_unique<ClusterRouter>(addresses, seconds(2));
+    }
+
+    void TearDown() override {
+        router.reset();
+        for (auto& node : nodes) {
+            node->stop();
+        }
+    }
+
+    // Find product IDs owned by the given nodes, one per entry
+    std::vector<std::string> idsOwnedBy(const std::vector<size_t>& owners) {
+        std::vector<std::string> ids;
+        for (size_t owner : owners) {
+            for (int i = 0;; ++i) {
+                std::string id = "SKU" + std::to_string(i);
+                if (router->ownerOf(id) == owner && std::find(ids.begin(), ids.end(), id) == ids.end()) {
+                    ids.push_back(id);
+                    break;
+                }
+            }
+        }
+        return ids;
+    }
+
+    void addStock(const std::string& id, int quantity) {
+        auto expiry = system_clock::now() + hours(24 * 30);
+        ASSERT_EQ(router->addProduct(PerishableProduct(id, "Item " + id, "Grocery", 2.5, quantity, expiry)),
+                  ClusterResult::OK);
+    }
+
+    int quantityOf(const std::string& id) {
+        ProductVersion product;
+        return router->getProduct(id, product) == ClusterResult::OK ? product.quantity : -1;
+    }
+
+    std::vector<std::unique_ptr<Inventory>> inventories;
+    std::vector<std::unique_ptr<ClusterNode>> nodes;
+    std::vector<ClusterNodeAddress> addresses;
+    std::unique_ptr<ClusterRouter> router;
+};
+
+TEST(ClusterPartitionerTest, OwnersAreStableBalancedAndMoveLittleOnGrowth) {
+    EXPECT_THROW(ClusterPartitioner(0), std::invalid_argument);
+
+    ClusterPartitioner four(4);
+    ClusterPartitioner five(5);
+    std::vector<size_t> per_node(4, 0);
+    size_t moved = 0;
+    const size_t count = 10000;
+    for (size_t i = 0; i < count; ++i) {
+        std::string id = "P" + std::to_string(i);
+        size_t owner = four.ownerOf(id);
+        ASSERT_LT(owner, 4u);
+        EXPECT_EQ(owner, ClusterPartitioner(4).ownerOf(id));
+        per_node[owner]++;
+
+        // Growing only moves products to the new node
+        size_t new_owner = five.ownerOf(id);
+        if (new_owner != owner) {
+            EXPECT_EQ(new_owner, 4u);
+            moved++;
+        }
+    }
+
+    for (size_t node_count : per_node) {
+        EXPECT_GT(node_count, count / 4 * 9 / 10);
+        EXPECT_LT(node_count, count / 4 * 11 / 10);
+    }
+    EXPECT_GT(moved, count / 5 * 8 / 10);
+    EXPECT_LT(moved, count / 5 * 12 / 10);
+}
+
+TEST_F(ClusterTest, ProductOperationsRunOnTheOwningNode) {
+    auto ids = idsOwnedBy({0, 1, 2});
+    for (const auto& id : ids) {
+        addStock(id, 10);
+    }
+
+    for (size_t node = 0; node < kNodeCount; ++node) {
+        EXPECT_EQ(inventories[node]->getTotalProductCount(), 1u);
+        EXPECT_NE(inventories[node]->getProduct(ids[node]), nullptr);
+    }
+
+    ProductVersion product;
+    ASSERT_EQ(router->getProduct(ids[1], product), ClusterResult::OK);
+    EXPECT_EQ(product.id, ids[1]);
+    EXPECT_EQ(product.name, "Item " + ids[1]);
+    EXPECT_EQ(product.category, "Grocery");
+    EXPECT_DOUBLE_EQ(product.price, 2.5);
+    EXPECT_EQ(product.quantity, 10);
+
+    EXPECT_EQ(router->addQuantity(ids[0], 5), ClusterResult::OK);
+    EXPECT_EQ(router->removeQuantity(ids[2], 4), ClusterResult::OK);
+    EXPECT_EQ(quantityOf(ids[0]), 15);
+    EXPECT_EQ(quantityOf(ids[2]), 6);
+    EXPECT_EQ(inventories[0]->getProduct(ids[0])->getQuantity(), 15);
+
+    EXPECT_EQ(router->removeQuantity(ids[2], 100), ClusterResult::REJECTED);
+    EXPECT_EQ(router->addQuantity(ids[0], -1), ClusterResult::REJECTED);
+    EXPECT_EQ(router->addProduct(PerishableProduct(ids[0], "Dup", "Grocery", 1.0, 1,
+                                                   system_clock::now() + hours(24))),
+              ClusterResult::REJECTED);
+
+    EXPECT_EQ(router->removeProduct(ids[1]), ClusterResult::OK);
+    EXPECT_EQ(router->getProduct(ids[1], product), ClusterResult::NOT_FOUND);
+    EXPECT_EQ(router->removeProduct(ids[1]), ClusterResult::NOT_FOUND);
+    EXPECT_EQ(router->addQuantity("MISSING", 1), ClusterResult::NOT_FOUND);
+}
+
+TEST_F(ClusterTest, SingleNodeOrderReservesInOneStep) {
+    auto ids = idsOwnedBy({1, 1});
+    addStock(ids[0], 10);
+    addStock(ids[1], 10);
+
+    EXPECT_EQ(router->placeOrder({{ids[0], 3}, {ids[1], 2}, {ids[0], 1}}), ClusterOrderResult::COMMITTED);
+    EXPECT_EQ(quantityOf(ids[0]), 6);
+    EXPECT_EQ(quantityOf(ids[1]), 8);
+    EXPECT_EQ(router->getSingleNodeOrderCount(), 1u);
+    EXPECT_EQ(router->getCrossNodeOrderCount(), 0u);
+
+    EXPECT_EQ(router->placeOrder({{ids[0], 3}, {ids[1], 20}}), ClusterOrderResult::INSUFFICIENT_STOCK);
+    EXPECT_EQ(quantityOf(ids[0]), 6);
+    EXPECT_EQ(quantityOf(ids[1]), 8);
+}
+
+TEST_F(ClusterTest, CrossNodeOrderCommitsOnEveryNode) {
+    auto ids = idsOwnedBy({0, 1, 2});
+    for (const auto& id : ids) {
+        addStock(id, 10);
+    }
+
+    EXPECT_EQ(router->placeOrder({{ids[0], 1}, {ids[1], 2}, {ids[2], 3}}), ClusterOrderResult::COMMITTED);
+    EXPECT_EQ(quantityOf(ids[0]), 9);
+    EXPECT_EQ(quantityOf(ids[1]), 8);
+    EXPECT_EQ(quantityOf(ids[2]), 7);
+    EXPECT_EQ(router->getCrossNodeOrderCount(), 1u);
+
+    for (size_t node = 0; node < kNodeCount; ++node) {
+        EXPECT_EQ(inventories[node]->getHoldCount(), 0u);
+        ClusterNodeStats stats;
+        ASSERT_EQ(router->getNodeStats(node, stats), ClusterResult::OK);
+        EXPECT_EQ(stats.product_count, 1u);
+        EXPECT_EQ(stats.prepared, 0u);
+        EXPECT_EQ(stats.committed, 1u);
+        EXPECT_EQ(stats.aborted, 0u);
+    }
+}
+
+TEST_F(ClusterTest, CrossNodeOrderWithoutStockAbortsEverywhere) {
+    auto ids = idsOwnedBy({0, 1, 2});
+    for (const auto& id : ids) {
+        addStock(id, 10);
+    }
+
+    EXPECT_EQ(router->placeOrder({{ids[0], 5}, {ids[1], 5}, {ids[2], 11}}),
+              ClusterOrderResult::INSUFFICIENT_STOCK);
+    for (size_t node = 0; node < kNodeCount; ++node) {
+        EXPECT_EQ(quantityOf(ids[node]), 10);
+        EXPECT_EQ(inventories[node]->getHoldCount(), 0u);
+        EXPECT_EQ(nodes[node]->getStats().prepared, 0u);
+    }
+    EXPECT_EQ(nodes[0]->getStats().aborted, 1u);
+    EXPECT_EQ(nodes[1]->getStats().aborted, 1u);
+    EXPECT_EQ(router->getCrossNodeOrderCount(), 0u);
+}
+
+TEST_F(ClusterTest, UnreachableNodeFailsOrderAndReleasesOtherHolds) {
+    auto ids = idsOwnedBy({0, 2});
+    addStock(ids[0], 10);
+    addStock(ids[1], 10);
+
+    nodes[2]->stop();
+    EXPECT_EQ(router->placeOrder({{ids[0], 4}, {ids[1], 4}}), ClusterOrderResult::UNAVAILABLE);
+    EXPECT_EQ(inventories[0]->getHoldCount(), 0u);
+    EXPECT_EQ(quantityOf(ids[0]), 10);
+    EXPECT_EQ(router->addQuantity(ids[1], 1), ClusterResult::UNAVAILABLE);
+    EXPECT_EQ(router->getUndeliveredDecisionCount(), 1u);     // The abort for node 2
+
+    // The node comes back on the same port, the router reconnects and delivers the abort
+    nodes[2] = std::make_unique<ClusterNode>(*inventories[2], addresses[2].port);
+    ASSERT_TRUE(nodes[2]->start());
+    auto deadline = steady_clock::now() + seconds(5);
+    while (router->getUndeliveredDecisionCount() != 0 && steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(milliseconds(20));
+    }
+    EXPECT_EQ(router->getUndeliveredDecisionCount(), 0u);
+    EXPECT_EQ(router->placeOrder({{ids[0], 4}, {ids[1], 4}}), ClusterOrderResult::COMMITTED);
+    EXPECT_EQ(quantityOf(ids[0]), 6);
+    EXPECT_EQ(quantityOf(ids[1]), 6);
+}
+
+namespace {
+
+// Requests of the cluster protocol, as a coordinator sends them
+constexpr uint8_t kPrepare = 7;
+constexpr uint8_t kCommit = 8;
+constexpr uint8_t kAbort = 9;
+
+// Send one request on a new connection and return the reply's status byte (-1 if none)
+int sendToNode(uint16_t port, uint8_t request_type, uint64_t transaction_id, const std::string& product_id = "",
+               int quantity = 0) {
+    int fd = Wire::connectTcp("127.0.0.1", port);
+    if (fd < 0) {
+        return -1;
+    }
+    ByteWriter request;
+    request.putFixed64(transaction_id);
+    if (request_type == kPrepare) {
+        request.putVarUInt(1);
+        request.putString(product_id);
+        request.putVarInt(quantity);
+    }
+    uint8_t type;
+    std::vector<uint8_t> reply;
+    bool ok = Wire::sendMessage(fd, request_type, request) &&
+              Wire::receiveMessage(fd, seconds(2), type, reply) == Wire::ReceiveResult::MESSAGE && !reply.empty();
+    Wire::closeSocket(fd);
+    return ok ? reply[0] : -1;
+}
+
+} // namespace
+
+TEST(ClusterNodeTest, PreparedHoldsWaitForTheDecision) {
+    Inventory inventory;
+    auto expiry = system_clock::now() + hours(24);
+    inventory.addProduct(std::make_unique<PerishableProduct>("A1", "Apple", "Produce", 1.0, 10, expiry));
+    ClusterNode node(inventory, 0);
+    ASSERT_TRUE(node.start());
+
+    // A coordinator that prepares and then goes quiet before phase 2
+    ASSERT_EQ(sendToNode(node.getPort(), kPrepare, 42, "A1", 8), 0);
+    EXPECT_EQ(node.getStats().prepared, 1u);
+    EXPECT_EQ(inventory.getAvailableQuantity("A1"), 2);
+
+    // Having voted yes, the node neither aborts nor lets the holds lapse on its own
+    std::this_thread::sleep_for(milliseconds(500));
+    inventory.expireHolds();
+    EXPECT_EQ(node.getStats().prepared, 1u);
+    EXPECT_EQ(node.getStats().aborted, 0u);
+    EXPECT_EQ(inventory.getAvailableQuantity("A1"), 2);
+
+    // The late commit still takes the stock
+    EXPECT_EQ(sendToNode(node.getPort(), kCommit, 42), 0);
+    EXPECT_EQ(node.getStats().prepared, 0u);
+    EXPECT_EQ(node.getStats().committed, 1u);
+    EXPECT_EQ(inventory.getHoldCount(), 0u);
+    EXPECT_EQ(inventory.getProduct("A1")->getQuantity(), 2);
+}
+
+TEST(ClusterNodeTest, AbortBeforePrepareRefusesTheLatePrepare) {
+    Inventory inventory;
+    auto expiry = system_clock::now() + hours(24);
+    inventory.addProduct(std::make_unique<PerishableProduct>("A1", "Apple", "Produce", 1.0, 10, expiry));
+    ClusterNode node(inventory, 0);
+    ASSERT_TRUE(node.start());
+
+    // The coordinator timed out on the prepare and aborted before the node got to it
+    EXPECT_EQ(sendToNode(node.getPort(), kAbort, 7), 0);
+    EXPECT_EQ(sendToNode(node.getPort(), kPrepare, 7, "A1", 4), 2);
+    EXPECT_EQ(node.getStats().prepared, 0u);
+    EXPECT_EQ(inventory.getHoldCount(), 0u);
+    EXPECT_EQ(inventory.getAvailableQuantity("A1"), 10);
+
+    // Other transactions are unaffected
+    EXPECT_EQ(sendToNode(node.getPort(), kPrepare, 8, "A1", 4), 0);
+    EXPECT_EQ(sendToNode(node.getPort(), kAbort, 8), 0);
+    EXPECT_EQ(node.getStats().aborted, 1u);
+    EXPECT_EQ(inventory.getAvailableQuantity("A1"), 10);
+}
+
+TEST(ClusterNodeTest, AbortDuringPrepareReleasesTheHolds) {
+    Inventory inventory;
+    auto expiry = system_clock::now() + hours(24);
+    inventory.addProduct(std::make_unique<PerishableProduct>("A1", "Apple", "Produce", 1.0, 10, expiry));
+    inventory.addProduct(std::make_unique<PerishableProduct>("B1", "Banana", "Produce", 1.0, 10, expiry));
+    ClusterNode node(inventory, 0);
+    ASSERT_TRUE(node.start());
+
+    // Hold the inventory lock so the prepare stalls between its abort check and placing its hold
+    std::atomic<bool> locked{false};
+    std::atomic<bool> unlock{false};
+    inventory.setChangeListener([&](const InventoryChange&) {
+        locked = true;
+        while (!unlock) {
+            std::this_thread::sleep_for(milliseconds(1));
+        }
+    });
+    std::thread writer([&]() { inventory.addQuantity("B1", 1); });
+    while (!locked) {
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+
+    int prepare_status = -1;
+    std::thread coordinator([&]() { prepare_status = sendToNode(node.getPort(), kPrepare, 9, "A1", 4); });
+    std::this_thread::sleep_for(milliseconds(100));
+
+    // The coordinator gave up on the prepare; the abort finds nothing prepared yet
+    EXPECT_EQ(sendToNode(node.getPort(), kAbort, 9), 0);
+    unlock = true;
+    writer.join();
+    coordinator.join();
+    inventory.setChangeListener(nullptr);
+
+    EXPECT_EQ(prepare_status, 2);
+    EXPECT_EQ(node.getStats().prepared, 0u);
+    EXPECT_EQ(node.getStats().aborted, 1u);
+    EXPECT_EQ(inventory.getHoldCount(), 0u);
+    EXPECT_EQ(inventory.getAvailableQuantity("A1"), 10);
+}
+
+TEST_F(ClusterTest, InvalidArgumentsAreRejected) {
+    EXPECT_THROW(ClusterRouter(std::vector<ClusterNodeAddress>{}), std::invalid_argument);
+    EXPECT_THROW(ClusterRouter({{"localhost", 1}}), std::invalid_argument);
+
+    EXPECT_EQ(router->placeOrder({}), ClusterOrderResult::INVALID);
+    EXPECT_EQ(router->placeOrder({{"SKU1", 0}}), ClusterOrderResult::INVALID);
+
+    ClusterNodeStats stats;
+    EXPECT_EQ(router->getNodeStats(kNodeCount, stats), ClusterResult::NOT_FOUND);
+}
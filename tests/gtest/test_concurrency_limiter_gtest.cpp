@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include "../../include/ConcurrencyLimiter.hpp"
+#include "../../include/Order.hpp"
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+namespace {
+
+// Keep the limiter saturated and complete one item per call
+void runSaturated(ConcurrencyLimiter& limiter, microseconds latency, int completions) {
+    for (int i = 0; i < completions; ++i) {
+        while (limiter.tryAcquire()) {
+        }
+        limiter.onComplete(latency);
+    }
+}
+
+} // namespace
+
+TEST(ConcurrencyLimiterTest, RejectsInvalidLimits) {
+    ConcurrencyLimiterConfig config;
+    config.min_limit = 0;
+    EXPECT_THROW(ConcurrencyLimiter limiter(config), std::invalid_argument);
+
+    config = ConcurrencyLimiterConfig();
+    config.initial_limit = 300;
+    EXPECT_THROW(ConcurrencyLimiter limiter(config), std::invalid_argument);
+}
+
+TEST(ConcurrencyLimiterTest, AdmitsUpToLimit) {
+    ConcurrencyLimiterConfig config;
+    config.initial_limit = 2;
+    ConcurrencyLimiter limiter(config);
+
+    EXPECT_TRUE(limiter.tryAcquire());
+    EXPECT_TRUE(limiter.tryAcquire());
+    EXPECT_FALSE(limiter.tryAcquire());
+    EXPECT_EQ(limiter.getInFlight(), 2);
+
+    limiter.onComplete(microseconds(100));
+    EXPECT_EQ(limiter.getInFlight(), 1);
+    EXPECT_TRUE(limiter.tryAcquire());
+}
+
+TEST(ConcurrencyLimiterTest, GrowsWhileLatencyStaysAtBaseline) {
+    ConcurrencyLimiter limiter;
+    runSaturated(limiter, microseconds(100), 200);
+
+    EXPECT_GT(limiter.getLimit(), 16);
+    EXPECT_NEAR(limiter.getLatencyMicros(), 100.0, 1.0);
+}
+
+TEST(ConcurrencyLimiterTest, DoesNotGrowWhenLimitIsUnused) {
+    ConcurrencyLimiter limiter;
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_TRUE(limiter.tryAcquire());
+        limiter.onComplete(microseconds(100));
+    }
+    EXPECT_EQ(limiter.getLimit(), 4);
+}
+
+TEST(ConcurrencyLimiterTest, ShrinksWhenLatencyRisesAboveBaseline) {
+    ConcurrencyLimiterConfig config;
+    config.latency_target = microseconds(0);
+    ConcurrencyLimiter limiter(config);
+    runSaturated(limiter, microseconds(100), 200);
+    int grown = limiter.getLimit();
+
+    // Queueing: the same work now takes much longer
+    runSaturated(limiter, microseconds(1000), 20);
+    EXPECT_LT(limiter.getLimit(), grown / 2);
+}
+
+TEST(ConcurrencyLimiterTest, LatencyTargetCapsTheLimit) {
+    ConcurrencyLimiterConfig config;
+    config.initial_limit = 64;
+    config.latency_target = milliseconds(1);
+    ConcurrencyLimiter limiter(config);
+
+    // Latency is stable (no gradient) but above the target
+    runSaturated(limiter, milliseconds(5), 100);
+    EXPECT_EQ(limiter.getLimit(), config.min_limit);
+}
+
+TEST(AdaptiveOrderProcessingTest, ProcessesEveryPendingOrder) {
+    Inventory inventory;
+    OrderManager manager(&inventory);
+    auto expiry = system_clock::now() + hours(24 * 30);
+    inventory.addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 150, expiry));
+
+    for (int i = 0; i < 200; ++i) {
+        Order* order = manager.createOrder("ORD" + std::to_string(i), "CUST001");
+        order->addItem("MILK001", 1, 5.0);
+    }
+
+    EXPECT_EQ(manager.processAllPendingOrders(inventory), 150);
+    EXPECT_EQ(manager.getOrdersByStatus(OrderStatus::CONFIRMED).size(), 150u);
+    EXPECT_EQ(manager.getOrdersByStatus(OrderStatus::FAILED).size(), 50u);
+    EXPECT_EQ(inventory.getProduct("MILK001")->getQuantity(), 0);
+
+    const ConcurrencyLimiter& limiter = manager.getProcessingLimiter();
+    EXPECT_EQ(limiter.getSampleCount(), 200u);
+    EXPECT_EQ(limiter.getInFlight(), 0);
+    EXPECT_EQ(manager.getProcessingQueueDepth(), 0u);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../../include/Downsampling.hpp"
+
+using namespace quirkventory;
+
+namespace {
+
+std::vector<TimeSeriesPoint> makeWave(size_t count) {
+    std::vector<TimeSeriesPoint> points;
+    for (size_t i = 0; i < count; ++i) {
+        points.push_back({static_cast<long long>(i) * 60, std::sin(i * 0.01) * 100.0});
+    }
+    return points;
+}
+
+} // namespace
+
+TEST(DownsamplingTest, ShortSeriesIsReturnedUnchanged) {
+    auto points = makeWave(10);
+    EXPECT_EQ(Downsampling::downsample(points, 10, DownsampleMethod::LTTB).size(), 10u);
+    EXPECT_EQ(Downsampling::downsample(points, 50, DownsampleMethod::MIN_MAX).size(), 10u);
+}
+
+TEST(DownsamplingTest, LttbHitsTargetAndKeepsEndpoints) {
+    auto points = makeWave(10000);
+    auto result = Downsampling::downsample(points, 500, DownsampleMethod::LTTB);
+
+    ASSERT_EQ(result.size(), 500u);
+    EXPECT_EQ(result.front().timestamp, points.front().timestamp);
+    EXPECT_EQ(result.back().timestamp, points.back().timestamp);
+    for (size_t i = 1; i < result.size(); ++i) {
+        EXPECT_LT(result[i - 1].timestamp, result[i].timestamp);
+    }
+}
+
+TEST(DownsamplingTest, LttbKeepsIsolatedSpike) {
+    auto points = makeWave(10000);
+    points[4321].value = 10000.0;
+
+    auto result = Downsampling::downsample(points, 100, DownsampleMethod::LTTB);
+    bool found = false;
+    for (const auto& point : result) {
+        found = found || point.timestamp == points[4321].timestamp;
+    }
+    EXPECT_TRUE(found);
+}
+
+TEST(DownsamplingTest, MinMaxKeepsGlobalExtremes) {
+    auto points = makeWave(10000);
+    points[1234].value = -500.0;
+    points[8765].value = 500.0;
+
+    auto result = Downsampling::downsample(points, 200, DownsampleMethod::MIN_MAX);
+    ASSERT_LE(result.size(), 200u);
+
+    double min_value = result.front().value;
+    double max_value = result.front().value;
+    for (size_t i = 1; i < result.size(); ++i) {
+        EXPECT_LT(result[i - 1].timestamp, result[i].timestamp);
+        min_value = std::min(min_value, result[i].value);
+        max_value = std::max(max_value, result[i].value);
+    }
+    EXPECT_DOUBLE_EQ(min_value, -500.0);
+    EXPECT_DOUBLE_EQ(max_value, 500.0);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include "../../include/IdGenerator.hpp"
+#include "../../include/Order.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+TEST(IdGeneratorTest, InvalidConfigurationThrows) {
+    EXPECT_THROW(IdGenerator(IdGenerator::MAX_NODE_ID + 1), std::invalid_argument);
+    EXPECT_THROW(IdGenerator(0, 0), std::invalid_argument);
+    EXPECT_THROW(IdGenerator(0, 4097), std::invalid_argument);
+}
+
+TEST(IdGeneratorTest, IdsEmbedNodeAndCurrentTime) {
+    IdGenerator generator(513);
+    auto before = system_clock::now() - milliseconds(1);
+    uint64_t id = generator.next();
+    auto after = system_clock::now() + milliseconds(1);
+
+    EXPECT_EQ(IdGenerator::getNodeId(id), 513u);
+    EXPECT_GE(IdGenerator::getTimestamp(id), before);
+    EXPECT_LE(IdGenerator::getTimestamp(id), after);
+}
+
+TEST(IdGeneratorTest, StringsAreFixedWidthAndSortLikeIds) {
+    EXPECT_EQ(IdGenerator::format(0, "ORD"), "ORD0000000000000");
+    EXPECT_EQ(IdGenerator::format(31), "000000000000Z");
+
+    IdGenerator generator;
+    std::string previous = generator.nextString("ORD");
+    for (int i = 0; i < 10000; ++i) {
+        std::string current = generator.nextString("ORD");
+        ASSERT_EQ(current.size(), 16u);
+        ASSERT_LT(previous, current);
+        previous = current;
+    }
+}
+
+TEST(IdGeneratorTest, ConcurrentThreadsNeverCollide) {
+    IdGenerator generator(1, 16);
+    const int thread_count = 8;
+    const int ids_per_thread = 250000;
+    std::vector<std::vector<uint64_t>> ids(thread_count);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t]() {
+            ids[t].reserve(ids_per_thread);
+            for (int i = 0; i < ids_per_thread; ++i) {
+                ids[t].push_back(generator.next());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<uint64_t> all;
+    for (const auto& thread_ids : ids) {
+        EXPECT_TRUE(std::is_sorted(thread_ids.begin(), thread_ids.end()));
+        EXPECT_EQ(std::adjacent_find(thread_ids.begin(), thread_ids.end()), thread_ids.end());
+        all.insert(all.end(), thread_ids.begin(), thread_ids.end());
+    }
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+}
+
+TEST(IdGeneratorTest, OrderManagerGeneratesOrderIds) {
+    OrderManager manager;
+    Order* first = manager.createOrderForCustomer("CUST001");
+    Order* second = manager.createOrderForCustomer("CUST001");
+
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(first->getOrderId().substr(0, 3), "ORD");
+    EXPECT_LT(first->getOrderId(), second->getOrderId());
+    EXPECT_EQ(manager.getTotalOrderCount(), 2u);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <stdexcept>
+#include "../../include/IdempotencyCache.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+TEST(IdempotencyCacheTest, RejectsInvalidConfiguration) {
+    EXPECT_THROW(IdempotencyCache(0), std::invalid_argument);
+    EXPECT_THROW(IdempotencyCache(10, milliseconds(0)), std::invalid_argument);
+}
+
+TEST(IdempotencyCacheTest, CompletedKeyReplaysResponse) {
+    IdempotencyCache cache;
+    IdempotentResponse response;
+
+    EXPECT_EQ(cache.begin("key-1", "body-a", response), IdempotencyOutcome::NEW);
+    EXPECT_EQ(cache.begin("key-1", "body-a", response), IdempotencyOutcome::IN_PROGRESS);
+
+    cache.complete("key-1", {201, "Created", "{\"order\":\"ORD1\"}"});
+    EXPECT_EQ(cache.begin("key-1", "body-a", response), IdempotencyOutcome::REPLAY);
+    EXPECT_EQ(response.status_code, 201);
+    EXPECT_EQ(response.body, "{\"order\":\"ORD1\"}");
+    EXPECT_EQ(cache.getReplayCount(), 1u);
+
+    EXPECT_EQ(cache.begin("key-1", "body-b", response), IdempotencyOutcome::MISMATCH);
+}
+
+TEST(IdempotencyCacheTest, AbandonedKeyCanBeRetried) {
+    IdempotencyCache cache;
+    IdempotentResponse response;
+
+    EXPECT_EQ(cache.begin("key-1", "body", response), IdempotencyOutcome::NEW);
+    cache.abandon("key-1");
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.begin("key-1", "body", response), IdempotencyOutcome::NEW);
+}
+
+TEST(IdempotencyCacheTest, KeysExpireAfterTtl) {
+    IdempotencyCache cache(100, milliseconds(20));
+    IdempotentResponse response;
+
+    EXPECT_EQ(cache.begin("key-1", "body", response), IdempotencyOutcome::NEW);
+    cache.complete("key-1", {201, "Created", "{}"});
+    std::this_thread::sleep_for(milliseconds(40));
+
+    EXPECT_EQ(cache.evictExpired(), 1u);
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.begin("key-1", "other body", response), IdempotencyOutcome::NEW);
+}
+
+TEST(IdempotencyCacheTest, CapacityEvictsOldestKeys) {
+    IdempotencyCache cache(4, hours(1), 1);
+    IdempotentResponse response;
+
+    for (int i = 0; i < 10; ++i) {
+        std::string key = "key-" + std::to_string(i);
+        ASSERT_EQ(cache.begin(key, "body", response), IdempotencyOutcome::NEW);
+        cache.complete(key, {201, "Created", key});
+    }
+
+    EXPECT_EQ(cache.size(), 4u);
+    EXPECT_EQ(cache.getEvictionCount(), 6u);
+    EXPECT_EQ(cache.begin("key-9", "body", response), IdempotencyOutcome::REPLAY);
+    EXPECT_EQ(cache.begin("key-0", "body", response), IdempotencyOutcome::NEW);
+}
+
+TEST(IdempotencyCacheTest, ConcurrentRetriesClaimKeyOnce) {
+    IdempotencyCache cache;
+    std::atomic<int> claimed{0};
+
+    std::vector<std::thread> clients;
+    for (int t = 0; t < 8; ++t) {
+        clients.emplace_back([&]() {
+            for (int i = 0; i < 1000; ++i) {
+                IdempotentResponse response;
+                if (cache.begin("key-" + std::to_string(i), "body", response) == IdempotencyOutcome::NEW) {
+                    claimed++;
+                    cache.complete("key-" + std::to_string(i), {201, "Created", "{}"});
+                }
+            }
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    EXPECT_EQ(claimed.load(), 1000);
+    EXPECT_EQ(cache.size(), 1000u);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include "../../include/OrderArchive.hpp"
+#include "../../include/Codec.hpp"
+#include "../../include/NotificationSystem.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+namespace {
+
+OrderRecord makeRecord(const std::string& id, const std::string& customer,
+                       const system_clock::time_point& date, OrderStatus status) {
+    OrderRecord record{id, customer, status, date, system_clock::time_point{}, {}, 0.0, ""};
+    record.items.emplace_back("MILK001", 2, 4.99);
+    record.items.back().category = "Dairy";
+    record.items.emplace_back("WIDGET", 1, 1.0 / 3.0);
+    record.total_amount = record.items[0].getTotalPrice() + record.items[1].getTotalPrice();
+    return record;
+}
+
+} // namespace
+
+TEST(CodecTest, VarintsRoundTripAndDetectTruncation) {
+    ByteWriter writer;
+    writer.putVarUInt(0);
+    writer.putVarUInt(300);
+    writer.putVarInt(-1);
+    writer.putVarInt(INT64_MIN);
+    writer.putString("hello");
+    writer.putDouble(2.5);
+
+    ByteReader reader(writer.getBuffer());
+    uint64_t u;
+    int64_t i;
+    std::string s;
+    double d;
+    ASSERT_TRUE(reader.getVarUInt(u)); EXPECT_EQ(u, 0u);
+    ASSERT_TRUE(reader.getVarUInt(u)); EXPECT_EQ(u, 300u);
+    ASSERT_TRUE(reader.getVarInt(i)); EXPECT_EQ(i, -1);
+    ASSERT_TRUE(reader.getVarInt(i)); EXPECT_EQ(i, INT64_MIN);
+    ASSERT_TRUE(reader.getString(s)); EXPECT_EQ(s, "hello");
+    ASSERT_TRUE(reader.getDouble(d)); EXPECT_EQ(d, 2.5);
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_FALSE(reader.getUInt8(*reinterpret_cast<uint8_t*>(&u)));
+
+    ByteReader truncated(writer.getBuffer().data(), 2);
+    ASSERT_TRUE(truncated.getVarUInt(u));
+    EXPECT_FALSE(truncated.getVarUInt(u));
+}
+
+TEST(OrderArchiveTest, RecordsRoundTripExactly) {
+    OrderArchive archive;
+    auto date = system_clock::time_point(hours(24 * 20000) + minutes(90));
+    OrderRecord record = makeRecord("ORD-2024-000001", "CUST001", date, OrderStatus::DELIVERED);
+    record.processed_date = date + seconds(3);
+    record.notes = "Left at door";
+    archive.archive({record});
+
+    OrderRecord found;
+    ASSERT_TRUE(archive.findOrder("ORD-2024-000001", found));
+    EXPECT_EQ(found.customer_id, "CUST001");
+    EXPECT_EQ(found.status, OrderStatus::DELIVERED);
+    EXPECT_EQ(found.order_date, date);
+    EXPECT_EQ(found.processed_date, date + seconds(3));
+    EXPECT_EQ(found.notes, "Left at door");
+    ASSERT_EQ(found.items.size(), 2u);
+    EXPECT_EQ(found.items[0].category, "Dairy");
+    EXPECT_EQ(found.items[0].unit_price, 4.99);
+    EXPECT_EQ(found.items[1].unit_price, 1.0 / 3.0);
+    EXPECT_EQ(found.total_amount, record.total_amount);
+    EXPECT_FALSE(archive.findOrder("ORD-2024-000002", found));
+}
+
+TEST(OrderArchiveTest, RangeAndCustomerQueriesAcrossSegments) {
+    OrderArchive archive;
+    auto base = system_clock::time_point(hours(24 * 20000));
+
+    std::vector<OrderRecord> first_batch;
+    for (int i = 0; i < 30; ++i) {
+        first_batch.push_back(makeRecord("ORD" + std::to_string(1000 + i), i % 3 == 0 ? "VIP" : "CUST",
+                                         base + hours(i * 4), OrderStatus::DELIVERED));
+    }
+    // Arrives out of order and lands on the first day again
+    std::vector<OrderRecord> second_batch = {
+        makeRecord("ORD2000", "VIP", base + minutes(30), OrderStatus::CANCELLED)
+    };
+
+    EXPECT_EQ(archive.archive(first_batch), 30u);
+    EXPECT_EQ(archive.archive(second_batch), 1u);
+    EXPECT_EQ(archive.size(), 31u);
+    EXPECT_EQ(archive.getSegmentCount(), 6u);
+
+    auto day_one = archive.getOrdersInDateRange(base, base + hours(23));
+    ASSERT_EQ(day_one.size(), 7u);
+    EXPECT_EQ(day_one[0].order_id, "ORD1000");
+    EXPECT_EQ(day_one[1].order_id, "ORD2000");
+    for (size_t i = 1; i < day_one.size(); ++i) {
+        EXPECT_LE(day_one[i - 1].order_date, day_one[i].order_date);
+    }
+
+    auto vip = archive.getOrdersByCustomer("VIP");
+    EXPECT_EQ(vip.size(), 11u);
+    EXPECT_TRUE(archive.getOrdersByCustomer("NOBODY").empty());
+}
+
+TEST(OrderArchiveTest, ClearedOrdersStayInReportsAndHistory) {
+    Inventory inventory;
+    inventory.addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 100,
+                                                             system_clock::now() + hours(24 * 30)));
+    OrderManager manager;
+
+    Order* delivered = manager.createOrder("ORD001", "CUST001");
+    delivered->addItem("MILK001", 4, 5.0);
+    ASSERT_TRUE(delivered->processOrder(inventory));
+    ASSERT_TRUE(delivered->updateStatus(OrderStatus::SHIPPED));
+    ASSERT_TRUE(delivered->updateStatus(OrderStatus::DELIVERED));
+
+    Order* pending = manager.createOrder("ORD002", "CUST001");
+    pending->addItem("MILK001", 1, 5.0);
+
+    EXPECT_EQ(manager.clearCompletedOrders(), 1);
+    EXPECT_EQ(manager.getTotalOrderCount(), 1u);
+    EXPECT_EQ(manager.getArchive().size(), 1u);
+
+    auto history = manager.getCustomerHistory("CUST001");
+    ASSERT_EQ(history.size(), 2u);
+    EXPECT_EQ(history[0].order_id, "ORD001");
+    EXPECT_EQ(history[0].status, OrderStatus::DELIVERED);
+    EXPECT_EQ(history[1].order_id, "ORD002");
+
+    auto now = system_clock::now();
+    SalesReport report(&manager, now - hours(1), now + hours(1), "tester");
+    std::string content = report.generate();
+    EXPECT_NE(content.find("Total Orders in Period: 2"), std::string::npos);
+    EXPECT_NE(content.find("Total Revenue: $20.00"), std::string::npos);
+}
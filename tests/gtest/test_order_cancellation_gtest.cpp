@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include "../../include/Order.hpp"
+#include "../../include/BackorderQueue.hpp"
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+// Test Fixture for Order Cancellation Tests
+class OrderCancellationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        inventory = std::make_unique<Inventory>();
+        order_manager = std::make_unique<OrderManager>(inventory.get());
+
+        auto expiry = system_clock::now() + hours(24 * 30);
+        inventory->addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 20, expiry));
+        inventory->addProduct(std::make_unique<PerishableProduct>("BREAD001", "Bread", "Bakery", 2.0, 30, expiry));
+    }
+
+    Order* placeOrder(const std::string& id, int milk, int bread, bool allow_backorder = false) {
+        Order* order = order_manager->createOrder(id, "CUST-" + id);
+        if (milk > 0) {
+            order->addItem("MILK001", milk, 5.0);
+        }
+        if (bread > 0) {
+            order->addItem("BREAD001", bread, 2.0);
+        }
+        EXPECT_TRUE(order->processOrder(*inventory, allow_backorder));
+        return order;
+    }
+
+    int quantity(const std::string& product_id) {
+        return inventory->getProduct(product_id)->getQuantity();
+    }
+
+    bool isLowStock(const std::string& product_id) {
+        for (const auto* product : inventory->getLowStockProducts()) {
+            if (product->getId() == product_id) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::unique_ptr<Inventory> inventory;
+    std::unique_ptr<OrderManager> order_manager;
+};
+
+TEST_F(OrderCancellationTest, CancellingConfirmedOrderRestocks) {
+    placeOrder("ORD001", 4, 6);
+    EXPECT_EQ(quantity("MILK001"), 16);
+
+    EXPECT_TRUE(order_manager->cancelOrder("ORD001", "Customer request"));
+    EXPECT_EQ(order_manager->getOrder("ORD001")->getStatus(), OrderStatus::CANCELLED);
+    EXPECT_EQ(order_manager->getOrder("ORD001")->getNotes(), "Customer request");
+    EXPECT_EQ(quantity("MILK001"), 20);
+    EXPECT_EQ(quantity("BREAD001"), 30);
+
+    // A second cancellation must not return the stock again
+    EXPECT_TRUE(order_manager->cancelOrder("ORD001"));
+    EXPECT_EQ(quantity("MILK001"), 20);
+    EXPECT_FALSE(order_manager->cancelOrder("MISSING"));
+}
+
+TEST_F(OrderCancellationTest, ShippedOrdersCannotBeCancelled) {
+    Order* order = placeOrder("ORD001", 4, 0);
+    ASSERT_TRUE(order->updateStatus(OrderStatus::SHIPPED));
+
+    EXPECT_FALSE(order_manager->cancelOrder("ORD001"));
+    EXPECT_EQ(quantity("MILK001"), 16);
+}
+
+TEST_F(OrderCancellationTest, BulkCancelReturnsSummedQuantities) {
+    placeOrder("ORD001", 3, 1);
+    placeOrder("ORD002", 5, 2);
+    Order* shipped = placeOrder("ORD003", 1, 1);
+    ASSERT_TRUE(shipped->updateStatus(OrderStatus::SHIPPED));
+    EXPECT_EQ(quantity("MILK001"), 11);
+    EXPECT_EQ(quantity("BREAD001"), 26);
+
+    size_t cancelled = order_manager->cancelOrders({"ORD001", "ORD002", "ORD003", "MISSING", "ORD001"}, "Bulk");
+    EXPECT_EQ(cancelled, 2u);
+    EXPECT_EQ(quantity("MILK001"), 19);
+    EXPECT_EQ(quantity("BREAD001"), 29);
+    EXPECT_EQ(shipped->getStatus(), OrderStatus::SHIPPED);
+}
+
+TEST_F(OrderCancellationTest, ReleaseClearsLowStockAlert) {
+    std::vector<std::string> alerts;
+    inventory->registerAlertCallback([&alerts](const std::string& alert) { alerts.push_back(alert); });
+
+    placeOrder("ORD001", 15, 0);
+    EXPECT_TRUE(isLowStock("MILK001"));
+    EXPECT_FALSE(isLowStock("BREAD001"));
+
+    EXPECT_EQ(order_manager->cancelOrders({"ORD001"}), 1u);
+    EXPECT_FALSE(isLowStock("MILK001"));
+    ASSERT_FALSE(alerts.empty());
+    EXPECT_NE(alerts.back().find("LOW STOCK CLEARED"), std::string::npos);
+    EXPECT_NE(alerts.back().find("MILK001"), std::string::npos);
+}
+
+TEST_F(OrderCancellationTest, LowStockSetFollowsThresholdChanges) {
+    placeOrder("ORD001", 12, 0);
+    EXPECT_TRUE(isLowStock("MILK001"));
+
+    inventory->setCategoryThreshold("Dairy", 5);
+    EXPECT_FALSE(isLowStock("MILK001"));
+
+    inventory->setCategoryThreshold("Dairy", 9);
+    EXPECT_TRUE(isLowStock("MILK001"));
+
+    inventory->removeProduct("MILK001");
+    EXPECT_TRUE(inventory->getLowStockProducts().empty());
+}
+
+TEST_F(OrderCancellationTest, CancelledBackorderReturnsOnlyAllocatedUnits) {
+    Order* order = placeOrder("ORD001", 25, 0, true);
+    ASSERT_EQ(order->getStatus(), OrderStatus::BACKORDERED);
+    EXPECT_EQ(quantity("MILK001"), 0);
+
+    EXPECT_EQ(order_manager->cancelOrders({"ORD001"}), 1u);
+    EXPECT_EQ(quantity("MILK001"), 20);
+    EXPECT_EQ(order_manager->getBackorders()->getWaitingOrderCount(), 0u);
+}
+
+TEST_F(OrderCancellationTest, CancellingDuringProcessingReturnsTakenStock) {
+    for (bool allow_backorder : {false, true}) {
+        Order* order = order_manager->createOrder(allow_backorder ? "ORD_BACKORDER" : "ORD_PLAIN", "CUST001");
+        order->addItem("MILK001", 5, 5.0);
+        order->addItem("BREAD001", 20, 2.0);
+
+        // Cancel once the order's stock has been taken, before it is confirmed
+        bool cancelled = false;
+        inventory->setChangeListener([&](const InventoryChange& change) {
+            if (!cancelled && change.kind == InventoryChange::Kind::PRODUCT && change.product->id == "BREAD001") {
+                cancelled = true;
+                EXPECT_TRUE(order->cancelOrder("Customer request"));
+            }
+        });
+        EXPECT_FALSE(order->processOrder(*inventory, allow_backorder));
+        inventory->setChangeListener(nullptr);
+
+        EXPECT_TRUE(cancelled);
+        EXPECT_EQ(order->getStatus(), OrderStatus::CANCELLED);
+        EXPECT_EQ(quantity("MILK001"), 20);
+        EXPECT_EQ(quantity("BREAD001"), 30);
+        EXPECT_EQ(order_manager->getBackorders()->getWaitingOrderCount(), 0u);
+    }
+}
+
+TEST(OrderCancellationManagerTest, ManagerWithoutInventoryDoesNotRestock) {
+    Inventory inventory;
+    OrderManager manager;
+    auto expiry = system_clock::now() + hours(24 * 30);
+    inventory.addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 10, expiry));
+
+    Order* order = manager.createOrder("ORD001", "CUST001");
+    order->addItem("MILK001", 4, 5.0);
+    ASSERT_TRUE(order->processOrder(inventory));
+
+    EXPECT_EQ(manager.cancelOrders({"ORD001"}), 1u);
+    EXPECT_EQ(order->getStatus(), OrderStatus::CANCELLED);
+    EXPECT_EQ(inventory.getProduct("MILK001")->getQuantity(), 6);
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include "../../include/OrderPipeline.hpp"
+#include "../../include/BoundedQueue.hpp"
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+TEST(BoundedQueueTest, FifoWithBackpressure) {
+    BoundedQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    int extra = 4;
+    EXPECT_FALSE(queue.tryPush(extra));
+    EXPECT_EQ(queue.sizeApprox(), 4u);
+
+    std::vector<int> out;
+    EXPECT_EQ(queue.popBatch(out, 3), 3u);
+    EXPECT_EQ(out, (std::vector<int>{0, 1, 2}));
+    int value = -1;
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(BoundedQueueTest, ConcurrentProducersAndConsumersLoseNothing) {
+    BoundedQueue<int> queue(64);
+    const int per_producer = 20000;
+    std::atomic<long long> sum{0};
+    std::atomic<int> popped{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < 4; ++p) {
+        threads.emplace_back([&, p]() {
+            for (int i = 1; i <= per_producer; ++i) {
+                int value = p * per_producer + i;
+                while (!queue.tryPush(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < 4; ++c) {
+        threads.emplace_back([&]() {
+            int value;
+            while (popped.load() < 4 * per_producer) {
+                if (queue.tryPop(value)) {
+                    sum += value;
+                    popped++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    long long n = 4LL * per_producer;
+    EXPECT_EQ(sum.load(), n * (n + 1) / 2);
+}
+
+// Test Fixture for batched reservation and the staged pipeline
+class OrderPipelineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        inventory = std::make_unique<Inventory>();
+        order_manager = std::make_unique<OrderManager>(inventory.get());
+
+        auto expiry = system_clock::now() + hours(24 * 30);
+        inventory->addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 150, expiry));
+        inventory->addProduct(std::make_unique<PerishableProduct>("BREAD001", "Bread", "Bakery", 2.0, 1000, expiry));
+    }
+
+    Order* createOrder(const std::string& id, const std::string& product_id, int quantity, double price) {
+        Order* order = order_manager->createOrder(id, "CUST-" + id);
+        order->addItem(product_id, quantity, price);
+        return order;
+    }
+
+    std::unique_ptr<Inventory> inventory;
+    std::unique_ptr<OrderManager> order_manager;
+};
+
+TEST_F(OrderPipelineTest, ReserveBatchIsAllOrNothingPerOrder) {
+    ASSERT_NE(inventory->placeHold("MILK001", 50, seconds(60)), 0u);
+
+    std::vector<bool> reserved;
+    size_t count = inventory->reserveBatch({
+        {{"MILK001", 60}, {"BREAD001", 10}},
+        {{"MILK001", 60}, {"BREAD001", 10}},    // Only 40 milk left unheld
+        {{"BREAD001", 5}, {"MISSING", 1}},
+        {{"BREAD001", 5}}
+    }, reserved);
+
+    EXPECT_EQ(count, 2u);
+    EXPECT_EQ(reserved, (std::vector<bool>{true, false, false, true}));
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 90);
+    EXPECT_EQ(inventory->getProduct("BREAD001")->getQuantity(), 985);
+}
+
+TEST_F(OrderPipelineTest, ProcessesOrdersInBatches) {
+    std::atomic<int> notified{0};
+    OrderPipelineConfig config;
+    config.flush_interval = milliseconds(50);
+    OrderPipeline pipeline(*inventory, config, [&notified](const std::vector<Order*>& orders) {
+        notified += static_cast<int>(orders.size());
+    });
+
+    for (int i = 0; i < 256; ++i) {
+        ASSERT_TRUE(pipeline.submit(createOrder("ORD" + std::to_string(i), "BREAD001", 2, 2.0)));
+    }
+    ASSERT_TRUE(pipeline.waitUntilIdle());
+
+    OrderPipelineStats stats = pipeline.getStats();
+    EXPECT_EQ(stats.submitted, 256u);
+    EXPECT_EQ(stats.confirmed, 256u);
+    EXPECT_EQ(stats.failed, 0u);
+    EXPECT_LE(stats.reserve_batches, 16u);
+    EXPECT_EQ(notified.load(), 256);
+    EXPECT_EQ(inventory->getProduct("BREAD001")->getQuantity(), 488);
+    EXPECT_EQ(order_manager->getOrdersByStatus(OrderStatus::CONFIRMED).size(), 256u);
+
+    // Confirmations still reach the manager's sales aggregates
+    auto now = system_clock::now();
+    EXPECT_EQ(order_manager->getSalesAggregator().query(now - hours(1), now + hours(1)).totals.orders, 256);
+}
+
+TEST_F(OrderPipelineTest, FailedOrdersAreNotifiedAsFailed) {
+    OrderPipeline pipeline(*inventory);
+
+    Order* too_big = createOrder("ORD001", "MILK001", 200, 5.0);
+    Order* unknown = createOrder("ORD002", "MISSING", 1, 1.0);
+    Order* fine = createOrder("ORD003", "MILK001", 100, 5.0);
+    ASSERT_TRUE(pipeline.submit(too_big));
+    ASSERT_TRUE(pipeline.submit(unknown));
+    ASSERT_TRUE(pipeline.submit(fine));
+    ASSERT_TRUE(pipeline.waitUntilIdle());
+
+    EXPECT_EQ(too_big->getStatus(), OrderStatus::FAILED);
+    EXPECT_EQ(unknown->getStatus(), OrderStatus::FAILED);
+    EXPECT_NE(unknown->getErrorMessage().find("Product not found"), std::string::npos);
+    EXPECT_EQ(fine->getStatus(), OrderStatus::CONFIRMED);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 50);
+    EXPECT_EQ(pipeline.getStats().failed, 2u);
+}
+
+TEST_F(OrderPipelineTest, DestructorDrainsSubmittedOrders) {
+    std::vector<Order*> orders;
+    {
+        OrderPipelineConfig config;
+        config.flush_interval = milliseconds(20);
+        OrderPipeline pipeline(*inventory, config);
+        for (int i = 0; i < 10; ++i) {
+            orders.push_back(createOrder("ORD" + std::to_string(i), "BREAD001", 1, 2.0));
+            ASSERT_TRUE(pipeline.submit(orders.back()));
+        }
+    }
+
+    for (const Order* order : orders) {
+        EXPECT_EQ(order->getStatus(), OrderStatus::CONFIRMED);
+    }
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include "../../include/OrderTimeIndex.hpp"
+#include "../../include/Order.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+// Test Fixture for OrderTimeIndex Tests
+class OrderTimeIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        base = system_clock::time_point(hours(24 * 20000));
+    }
+
+    Order* makeOrder(const std::string& id, const system_clock::time_point& date) {
+        orders.push_back(std::make_unique<Order>(id, "CUST001", date));
+        return orders.back().get();
+    }
+
+    system_clock::time_point base;
+    std::vector<std::unique_ptr<Order>> orders;
+};
+
+TEST_F(OrderTimeIndexTest, RangeReturnsMatchingWindowInDateOrder) {
+    OrderTimeIndex index(4);
+    for (int i = 0; i < 20; ++i) {
+        Order* order = makeOrder("ORD" + std::to_string(i), base + hours(i));
+        index.insert(order->getOrderDate(), order);
+    }
+
+    EXPECT_EQ(index.size(), 20u);
+    EXPECT_EQ(index.getSegmentCount(), 5u);
+
+    auto result = index.getRange(base + hours(5), base + hours(9));
+    ASSERT_EQ(result.size(), 5u);
+    for (size_t i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(result[i]->getOrderId(), "ORD" + std::to_string(5 + i));
+    }
+
+    EXPECT_TRUE(index.getRange(base - hours(10), base - hours(1)).empty());
+    EXPECT_TRUE(index.getRange(base + hours(9), base + hours(5)).empty());
+}
+
+TEST_F(OrderTimeIndexTest, OutOfOrderInsertsStaySorted) {
+    OrderTimeIndex index(2);
+    for (int i : {5, 1, 9, 3, 7, 0, 8, 2, 6, 4}) {
+        Order* order = makeOrder("ORD" + std::to_string(i), base + minutes(i));
+        index.insert(order->getOrderDate(), order);
+    }
+
+    auto result = index.getRange(system_clock::time_point::min(), system_clock::time_point::max());
+    ASSERT_EQ(result.size(), 10u);
+    for (size_t i = 1; i < result.size(); ++i) {
+        EXPECT_LE(result[i - 1]->getOrderDate(), result[i]->getOrderDate());
+    }
+}
+
+TEST_F(OrderTimeIndexTest, RemoveDropsOnlyThatOrder) {
+    OrderTimeIndex index(4);
+    Order* first = makeOrder("ORD001", base);
+    Order* same_time = makeOrder("ORD002", base);
+    index.insert(base, first);
+    index.insert(base, same_time);
+
+    EXPECT_TRUE(index.remove(base, first));
+    EXPECT_FALSE(index.remove(base, first));
+
+    auto result = index.getRange(base, base);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0], same_time);
+
+    EXPECT_TRUE(index.remove(base, same_time));
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_EQ(index.getSegmentCount(), 0u);
+}
+
+TEST(OrderManagerDateRangeTest, RangeQueryFollowsCreateAndRemove) {
+    OrderManager manager;
+    auto now = system_clock::now();
+
+    manager.createOrder("OLD001", "CUST001", now - hours(24 * 10));
+    manager.createOrder("NEW001", "CUST001", now - hours(1));
+    manager.createOrder("NEW002", "CUST002", now);
+
+    auto recent = manager.getOrdersInDateRange(now - hours(24), now);
+    ASSERT_EQ(recent.size(), 2u);
+    EXPECT_EQ(recent[0]->getOrderId(), "NEW001");
+    EXPECT_EQ(recent[1]->getOrderId(), "NEW002");
+
+    EXPECT_TRUE(manager.removeOrder("NEW001"));
+    recent = manager.getOrdersInDateRange(now - hours(24), now);
+    ASSERT_EQ(recent.size(), 1u);
+    EXPECT_EQ(recent[0]->getOrderId(), "NEW002");
+}
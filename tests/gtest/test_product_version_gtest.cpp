@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+#include "../../include/HTTPServer.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+// Test Fixture for Product Version Tests
+class ProductVersionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        inventory = std::make_unique<Inventory>();
+        auto expiry = system_clock::now() + hours(24 * 30);
+        inventory->addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 20, expiry));
+    }
+
+    uint64_t version() {
+        return inventory->getProduct("MILK001")->getVersion();
+    }
+
+    std::unique_ptr<Inventory> inventory;
+};
+
+TEST_F(ProductVersionTest, EveryChangeBumpsVersion) {
+    uint64_t initial = version();
+    EXPECT_EQ(initial, 1u);
+
+    inventory->removeQuantity("MILK001", 2);
+    uint64_t after_sale = version();
+    EXPECT_GT(after_sale, initial);
+
+    inventory->addQuantity("MILK001", 5);
+    EXPECT_GT(version(), after_sale);
+}
+
+TEST_F(ProductVersionTest, UpdateWithCurrentVersionSucceeds) {
+    ProductUpdate update;
+    update.name = "Organic Milk";
+    update.price = 6.5;
+
+    uint64_t new_version = 0;
+    EXPECT_EQ(inventory->updateProduct("MILK001", update, version(), new_version), ProductUpdateResult::UPDATED);
+
+    const Product* product = inventory->getProduct("MILK001");
+    EXPECT_EQ(product->getName(), "Organic Milk");
+    EXPECT_DOUBLE_EQ(product->getPrice(), 6.5);
+    EXPECT_EQ(product->getQuantity(), 20);
+    EXPECT_EQ(new_version, product->getVersion());
+    EXPECT_GT(new_version, 1u);
+}
+
+TEST_F(ProductVersionTest, StaleVersionIsRejectedWithoutChanges) {
+    uint64_t read_version = version();
+
+    ProductUpdate first;
+    first.price = 7.0;
+    uint64_t first_version = 0;
+    ASSERT_EQ(inventory->updateProduct("MILK001", first, read_version, first_version), ProductUpdateResult::UPDATED);
+
+    // A second editor based on the same read must not overwrite the first
+    ProductUpdate second;
+    second.price = 4.0;
+    second.name = "Cheap Milk";
+    uint64_t current = 0;
+    EXPECT_EQ(inventory->updateProduct("MILK001", second, read_version, current), ProductUpdateResult::VERSION_MISMATCH);
+    EXPECT_EQ(current, first_version);
+    EXPECT_DOUBLE_EQ(inventory->getProduct("MILK001")->getPrice(), 7.0);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getName(), "Fresh Milk");
+
+    // Retrying with the version it was told about succeeds
+    EXPECT_EQ(inventory->updateProduct("MILK001", second, current, current), ProductUpdateResult::UPDATED);
+    EXPECT_DOUBLE_EQ(inventory->getProduct("MILK001")->getPrice(), 4.0);
+}
+
+TEST_F(ProductVersionTest, ZeroExpectedVersionIsUnconditional) {
+    inventory->removeQuantity("MILK001", 1);
+
+    ProductUpdate update;
+    update.quantity = 50;
+    uint64_t new_version = 0;
+    EXPECT_EQ(inventory->updateProduct("MILK001", update, 0, new_version), ProductUpdateResult::UPDATED);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 50);
+}
+
+TEST_F(ProductVersionTest, InvalidOrMissingProductChangesNothing) {
+    uint64_t before = version();
+    uint64_t current = 0;
+
+    ProductUpdate bad;
+    bad.name = "Milk";
+    bad.price = -1.0;
+    EXPECT_EQ(inventory->updateProduct("MILK001", bad, before, current), ProductUpdateResult::INVALID);
+    EXPECT_EQ(version(), before);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getName(), "Fresh Milk");
+
+    ProductUpdate update;
+    update.price = 1.0;
+    EXPECT_EQ(inventory->updateProduct("NOPE", update, 0, current), ProductUpdateResult::NOT_FOUND);
+}
+
+TEST_F(ProductVersionTest, CategoryChangeMovesStockAndThreshold) {
+    inventory->setCategoryThreshold("Frozen", 25);
+
+    ProductUpdate update;
+    update.category = "Frozen";
+    uint64_t current = 0;
+    ASSERT_EQ(inventory->updateProduct("MILK001", update, 0, current), ProductUpdateResult::UPDATED);
+
+    EXPECT_EQ(inventory->getProductsByCategory("Frozen").size(), 1u);
+    EXPECT_TRUE(inventory->getProductsByCategory("Dairy").empty());
+
+    // 20 units is under the new category's threshold of 25
+    auto low_stock = inventory->getLowStockProducts();
+    ASSERT_EQ(low_stock.size(), 1u);
+    EXPECT_EQ(low_stock[0]->getId(), "MILK001");
+}
+
+TEST_F(ProductVersionTest, ConcurrentEditorsLoseNoUpdates) {
+    // Each editor adds 1 to the quantity with read-modify-CAS, retrying on conflict
+    const int editors = 4;
+    const int increments = 200;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < editors; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < increments; ++i) {
+                for (;;) {
+                    // Read the version first: the quantity read after it is at least as new
+                    const Product* product = inventory->getProduct("MILK001");
+                    uint64_t read_version = product->getVersion();
+                    int quantity = product->getQuantity();
+
+                    ProductUpdate update;
+                    update.quantity = quantity + 1;
+                    uint64_t current = 0;
+                    if (inventory->updateProduct("MILK001", update, read_version, current) ==
+                        ProductUpdateResult::UPDATED) {
+                        break;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 20 + editors * increments);
+    EXPECT_GE(version(), 1u + editors * increments);
+}
+
+TEST_F(ProductVersionTest, ProductResponsesMatchTheirETag) {
+    HTTPServer server("localhost", 8080);
+    server.setSystemComponents(inventory.get(), nullptr, nullptr, nullptr);
+    server.start();
+
+    // The body's version field must be the one the ETag names
+    auto etag_matches_body = [](const std::string& response) {
+        size_t etag = response.find("ETag: \"");
+        if (etag == std::string::npos) {
+            return false;
+        }
+        std::string tag = response.substr(etag + 7, response.find('"', etag + 7) - etag - 7);
+        return response.find("\"version\":" + tag + ",") != std::string::npos;
+    };
+
+    // Another editor renames the product right after the PUT's restock, before its response is built
+    bool renamed = false;
+    inventory->addRestockListener([&](const std::string&) {
+        if (!renamed) {
+            renamed = true;
+            ProductUpdate rename;
+            rename.name = "Renamed Milk";
+            uint64_t current = 0;
+            inventory->updateProduct("MILK001", rename, 0, current);
+        }
+    });
+
+    std::string body = "{\"quantity\":30}";
+    std::string put = server.handleRawRequest("PUT /api/products/MILK001 HTTP/1.1\r\nContent-Length: " +
+                                              std::to_string(body.size()) + "\r\n\r\n" + body);
+    ASSERT_TRUE(renamed);
+    EXPECT_EQ(put.substr(0, 12), "HTTP/1.1 200");
+    EXPECT_TRUE(etag_matches_body(put)) << put;
+    EXPECT_NE(put.find("\"name\":\"Fresh Milk\""), std::string::npos) << put;
+
+    std::string get = server.handleRawRequest("GET /api/products/MILK001 HTTP/1.1\r\n\r\n");
+    EXPECT_TRUE(etag_matches_body(get)) << get;
+    EXPECT_NE(get.find("\"name\":\"Renamed Milk\""), std::string::npos) << get;
+    server.stop();
+}
+
+TEST_F(ProductVersionTest, ProductListingEscapesIds) {
+    auto expiry = system_clock::now() + hours(24 * 30);
+    inventory->addProduct(std::make_unique<PerishableProduct>("ODD\"001", "Odd \"Item\"", "Misc", 1.0, 5, expiry));
+
+    HTTPServer server("localhost", 8080);
+    server.setSystemComponents(inventory.get(), nullptr, nullptr, nullptr);
+    server.start();
+
+    std::string listing = server.handleRawRequest("GET /api/products HTTP/1.1\r\n\r\n");
+    EXPECT_NE(listing.find("\"id\":\"ODD\\\"001\""), std::string::npos) << listing;
+    EXPECT_EQ(listing.find("\"id\":\"ODD\"001\""), std::string::npos) << listing;
+    server.stop();
+}
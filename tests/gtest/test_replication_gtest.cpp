@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+#include "../../include/Replication.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+// Test Fixture for Replication Tests (primary and followers over loopback)
+class ReplicationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        primary_inventory = std::make_unique<Inventory>();
+        auto expiry = system_clock::now() + hours(24 * 30);
+        primary_inventory->addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 20, expiry));
+        primary_inventory->addProduct(std::make_unique<PerishableProduct>("BREAD001", "Bread", "Bakery", 2.0, 30, expiry));
+    }
+
+    // Wait until the follower has loaded a snapshot and applied everything the primary logged so far
+    bool caughtUp(const ReplicationPrimary& primary, const ReplicationFollower& follower) {
+        auto deadline = steady_clock::now() + seconds(10);
+        while (follower.getStatus().snapshots_loaded == 0 && steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(milliseconds(5));
+        }
+        return follower.getStatus().snapshots_loaded > 0 && follower.waitForLsn(primary.getLastLsn(), seconds(10));
+    }
+
+    int quantityOf(Inventory& inventory, const std::string& product_id) {
+        const Product* product = inventory.getProduct(product_id);
+        return product ? product->getQuantity() : -1;
+    }
+
+    std::unique_ptr<Inventory> primary_inventory;
+};
+
+TEST_F(ReplicationTest, NewFollowerLoadsSnapshotThenStreams) {
+    ReplicationPrimary primary(*primary_inventory, 0);
+    ASSERT_TRUE(primary.start());
+    EXPECT_NE(primary.getPort(), 0);
+
+    Inventory replica;
+    ReplicationFollower follower(replica, "127.0.0.1", primary.getPort());
+    ASSERT_TRUE(follower.start());
+    ASSERT_TRUE(caughtUp(primary, follower));
+    EXPECT_EQ(quantityOf(replica, "MILK001"), 20);
+    EXPECT_EQ(quantityOf(replica, "BREAD001"), 30);
+
+    // Later changes stream across
+    auto expiry = system_clock::now() + hours(24);
+    primary_inventory->removeQuantity("MILK001", 5);
+    primary_inventory->addProduct(std::make_unique<PerishableProduct>("EGGS001", "Eggs", "Dairy", 3.0, 12, expiry));
+    primary_inventory->removeProduct("BREAD001");
+    primary_inventory->setCategoryThreshold("Dairy", 16);
+    ASSERT_TRUE(caughtUp(primary, follower));
+
+    EXPECT_EQ(quantityOf(replica, "MILK001"), 15);
+    EXPECT_EQ(quantityOf(replica, "EGGS001"), 12);
+    EXPECT_EQ(replica.getProduct("BREAD001"), nullptr);
+    EXPECT_EQ(replica.getLowStockProducts().size(), 2u);
+    EXPECT_DOUBLE_EQ(replica.getTotalValue(), primary_inventory->getTotalValue());
+
+    ReplicationStatus status = follower.getStatus();
+    EXPECT_TRUE(status.connected);
+    EXPECT_EQ(status.snapshots_loaded, 1u);
+    EXPECT_EQ(status.applied_lsn, primary.getLastLsn());
+    EXPECT_EQ(status.lag_changes, 0u);
+    EXPECT_GE(status.apply_delay_ms, 0.0);
+}
+
+TEST_F(ReplicationTest, ReplicaKeepsProductVersions) {
+    ReplicationPrimary primary(*primary_inventory, 0);
+    ASSERT_TRUE(primary.start());
+    Inventory replica;
+    ReplicationFollower follower(replica, "127.0.0.1", primary.getPort());
+    ASSERT_TRUE(follower.start());
+    ASSERT_TRUE(caughtUp(primary, follower));
+    const Product* original = replica.getProduct("MILK001");
+
+    ProductUpdate update;
+    update.name = "Whole Milk";
+    update.category = "Chilled";
+    uint64_t version = 0;
+    ASSERT_EQ(primary_inventory->updateProduct("MILK001", update, 0, version), ProductUpdateResult::UPDATED);
+    ASSERT_TRUE(caughtUp(primary, follower));
+
+    const Product* copy = replica.getProduct("MILK001");
+    ASSERT_NE(copy, nullptr);
+    EXPECT_EQ(copy->getName(), "Whole Milk");
+    EXPECT_EQ(copy->getCategory(), "Chilled");
+    EXPECT_EQ(copy->getVersion(), version);
+    EXPECT_EQ(copy, original);      // Updated in place, so earlier pointers stay valid
+}
+
+TEST_F(ReplicationTest, PrimaryReportsFollowerLag) {
+    ReplicationPrimary primary(*primary_inventory, 0);
+    ASSERT_TRUE(primary.start());
+    Inventory replica;
+    ReplicationFollower follower(replica, "127.0.0.1", primary.getPort());
+    ASSERT_TRUE(follower.start());
+
+    for (int i = 0; i < 10; ++i) {
+        primary_inventory->removeQuantity("BREAD001", 1);
+    }
+    ASSERT_TRUE(caughtUp(primary, follower));
+
+    // Acknowledgements follow the changes, so allow the primary a moment to take them in
+    std::vector<ReplicaStatus> replicas;
+    auto deadline = steady_clock::now() + seconds(10);
+    do {
+        std::this_thread::sleep_for(milliseconds(10));
+        replicas = primary.getReplicas();
+    } while (steady_clock::now() < deadline && (replicas.empty() || replicas[0].lag_changes != 0));
+
+    ASSERT_EQ(replicas.size(), 1u);
+    EXPECT_EQ(replicas[0].acked_lsn, primary.getLastLsn());
+    EXPECT_EQ(replicas[0].lag_changes, 0u);
+    EXPECT_EQ(replicas[0].snapshots_sent, 1u);
+}
+
+TEST_F(ReplicationTest, ReconnectingFollowerResumesFromLog) {
+    auto primary = std::make_unique<ReplicationPrimary>(*primary_inventory, 0);
+    ASSERT_TRUE(primary->start());
+    uint16_t port = primary->getPort();
+
+    Inventory replica;
+    ReplicationFollower follower(replica, "127.0.0.1", port);
+    ASSERT_TRUE(follower.start());
+    ASSERT_TRUE(caughtUp(*primary, follower));
+
+    // Changes made while the follower is cut off are sent from the log on reconnect
+    primary->stop();
+    primary_inventory->removeQuantity("MILK001", 3);
+    ASSERT_TRUE(primary->start());
+    EXPECT_EQ(primary->getPort(), port);
+    ASSERT_TRUE(caughtUp(*primary, follower));
+
+    EXPECT_EQ(quantityOf(replica, "MILK001"), 17);
+    ReplicationStatus status = follower.getStatus();
+    EXPECT_EQ(status.snapshots_loaded, 1u);
+    EXPECT_GE(status.reconnects, 1u);
+}
+
+TEST_F(ReplicationTest, FollowerBehindTheLogGetsNewSnapshot) {
+    auto primary = std::make_unique<ReplicationPrimary>(*primary_inventory, 0, "127.0.0.1", 4);
+    ASSERT_TRUE(primary->start());
+    uint16_t port = primary->getPort();
+
+    Inventory replica;
+    ReplicationFollower follower(replica, "127.0.0.1", port);
+    ASSERT_TRUE(follower.start());
+    ASSERT_TRUE(caughtUp(*primary, follower));
+
+    // More changes than the log keeps happen while the follower is away
+    primary->stop();
+    for (int i = 0; i < 10; ++i) {
+        primary_inventory->removeQuantity("MILK001", 1);
+    }
+    EXPECT_EQ(primary->getOldestLsn(), primary->getLastLsn() - 3);
+    ASSERT_TRUE(primary->start());
+    ASSERT_TRUE(caughtUp(*primary, follower));
+
+    EXPECT_EQ(quantityOf(replica, "MILK001"), 10);
+    EXPECT_EQ(follower.getStatus().snapshots_loaded, 2u);
+}
+
+TEST_F(ReplicationTest, SnapshotReplacesStaleReplicaState) {
+    // The replica starts with state of its own, e.g. from an earlier primary
+    Inventory replica(25);
+    auto expiry = system_clock::now() + hours(24);
+    replica.addProduct(std::make_unique<PerishableProduct>("OLD001", "Old", "Dairy", 1.0, 5, expiry));
+    replica.addProduct(std::make_unique<PerishableProduct>("MILK001", "Stale Milk", "Other", 9.0, 99, expiry));
+
+    primary_inventory->setCategoryThreshold("Bakery", 40);
+    ReplicationPrimary primary(*primary_inventory, 0);
+    ASSERT_TRUE(primary.start());
+    ReplicationFollower follower(replica, "127.0.0.1", primary.getPort());
+    ASSERT_TRUE(follower.start());
+    ASSERT_TRUE(caughtUp(primary, follower));
+
+    EXPECT_EQ(replica.getProduct("OLD001"), nullptr);
+    EXPECT_EQ(replica.getProduct("MILK001")->getName(), "Fresh Milk");
+    EXPECT_EQ(quantityOf(replica, "MILK001"), 20);
+    EXPECT_DOUBLE_EQ(replica.getValueByCategory()["Other"], 0.0);
+
+    // Thresholds come from the primary: default 10, Bakery 40
+    auto low_stock = replica.getLowStockProducts();
+    ASSERT_EQ(low_stock.size(), 1u);
+    EXPECT_EQ(low_stock[0]->getId(), "BREAD001");
+}
+
+TEST_F(ReplicationTest, InvalidArguments) {
+    EXPECT_THROW(ReplicationPrimary(*primary_inventory, 0, "127.0.0.1", 0), std::invalid_argument);
+
+    ReplicationPrimary unbindable(*primary_inventory, 0, "not-an-address");
+    EXPECT_FALSE(unbindable.start());
+
+    Inventory replica;
+    ReplicationFollower follower(replica, "localhost", 7070);
+    EXPECT_FALSE(follower.start());
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include "../../include/ReportWriter.hpp"
+#include "../../include/NotificationSystem.hpp"
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+// Test Fixture for ReportWriter Tests
+class ReportWriterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        filename = ::testing::TempDir() + "quirkventory_report_writer_test.out";
+    }
+
+    void TearDown() override {
+        std::remove(filename.c_str());
+    }
+
+    std::string readFile() const {
+        std::ifstream file(filename);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+
+    void writeSample(ReportFormat format) {
+        FileSink sink(16);  // Tiny buffer to exercise flushing
+        ASSERT_TRUE(sink.open(filename));
+        auto writer = ReportWriter::create(format, sink);
+        writer->beginReport("Sample", "tester", system_clock::time_point(seconds(1000)));
+        writer->beginSection("low_stock", {"id", "name", "quantity"});
+        writer->beginRow();
+        writer->addField("P1");
+        writer->addField("Milk, \"Fresh\"");
+        writer->addField(3);
+        writer->endRow();
+        writer->writeNote("done");
+        writer->endReport();
+        EXPECT_TRUE(sink.close());
+    }
+
+    std::string filename;
+};
+
+TEST_F(ReportWriterTest, CsvQuotesFieldsAndPrefixesSection) {
+    writeSample(ReportFormat::CSV);
+    std::string content = readFile();
+
+    EXPECT_NE(content.find("section,id,name,quantity\n"), std::string::npos);
+    EXPECT_NE(content.find("low_stock,P1,\"Milk, \"\"Fresh\"\"\",3\n"), std::string::npos);
+    EXPECT_NE(content.find("# done\n"), std::string::npos);
+}
+
+TEST_F(ReportWriterTest, JsonLinesWritesOneObjectPerRow) {
+    writeSample(ReportFormat::JSON_LINES);
+    std::string content = readFile();
+
+    EXPECT_NE(content.find("{\"section\":\"report\",\"title\":\"Sample\",\"generated_by\":\"tester\",\"generated\":1000}\n"),
+              std::string::npos);
+    EXPECT_NE(content.find("{\"section\":\"low_stock\",\"id\":\"P1\",\"name\":\"Milk, \\\"Fresh\\\"\",\"quantity\":3}\n"),
+              std::string::npos);
+    EXPECT_NE(content.find("{\"section\":\"low_stock\",\"note\":\"done\"}\n"), std::string::npos);
+}
+
+TEST_F(ReportWriterTest, TextUsesSectionHeadings) {
+    writeSample(ReportFormat::TEXT);
+    std::string content = readFile();
+
+    EXPECT_NE(content.find("Sample\n"), std::string::npos);
+    EXPECT_NE(content.find("LOW STOCK\n---------\nid | name | quantity\n"), std::string::npos);
+    EXPECT_NE(content.find("P1 | Milk, \"Fresh\" | 3\n"), std::string::npos);
+    EXPECT_NE(content.find("End of Report"), std::string::npos);
+}
+
+TEST_F(ReportWriterTest, OpenFailsForMissingDirectory) {
+    FileSink sink;
+    EXPECT_FALSE(sink.open("/nonexistent-directory/report.csv"));
+    EXPECT_FALSE(sink.isOpen());
+}
+
+TEST_F(ReportWriterTest, InventoryReportStreamsEveryProduct) {
+    Inventory inventory(10);
+    auto expiry = system_clock::now() + hours(24 * 30);
+    for (int i = 0; i < 10000; ++i) {
+        inventory.addProduct(std::make_unique<PerishableProduct>(
+            "P" + std::to_string(i), "Product " + std::to_string(i), "Dairy", 1.5, i % 20, expiry));
+    }
+
+    InventoryReport report(&inventory, "tester", true, true, true);
+    ASSERT_TRUE(report.exportToFile(filename, ReportFormat::CSV));
+    std::string content = readFile();
+
+    size_t product_rows = 0;
+    size_t low_stock_rows = 0;
+    std::istringstream lines(content);
+    std::string line;
+    while (std::getline(lines, line)) {
+        product_rows += line.rfind("products,P", 0) == 0 ? 1 : 0;
+        low_stock_rows += line.rfind("low_stock,P", 0) == 0 ? 1 : 0;
+    }
+    EXPECT_EQ(product_rows, 10000u);
+    EXPECT_EQ(low_stock_rows, 5000u);
+    EXPECT_NE(content.find("inventory_overview,total_products,10000\n"), std::string::npos);
+}
+
+TEST_F(ReportWriterTest, InventoryExportTotalsMatchListingDuringWrites) {
+    for (bool versioned : {false, true}) {
+        Inventory inventory(10);
+        if (versioned) {
+            inventory.enableVersioning();
+        }
+        auto expiry = system_clock::now() + hours(24 * 30);
+        for (int i = 0; i < 2000; ++i) {
+            inventory.addProduct(std::make_unique<PerishableProduct>(
+                "P" + std::to_string(i), "Product " + std::to_string(i), "Dairy", 1.0, 50, expiry));
+        }
+
+        std::atomic<bool> stop(false);
+        std::thread writer([&]() {
+            for (int round = 0; !stop.load(); ++round) {
+                inventory.updateQuantity("P" + std::to_string(round % 2000), round % 100);
+            }
+        });
+
+        InventoryReport report(&inventory, "tester", true, true, true);
+        bool exported = report.exportToFile(filename, ReportFormat::CSV);
+        stop.store(true);
+        writer.join();
+        ASSERT_TRUE(exported);
+
+        // products,<id>,<name>,<category>,<price>,<quantity>,<value>
+        long long listed_quantity = 0;
+        long long total_quantity = -1;
+        std::istringstream lines(readFile());
+        std::string line;
+        while (std::getline(lines, line)) {
+            std::vector<std::string> fields;
+            std::istringstream row(line);
+            for (std::string field; std::getline(row, field, ',');) {
+                fields.push_back(field);
+            }
+            if (fields.size() == 7 && fields[0] == "products") {
+                listed_quantity += std::stoll(fields[5]);
+            } else if (fields.size() == 3 && fields[0] == "inventory_overview" && fields[1] == "total_quantity") {
+                total_quantity = std::stoll(fields[2]);
+            }
+        }
+        EXPECT_EQ(listed_quantity, total_quantity) << (versioned ? "versioned" : "unversioned");
+    }
+}
+
+TEST_F(ReportWriterTest, ExportWithoutInventoryWritesNote) {
+    InventoryReport report(nullptr, "tester");
+    ASSERT_TRUE(report.exportToFile(filename));
+    EXPECT_NE(readFile().find("No inventory data available."), std::string::npos);
+}
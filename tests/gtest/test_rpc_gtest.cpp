@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <unistd.h>
+#include "../../include/Inventory.hpp"
+#include "../../include/Order.hpp"
+#include "../../include/Product.hpp"
+#include "../../include/Rpc.hpp"
+#include "../../include/Wire.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+// Test Fixture for RPC Tests (server and clients over loopback and a Unix domain socket)
+class RpcTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        inventory = std::make_unique<Inventory>();
+        auto expiry = system_clock::now() + hours(24 * 30);
+        inventory->addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 20, expiry));
+        inventory->addProduct(std::make_unique<PerishableProduct>("BREAD001", "Bread", "Bakery", 2.0, 30, expiry));
+        order_manager = std::make_unique<OrderManager>(inventory.get());
+        server = std::make_unique<RpcServer>(*inventory, *order_manager);
+        ASSERT_TRUE(server->start(0));
+        ASSERT_TRUE(client.connect("127.0.0.1", server->getPort()));
+    }
+
+    void TearDown() override {
+        client.close();
+        server->stop();
+    }
+
+    std::unique_ptr<Inventory> inventory;
+    std::unique_ptr<OrderManager> order_manager;
+    std::unique_ptr<RpcServer> server;
+    RpcClient client;
+};
+
+TEST_F(RpcTest, ProductLookupReportsStateAndAvailability) {
+    RpcProduct product;
+    ASSERT_EQ(client.getProduct("MILK001", product), RpcStatus::OK);
+    EXPECT_EQ(product.state.id, "MILK001");
+    EXPECT_EQ(product.state.name, "Fresh Milk");
+    EXPECT_EQ(product.state.category, "Dairy");
+    EXPECT_DOUBLE_EQ(product.state.price, 5.0);
+    EXPECT_EQ(product.state.quantity, 20);
+    EXPECT_EQ(product.available_quantity, 20);
+
+    inventory->placeHold("MILK001", 5, seconds(60));
+    ASSERT_EQ(client.getProduct("MILK001", product), RpcStatus::OK);
+    EXPECT_EQ(product.state.quantity, 20);
+    EXPECT_EQ(product.available_quantity, 15);
+
+    EXPECT_EQ(client.getProduct("MISSING", product), RpcStatus::NOT_FOUND);
+}
+
+TEST_F(RpcTest, ReserveConfirmAndRelease) {
+    uint64_t first = 0;
+    uint64_t second = 0;
+    ASSERT_EQ(client.reserve("MILK001", 8, seconds(60), first), RpcStatus::OK);
+    ASSERT_EQ(client.reserve("MILK001", 7, seconds(60), second), RpcStatus::OK);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(inventory->getAvailableQuantity("MILK001"), 5);
+
+    uint64_t refused = 0;
+    EXPECT_EQ(client.reserve("MILK001", 6, seconds(60), refused), RpcStatus::REJECTED);
+    EXPECT_EQ(client.reserve("MISSING", 1, seconds(60), refused), RpcStatus::NOT_FOUND);
+    EXPECT_EQ(client.reserve("MILK001", 0, seconds(60), refused), RpcStatus::BAD_REQUEST);
+    EXPECT_EQ(client.reserve("MILK001", 1, milliseconds(0), refused), RpcStatus::BAD_REQUEST);
+    EXPECT_EQ(client.reserve("MILK001", 1, RpcServer::MAX_HOLD_TTL + milliseconds(1), refused),
+              RpcStatus::BAD_REQUEST);
+    EXPECT_EQ(client.reserve("MILK001", 1, hours(24 * 365 * 1000), refused), RpcStatus::BAD_REQUEST);
+
+    EXPECT_EQ(inventory->getHoldCount(), 2u);
+
+    EXPECT_EQ(client.confirm(first), RpcStatus::OK);
+    EXPECT_EQ(client.release(second), RpcStatus::OK);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 12);
+    EXPECT_EQ(inventory->getAvailableQuantity("MILK001"), 12);
+
+    EXPECT_EQ(client.confirm(first), RpcStatus::NOT_FOUND);
+    EXPECT_EQ(client.release(second), RpcStatus::NOT_FOUND);
+}
+
+TEST_F(RpcTest, OrdersAreCreatedAndProcessed) {
+    RpcOrder order;
+    ASSERT_EQ(client.createOrder("CUST001", {{"MILK001", 2}, {"BREAD001", 3}}, order), RpcStatus::OK);
+    EXPECT_FALSE(order.order_id.empty());
+    EXPECT_EQ(order.status, OrderStatus::CONFIRMED);
+    EXPECT_DOUBLE_EQ(order.total_amount, 16.0);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 18);
+    EXPECT_NE(order_manager->getOrder(order.order_id), nullptr);
+
+    // Created pending, processed later
+    RpcOrder pending;
+    ASSERT_EQ(client.createOrder("CUST002", {{"BREAD001", 1}}, pending, false), RpcStatus::OK);
+    EXPECT_EQ(pending.status, OrderStatus::PENDING);
+    EXPECT_EQ(inventory->getProduct("BREAD001")->getQuantity(), 27);
+    ASSERT_EQ(client.processOrder(pending.order_id, pending), RpcStatus::OK);
+    EXPECT_EQ(pending.status, OrderStatus::CONFIRMED);
+    EXPECT_EQ(inventory->getProduct("BREAD001")->getQuantity(), 26);
+
+    RpcBatch batch;
+    size_t short_stock = batch.createOrder("CUST003", {{"MILK001", 100}});
+    size_t unknown_product = batch.createOrder("CUST003", {{"MISSING", 1}});
+    size_t no_items = batch.createOrder("CUST003", {});
+    size_t unknown_order = batch.processOrder("ORD-MISSING");
+    ASSERT_TRUE(client.execute(batch));
+    EXPECT_EQ(batch.result(short_stock).status, RpcStatus::REJECTED);
+    EXPECT_NE(batch.result(short_stock).error.find("failed"), std::string::npos);
+    EXPECT_EQ(batch.result(unknown_product).status, RpcStatus::NOT_FOUND);
+    EXPECT_EQ(batch.result(no_items).status, RpcStatus::BAD_REQUEST);
+    EXPECT_EQ(batch.result(unknown_order).status, RpcStatus::NOT_FOUND);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 18);
+}
+
+TEST_F(RpcTest, PipelinedBatchIsAnsweredInOrderWithFewWrites) {
+    RpcBatch batch;
+    for (int i = 0; i < 100; ++i) {
+        batch.getProduct(i % 2 ? "MILK001" : "BREAD001");
+    }
+    size_t hold = batch.reserve("MILK001", 4, seconds(60));
+    size_t missing = batch.getProduct("MISSING");
+
+    uint64_t writes_before = server->getWriteCount();
+    ASSERT_TRUE(client.execute(batch));
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(batch.result(i).status, RpcStatus::OK);
+        EXPECT_EQ(batch.result(i).product.state.id, i % 2 ? "MILK001" : "BREAD001");
+    }
+    EXPECT_EQ(batch.result(hold).status, RpcStatus::OK);
+    EXPECT_NE(batch.result(hold).hold_id, 0u);
+    EXPECT_EQ(batch.result(missing).status, RpcStatus::NOT_FOUND);
+
+    EXPECT_EQ(server->getRequestCount(), 102u);
+    EXPECT_LT(server->getWriteCount() - writes_before, 102u);
+
+    // A cleared batch is reused for the next round trip
+    uint64_t hold_id = batch.result(hold).hold_id;
+    batch.clear();
+    batch.release(hold_id);
+    ASSERT_TRUE(client.execute(batch));
+    EXPECT_EQ(batch.result(0).status, RpcStatus::OK);
+}
+
+TEST_F(RpcTest, UnixDomainSocketServesTheSameProtocol) {
+    std::string path = "/tmp/quirkventory_rpc_test_" + std::to_string(::getpid()) + ".sock";
+    RpcServer unix_server(*inventory, *order_manager);
+    ASSERT_TRUE(unix_server.startUnix(path));
+    EXPECT_EQ(unix_server.getPort(), 0);
+
+    RpcClient unix_client;
+    ASSERT_TRUE(unix_client.connectUnix(path));
+    RpcProduct product;
+    ASSERT_EQ(unix_client.getProduct("BREAD001", product), RpcStatus::OK);
+    EXPECT_EQ(product.state.quantity, 30);
+
+    unix_client.close();
+    unix_server.stop();
+    EXPECT_NE(::access(path.c_str(), F_OK), 0);
+    EXPECT_FALSE(unix_client.connectUnix(path));
+}
+
+TEST_F(RpcTest, BadRequestsAndLostConnections) {
+    // Unknown request types get an error reply, not a dropped connection
+    int fd = Wire::connectTcp("127.0.0.1", server->getPort());
+    ASSERT_GE(fd, 0);
+    ByteWriter request;
+    request.putVarUInt(7);
+    ASSERT_TRUE(Wire::sendMessage(fd, 200, request));
+    uint8_t type;
+    std::vector<uint8_t> reply;
+    ASSERT_EQ(Wire::receiveMessage(fd, seconds(2), type, reply), Wire::ReceiveResult::MESSAGE);
+    EXPECT_EQ(type, 200);
+    ASSERT_GE(reply.size(), 2u);
+    EXPECT_EQ(reply[0], 7);
+    EXPECT_EQ(reply[1], static_cast<uint8_t>(RpcStatus::BAD_REQUEST));
+    Wire::closeSocket(fd);
+
+    // Once the server goes away calls fail instead of hanging
+    server->stop();
+    RpcProduct product;
+    EXPECT_EQ(client.getProduct("MILK001", product), RpcStatus::UNAVAILABLE);
+    EXPECT_FALSE(client.isConnected());
+
+    RpcClient unconnected;
+    RpcBatch batch;
+    batch.getProduct("MILK001");
+    EXPECT_FALSE(unconnected.execute(batch));
+    EXPECT_EQ(batch.result(0).status, RpcStatus::UNAVAILABLE);
+}
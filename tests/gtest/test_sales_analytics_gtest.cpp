@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include "../../include/SalesAnalytics.hpp"
+#include "../../include/Order.hpp"
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+#include "../../include/NotificationSystem.hpp"
+#include "../../include/HTTPServer.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+// Test Fixture for Sales Analytics Tests
+class SalesAnalyticsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        inventory = std::make_unique<Inventory>();
+        order_manager = std::make_unique<OrderManager>();
+
+        auto expiry = system_clock::now() + hours(24 * 30);
+        inventory->addProduct(std::make_unique<PerishableProduct>("LAPTOP001", "Gaming Laptop", "Electronics", 1000.0, 50, expiry));
+        inventory->addProduct(std::make_unique<PerishableProduct>("MOUSE001", "Wireless Mouse", "Electronics", 50.0, 100, expiry));
+        inventory->addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 100, expiry));
+    }
+
+    Order* createConfirmedOrder(const std::string& id, const std::string& product_id, int quantity, double price) {
+        Order* order = order_manager->createOrder(id, "CUST-" + id);
+        order->addItem(product_id, quantity, price);
+        EXPECT_TRUE(order->processOrder(*inventory));
+        return order;
+    }
+
+    std::unique_ptr<Inventory> inventory;
+    std::unique_ptr<OrderManager> order_manager;
+};
+
+TEST_F(SalesAnalyticsTest, ConfirmedOrdersAreAggregated) {
+    createConfirmedOrder("ORD001", "LAPTOP001", 2, 1000.0);
+    createConfirmedOrder("ORD002", "MILK001", 4, 5.0);
+
+    auto now = system_clock::now();
+    SalesBucket sales = order_manager->getSalesAggregator().query(now - hours(1), now + hours(1));
+
+    EXPECT_EQ(sales.totals.orders, 2);
+    EXPECT_EQ(sales.totals.units, 6);
+    EXPECT_DOUBLE_EQ(sales.totals.revenue, 2020.0);
+    EXPECT_DOUBLE_EQ(sales.by_category["Electronics"].revenue, 2000.0);
+    EXPECT_DOUBLE_EQ(sales.by_category["Dairy"].revenue, 20.0);
+    EXPECT_EQ(sales.by_product["MILK001"].units, 4);
+}
+
+TEST_F(SalesAnalyticsTest, PendingAndFailedOrdersAreNotAggregated) {
+    Order* pending = order_manager->createOrder("ORD001", "CUST001");
+    pending->addItem("LAPTOP001", 1, 1000.0);
+
+    Order* failed = order_manager->createOrder("ORD002", "CUST002");
+    failed->addItem("LAPTOP001", 500, 1000.0);
+    EXPECT_FALSE(failed->processOrder(*inventory));
+
+    auto now = system_clock::now();
+    SalesBucket sales = order_manager->getSalesAggregator().query(now - hours(1), now + hours(1));
+    EXPECT_EQ(sales.totals.orders, 0);
+}
+
+TEST_F(SalesAnalyticsTest, CancellingConfirmedOrderReversesAggregates) {
+    createConfirmedOrder("ORD001", "LAPTOP001", 1, 1000.0);
+    Order* cancelled = createConfirmedOrder("ORD002", "MOUSE001", 3, 50.0);
+
+    EXPECT_TRUE(cancelled->cancelOrder("Customer request"));
+
+    auto now = system_clock::now();
+    SalesBucket sales = order_manager->getSalesAggregator().query(now - hours(1), now + hours(1));
+    EXPECT_EQ(sales.totals.orders, 1);
+    EXPECT_DOUBLE_EQ(sales.totals.revenue, 1000.0);
+    EXPECT_EQ(sales.by_product.count("MOUSE001"), 0u);
+}
+
+TEST(OrderStatusNotificationTest, ConcurrentChangesReachListenerInOrder) {
+    Order order("ORD001", "CUST001");
+    std::vector<OrderStatus> delivered;
+    order.setStatusListener([&](const Order&, OrderStatus, OrderStatus new_status, StockReleases*) {
+        if (new_status == OrderStatus::CONFIRMED) {
+            // Cancel on another thread while the confirmation is still being delivered
+            std::thread([&order]() { EXPECT_TRUE(order.cancelOrder("Customer request")); }).join();
+        }
+        delivered.push_back(new_status);
+    });
+
+    ASSERT_TRUE(order.updateStatus(OrderStatus::PROCESSING));
+    ASSERT_TRUE(order.updateStatus(OrderStatus::CONFIRMED));
+
+    std::vector<OrderStatus> expected = {OrderStatus::PROCESSING, OrderStatus::CONFIRMED, OrderStatus::CANCELLED};
+    EXPECT_EQ(delivered, expected);
+}
+
+TEST_F(SalesAnalyticsTest, InterleavedConfirmAndCancelLeaveNoRevenue) {
+    std::vector<Order*> orders;
+    for (int i = 0; i < 500; ++i) {
+        Order* order = order_manager->createOrder("RACE" + std::to_string(i), "CUST001");
+        order->addItem("MILK001", 1, 5.0);
+        ASSERT_TRUE(order->updateStatus(OrderStatus::PROCESSING));
+        orders.push_back(order);
+    }
+
+    std::thread confirmer([&]() {
+        for (Order* order : orders) {
+            order->updateStatus(OrderStatus::CONFIRMED);
+        }
+    });
+    std::thread canceller([&]() {
+        for (Order* order : orders) {
+            EXPECT_TRUE(order->cancelOrder("Customer request"));
+        }
+    });
+    confirmer.join();
+    canceller.join();
+
+    auto now = system_clock::now();
+    SalesBucket sales = order_manager->getSalesAggregator().query(now - hours(1), now + hours(1));
+    EXPECT_EQ(sales.totals.orders, 0);
+    EXPECT_DOUBLE_EQ(sales.totals.revenue, 0.0);
+    EXPECT_EQ(order_manager->getSalesAggregator().getBucketCount(BucketGranularity::HOUR), 0u);
+}
+
+TEST_F(SalesAnalyticsTest, RangeOutsideOrdersIsEmpty) {
+    createConfirmedOrder("ORD001", "LAPTOP001", 1, 1000.0);
+
+    auto now = system_clock::now();
+    SalesBucket sales = order_manager->getSalesAggregator().query(now - hours(24 * 30), now - hours(24 * 2));
+    EXPECT_EQ(sales.totals.orders, 0);
+}
+
+TEST_F(SalesAnalyticsTest, LongRangeUsesCoarseBucketsWithSameResult) {
+    createConfirmedOrder("ORD001", "LAPTOP001", 1, 1000.0);
+    createConfirmedOrder("ORD002", "MILK001", 10, 5.0);
+
+    auto now = system_clock::now();
+    const SalesAggregator& aggregator = order_manager->getSalesAggregator();
+    SalesBucket narrow = aggregator.query(now - hours(1), now + hours(1));
+    SalesBucket wide = aggregator.query(now - hours(24 * 365), now + hours(24 * 365));
+
+    EXPECT_EQ(wide.totals.orders, narrow.totals.orders);
+    EXPECT_DOUBLE_EQ(wide.totals.revenue, narrow.totals.revenue);
+    EXPECT_EQ(aggregator.getBucketCount(BucketGranularity::HOUR), 1u);
+    EXPECT_EQ(aggregator.getBucketCount(BucketGranularity::WEEK), 1u);
+}
+
+TEST_F(SalesAnalyticsTest, TimeSeriesReportsBucketStarts) {
+    createConfirmedOrder("ORD001", "LAPTOP001", 1, 1000.0);
+
+    auto now = system_clock::now();
+    auto series = order_manager->getSalesAggregator().getTimeSeries(now - hours(48), now, BucketGranularity::DAY);
+
+    ASSERT_EQ(series.size(), 1u);
+    EXPECT_LE(series[0].first, now);
+    EXPECT_GT(series[0].first + hours(24), now);
+    EXPECT_DOUBLE_EQ(series[0].second.revenue, 1000.0);
+}
+
+TEST(SalesAggregatorTest, WeeksStartOnMonday) {
+    // 1970-01-05 was a Monday
+    auto monday = system_clock::time_point(hours(24 * 4));
+    auto sunday = monday - seconds(1);
+
+    EXPECT_EQ(SalesAggregator::bucketIndex(monday, BucketGranularity::WEEK), 1);
+    EXPECT_EQ(SalesAggregator::bucketIndex(sunday, BucketGranularity::WEEK), 0);
+    EXPECT_EQ(SalesAggregator::bucketStart(1, BucketGranularity::WEEK), monday);
+}
+
+TEST_F(SalesAnalyticsTest, SalesReportIncludesRevenueBreakdown) {
+    createConfirmedOrder("ORD001", "LAPTOP001", 1, 1000.0);
+
+    auto now = system_clock::now();
+    SalesReport report(order_manager.get(), now - hours(24), now + hours(1), "tester");
+    std::string content = report.generate();
+
+    EXPECT_NE(content.find("Confirmed Revenue: $1000.00"), std::string::npos);
+    EXPECT_NE(content.find("- Electronics: $1000.00"), std::string::npos);
+    EXPECT_NE(content.find("- LAPTOP001: $1000.00"), std::string::npos);
+}
+
+TEST_F(SalesAnalyticsTest, SalesReportNamesTopCustomer) {
+    for (int i = 0; i < 3; ++i) {
+        Order* order = order_manager->createOrder("ORD00" + std::to_string(i), i == 0 ? "CUST_BIG" : "CUST_SMALL");
+        order->addItem(i == 0 ? "LAPTOP001" : "MOUSE001", 1, i == 0 ? 1000.0 : 50.0);
+        ASSERT_TRUE(order->processOrder(*inventory));
+    }
+
+    auto now = system_clock::now();
+    SalesReport report(order_manager.get(), now - hours(24), now + hours(1), "tester");
+    EXPECT_NE(report.generate().find("Top Customer by Revenue: CUST_BIG ($1000.00)"), std::string::npos);
+}
+
+TEST_F(SalesAnalyticsTest, DatesBeyondTheClockRangeAreRejected) {
+    HTTPServer server("localhost", 8080);
+    server.setSystemComponents(inventory.get(), order_manager.get(), nullptr, nullptr);
+    server.start();
+
+    auto status = [&](const std::string& query) {
+        return server.handleRawRequest("GET /api/charts/sales?" + query + " HTTP/1.1\r\n\r\n").substr(0, 12);
+    };
+    EXPECT_EQ(status("from=1700000000&to=1700086400"), "HTTP/1.1 200");
+    EXPECT_EQ(status("from=2200-01-01"), "HTTP/1.1 200");
+
+    // Past the 64-bit tick range of a nanosecond system_clock (about +/-292 years from 1970)
+    if (duration_cast<seconds>(system_clock::duration::max()).count() < 253402300799LL) {
+        EXPECT_EQ(status("from=999999999999"), "HTTP/1.1 400");
+        EXPECT_EQ(status("to=-999999999999"), "HTTP/1.1 400");
+        EXPECT_EQ(status("to=9999-12-31"), "HTTP/1.1 400");
+        EXPECT_EQ(status("from=0001-01-01"), "HTTP/1.1 400");
+    }
+    server.stop();
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <stdexcept>
+#include "../../include/Scheduler.hpp"
+#include "../../include/ThreadPool.hpp"
+#include "../../include/Inventory.hpp"
+#include "../../include/Order.hpp"
+#include "../../include/NotificationSystem.hpp"
+#include "../../include/OrderArchive.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+// Test Fixture for Scheduler Tests
+class SchedulerTest : public ::testing::Test {
+protected:
+    SchedulerTest() : pool(2), scheduler(&pool, milliseconds(2)) {}
+
+    // Wait until a job has completed at least `runs` runs
+    bool waitForRuns(const std::string& name, uint64_t runs, milliseconds timeout = milliseconds(2000)) {
+        auto deadline = steady_clock::now() + timeout;
+        JobStats stats;
+        while (steady_clock::now() < deadline) {
+            if (scheduler.getJobStats(name, stats) && stats.runs >= runs) {
+                return true;
+            }
+            std::this_thread::sleep_for(milliseconds(2));
+        }
+        return false;
+    }
+
+    ThreadPool pool;
+    Scheduler scheduler;
+};
+
+TEST_F(SchedulerTest, RecurringJobRunsRepeatedly) {
+    std::atomic<int> count{0};
+    ASSERT_TRUE(scheduler.addJob("counter", milliseconds(10), [&count]() { count++; }));
+    EXPECT_FALSE(scheduler.addJob("counter", milliseconds(10), [&count]() { count++; }));
+    EXPECT_FALSE(scheduler.addJob("zero", milliseconds(0), []() {}));
+
+    ASSERT_TRUE(scheduler.start());
+    EXPECT_FALSE(scheduler.start());
+    ASSERT_TRUE(waitForRuns("counter", 3));
+    scheduler.stop();
+
+    JobStats stats;
+    ASSERT_TRUE(scheduler.getJobStats("counter", stats));
+    EXPECT_EQ(stats.runs, static_cast<uint64_t>(count.load()));
+    EXPECT_EQ(stats.failures, 0u);
+    EXPECT_GE(stats.max_duration, stats.last_duration);
+    EXPECT_NE(stats.last_run, system_clock::time_point{});
+}
+
+TEST_F(SchedulerTest, SlowJobNeverOverlapsItself) {
+    std::atomic<int> active{0};
+    std::atomic<int> max_active{0};
+    ASSERT_TRUE(scheduler.addJob("slow", milliseconds(4), [&]() {
+        int now_active = ++active;
+        int expected = max_active.load();
+        while (now_active > expected && !max_active.compare_exchange_weak(expected, now_active)) {
+        }
+        std::this_thread::sleep_for(milliseconds(30));
+        --active;
+    }, 0.0));
+
+    scheduler.start();
+    ASSERT_TRUE(waitForRuns("slow", 3));
+    scheduler.stop();
+
+    JobStats stats;
+    ASSERT_TRUE(scheduler.getJobStats("slow", stats));
+    EXPECT_EQ(max_active.load(), 1);
+    EXPECT_GT(stats.skipped, 0u);
+    EXPECT_GE(stats.max_duration, microseconds(30000));
+}
+
+TEST_F(SchedulerTest, ThrowingJobIsCountedAndKeepsRunning) {
+    ASSERT_TRUE(scheduler.addJob("failing", milliseconds(5), []() {
+        throw std::runtime_error("boom");
+    }));
+
+    scheduler.start();
+    ASSERT_TRUE(waitForRuns("failing", 2));
+    scheduler.stop();
+
+    JobStats stats;
+    ASSERT_TRUE(scheduler.getJobStats("failing", stats));
+    EXPECT_EQ(stats.failures, stats.runs);
+}
+
+TEST_F(SchedulerTest, RemovedJobStopsFiring) {
+    std::atomic<int> count{0};
+    ASSERT_TRUE(scheduler.addJob("temp", milliseconds(5), [&count]() { count++; }));
+
+    scheduler.start();
+    ASSERT_TRUE(waitForRuns("temp", 1));
+    EXPECT_TRUE(scheduler.removeJob("temp"));
+    EXPECT_FALSE(scheduler.removeJob("temp"));
+
+    std::this_thread::sleep_for(milliseconds(20));
+    int after_remove = count.load();
+    std::this_thread::sleep_for(milliseconds(40));
+    scheduler.stop();
+
+    EXPECT_EQ(count.load(), after_remove);
+    EXPECT_FALSE(scheduler.hasJob("temp"));
+}
+
+TEST_F(SchedulerTest, RunNowDispatchesWithoutTimer) {
+    std::atomic<int> count{0};
+    ASSERT_TRUE(scheduler.addJob("manual", hours(1), [&count]() { count++; }));
+
+    EXPECT_TRUE(scheduler.runNow("manual"));
+    EXPECT_FALSE(scheduler.runNow("missing"));
+    ASSERT_TRUE(waitForRuns("manual", 1));
+    EXPECT_EQ(count.load(), 1);
+}
+
+TEST_F(SchedulerTest, InventoryMaintenanceExpiresHoldsAndClearsOrders) {
+    Inventory inventory;
+    OrderManager order_manager;
+    NotificationManager notifications;
+
+    inventory.addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 10,
+        system_clock::now() + hours(24 * 30)));
+    ASSERT_NE(inventory.placeHold("MILK001", 4, milliseconds(1)), 0u);
+
+    Order* order = order_manager.createOrder("ORD001", "CUST001");
+    order->addItem("MILK001", 1, 5.0);
+    ASSERT_TRUE(order->cancelOrder("test"));
+
+    MaintenanceSchedule schedule;
+    schedule.hold_expiry = milliseconds(5);
+    schedule.order_clearing = milliseconds(5);
+    EXPECT_EQ(scheduleInventoryMaintenance(scheduler, inventory, &order_manager, &notifications, schedule), 6);
+
+    scheduler.start();
+
+    // Holds expire on 100ms ticks; nothing but the scheduler calls expireHolds here
+    auto deadline = steady_clock::now() + seconds(2);
+    while (inventory.getHoldCount() > 0 && steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(milliseconds(5));
+    }
+    ASSERT_TRUE(waitForRuns("order-clearing", 1));
+    scheduler.stop();
+
+    EXPECT_EQ(inventory.getHoldCount(), 0u);
+    EXPECT_EQ(inventory.getAvailableQuantity("MILK001"), 10);
+    EXPECT_EQ(order_manager.getOrder("ORD001"), nullptr);
+    EXPECT_EQ(order_manager.getArchive().size(), 1u);
+}
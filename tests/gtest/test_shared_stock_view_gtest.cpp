@@ -0,0 +1,357 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+#include "../../include/SharedStockView.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+namespace {
+
+std::vector<std::string>& usedNames() {
+    static std::vector<std::string> names;
+    return names;
+}
+
+std::string segmentName(const std::string& suffix) {
+    std::string name = "/quirkventory_test_" + std::to_string(::getpid()) + "_" + suffix;
+    usedNames().push_back(name);
+    return name;
+}
+
+// Writers leave their lock objects behind on purpose; remove the ones these tests made
+class LockCleanup : public ::testing::Environment {
+public:
+    void TearDown() override {
+        for (const auto& name : usedNames()) {
+            ::shm_unlink((name + SharedStockWriter::LOCK_SUFFIX).c_str());
+        }
+    }
+};
+
+const ::testing::Environment* const kLockCleanup = ::testing::AddGlobalTestEnvironment(new LockCleanup);
+
+} // namespace
+
+// Test Fixture for Shared Stock View Tests (an inventory publishing to a segment read in-process)
+class SharedStockViewTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        name = segmentName("inventory");
+        auto expiry = system_clock::now() + hours(24 * 30);
+        inventory.addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 20, expiry));
+        inventory.addProduct(std::make_unique<PerishableProduct>("BREAD001", "Bread", "Bakery", 2.0, 30, expiry));
+        ASSERT_TRUE(inventory.publishSharedView(name, 64));
+        ASSERT_TRUE(reader.open(name));
+    }
+
+    void TearDown() override {
+        reader.close();
+        inventory.stopSharedView();
+    }
+
+    SharedStockRecord read(const std::string& product_id) {
+        SharedStockRecord record{};
+        EXPECT_EQ(reader.read(product_id, record), SharedReadResult::FOUND);
+        return record;
+    }
+
+    std::string name;
+    Inventory inventory;
+    SharedStockReader reader;
+};
+
+TEST_F(SharedStockViewTest, ExistingProductsArePublished) {
+    EXPECT_TRUE(inventory.isPublishingSharedView());
+    EXPECT_EQ(reader.getCapacity(), 64u);
+
+    SharedStockRecord milk = read("MILK001");
+    EXPECT_EQ(milk.quantity, 20);
+    EXPECT_EQ(milk.available_quantity, 20);
+    EXPECT_DOUBLE_EQ(milk.price, 5.0);
+    EXPECT_EQ(milk.product_version, inventory.getProduct("MILK001")->getVersion());
+    EXPECT_EQ(read("BREAD001").quantity, 30);
+
+    SharedStockRecord missing;
+    EXPECT_EQ(reader.read("MISSING", missing), SharedReadResult::NOT_FOUND);
+    EXPECT_EQ(reader.read(std::string(100, 'X'), missing), SharedReadResult::NOT_FOUND);
+}
+
+TEST_F(SharedStockViewTest, CommittedChangesArePublished) {
+    inventory.removeQuantity("MILK001", 5);
+    EXPECT_EQ(read("MILK001").quantity, 15);
+
+    ProductUpdate update;
+    update.price = 6.5;
+    uint64_t version = 0;
+    ASSERT_EQ(inventory.updateProduct("MILK001", update, 0, version), ProductUpdateResult::UPDATED);
+    SharedStockRecord milk = read("MILK001");
+    EXPECT_DOUBLE_EQ(milk.price, 6.5);
+    EXPECT_EQ(milk.product_version, version);
+
+    inventory.addProduct(std::make_unique<PerishableProduct>("EGGS001", "Eggs", "Dairy", 3.0, 12,
+                                                             system_clock::now() + hours(24 * 7)));
+    EXPECT_EQ(read("EGGS001").quantity, 12);
+
+    ASSERT_TRUE(inventory.removeProduct("BREAD001"));
+    SharedStockRecord bread;
+    EXPECT_EQ(reader.read("BREAD001", bread), SharedReadResult::NOT_FOUND);
+
+    // A product added again under a removed ID reuses its record
+    inventory.addProduct(std::make_unique<PerishableProduct>("BREAD001", "Bread", "Bakery", 2.5, 8,
+                                                             system_clock::now() + hours(24)));
+    EXPECT_EQ(read("BREAD001").quantity, 8);
+}
+
+TEST_F(SharedStockViewTest, HoldsChangeAvailableQuantity) {
+    uint64_t first = inventory.placeHold("MILK001", 5, seconds(60));
+    uint64_t second = inventory.placeHold("MILK001", 3, seconds(60));
+    ASSERT_NE(first, 0u);
+    ASSERT_NE(second, 0u);
+    SharedStockRecord milk = read("MILK001");
+    EXPECT_EQ(milk.quantity, 20);
+    EXPECT_EQ(milk.available_quantity, 12);
+
+    ASSERT_TRUE(inventory.confirmHold(first));
+    milk = read("MILK001");
+    EXPECT_EQ(milk.quantity, 15);
+    EXPECT_EQ(milk.available_quantity, 12);
+
+    ASSERT_TRUE(inventory.releaseHold(second));
+    EXPECT_EQ(read("MILK001").available_quantity, 15);
+}
+
+TEST_F(SharedStockViewTest, StoppingRetiresTheSegment) {
+    // Only one view at a time
+    EXPECT_FALSE(inventory.publishSharedView(segmentName("second")));
+    EXPECT_THROW(inventory.publishSharedView("no-leading-slash"), std::invalid_argument);
+
+    inventory.stopSharedView();
+    EXPECT_FALSE(inventory.isPublishingSharedView());
+    EXPECT_TRUE(reader.isRetired());
+    EXPECT_EQ(read("MILK001").quantity, 20);    // Last values stay readable
+
+    SharedStockReader late;
+    EXPECT_FALSE(late.open(name));
+
+    // Publishing again creates a fresh segment under the same name
+    inventory.removeQuantity("MILK001", 1);
+    ASSERT_TRUE(inventory.publishSharedView(name, 64));
+    ASSERT_TRUE(reader.open(name));
+    EXPECT_FALSE(reader.isRetired());
+    EXPECT_EQ(read("MILK001").quantity, 19);
+}
+
+TEST(SharedStockWriterTest, RejectsWhatDoesNotFit) {
+    EXPECT_THROW(SharedStockWriter("/", 16), std::invalid_argument);
+    EXPECT_THROW(SharedStockWriter("/a/b", 16), std::invalid_argument);
+    EXPECT_THROW(SharedStockWriter("/name", 0), std::invalid_argument);
+
+    SharedStockWriter writer(segmentName("small"), 3);
+    EXPECT_EQ(writer.getCapacity(), 4u);
+    EXPECT_FALSE(writer.publish("P0", SharedStockRecord{1, 1, 1.0, 1}));   // Not created yet
+    ASSERT_TRUE(writer.create());
+
+    // Three quarters of the slots are usable
+    EXPECT_TRUE(writer.publish("P0", SharedStockRecord{1, 1, 1.0, 1}));
+    EXPECT_TRUE(writer.publish("P1", SharedStockRecord{2, 2, 2.0, 1}));
+    EXPECT_TRUE(writer.publish("P2", SharedStockRecord{3, 3, 3.0, 1}));
+    EXPECT_FALSE(writer.publish("P3", SharedStockRecord{4, 4, 4.0, 1}));
+    EXPECT_FALSE(writer.publish(std::string(SharedStockWriter::MAX_ID_LENGTH + 1, 'X'),
+                                SharedStockRecord{5, 5, 5.0, 1}));
+    EXPECT_EQ(writer.getRecordCount(), 3u);
+    EXPECT_EQ(writer.getOverflowCount(), 2u);
+
+    // Removed products keep their slot, so the table stays full
+    EXPECT_TRUE(writer.remove("P1"));
+    EXPECT_FALSE(writer.remove("P3"));
+    EXPECT_FALSE(writer.publish("P3", SharedStockRecord{4, 4, 4.0, 1}));
+    EXPECT_TRUE(writer.publish("P1", SharedStockRecord{6, 6, 6.0, 2}));
+
+    SharedStockReader reader;
+    ASSERT_TRUE(reader.open(writer.getName()));
+    SharedStockRecord record;
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(reader.read("P" + std::to_string(i), record), SharedReadResult::FOUND);
+    }
+    EXPECT_EQ(record.quantity, 3);
+    EXPECT_EQ(reader.read("P3", record), SharedReadResult::NOT_FOUND);
+
+    SharedStockReader unopened;
+    EXPECT_FALSE(unopened.open(segmentName("never-created")));
+    EXPECT_EQ(unopened.read("P0", record), SharedReadResult::NOT_FOUND);
+}
+
+TEST(SharedStockWriterTest, OnlyAbandonedSegmentsAreReplaced) {
+    SharedStockWriter live(segmentName("live"), 16);
+    ASSERT_TRUE(live.create());
+    ASSERT_TRUE(live.publish("MILK001", SharedStockRecord{20, 20, 5.0, 1}));
+
+    // A second writer under the same name must not take over a live writer's segment
+    SharedStockWriter second(live.getName(), 16);
+    EXPECT_FALSE(second.create());
+    SharedStockReader reader;
+    ASSERT_TRUE(reader.open(live.getName()));
+    SharedStockRecord record;
+    EXPECT_EQ(reader.read("MILK001", record), SharedReadResult::FOUND);
+    live.close();
+    EXPECT_TRUE(second.create());
+    second.close();
+
+    // A segment whose writer exited without removing it is replaced
+    std::string orphan = segmentName("orphan");
+    pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        SharedStockWriter writer(orphan, 16);
+        bool published = writer.create() && writer.publish("MILK001", SharedStockRecord{7, 7, 5.0, 1});
+        ::_exit(published ? 0 : 1);     // Skips the destructor, leaving the segment behind
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+    ASSERT_TRUE(reader.open(orphan));
+    EXPECT_EQ(reader.read("MILK001", record), SharedReadResult::FOUND);
+
+    SharedStockWriter replacement(orphan, 16);
+    ASSERT_TRUE(replacement.create());
+    ASSERT_TRUE(reader.open(orphan));
+    EXPECT_EQ(reader.read("MILK001", record), SharedReadResult::NOT_FOUND);
+}
+
+TEST(SharedStockWriterTest, OneWriterTakesOverAnAbandonedSegment) {
+    std::string orphan = segmentName("takeover");
+    pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        SharedStockWriter writer(orphan, 16);
+        ::_exit(writer.create() ? 0 : 1);     // Leaves the segment behind
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    // Hold the name's lock so both writers find the segment abandoned at the same moment
+    int lock_fd = ::shm_open((orphan + SharedStockWriter::LOCK_SUFFIX).c_str(), O_RDONLY | O_CREAT, 0644);
+    ASSERT_GE(lock_fd, 0);
+    ASSERT_EQ(::flock(lock_fd, LOCK_EX), 0);
+
+    SharedStockWriter first(orphan, 16);
+    SharedStockWriter second(orphan, 16);
+    std::atomic<int> finished{0};
+    bool created[2] = {false, false};
+    std::thread racing[2];
+    SharedStockWriter* writers[2] = {&first, &second};
+    for (int i = 0; i < 2; ++i) {
+        racing[i] = std::thread([&, i]() {
+            created[i] = writers[i]->create() &&
+                         writers[i]->publish("WINNER", SharedStockRecord{i, i, 1.0, 1});
+            finished++;
+        });
+    }
+    std::this_thread::sleep_for(milliseconds(100));
+    EXPECT_EQ(finished.load(), 0);
+    ::close(lock_fd);
+    for (auto& thread : racing) {
+        thread.join();
+    }
+
+    // Exactly one replaced it, and the name still refers to the winner's segment
+    ASSERT_NE(created[0], created[1]);
+    SharedStockReader reader;
+    ASSERT_TRUE(reader.open(orphan));
+    SharedStockRecord record;
+    ASSERT_EQ(reader.read("WINNER", record), SharedReadResult::FOUND);
+    EXPECT_EQ(record.quantity, created[0] ? 0 : 1);
+}
+
+TEST(SharedStockWriterTest, ReadsAreNeverTornWhileWriting) {
+    SharedStockWriter writer(segmentName("torn"), 16);
+    ASSERT_TRUE(writer.create());
+    ASSERT_TRUE(writer.publish("HOT", SharedStockRecord{0, 0, 0.0, 0}));
+
+    std::atomic<bool> done{false};
+    std::thread writing([&]() {
+        for (int i = 1; i <= 200000; ++i) {
+            writer.publish("HOT", SharedStockRecord{i, -i, static_cast<double>(i), static_cast<uint64_t>(i)});
+        }
+        done.store(true);
+    });
+
+    SharedStockReader reader;
+    ASSERT_TRUE(reader.open(writer.getName()));
+    size_t torn = 0;
+    size_t found = 0;
+    int last = 0;
+    bool backwards = false;
+    // Reads once more after the writer finishes, so even a writer that ran first is read
+    bool finished = false;
+    while (!finished) {
+        finished = done.load();
+        SharedStockRecord record;
+        if (reader.read("HOT", record) != SharedReadResult::FOUND) {
+            continue;
+        }
+        found++;
+        if (record.available_quantity != -record.quantity || record.price != record.quantity ||
+            record.product_version != static_cast<uint64_t>(record.quantity)) {
+            torn++;
+        }
+        backwards = backwards || record.quantity < last;
+        last = record.quantity;
+    }
+    writing.join();
+
+    EXPECT_GT(found, 0u);
+    EXPECT_EQ(torn, 0u);
+    EXPECT_FALSE(backwards);
+}
+
+TEST(SharedStockWriterTest, OtherProcessesReadTheSegment) {
+    SharedStockWriter writer(segmentName("fork"), 16);
+    ASSERT_TRUE(writer.create());
+    ASSERT_TRUE(writer.publish("MILK001", SharedStockRecord{20, 15, 5.0, 3}));
+
+    int ready[2];
+    int go[2];
+    ASSERT_EQ(::pipe(ready), 0);
+    ASSERT_EQ(::pipe(go), 0);
+    pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        // Exit code 0 only if the child saw both the first value and the later update
+        SharedStockReader reader;
+        SharedStockRecord record;
+        bool first = reader.open(writer.getName()) &&
+                     reader.read("MILK001", record) == SharedReadResult::FOUND &&
+                     record.available_quantity == 15;
+        char byte = 'r';
+        bool signalled = ::write(ready[1], &byte, 1) == 1 && ::read(go[0], &byte, 1) == 1;
+        bool updated = reader.read("MILK001", record) == SharedReadResult::FOUND && record.quantity == 12;
+        ::_exit(first && signalled && updated ? 0 : 1);
+    }
+
+    char byte;
+    ASSERT_EQ(::read(ready[0], &byte, 1), 1);
+    writer.publish("MILK001", SharedStockRecord{12, 12, 5.0, 4});
+    ASSERT_EQ(::write(go[1], "x", 1), 1);
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    for (int fd : {ready[0], ready[1], go[0], go[1]}) {
+        ::close(fd);
+    }
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
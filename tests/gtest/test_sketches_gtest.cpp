@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <map>
+#include "../../include/Sketches.hpp"
+#include "../../include/SalesAnalytics.hpp"
+#include "../../include/Order.hpp"
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+TEST(SpaceSavingSketchTest, ExactWhileUnderCapacity) {
+    SpaceSavingSketch sketch(4);
+    sketch.add("A", 5);
+    sketch.add("B", 2);
+    sketch.add("C", 9);
+    sketch.add("A", 1);
+
+    auto top = sketch.getTopK(2);
+    ASSERT_EQ(top.size(), 2u);
+    EXPECT_EQ(top[0].key, "C");
+    EXPECT_DOUBLE_EQ(top[0].count, 9.0);
+    EXPECT_EQ(top[1].key, "A");
+    EXPECT_DOUBLE_EQ(top[1].count, 6.0);
+    EXPECT_DOUBLE_EQ(top[1].error, 0.0);
+    EXPECT_DOUBLE_EQ(sketch.getTotalWeight(), 17.0);
+}
+
+TEST(SpaceSavingSketchTest, HeavyHittersSurviveLongTail) {
+    SpaceSavingSketch sketch(16);
+    for (int round = 0; round < 100; ++round) {
+        sketch.add("HOT1", 10);
+        sketch.add("HOT2", 5);
+        for (int i = 0; i < 50; ++i) {
+            sketch.add("TAIL" + std::to_string(round * 50 + i), 1);
+        }
+    }
+
+    EXPECT_EQ(sketch.size(), 16u);
+    auto top = sketch.getTopK(2);
+    ASSERT_EQ(top.size(), 2u);
+    EXPECT_EQ(top[0].key, "HOT1");
+    EXPECT_EQ(top[1].key, "HOT2");
+    EXPECT_GE(top[0].count, 1000.0);
+    EXPECT_LE(top[0].getLowerBound(), 1000.0);
+}
+
+TEST(SpaceSavingSketchTest, SubtractNeverDropsBelowError) {
+    SpaceSavingSketch sketch(1);
+    sketch.add("A", 3);
+    sketch.add("B", 2);
+    EXPECT_DOUBLE_EQ(sketch.estimate("B"), 5.0);
+
+    sketch.subtract("B", 10);
+    EXPECT_DOUBLE_EQ(sketch.estimate("B"), 3.0);
+    EXPECT_DOUBLE_EQ(sketch.estimate("A"), 0.0);
+}
+
+TEST(SpaceSavingSketchTest, MergedShardsKeepHeavyHittersWithoutUndercounting) {
+    SpaceSavingSketch merged(8);
+    std::map<std::string, double> exact;
+    for (int shard = 0; shard < 4; ++shard) {
+        SpaceSavingSketch partial(8);
+        for (int i = 0; i < 200; ++i) {
+            std::string key = (i % 4 == 0) ? "HOT" : "TAIL" + std::to_string(shard * 200 + i);
+            partial.add(key, 2);
+            exact[key] += 2;
+        }
+        merged.merge(partial);
+    }
+
+    EXPECT_LE(merged.size(), 8u);
+    EXPECT_DOUBLE_EQ(merged.getTotalWeight(), 1600.0);
+    auto top = merged.getTopK(1);
+    ASSERT_EQ(top.size(), 1u);
+    EXPECT_EQ(top[0].key, "HOT");
+    for (const auto& entry : merged.getTopK(8)) {
+        EXPECT_GE(entry.count, exact[entry.key]);
+        EXPECT_LE(entry.getLowerBound(), exact[entry.key]);
+    }
+}
+
+TEST(SpaceSavingSketchTest, MergeUnderCapacityIsExact) {
+    SpaceSavingSketch a(4);
+    SpaceSavingSketch b(4);
+    a.add("A", 5);
+    a.add("B", 1);
+    b.add("A", 2);
+    b.add("C", 4);
+
+    a.merge(b);
+    EXPECT_DOUBLE_EQ(a.estimate("A"), 7.0);
+    EXPECT_DOUBLE_EQ(a.estimate("B"), 1.0);
+    EXPECT_DOUBLE_EQ(a.estimate("C"), 4.0);
+    EXPECT_DOUBLE_EQ(a.getTopK(1)[0].error, 0.0);
+}
+
+TEST(SpaceSavingSketchTest, ZeroCapacityThrows) {
+    EXPECT_THROW(SpaceSavingSketch(0), std::invalid_argument);
+}
+
+TEST(TopProductsTest, OrderConfirmationsFeedRankings) {
+    Inventory inventory;
+    OrderManager order_manager;
+    auto expiry = system_clock::now() + hours(24 * 30);
+    inventory.addProduct(std::make_unique<PerishableProduct>("LAPTOP001", "Gaming Laptop", "Electronics", 1000.0, 50, expiry));
+    inventory.addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 100, expiry));
+
+    Order* laptop = order_manager.createOrder("ORD001", "CUST001");
+    laptop->addItem("LAPTOP001", 1, 1000.0);
+    ASSERT_TRUE(laptop->processOrder(inventory));
+
+    Order* milk = order_manager.createOrder("ORD002", "CUST002");
+    milk->addItem("MILK001", 20, 5.0);
+    ASSERT_TRUE(milk->processOrder(inventory));
+
+    const SalesAggregator& aggregator = order_manager.getSalesAggregator();
+    auto by_units = aggregator.getTopProducts(1, SalesMetric::UNITS);
+    auto by_revenue = aggregator.getTopProducts(1, SalesMetric::REVENUE);
+    ASSERT_EQ(by_units.size(), 1u);
+    ASSERT_EQ(by_revenue.size(), 1u);
+    EXPECT_EQ(by_units[0].key, "MILK001");
+    EXPECT_EQ(by_revenue[0].key, "LAPTOP001");
+
+    auto now = system_clock::now();
+    auto exact = aggregator.getTopProductsInRange(now - hours(1), now + hours(1), 5, SalesMetric::REVENUE);
+    ASSERT_EQ(exact.size(), 2u);
+    EXPECT_EQ(exact[0].first, "LAPTOP001");
+    EXPECT_EQ(exact[1].second.units, 20);
+
+    ASSERT_TRUE(laptop->cancelOrder("Customer request"));
+    by_revenue = aggregator.getTopProducts(1, SalesMetric::REVENUE);
+    EXPECT_EQ(by_revenue[0].key, "MILK001");
+}
+
+TEST(HyperLogLogTest, EstimatesWithinOnePercentAtScale) {
+    HyperLogLog sketch;
+    for (int i = 0; i < 100000; ++i) {
+        sketch.add("CUST" + std::to_string(i));
+        sketch.add("CUST" + std::to_string(i));  // Duplicates don't count
+    }
+
+    EXPECT_NEAR(sketch.estimate(), 100000.0, 100000.0 * 0.03);
+    EXPECT_EQ(sketch.getMemoryUsage(), 16384u);
+}
+
+TEST(HyperLogLogTest, SmallCountsAreNearExact) {
+    HyperLogLog sketch;
+    EXPECT_DOUBLE_EQ(sketch.estimate(), 0.0);
+    for (int i = 0; i < 50; ++i) {
+        sketch.add("CUST" + std::to_string(i));
+    }
+    EXPECT_NEAR(sketch.estimate(), 50.0, 1.0);
+}
+
+TEST(HyperLogLogTest, MergeCountsUnion) {
+    HyperLogLog first;
+    HyperLogLog second;
+    for (int i = 0; i < 6000; ++i) {
+        first.add("CUST" + std::to_string(i));
+        second.add("CUST" + std::to_string(i + 4000));
+    }
+
+    EXPECT_TRUE(first.merge(second));
+    EXPECT_NEAR(first.estimate(), 10000.0, 10000.0 * 0.03);
+
+    HyperLogLog other_precision(10);
+    EXPECT_FALSE(first.merge(other_precision));
+    EXPECT_THROW(HyperLogLog(2), std::invalid_argument);
+}
+
+TEST(TDigestTest, QuantilesOfUniformValues) {
+    TDigest digest;
+    for (int i = 1; i <= 10000; ++i) {
+        digest.add(i);
+    }
+
+    EXPECT_DOUBLE_EQ(digest.getCount(), 10000.0);
+    EXPECT_NEAR(digest.quantile(0.5), 5000.0, 100.0);
+    EXPECT_NEAR(digest.quantile(0.95), 9500.0, 50.0);
+    EXPECT_NEAR(digest.quantile(0.99), 9900.0, 20.0);
+    EXPECT_DOUBLE_EQ(digest.quantile(0.0), 1.0);
+    EXPECT_DOUBLE_EQ(digest.quantile(1.0), 10000.0);
+    EXPECT_LE(digest.getCentroidCount(), 200u);
+}
+
+TEST(TDigestTest, MergedDigestsMatchCombinedStream) {
+    TDigest low;
+    TDigest high;
+    for (int i = 0; i < 5000; ++i) {
+        low.add(i);
+        high.add(5000 + i);
+    }
+
+    low.merge(high);
+    EXPECT_DOUBLE_EQ(low.getCount(), 10000.0);
+    EXPECT_NEAR(low.quantile(0.5), 5000.0, 100.0);
+    EXPECT_NEAR(low.quantile(0.95), 9500.0, 50.0);
+}
+
+TEST(OrderDistributionTest, ConfirmedOrdersFeedCustomerSketches) {
+    Inventory inventory;
+    OrderManager order_manager;
+    auto expiry = system_clock::now() + hours(24 * 30);
+    inventory.addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 1000, expiry));
+
+    for (int i = 0; i < 20; ++i) {
+        Order* order = order_manager.createOrder("ORD" + std::to_string(i), "CUST" + std::to_string(i % 5));
+        order->addItem("MILK001", i + 1, 5.0);
+        ASSERT_TRUE(order->processOrder(inventory));
+    }
+
+    auto now = system_clock::now();
+    OrderDistribution distribution = order_manager.getSalesAggregator().getOrderDistribution(now - hours(24 * 60), now);
+    EXPECT_NEAR(distribution.customers.estimate(), 5.0, 0.5);
+    EXPECT_DOUBLE_EQ(distribution.order_values.getCount(), 20.0);
+    EXPECT_DOUBLE_EQ(distribution.order_values.getMax(), 100.0);
+    EXPECT_NEAR(distribution.order_values.quantile(0.5), 52.5, 5.0);
+
+    OrderDistribution empty = order_manager.getSalesAggregator().getOrderDistribution(now - hours(24 * 60), now - hours(24 * 30));
+    EXPECT_DOUBLE_EQ(empty.order_values.getCount(), 0.0);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include "../../include/StockCombiner.hpp"
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+TEST(StockCombinerTest, BatchesAreAppliedInArrivalOrder) {
+    std::vector<int> applied;
+    StockCombiner combiner([&applied](const std::vector<StockCombiner::Request*>& batch) {
+        for (auto* request : batch) {
+            applied.push_back(request->amount);
+            request->success = request->amount % 2 == 0;
+        }
+    });
+
+    std::string key = "SKU";
+    EXPECT_TRUE(combiner.submit(key, 2));
+    EXPECT_FALSE(combiner.submit(key, 3));
+    EXPECT_EQ(applied, (std::vector<int>{2, 3}));
+    EXPECT_EQ(combiner.getBatchCount(), 2u);
+    EXPECT_EQ(combiner.getCombinedRequestCount(), 2u);
+}
+
+TEST(StockCombinerTest, RepeatedHitsMarkOnlyThatKeyHot) {
+    // One slot, so every key shares it
+    StockCombiner combiner([](const std::vector<StockCombiner::Request*>&) {}, 1);
+
+    EXPECT_FALSE(combiner.isHot("HOT"));
+    for (uint32_t i = 0; i <= StockCombiner::HOT_THRESHOLD; ++i) {
+        combiner.recordHit("HOT");
+        combiner.recordHit("COLD" + std::to_string(i % 8));
+        combiner.recordHit("HOT");
+    }
+    EXPECT_TRUE(combiner.isHot("HOT"));
+    EXPECT_FALSE(combiner.isHot("COLD0"));
+}
+
+TEST(StockCombinerTest, HitsSpreadOverManyKeysMarkNoneHot) {
+    StockCombiner combiner([](const std::vector<StockCombiner::Request*>&) {}, 1);
+
+    for (uint32_t i = 0; i < StockCombiner::HOT_THRESHOLD * 8; ++i) {
+        combiner.recordHit("SKU" + std::to_string(i % 16));
+    }
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_FALSE(combiner.isHot("SKU" + std::to_string(i)));
+    }
+}
+
+// Test Fixture for combined Inventory removals
+class CombinedRemovalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto expiry = system_clock::now() + hours(24 * 30);
+        inventory.addProduct(std::make_unique<PerishableProduct>("HOT001", "Flash Sale Item", "Sale", 10.0, 5000, expiry));
+        inventory.addProduct(std::make_unique<PerishableProduct>("COLD001", "Regular Item", "Sale", 10.0, 10, expiry));
+    }
+
+    Inventory inventory;
+};
+
+TEST_F(CombinedRemovalTest, ConcurrentRemovalsNeverOversell) {
+    inventory.setStockCombining(StockCombining::ALWAYS);
+
+    std::atomic<int> succeeded{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 8; ++t) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < 1000; ++i) {
+                if (inventory.removeQuantity("HOT001", 1)) {
+                    succeeded++;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(succeeded.load(), 5000);
+    EXPECT_EQ(inventory.getProduct("HOT001")->getQuantity(), 0);
+    EXPECT_EQ(inventory.getStockCombiner().getCombinedRequestCount(), 8000u);
+}
+
+TEST_F(CombinedRemovalTest, CombinedPathRespectsHoldsAndMissingProducts) {
+    inventory.setStockCombining(StockCombining::ALWAYS);
+    ASSERT_NE(inventory.placeHold("COLD001", 8, seconds(60)), 0u);
+
+    EXPECT_FALSE(inventory.removeQuantity("COLD001", 3));
+    EXPECT_TRUE(inventory.removeQuantity("COLD001", 2));
+    EXPECT_FALSE(inventory.removeQuantity("MISSING", 1));
+    EXPECT_EQ(inventory.getProduct("COLD001")->getQuantity(), 8);
+}
+
+TEST_F(CombinedRemovalTest, OffModeNeverCombines) {
+    inventory.setStockCombining(StockCombining::OFF);
+    EXPECT_TRUE(inventory.removeQuantity("HOT001", 10));
+    EXPECT_EQ(inventory.getStockCombiner().getBatchCount(), 0u);
+    EXPECT_EQ(inventory.getProduct("HOT001")->getQuantity(), 4990);
+}
@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../../include/Inventory.hpp"
+#include "../../include/Order.hpp"
+#include "../../include/Product.hpp"
+#include "../../include/StockTable.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+namespace {
+
+ProductStock makeStock(int quantity, double price = 1.0, uint64_t version = 1) {
+    ProductStock stock;
+    stock.quantity = quantity;
+    stock.available_quantity = quantity;
+    stock.price = price;
+    stock.product_version = version;
+    return stock;
+}
+
+} // namespace
+
+TEST(StockTableTest, PublishReadAndRemove) {
+    StockTable table;
+    ProductStock stock;
+    EXPECT_FALSE(table.read("MILK001", stock));
+
+    ProductStock milk = makeStock(20, 5.0, 3);
+    milk.available_quantity = 15;
+    milk.perishable = true;
+    milk.expiry_date = system_clock::now() - hours(1);
+    table.publish("MILK001", milk);
+
+    ASSERT_TRUE(table.read("MILK001", stock));
+    EXPECT_EQ(stock.quantity, 20);
+    EXPECT_EQ(stock.available_quantity, 15);
+    EXPECT_DOUBLE_EQ(stock.price, 5.0);
+    EXPECT_EQ(stock.product_version, 3u);
+    EXPECT_TRUE(stock.isExpired());
+    EXPECT_EQ(stock.expiry_date, milk.expiry_date);
+
+    table.remove("MILK001");
+    table.remove("MISSING");
+    EXPECT_FALSE(table.read("MILK001", stock));
+
+    // A returning ID reuses its cell
+    table.publish("MILK001", makeStock(7));
+    ASSERT_TRUE(table.read("MILK001", stock));
+    EXPECT_EQ(stock.quantity, 7);
+    EXPECT_FALSE(stock.isExpired());
+    EXPECT_EQ(table.getCellCount(), 1u);
+}
+
+TEST(StockTableTest, GrowsWhileReadersProbe) {
+    StockTable table(8);
+    constexpr int kProducts = 5000;
+    table.publish("P0", makeStock(0));
+
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (int i = 1; i < kProducts; ++i) {
+            table.publish("P" + std::to_string(i), makeStock(i));
+        }
+        done.store(true);
+    });
+
+    // P0 stays findable through every resize
+    size_t misses = 0;
+    ProductStock stock;
+    while (!done.load()) {
+        if (!table.read("P0", stock)) {
+            misses++;
+        }
+    }
+    writer.join();
+    EXPECT_EQ(misses, 0u);
+
+    for (int i = 0; i < kProducts; ++i) {
+        ASSERT_TRUE(table.read("P" + std::to_string(i), stock)) << i;
+        EXPECT_EQ(stock.quantity, i);
+    }
+    EXPECT_FALSE(table.read("P" + std::to_string(kProducts), stock));
+    EXPECT_EQ(table.getCellCount(), static_cast<size_t>(kProducts));
+}
+
+TEST(StockTableTest, ReadsAreNeverTornWhileWriting) {
+    StockTable table;
+    table.publish("HOT", makeStock(0, 0.0, 0));
+
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (int i = 1; i <= 200000; ++i) {
+            ProductStock stock = makeStock(i, static_cast<double>(i), static_cast<uint64_t>(i));
+            stock.available_quantity = -i;
+            table.publish("HOT", stock);
+        }
+        done.store(true);
+    });
+
+    size_t torn = 0;
+    size_t reads = 0;
+    int last = 0;
+    bool backwards = false;
+    while (!done.load()) {
+        ProductStock stock;
+        ASSERT_TRUE(table.read("HOT", stock));
+        reads++;
+        if (stock.available_quantity != -stock.quantity || stock.price != stock.quantity ||
+            stock.product_version != static_cast<uint64_t>(stock.quantity)) {
+            torn++;
+        }
+        backwards = backwards || stock.quantity < last;
+        last = stock.quantity;
+    }
+    writer.join();
+
+    EXPECT_GT(reads, 0u);
+    EXPECT_EQ(torn, 0u);
+    EXPECT_FALSE(backwards);
+}
+
+// Test Fixture for Inventory's lock-free read paths
+class InventoryStockReadTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto expiry = system_clock::now() + hours(24 * 30);
+        inventory.addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 20, expiry));
+
+        // Only replicated states may already be expired
+        ProductVersion old_cheese;
+        old_cheese.id = "OLD001";
+        old_cheese.name = "Old Cheese";
+        old_cheese.category = "Dairy";
+        old_cheese.price = 8.0;
+        old_cheese.quantity = 5;
+        old_cheese.product_version = 1;
+        old_cheese.perishable = true;
+        old_cheese.expiry_date = system_clock::now() - hours(1);
+        ASSERT_TRUE(inventory.applyProductState(old_cheese));
+    }
+
+    Inventory inventory;
+};
+
+TEST_F(InventoryStockReadTest, ReadersFollowCommittedChanges) {
+    ProductStock stock;
+    ASSERT_TRUE(inventory.readStock("MILK001", stock));
+    EXPECT_EQ(stock.quantity, 20);
+    EXPECT_DOUBLE_EQ(stock.price, 5.0);
+    EXPECT_EQ(stock.product_version, inventory.getProduct("MILK001")->getVersion());
+    EXPECT_FALSE(stock.isExpired());
+    ASSERT_TRUE(inventory.readStock("OLD001", stock));
+    EXPECT_TRUE(stock.isExpired());
+
+    inventory.removeQuantity("MILK001", 4);
+    uint64_t hold = inventory.placeHold("MILK001", 6, seconds(60));
+    ASSERT_NE(hold, 0u);
+    EXPECT_EQ(inventory.getAvailableQuantity("MILK001"), 10);
+    ASSERT_TRUE(inventory.confirmHold(hold));
+    EXPECT_EQ(inventory.getAvailableQuantity("MILK001"), 10);
+    ASSERT_TRUE(inventory.readStock("MILK001", stock));
+    EXPECT_EQ(stock.quantity, 10);
+
+    ProductUpdate update;
+    update.price = 5.5;
+    uint64_t version = 0;
+    ASSERT_EQ(inventory.updateProduct("MILK001", update, 0, version), ProductUpdateResult::UPDATED);
+    ASSERT_TRUE(inventory.readStock("MILK001", stock));
+    EXPECT_DOUBLE_EQ(stock.price, 5.5);
+    EXPECT_EQ(stock.product_version, version);
+
+    ASSERT_TRUE(inventory.removeProduct("MILK001"));
+    EXPECT_FALSE(inventory.hasProduct("MILK001"));
+    EXPECT_EQ(inventory.getAvailableQuantity("MILK001"), -1);
+    EXPECT_FALSE(inventory.readStock("MILK001", stock));
+}
+
+TEST_F(InventoryStockReadTest, ValidateOrderUsesOneConsistentRead) {
+    Order order("ORD-1", "CUST001");
+    order.addItem("MILK001", 25, 9.0);
+    order.addItem("OLD001", 1, 8.0);
+    order.addItem("MISSING", 1, 1.0);
+
+    auto errors = order.validateOrder(inventory);
+    ASSERT_EQ(errors.size(), 4u);
+    EXPECT_NE(errors[0].find("Insufficient quantity for product MILK001"), std::string::npos);
+    EXPECT_NE(errors[1].find("Price mismatch for product MILK001"), std::string::npos);
+    EXPECT_NE(errors[2].find("Product is expired: OLD001"), std::string::npos);
+    EXPECT_NE(errors[3].find("Product not found: MISSING"), std::string::npos);
+
+    Order valid("ORD-2", "CUST001");
+    valid.addItem("MILK001", 20, 5.1);
+    EXPECT_TRUE(valid.validateOrder(inventory).empty());
+    inventory.placeHold("MILK001", 1, seconds(60));
+    EXPECT_EQ(valid.validateOrder(inventory).size(), 1u);
+    EXPECT_TRUE(valid.validateOrder(inventory, false).empty());
+}
+
+TEST_F(InventoryStockReadTest, ReadersSeeWholeStatesUnderConcurrentWrites) {
+    // The writer keeps quantity and price in step; a reader must never see them apart
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (int i = 1; i <= 20000; ++i) {
+            ProductUpdate update;
+            update.quantity = i;
+            update.price = static_cast<double>(i);
+            uint64_t version = 0;
+            inventory.updateProduct("MILK001", update, 0, version);
+        }
+        done.store(true);
+    });
+
+    size_t mismatched = 0;
+    while (!done.load()) {
+        ProductStock stock;
+        ASSERT_TRUE(inventory.readStock("MILK001", stock));
+        if (stock.quantity > 20 && stock.price != stock.quantity) {
+            mismatched++;
+        }
+        EXPECT_TRUE(inventory.hasProduct("MILK001"));
+    }
+    writer.join();
+    EXPECT_EQ(mismatched, 0u);
+    EXPECT_EQ(inventory.getAvailableQuantity("MILK001"), 20000);
+}
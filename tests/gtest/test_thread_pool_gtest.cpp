@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include "../../include/ThreadPool.hpp"
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+#include "../../include/NotificationSystem.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+TEST(ThreadPoolTest, SubmitReturnsResult) {
+    ThreadPool pool(2);
+    auto future = pool.submit([]() { return 6 * 7; });
+    EXPECT_EQ(future.get(), 42);
+    EXPECT_EQ(pool.getThreadCount(), 2u);
+}
+
+TEST(ThreadPoolTest, ParallelForRunsEveryIndexOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallelFor(hits.size(), [&](size_t index) { hits[index]++; });
+
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, NestedParallelForDoesNotDeadlock) {
+    ThreadPool pool(2);
+    std::atomic<int> total{0};
+    pool.parallelFor(8, [&](size_t) {
+        pool.parallelFor(8, [&](size_t) { total++; });
+    });
+    EXPECT_EQ(total.load(), 64);
+}
+
+TEST(ThreadPoolTest, ParallelForRethrowsException) {
+    ThreadPool pool(2);
+    EXPECT_THROW(pool.parallelFor(10, [](size_t index) {
+        if (index == 7) {
+            throw std::runtime_error("shard failed");
+        }
+    }), std::runtime_error);
+}
+
+// Test Fixture for snapshot-based report tests
+class ParallelReportTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        inventory = std::make_unique<Inventory>(10);
+        auto fresh = system_clock::now() + hours(24 * 30);
+        auto soon = system_clock::now() + hours(24 * 3);
+        for (int i = 0; i < 200; ++i) {
+            std::string category = (i % 2 == 0) ? "Dairy" : "Bakery";
+            inventory->addProduct(std::make_unique<PerishableProduct>(
+                "P" + std::to_string(i), "Product " + std::to_string(i), category,
+                2.0, i < 5 ? 1 : 50, i == 0 ? soon : fresh));
+        }
+    }
+
+    std::unique_ptr<Inventory> inventory;
+};
+
+TEST_F(ParallelReportTest, SnapshotMatchesInventory) {
+    ThreadPool pool(4);
+    InventorySnapshot snapshot = inventory->snapshot(7, &pool);
+
+    ASSERT_EQ(snapshot.products.size(), 200u);
+    long long quantity = 0;
+    int low_stock = 0;
+    int expiring = 0;
+    for (const auto& product : snapshot.products) {
+        quantity += product.quantity;
+        low_stock += product.isLowStock() ? 1 : 0;
+        expiring += product.expiring_soon ? 1 : 0;
+    }
+    EXPECT_EQ(quantity, inventory->getTotalQuantity());
+    EXPECT_EQ(low_stock, 5);
+    EXPECT_EQ(expiring, 1);
+
+    // Later changes don't affect an existing snapshot
+    inventory->updateQuantity("P10", 0);
+    EXPECT_EQ(snapshot.products.size(), 200u);
+    EXPECT_EQ(inventory->snapshot().products.size(), 200u);
+}
+
+TEST_F(ParallelReportTest, InventoryReportUsesSnapshotTotals) {
+    InventoryReport report(inventory.get(), "tester");
+    std::string content = report.generate();
+
+    EXPECT_NE(content.find("Total Products: 200"), std::string::npos);
+    EXPECT_NE(content.find("Total Quantity: " + std::to_string(inventory->getTotalQuantity())), std::string::npos);
+    EXPECT_NE(content.find("Low Stock Items: 5"), std::string::npos);
+    EXPECT_NE(content.find("Items Expiring Soon: 1"), std::string::npos);
+    EXPECT_NE(content.find("- Bakery: $"), std::string::npos);
+    EXPECT_LT(content.find("INVENTORY OVERVIEW"), content.find("CATEGORY BREAKDOWN"));
+    EXPECT_LT(content.find("LOW STOCK ANALYSIS"), content.find("EXPIRY ANALYSIS"));
+}
+
+TEST_F(ParallelReportTest, SalesReportCountsArchivedOrdersOnce) {
+    OrderManager order_manager;
+    for (int i = 0; i < 6; ++i) {
+        Order* order = order_manager.createOrder("ORD" + std::to_string(i), "CUST001");
+        order->addItem("P100", 1, 2.0);
+        ASSERT_TRUE(order->processOrder(*inventory));
+        if (i < 4) {
+            ASSERT_TRUE(order->updateStatus(OrderStatus::SHIPPED));
+            ASSERT_TRUE(order->updateStatus(OrderStatus::DELIVERED));
+        }
+    }
+    EXPECT_EQ(order_manager.clearCompletedOrders(), 4);
+
+    auto now = system_clock::now();
+    SalesReport report(&order_manager, now - hours(1), now + hours(1), "tester");
+    std::string content = report.generate();
+    EXPECT_NE(content.find("Total Orders in Period: 6"), std::string::npos);
+    EXPECT_NE(content.find("Total Revenue: $12.00"), std::string::npos);
+    EXPECT_NE(content.find("Confirmed Revenue: $12.00"), std::string::npos);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <cmath>
+#include "../../include/TimeSeries.hpp"
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+namespace {
+
+// 2024-01-01T00:00:00Z
+constexpr long long BASE = 1704067200;
+
+} // namespace
+
+TEST(GorillaBlockTest, RoundTripsIrregularSamples) {
+    GorillaBlock block;
+    std::vector<TimeSeriesPoint> samples = {
+        {BASE, 100.0}, {BASE + 60, 100.0}, {BASE + 120, 97.0}, {BASE + 181, 97.5},
+        {BASE + 5000, -3.25}, {BASE + 5000, 1e12}, {BASE + 90000000, 0.1}, {BASE + 90000060, NAN}
+    };
+    for (const auto& sample : samples) {
+        EXPECT_TRUE(block.append(sample.timestamp, sample.value));
+    }
+    EXPECT_FALSE(block.append(BASE, 1.0));
+
+    std::vector<TimeSeriesPoint> decoded;
+    block.forEach([&](const TimeSeriesPoint& point) {
+        decoded.push_back(point);
+        return true;
+    });
+
+    ASSERT_EQ(decoded.size(), samples.size());
+    for (size_t i = 0; i + 1 < samples.size(); ++i) {
+        EXPECT_EQ(decoded[i].timestamp, samples[i].timestamp);
+        EXPECT_EQ(decoded[i].value, samples[i].value);
+    }
+    EXPECT_TRUE(std::isnan(decoded.back().value));
+}
+
+TEST(GorillaBlockTest, RegularSamplesCompressWell) {
+    GorillaBlock block;
+    for (int i = 0; i < 1000; ++i) {
+        block.append(BASE + i * 60, 500 - i / 10);
+    }
+
+    // Well under two bytes per sample versus sixteen uncompressed
+    EXPECT_LT(block.getByteSize(), 2000u);
+}
+
+TEST(TimeSeriesTest, PointsSpanBlocksAndRespectRange) {
+    TimeSeries series(16);
+    for (int i = 0; i < 100; ++i) {
+        series.append(BASE + i * 10, i);
+    }
+
+    auto points = series.getPoints(BASE + 155, BASE + 399);
+    ASSERT_EQ(points.size(), 24u);
+    EXPECT_EQ(points.front().timestamp, BASE + 160);
+    EXPECT_EQ(points.back().timestamp, BASE + 390);
+    EXPECT_TRUE(series.getPoints(BASE + 2000, BASE + 3000).empty());
+}
+
+TEST(TimeSeriesTest, RollupsSummarizeAndCarryLevelForward) {
+    TimeSeries series;
+    series.append(BASE + 10, 50);
+    series.append(BASE + 20, 40);
+    series.append(BASE + 30, 45);
+    series.append(BASE + 3 * 3600 + 5, 20);
+
+    auto hourly = series.getRollups(BASE, BASE + 4 * 3600 - 1, BucketGranularity::HOUR);
+    ASSERT_EQ(hourly.size(), 4u);
+
+    EXPECT_EQ(hourly[0].start, BASE);
+    EXPECT_DOUBLE_EQ(hourly[0].min, 40);
+    EXPECT_DOUBLE_EQ(hourly[0].max, 50);
+    EXPECT_DOUBLE_EQ(hourly[0].last, 45);
+    EXPECT_DOUBLE_EQ(hourly[0].getAverage(), 45);
+    EXPECT_EQ(hourly[0].count, 3u);
+
+    // Empty hours hold the previous level
+    EXPECT_EQ(hourly[1].count, 0u);
+    EXPECT_DOUBLE_EQ(hourly[1].min, 45);
+    EXPECT_DOUBLE_EQ(hourly[2].last, 45);
+
+    EXPECT_DOUBLE_EQ(hourly[3].min, 20);
+    EXPECT_DOUBLE_EQ(hourly[3].max, 45);
+    EXPECT_DOUBLE_EQ(hourly[3].last, 20);
+
+    auto daily = series.getRollups(BASE, BASE + 24 * 3600 - 1, BucketGranularity::DAY);
+    ASSERT_EQ(daily.size(), 1u);
+    EXPECT_DOUBLE_EQ(daily[0].min, 20);
+    EXPECT_DOUBLE_EQ(daily[0].max, 50);
+    EXPECT_EQ(daily[0].count, 4u);
+
+    // 2024-01-01 was a Monday
+    auto weekly = series.getRollups(BASE, BASE + 7 * 24 * 3600 - 1, BucketGranularity::WEEK);
+    ASSERT_EQ(weekly.size(), 1u);
+    EXPECT_EQ(weekly[0].start, BASE);
+    EXPECT_DOUBLE_EQ(weekly[0].last, 20);
+}
+
+TEST(InventoryStockHistoryTest, StockChangesAreRecorded) {
+    Inventory inventory;
+    auto expiry = system_clock::now() + hours(24 * 30);
+    inventory.addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 100, expiry));
+    inventory.addProduct(std::make_unique<PerishableProduct>("CHEESE001", "Cheddar", "Dairy", 8.0, 20, expiry));
+
+    EXPECT_TRUE(inventory.removeQuantity("MILK001", 30));
+    EXPECT_TRUE(inventory.addQuantity("CHEESE001", 5));
+    EXPECT_TRUE(inventory.updateQuantity("MILK001", 90));
+    EXPECT_TRUE(inventory.removeProduct("CHEESE001"));
+
+    const TimeSeriesStore& history = inventory.getStockHistory();
+    auto start = system_clock::now() - hours(1);
+    auto end = system_clock::now() + hours(1);
+
+    auto milk = history.getPoints("product:MILK001", start, end);
+    ASSERT_EQ(milk.size(), 3u);
+    EXPECT_DOUBLE_EQ(milk[0].value, 100);
+    EXPECT_DOUBLE_EQ(milk[1].value, 70);
+    EXPECT_DOUBLE_EQ(milk[2].value, 90);
+
+    auto cheese = history.getPoints("product:CHEESE001", start, end);
+    ASSERT_EQ(cheese.size(), 3u);
+    EXPECT_DOUBLE_EQ(cheese.back().value, 0);
+
+    auto dairy = history.getPoints("category:Dairy", start, end);
+    std::vector<double> levels;
+    for (const auto& point : dairy) {
+        levels.push_back(point.value);
+    }
+    EXPECT_EQ(levels, (std::vector<double>{100, 120, 90, 95, 115, 90}));
+
+    EXPECT_EQ(history.getSeriesCount(), 3u);
+    EXPECT_FALSE(history.hasSeries("product:UNKNOWN"));
+}
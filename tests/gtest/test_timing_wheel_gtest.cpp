@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include "../../include/TimingWheel.hpp"
+#include "../../include/Inventory.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+TEST(TimingWheelTest, TimersFireExactlyAtTheirTick) {
+    TimingWheel wheel;
+    std::mt19937_64 rng(7);
+    std::vector<uint64_t> expiry(5000);
+    for (uint64_t id = 0; id < expiry.size(); ++id) {
+        // Spread across all four levels
+        expiry[id] = 1 + rng() % (uint64_t(1) << (8 * (1 + id % 4)));
+        expiry[id] = std::min<uint64_t>(expiry[id], 3000000);
+        wheel.schedule(id, expiry[id]);
+    }
+    EXPECT_EQ(wheel.size(), expiry.size());
+
+    std::vector<uint64_t> fired_at(expiry.size(), 0);
+    uint64_t now = 0;
+    while (wheel.size() > 0) {
+        now += 1 + rng() % 1000;
+        wheel.advance(now, [&](uint64_t id) { fired_at[id] = now; });
+    }
+
+    // Each timer fires on the first advance that reaches its tick
+    for (uint64_t id = 0; id < expiry.size(); ++id) {
+        ASSERT_GE(fired_at[id], expiry[id]);
+        ASSERT_LT(fired_at[id] - expiry[id], 1000u);
+    }
+}
+
+TEST(TimingWheelTest, StepwiseAdvanceFiresOnTheDueTick) {
+    TimingWheel wheel(1000);
+    wheel.schedule(1, 1000 + 70000);
+    wheel.schedule(2, 500);     // Already past: fires on the next tick
+
+    std::vector<std::pair<uint64_t, uint64_t>> fired;
+    for (uint64_t tick = 1001; tick <= 1000 + 70000; ++tick) {
+        wheel.advance(tick, [&](uint64_t id) { fired.emplace_back(id, tick); });
+    }
+
+    ASSERT_EQ(fired.size(), 2u);
+    EXPECT_EQ(fired[0], std::make_pair(uint64_t(2), uint64_t(1001)));
+    EXPECT_EQ(fired[1], std::make_pair(uint64_t(1), uint64_t(71000)));
+}
+
+class StockHoldTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        inventory = std::make_unique<Inventory>();
+        inventory->addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 10,
+                                                                  system_clock::now() + hours(24 * 30)));
+    }
+
+    std::unique_ptr<Inventory> inventory;
+};
+
+TEST_F(StockHoldTest, HeldStockIsUnavailableUntilReleased) {
+    uint64_t hold = inventory->placeHold("MILK001", 7, minutes(5));
+    ASSERT_NE(hold, 0u);
+
+    EXPECT_EQ(inventory->getAvailableQuantity("MILK001"), 3);
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 10);
+    EXPECT_EQ(inventory->placeHold("MILK001", 4, minutes(5)), 0u);
+    EXPECT_FALSE(inventory->removeQuantity("MILK001", 4));
+
+    EXPECT_TRUE(inventory->releaseHold(hold));
+    EXPECT_FALSE(inventory->releaseHold(hold));
+    EXPECT_EQ(inventory->getAvailableQuantity("MILK001"), 10);
+}
+
+TEST_F(StockHoldTest, ConfirmRemovesHeldStock) {
+    uint64_t hold = inventory->placeHold("MILK001", 4, minutes(5));
+    StockHold details;
+    ASSERT_TRUE(inventory->getHold(hold, details));
+    EXPECT_EQ(details.quantity, 4);
+
+    EXPECT_TRUE(inventory->confirmHold(hold));
+    EXPECT_FALSE(inventory->confirmHold(hold));
+    EXPECT_EQ(inventory->getProduct("MILK001")->getQuantity(), 6);
+    EXPECT_EQ(inventory->getAvailableQuantity("MILK001"), 6);
+    EXPECT_EQ(inventory->getHoldCount(), 0u);
+}
+
+TEST_F(StockHoldTest, HoldsExpireAfterTheirTtl) {
+    uint64_t hold = inventory->placeHold("MILK001", 10, milliseconds(150));
+    ASSERT_NE(hold, 0u);
+    EXPECT_EQ(inventory->expireHolds(), 0u);
+    EXPECT_EQ(inventory->getAvailableQuantity("MILK001"), 0);
+
+    std::this_thread::sleep_for(milliseconds(400));
+    EXPECT_EQ(inventory->expireHolds(), 1u);
+    EXPECT_EQ(inventory->getAvailableQuantity("MILK001"), 10);
+    EXPECT_FALSE(inventory->confirmHold(hold));
+}
+
+TEST_F(StockHoldTest, TtlMustBePositiveAndIsCapped) {
+    EXPECT_EQ(inventory->placeHold("MILK001", 1, milliseconds(0)), 0u);
+    EXPECT_EQ(inventory->placeHold("MILK001", 1, milliseconds(-1)), 0u);
+    EXPECT_EQ(inventory->placeHold("MILK001", 1, milliseconds::min()), 0u);
+    EXPECT_EQ(inventory->getHoldCount(), 0u);
+    EXPECT_EQ(inventory->getAvailableQuantity("MILK001"), 10);
+
+    // Would overflow the deadline arithmetic if taken as is
+    auto before = system_clock::now();
+    uint64_t hold = inventory->placeHold("MILK001", 3, milliseconds::max());
+    ASSERT_NE(hold, 0u);
+    StockHold details;
+    ASSERT_TRUE(inventory->getHold(hold, details));
+    EXPECT_GE(details.expires_at, before + Inventory::MAX_HOLD_TTL);
+    EXPECT_LE(details.expires_at, system_clock::now() + Inventory::MAX_HOLD_TTL);
+    EXPECT_EQ(inventory->expireHolds(), 0u);
+    EXPECT_EQ(inventory->getAvailableQuantity("MILK001"), 7);
+    EXPECT_TRUE(inventory->releaseHold(hold));
+}
+
+TEST_F(StockHoldTest, RemovingProductDropsItsHolds) {
+    uint64_t hold = inventory->placeHold("MILK001", 2, minutes(5));
+    EXPECT_TRUE(inventory->removeProduct("MILK001"));
+    EXPECT_EQ(inventory->getHoldCount(), 0u);
+    EXPECT_FALSE(inventory->confirmHold(hold));
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include "../../include/Inventory.hpp"
+#include "../../include/Product.hpp"
+#include "../../include/VersionStore.hpp"
+
+using namespace quirkventory;
+using namespace std::chrono;
+
+// Test Fixture for Inventory Versioning Tests
+class VersionStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        inventory = std::make_unique<Inventory>();
+        auto expiry = system_clock::now() + hours(24 * 30);
+        inventory->addProduct(std::make_unique<PerishableProduct>("MILK001", "Fresh Milk", "Dairy", 5.0, 20, expiry));
+        inventory->addProduct(std::make_unique<PerishableProduct>("BREAD001", "Bread", "Bakery", 2.0, 30, expiry));
+    }
+
+    int quantityIn(const VersionStore::ReadView& view, const std::string& product_id) {
+        ProductRecord record;
+        return inventory->getProductRecord(view, product_id, record) ? record.quantity : -1;
+    }
+
+    std::unique_ptr<Inventory> inventory;
+};
+
+TEST_F(VersionStoreTest, DisabledByDefault) {
+    EXPECT_FALSE(inventory->isVersioningEnabled());
+    EXPECT_EQ(inventory->getVersionStore(), nullptr);
+    EXPECT_FALSE(inventory->openReadView().valid());
+    EXPECT_EQ(inventory->collectVersionGarbage(), 0u);
+
+    InventorySnapshot snapshot;
+    EXPECT_FALSE(inventory->snapshotAsOf(system_clock::now(), snapshot));
+
+    // The unversioned paths keep working
+    EXPECT_EQ(inventory->snapshot().products.size(), 2u);
+}
+
+TEST_F(VersionStoreTest, EnableSeedsExistingProducts) {
+    ASSERT_TRUE(inventory->enableVersioning());
+    EXPECT_FALSE(inventory->enableVersioning());
+
+    auto view = inventory->openReadView();
+    ASSERT_TRUE(view.valid());
+    EXPECT_EQ(quantityIn(view, "MILK001"), 20);
+    EXPECT_EQ(quantityIn(view, "BREAD001"), 30);
+    EXPECT_EQ(inventory->getVersionStore()->getVersionCount(), 2u);
+}
+
+TEST_F(VersionStoreTest, PinnedViewIgnoresLaterWrites) {
+    inventory->enableVersioning();
+    auto view = inventory->openReadView();
+
+    inventory->removeQuantity("MILK001", 5);
+    inventory->removeProduct("BREAD001");
+    auto expiry = system_clock::now() + hours(24);
+    inventory->addProduct(std::make_unique<PerishableProduct>("EGGS001", "Eggs", "Dairy", 3.0, 12, expiry));
+
+    // The pinned view still sees the state it was opened at
+    EXPECT_EQ(quantityIn(view, "MILK001"), 20);
+    EXPECT_EQ(quantityIn(view, "BREAD001"), 30);
+    EXPECT_EQ(quantityIn(view, "EGGS001"), -1);
+
+    auto latest = inventory->openReadView();
+    EXPECT_EQ(quantityIn(latest, "MILK001"), 15);
+    EXPECT_EQ(quantityIn(latest, "BREAD001"), -1);
+
+    // Records carry the version the product had in the view
+    ProductRecord then, now;
+    ASSERT_TRUE(inventory->getProductRecord(view, "MILK001", then));
+    ASSERT_TRUE(inventory->getProductRecord(latest, "MILK001", now));
+    EXPECT_EQ(now.product_version, inventory->getProduct("MILK001")->getVersion());
+    EXPECT_LT(then.product_version, now.product_version);
+    EXPECT_EQ(quantityIn(latest, "EGGS001"), 12);
+
+    size_t visited = 0;
+    inventory->forEachProduct(view, [&visited](const ProductRecord&) { visited++; });
+    EXPECT_EQ(visited, 2u);
+}
+
+TEST_F(VersionStoreTest, AsOfReadsRecentHistory) {
+    inventory->enableVersioning(minutes(5));
+
+    std::this_thread::sleep_for(milliseconds(2));
+    auto before_sale = system_clock::now();
+    std::this_thread::sleep_for(milliseconds(2));
+    inventory->removeQuantity("MILK001", 8);
+
+    InventorySnapshot past;
+    ASSERT_TRUE(inventory->snapshotAsOf(before_sale, past));
+    EXPECT_EQ(past.taken_at, before_sale);
+    ASSERT_EQ(past.products.size(), 2u);
+    for (const auto& record : past.products) {
+        if (record.id == "MILK001") {
+            EXPECT_EQ(record.quantity, 20);
+        }
+    }
+
+    auto now_view = inventory->openReadViewAsOf(system_clock::now());
+    EXPECT_EQ(quantityIn(now_view, "MILK001"), 12);
+
+    // Before versioning was enabled there is no history to read
+    InventorySnapshot too_old;
+    EXPECT_FALSE(inventory->snapshotAsOf(before_sale - hours(1), too_old));
+}
+
+TEST_F(VersionStoreTest, BatchedChangesBecomeVisibleTogether) {
+    inventory->enableVersioning();
+    const VersionStore* store = inventory->getVersionStore();
+    uint64_t before = store->getLatestCommit();
+
+    inventory->releaseQuantities({{"MILK001", 1}, {"BREAD001", 2}});
+    EXPECT_EQ(store->getLatestCommit(), before + 1);
+
+    std::vector<bool> reserved;
+    inventory->reserveBatch({{{"MILK001", 3}, {"BREAD001", 4}}}, reserved);
+    EXPECT_EQ(store->getLatestCommit(), before + 2);
+
+    auto view = inventory->openReadView();
+    EXPECT_EQ(quantityIn(view, "MILK001"), 18);
+    EXPECT_EQ(quantityIn(view, "BREAD001"), 28);
+}
+
+TEST_F(VersionStoreTest, GarbageCollectionKeepsWhatViewsNeed) {
+    inventory->enableVersioning(milliseconds(0));
+    const VersionStore* store = inventory->getVersionStore();
+
+    auto view = inventory->openReadView();
+    for (int i = 0; i < 10; ++i) {
+        inventory->removeQuantity("MILK001", 1);
+    }
+    EXPECT_EQ(store->getVersionCount(), 12u);
+
+    // The open view still needs the seeded version of MILK001, so nothing older goes
+    EXPECT_EQ(inventory->collectVersionGarbage(), 0u);
+    EXPECT_EQ(quantityIn(view, "MILK001"), 20);
+
+    // Once it is released only the newest version of each product is needed
+    view.release();
+    EXPECT_EQ(inventory->collectVersionGarbage(), 10u);
+    EXPECT_EQ(store->getVersionCount(), 2u);
+    EXPECT_EQ(quantityIn(inventory->openReadView(), "MILK001"), 10);
+
+    // A removed product's chain goes away once no view can see it
+    inventory->removeProduct("BREAD001");
+    inventory->collectVersionGarbage();
+    EXPECT_EQ(store->getVersionCount(), 1u);
+    EXPECT_EQ(quantityIn(inventory->openReadView(), "BREAD001"), -1);
+}
+
+TEST_F(VersionStoreTest, ReadersSeeConsistentTotalsDuringWrites) {
+    inventory->enableVersioning(milliseconds(0));
+
+    // Stock moves between the two products one unit per commit, so every view totals 49 or 50
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (int i = 0; i < 2000; ++i) {
+            std::vector<bool> reserved;
+            inventory->reserveBatch({{{"MILK001", 1}}}, reserved);
+            inventory->releaseQuantities({{"BREAD001", 1}});
+            inventory->reserveBatch({{{"BREAD001", 1}}}, reserved);
+            inventory->releaseQuantities({{"MILK001", 1}});
+            if (i % 100 == 0) {
+                inventory->collectVersionGarbage();
+            }
+        }
+        done = true;
+    });
+
+    int inconsistent = 0;
+    int reads = 0;
+    while (!done || reads == 0) {
+        auto view = inventory->openReadView();
+        int milk = quantityIn(view, "MILK001");
+        int bread = quantityIn(view, "BREAD001");
+        if (milk + bread < 49 || milk + bread > 50) {
+            inconsistent++;
+        }
+        reads++;
+    }
+    writer.join();
+
+    EXPECT_EQ(inconsistent, 0);
+    auto snapshot = inventory->snapshot();
+    int total = 0;
+    for (const auto& record : snapshot.products) {
+        total += record.quantity;
+    }
+    EXPECT_EQ(total, 50);
+}